@@ -4,6 +4,7 @@
 #include <cstring>
 #include "util.h"
 #include "iterator.h"
+#include "simd.h"
 
 namespace mystl
 {
@@ -19,86 +20,96 @@ namespace mystl
 #undef min
 #endif
 
+// 本文件中的算法都是 constexpr 的，可以在编译期构造常量表
+    // 连续内存上的 copy/move/fill/equal/mismatch/lexicographical_compare/find/count/search/find_first_of
+    // 和 min_element/max_element/minmax_element 调用 simd.h 中按 CPU 分派的向量化内核，
+    // 这些快速路径在编译期求值时退回到逐元素循环（见 util.h 中的 is_constant_evaluated）
+// noexcept 按元素操作和迭代器操作是否会抛异常来推导，容器可以据此选择移动而不是拷贝
+
 // 1.max：比较两个参数的大小，返回较大值，相等时返回第一个值
 template <class T>
-const T& max(const T& lhs, const T& rhs){
+constexpr const T& max(const T& lhs, const T& rhs) noexcept(noexcept(lhs<rhs)){
     return lhs<rhs? rhs:lhs;
 }
 
 // 1.1自定义比较函数的max
     // 比较函数按小于来写
 template <class T, class Compare>
-const T& max(const T& lhs, const T& rhs, Compare comp){
+constexpr const T& max(const T& lhs, const T& rhs, Compare comp) noexcept(noexcept(comp(lhs,rhs))){
     return comp(lhs,rhs)? rhs:lhs;
 }
 
 // 2.min：比较两个参数的大小，返回较小值，相等时返回第一个值
 template <class T>
-const T& min(const T& lhs, const T& rhs){
+constexpr const T& min(const T& lhs, const T& rhs) noexcept(noexcept(rhs<lhs)){
     return rhs<lhs? rhs:lhs;
 }
 
 // 2.1自定义比较函数的min
     // 比较函数也是小于
 template <class T, class Compare>
-const T& min(const T& lhs, const T& rhs, Compare comp){
+constexpr const T& min(const T& lhs, const T& rhs, Compare comp) noexcept(noexcept(comp(rhs,lhs))){
     return comp(rhs,lhs)? rhs:lhs;
 }
 
 // 3.iter_swap：将两个迭代器所指对象对调
 template <class FIter1, class FIter2>
-void iter_swap(FIter1 lhs, FIter2 rhs){
+constexpr void iter_swap(FIter1 lhs, FIter2 rhs) noexcept(noexcept(mystl::swap(*lhs,*rhs))){
     mystl::swap(*lhs,*rhs);
 }
 
 // 4.copy：把被拷贝容器[first,last)区间内的元素拷贝到指定容器中
 // 针对input_iterator_tag的重载
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag){
-    for(;first!=last; first++,result++){
+constexpr OutputIter unchecked_copy_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag)
+    noexcept(noexcept(*result=*first) && noexcept(first!=last) && noexcept(++first) && noexcept(++result)){
+    for(;first!=last; ++first,++result){
         *result=*first;
     }
     return result;
 }
 // 针对random_access_iterator_tag的重载
 template <class RandomIter, class OutputIter>
-OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result, mystl::random_access_iterator_tag){
+constexpr OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result, mystl::random_access_iterator_tag)
+    noexcept(noexcept(*result=*first) && noexcept(last-first) && noexcept(++first) && noexcept(++result)){
     // 速度快于input_iterator_tag的拷贝
-    for(auto n=last-first; n>0; n--,first++,result++){
+    for(auto n=last-first; n>0; --n,++first,++result){
         *result=*first;
     }
     return result;
 }
 // 根据迭代器类型调用对应函数，复制迭代器位置上的值
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result){
+constexpr OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result)
+    noexcept(noexcept(unchecked_copy_cat(first,last,result,iterator_category(first)))){
     return unchecked_copy_cat(first,last,result,iterator_category(first));
-} 
+}
 
 // 为trivially_copy_assignable 类型提供特化版本
     // 使用类型特征萃取和 SFINAE 技术，利用了编译期进行类型检查，以便在符合条件的情况下使用更高效的 memmove 函数进行复制
     // SFINAE（Substitution Failure Is Not An Error）： 是一种模板元编程技术，允许在编译期根据类型的条件进行选择和重载。
         // 当在模板实例化时发生类型替换失败（例如，不满足某些条件时），编译器不会抛出错误，而是会继续寻找其他可行的模板实例化。
 template <class Tp,class Up>
-typename std::enable_if<
+constexpr typename std::enable_if<
 std::is_same<typename std::remove_const<Tp>::type, Up>::value && 
 std::is_trivially_copy_assignable<Up>::value,Up*
->::type unchecked_copy(Tp* first,Tp* last, Up* result){
+>::type unchecked_copy(Tp* first,Tp* last, Up* result) noexcept{
     // std::enable_if 是一个模板元函数，在编译时条件为真则返回第二个类型参数
     // 在这里，我们检查 Tp 是否去除了 const 修饰后和 Up 是否相同，以及 Up 是否可以进行平凡的拷贝赋值
-    // 如果满足，则调用memmove函数，将一块内存从一个位置复制到另一个位置，速度最快
-        // 第一个参数：目标内存块的指针，表示数据将被移动到的位置。
-        // 第二个参数：源内存块的指针，表示要被移动的数据的起始位置。
-        // 第三个参数：要移动的字节数。
+    // 如果满足，则按字节整块复制（memmove 语义，允许重叠），由 simd::copy_bytes 选择当前 CPU 上最快的内核
+    if(mystl::is_constant_evaluated()){
+        return unchecked_copy_cat(first,last,result,mystl::random_access_iterator_tag());
+    }
     const auto n=static_cast<size_t>(last-first);
     if(n!=0){
-        std::memmove(result,first,n*sizeof(Up));
+        mystl::simd::copy_bytes(result,first,n*sizeof(Up));
     }
     return result+n;
 }
 
 template <class InputIter, class OutputIter>
-OutputIter copy(InputIter first, InputIter last, OutputIter result){
+constexpr OutputIter copy(InputIter first, InputIter last, OutputIter result)
+    noexcept(noexcept(unchecked_copy(first,last,result))){
     return unchecked_copy(first,last,result);
 }
 
@@ -106,7 +117,8 @@ OutputIter copy(InputIter first, InputIter last, OutputIter result){
 // 5.copy_backward：将 [first, last)区间内的元素拷贝到 [result - (last - first), result)内
 // bidirectional_iterator_tag（针对bidirectional_iterator_tag及以上的迭代器）
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result, mystl::bidirectional_iterator_tag){
+constexpr BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result, mystl::bidirectional_iterator_tag)
+    noexcept(noexcept(*--result=*--last) && noexcept(first!=last)){
     while(first!=last){
         // 前--是因为右开
         *--result=*--last;
@@ -115,32 +127,39 @@ BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first, Bidirec
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result){
+constexpr BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
+    noexcept(noexcept(unchecked_copy_backward_cat(first,last,result,iterator_category(first)))){
     return unchecked_copy_backward_cat(first,last,result,iterator_category(first));
 }
 
 // trivially_copy_assignable特化版本
 template <class Tp, class Up>
-typename std::enable_if<
+constexpr typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type,Up>::value &&
     std::is_trivially_copy_assignable<Up>::value, Up*>::type
-    unchecked_copy_backward(Tp* first, Tp* last, Up* result){
+    unchecked_copy_backward(Tp* first, Tp* last, Up* result) noexcept{
+    if(mystl::is_constant_evaluated()){
+        return unchecked_copy_backward_cat(first,last,result,mystl::bidirectional_iterator_tag());
+    }
     const auto n=static_cast<size_t>(last-first);
     if(n!=0){
         result-=n; //起点
-        std::memmove(result, first, n*sizeof(Up));
+        mystl::simd::copy_bytes(result, first, n*sizeof(Up));
     }
     return result;
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result){
+constexpr BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
+    noexcept(noexcept(unchecked_copy_backward(first,last,result))){
     return unchecked_copy_backward(first,last,result);
 }
 
 // 6.copy_if：把[first, last)内满足一元操作 unary_pred 的元素拷贝到以 result 为起始的位置上
 template <class InputIter, class OutputIter, class UnaryPredicate>
-OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred){
+constexpr OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred)
+    noexcept(noexcept(unary_pred(*first)) && noexcept(*result++=*first) &&
+             noexcept(first!=last) && noexcept(++first)){
     for(; first!=last; ++first){
         if(unary_pred(*first)){
             // 注意result++不能放在for循环中，因为可能存在不满足条件的元素
@@ -152,29 +171,38 @@ OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPred
 
 // 7.copy_n：把 [first, first + n)区间上的元素拷贝到 [result, result + n)上，返回一个 pair 分别指向拷贝结束的尾部
 template <class InputIter, class Size, class OutputIter>
-mystl::pair<InputIter, OutputIter> unchecked_copy_n(InputIter fisr, Size n, OutputIter result, mystl::input_iterator_tag){
+constexpr mystl::pair<InputIter, OutputIter> unchecked_copy_n(InputIter first, Size n, OutputIter result, mystl::input_iterator_tag)
+    noexcept(noexcept(*result=*first) && noexcept(++first) && noexcept(++result) &&
+             std::is_nothrow_copy_constructible<InputIter>::value &&
+             std::is_nothrow_copy_constructible<OutputIter>::value){
     for(; n>0;--n, ++first, ++result){
         *result=*first;
     }
-    return mystl::pair<InputIter, OutputIter>(fisrt,result);
+    return mystl::pair<InputIter, OutputIter>(first,result);
 }
 
 // random_access_iterator_tag特化版本
 template <class RandomIter, class Size, class OutputIter>
-mystl::pair<RandomIter, OutputIter> unchecked_copy_n(RandomIter first, Size n, OutputIter result, mystl::random_access_iterator_tag){
+constexpr mystl::pair<RandomIter, OutputIter> unchecked_copy_n(RandomIter first, Size n, OutputIter result, mystl::random_access_iterator_tag)
+    noexcept(noexcept(first+n) && noexcept(mystl::copy(first, first, result)) &&
+             std::is_nothrow_copy_constructible<RandomIter>::value &&
+             std::is_nothrow_copy_constructible<OutputIter>::value){
     auto last=first+n;
     return mystl::pair<RandomIter, OutputIter>(last, mystl::copy(first, last, result));
 }
 
 template <class InputIter, class Size, class OutputIter>
-mystl::pair<InputIter, OutputIter> copy_n(InputIter first, Size n, OutputIter result){
+constexpr mystl::pair<InputIter, OutputIter> copy_n(InputIter first, Size n, OutputIter result)
+    noexcept(noexcept(unchecked_copy_n(first, n,result,iterator_category(first)))){
     return unchecked_copy_n(first, n,result,iterator_category(first));
 }
 
 // 8.move：把 [first, last)区间内的元素移动到 [result, result + (last - first))内
 // input_iterator_tag
 template <class InputIter, class OutputIter>
-OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag){
+constexpr OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag)
+    noexcept(noexcept(*result=mystl::move(*first)) && noexcept(first!=last) &&
+             noexcept(++first) && noexcept(++result)){
     for(; first!=last; ++first, ++result){
         *result=mystl::move(*first);
     }
@@ -183,33 +211,40 @@ OutputIter unchecked_move_cat(InputIter first, InputIter last, OutputIter result
 
 // random_access_iterator_tag特化版本
 template <class RandomIter, class OutputIter>
-OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter result, mystl::random_access_iterator_tag){
-    for(auto n=last-first; n>0; --n,++fisrt,++result){
+constexpr OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter result, mystl::random_access_iterator_tag)
+    noexcept(noexcept(*result=mystl::move(*first)) && noexcept(last-first) &&
+             noexcept(++first) && noexcept(++result)){
+    for(auto n=last-first; n>0; --n,++first,++result){
         *result=mystl::move(*first);
     }
     return result;
 }
 
 template <class InputIter, class OutputIter>
-OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result){
+constexpr OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result)
+    noexcept(noexcept(unchecked_move_cat(first, last,result,iterator_category(first)))){
     return unchecked_move_cat(first, last,result,iterator_category(first));
 }
 
 // trivially_copy_assignable特化版本
 template <class Tp, class Up>
-typename std::enable_if<
+constexpr typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
     std::is_trivially_move_assignable<Up>::value,Up*>::type
-    unchecked_move(Tp* first, Tp* last, Up* result){
+    unchecked_move(Tp* first, Tp* last, Up* result) noexcept{
+    if(mystl::is_constant_evaluated()){
+        return unchecked_move_cat(first, last, result, mystl::random_access_iterator_tag());
+    }
     const size_t n=static_cast<size_t>(last-first);
     if(n!=0){
-        std::memmove(result,first,n*sizeof(Up));
+        mystl::simd::copy_bytes(result,first,n*sizeof(Up));
     }
     return result+n;
 }
 
 template <class InputIter, class OutputIter>
-OutputIter move(InputIter first, InputIter last, OutputIter result){
+constexpr OutputIter move(InputIter first, InputIter last, OutputIter result)
+    noexcept(noexcept(unchecked_move(first, last, result))){
     return unchecked_move(first, last, result);
 }
 
@@ -217,7 +252,8 @@ OutputIter move(InputIter first, InputIter last, OutputIter result){
 // 9.move_backward：将 [first, last)区间内的元素移动到 [result - (last - first), result)内
 // bidirectional_iterator_tag 版本
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,BidirectionalIter2 result, mystl::bidirectional_iterator_tag){
+constexpr BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first, BidirectionalIter1 last,BidirectionalIter2 result, mystl::bidirectional_iterator_tag)
+    noexcept(noexcept(*--result = mystl::move(*--last)) && noexcept(first != last)){
     while (first != last)
         *--result = mystl::move(*--last);
     return result;
@@ -225,40 +261,47 @@ BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first, Bidirec
 
 // random_access_iterator_tag 版本
 template <class RandomIter1, class RandomIter2> 
-RandomIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,RandomIter2 result, mystl::random_access_iterator_tag){
+constexpr RandomIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,RandomIter2 result, mystl::random_access_iterator_tag)
+    noexcept(noexcept(*--result = mystl::move(*--last)) && noexcept(last - first)){
     for (auto n = last - first; n > 0; --n)
         *--result = mystl::move(*--last);
     return result;
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result){
+constexpr BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
+    noexcept(noexcept(unchecked_move_backward_cat(first, last, result,iterator_category(first)))){
   return unchecked_move_backward_cat(first, last, result,iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
-typename std::enable_if<
+constexpr typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
     std::is_trivially_move_assignable<Up>::value,Up*>::type
-    unchecked_move_backward(Tp* first, Tp* last, Up* result){
+    unchecked_move_backward(Tp* first, Tp* last, Up* result) noexcept{
+    if (mystl::is_constant_evaluated())
+        return unchecked_move_backward_cat(first, last, result, mystl::random_access_iterator_tag());
     const size_t n = static_cast<size_t>(last - first);
     if (n != 0)
     {
         result -= n;
-        std::memmove(result, first, n * sizeof(Up));
+        mystl::simd::copy_bytes(result, first, n * sizeof(Up));
     }
     return result;
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result){
+constexpr BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result)
+    noexcept(noexcept(unchecked_move_backward(first, last, result))){
   return unchecked_move_backward(first, last, result);
 }
 
 // 10.equal：比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2){
+constexpr bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    noexcept(noexcept(*first1!=*first2) && noexcept(first1!=last1) &&
+             noexcept(++first1) && noexcept(++first2)){
     for(; first1!=last1; ++first1, ++first2){
         if(*first1!=*first2){
             return false;
@@ -267,9 +310,35 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2){
     return true;
 }
 
+// 可按字节比较的同类型元素（整数、指针、枚举）：调用向量化的 mismatch_bytes 内核
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+    mystl::simd::is_bitwise_comparable<typename std::remove_const<Tp>::type>::value, bool>::type
+    unchecked_equal(Tp* first1, Tp* last1, Up* first2) noexcept{
+    if(mystl::is_constant_evaluated()){
+        for(; first1!=last1; ++first1, ++first2){
+            if(*first1!=*first2){
+                return false;
+            }
+        }
+        return true;
+    }
+    const size_t bytes=static_cast<size_t>(last1-first1)*sizeof(Tp);
+    return mystl::simd::mismatch_bytes(first1, first2, bytes)==bytes;
+}
+
+template <class InputIter1, class InputIter2>
+constexpr bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    noexcept(noexcept(unchecked_equal(first1, last1, first2))){
+    return unchecked_equal(first1, last1, first2);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compared>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp){
+constexpr bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
+    noexcept(noexcept(comp(*first1,*first2)) && noexcept(first1!=last1) &&
+             noexcept(++first1) && noexcept(++first2)){
     for(; first1!=last1; ++first1, ++first2){
         if(!comp(*first1,*first2)){
             return false;
@@ -280,7 +349,8 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp
 
 // 11.fill_n：从first位置开始填充n个相同值
 template <class OutputIter, class Size, class T>
-OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value){
+constexpr OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value)
+    noexcept(noexcept(*first=value) && noexcept(++first)){
     for(; n>0; n--,++first){
         *first=value;
     }
@@ -289,40 +359,72 @@ OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value){
 
 // 为 one-byte 类型提供特化版本，提高效率
 template <class Tp, class Size, class Up>
-typename std::enable_if<
+constexpr typename std::enable_if<
     std::is_integral<Tp>::value && sizeof(Tp)==1 &&
     !std::is_same<Tp, bool>::value &&
     std::is_integral<Up>::value && sizeof(Up)==1, Tp*>::type
     // 是整数类型，并且大小为 1 字节，不是 bool 类型（如 char、signed char、unsigned char）
-    unchecked_fill_n(Tp* first, Size n, Up value){
+    unchecked_fill_n(Tp* first, Size n, Up value) noexcept{
+    if(mystl::is_constant_evaluated()){
+        for(Size i=0; i<n; ++i){
+            first[i]=static_cast<Tp>(value);
+        }
+        return n>0? first+n : first;
+    }
+    if(n>0){
+        // 整块按字节填充，大块时内核退回到 libc 的 memset
+        mystl::simd::fill(reinterpret_cast<uint8_t*>(first), static_cast<uint8_t>(value), static_cast<size_t>(n));
+        return first+n;
+    }
+    return first;
+}
+
+// 为 2/4/8 字节的标量类型（整数、浮点数、指针、枚举）提供特化版本
+    // 先把 value 转换为元素类型，再按位模式整块填充，与逐个赋值的结果相同
+template <class Tp, class Size, class Up>
+constexpr typename std::enable_if<
+    std::is_scalar<Tp>::value && !std::is_const<Tp>::value &&
+    (sizeof(Tp)==2 || sizeof(Tp)==4 || sizeof(Tp)==8) &&
+    std::is_convertible<const Up&, Tp>::value, Tp*>::type
+    unchecked_fill_n(Tp* first, Size n, const Up& value) noexcept{
+    const Tp v=value;
+    if(mystl::is_constant_evaluated()){
+        for(Size i=0; i<n; ++i){
+            first[i]=v;
+        }
+        return n>0? first+n : first;
+    }
     if(n>0){
-        // 对于某些操作，如初始化大型内存块，使用 memset 可能会比逐个赋值更高效，因为 memset 是高度优化的库函数。
-        // 第一个参数指向要填充的内存块的起始地址，第二个参数是要填充的值，第三个参数是要填充的字节数。
-        std::memset(first, (unsigned char)value, (size_t)(n));
+        mystl::simd::fill_n(first, v, static_cast<size_t>(n));
+        return first+n;
     }
-    return first+n;
+    return first;
 }
 
 template <class OutputIter, class Size, class T>
-OutputIter fill_n(OutputIter first, Size n, const T& value){
+constexpr OutputIter fill_n(OutputIter first, Size n, const T& value)
+    noexcept(noexcept(unchecked_fill_n(first, n, value))){
     return unchecked_fill_n(first, n, value);
 }
 
 // 12.fill：为 [first, last)区间内的所有元素填充新值
 template <class ForwardIter, class T>
-void fill_cat(ForwardIter first, ForwardIter last, const T& value,mystl::forward_iterator_tag){
+constexpr void fill_cat(ForwardIter first, ForwardIter last, const T& value,mystl::forward_iterator_tag)
+    noexcept(noexcept(*first = value) && noexcept(first != last) && noexcept(++first)){
     for (; first != last; ++first){
         *first = value;
     }
 }
 
 template <class RandomIter, class T>
-void fill_cat(RandomIter first, RandomIter last, const T& value,mystl::random_access_iterator_tag){
-    fill_n(first, last - first, value);
+constexpr void fill_cat(RandomIter first, RandomIter last, const T& value,mystl::random_access_iterator_tag)
+    noexcept(noexcept(mystl::fill_n(first, last - first, value))){
+    mystl::fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
-void fill(ForwardIter first, ForwardIter last, const T& value){
+constexpr void fill(ForwardIter first, ForwardIter last, const T& value)
+    noexcept(noexcept(fill_cat(first, last, value, iterator_category(first)))){
     fill_cat(first, last, value, iterator_category(first));
 }
 
@@ -332,7 +434,10 @@ void fill(ForwardIter first, ForwardIter last, const T& value){
 // (3)如果到达 last2 而尚未到达 last1 返回 false
 // (4)如果同时到达 last1 和 last2 返回 false
 template <class InputIter1, class InputIter2>
-bool lexicographical_compare(InputIter1 first1, InputIter1 last1,InputIter2 first2, InputIter2 last2){
+constexpr bool unchecked_lexicographical_compare(InputIter1 first1, InputIter1 last1,InputIter2 first2, InputIter2 last2)
+    noexcept(noexcept(*first1 < *first2) && noexcept(*first2 < *first1) &&
+             noexcept(first1 != last1) && noexcept(first2 != last2) &&
+             noexcept(++first1) && noexcept(++first2)){
     for (; first1 != last1 && first2 != last2; ++first1, ++first2)
     {
         // 等于就继续比较
@@ -344,10 +449,48 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1,InputIter2 firs
     return first1 == last1 && first2 != last2;
 }
 
+// 同类型整数（不含 bool）的连续区间：先用 mismatch_bytes 找到第一个不同的字节，
+// 它所在的元素就是第一个不同的元素，再按元素类型比较这一对元素
+    // 多字节元素在小端序下高位字节在后，不能直接比较字节，有符号类型也不能按无符号字节比较，
+    // 所以只用字节比较定位，大小由元素本身的 < 决定，任何字节序和符号都正确
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+    std::is_integral<typename std::remove_const<Tp>::type>::value &&
+    !std::is_same<typename std::remove_const<Tp>::type, bool>::value, bool>::type
+    unchecked_lexicographical_compare(Tp* first1, Tp* last1, Up* first2, Up* last2) noexcept{
+    const auto len1 = last1 - first1;
+    const auto len2 = last2 - first2;
+    if (mystl::is_constant_evaluated())
+    {
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+        {
+            if (*first1 != *first2)
+                return *first1 < *first2;
+        }
+        return len1 < len2;
+    }
+    // 先找出相同长度部分中第一个不同的元素
+    const auto len = static_cast<size_t>(mystl::min(len1, len2));
+    const size_t k = mystl::simd::mismatch_bytes(first1, first2, len * sizeof(Tp)) / sizeof(Tp);
+    if (k != len)
+        return first1[k] < first2[k];
+    // 若相等，长度较长的比较大
+    return len1 < len2;
+}
+
+template <class InputIter1, class InputIter2>
+constexpr bool lexicographical_compare(InputIter1 first1, InputIter1 last1,InputIter2 first2, InputIter2 last2)
+    noexcept(noexcept(unchecked_lexicographical_compare(first1, last1, first2, last2))){
+    return unchecked_lexicographical_compare(first1, last1, first2, last2);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compred>
-bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
-    InputIter2 first2, InputIter2 last2, Compred comp){
+constexpr bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, Compred comp)
+    noexcept(noexcept(comp(*first1, *first2)) && noexcept(first1 != last1) &&
+             noexcept(first2 != last2) && noexcept(++first1) && noexcept(++first2)){
     for (; first1 != last1 && first2 != last2; ++first1, ++first2)
     {
         if (comp(*first1, *first2))
@@ -358,20 +501,13 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
     return first1 == last1 && first2 != last2;
 }
 
-// 针对 const unsigned char* 的特化版本
-bool lexicographical_compare(const unsigned char* first1,const unsigned char* last1,
-    const unsigned char* first2,const unsigned char* last2){
-    const auto len1 = last1 - first1;
-    const auto len2 = last2 - first2;
-    // 先比较相同长度的部分
-    const auto result = std::memcmp(first1, first2, mystl::min(len1, len2));
-    // 若相等，长度较长的比较大
-    return result != 0 ? result < 0 : len1 < len2;
-}
-
 // 14.mismatch：平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
 template <class InputIter1, class InputIter2>
-mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2){
+constexpr mystl::pair<InputIter1, InputIter2> unchecked_mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    noexcept(noexcept(*first1 == *first2) && noexcept(first1 != last1) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<InputIter1>::value &&
+             std::is_nothrow_copy_constructible<InputIter2>::value){
     while (first1 != last1 && *first1 == *first2){
         ++first1;
         ++first2;
@@ -379,9 +515,38 @@ mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1
     return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+// 可按字节比较的同类型元素：第一个不同的字节所在的元素就是第一个失配的元素
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+    mystl::simd::is_bitwise_comparable<typename std::remove_const<Tp>::type>::value,
+    mystl::pair<Tp*, Up*>>::type
+    unchecked_mismatch(Tp* first1, Tp* last1, Up* first2) noexcept{
+    if (mystl::is_constant_evaluated()){
+        while (first1 != last1 && *first1 == *first2){
+            ++first1;
+            ++first2;
+        }
+        return mystl::pair<Tp*, Up*>(first1, first2);
+    }
+    const size_t k = mystl::simd::mismatch_bytes(first1, first2,
+        static_cast<size_t>(last1 - first1) * sizeof(Tp)) / sizeof(Tp);
+    return mystl::pair<Tp*, Up*>(first1 + k, first2 + k);
+}
+
+template <class InputIter1, class InputIter2>
+constexpr mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    noexcept(noexcept(unchecked_mismatch(first1, last1, first2))){
+    return unchecked_mismatch(first1, last1, first2);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compred>
-mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp){
+constexpr mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp)
+    noexcept(noexcept(comp(*first1, *first2)) && noexcept(first1 != last1) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<InputIter1>::value &&
+             std::is_nothrow_copy_constructible<InputIter2>::value){
     while (first1 != last1 && comp(*first1, *first2)){
         ++first1;
         ++first2;
@@ -389,6 +554,538 @@ mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1
     return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+// 15.find：在 [first, last)区间内找到第一个等于 value 的元素，没有时返回 last
+template <class InputIter, class T>
+constexpr InputIter unchecked_find_cat(InputIter first, InputIter last, const T& value, mystl::input_iterator_tag)
+    noexcept(noexcept(*first==value) && noexcept(first!=last) && noexcept(++first) &&
+             std::is_nothrow_copy_constructible<InputIter>::value){
+    while(first!=last && !(*first==value)){
+        ++first;
+    }
+    return first;
+}
+
+// 随机访问迭代器先算出次数，每轮比较 4 个元素，省去大部分 first!=last 的判断
+template <class RandomIter, class T>
+constexpr RandomIter unchecked_find_cat(RandomIter first, RandomIter last, const T& value, mystl::random_access_iterator_tag)
+    noexcept(noexcept(*first==value) && noexcept(last-first) && noexcept(++first) &&
+             std::is_nothrow_copy_constructible<RandomIter>::value){
+    for(auto trip=(last-first)>>2; trip>0; --trip){
+        if(*first==value) return first;
+        ++first;
+        if(*first==value) return first;
+        ++first;
+        if(*first==value) return first;
+        ++first;
+        if(*first==value) return first;
+        ++first;
+    }
+    for(auto n=last-first; n>0; --n, ++first){
+        if(*first==value) return first;
+    }
+    return last;
+}
+
+template <class InputIter, class T>
+constexpr InputIter unchecked_find(InputIter first, InputIter last, const T& value)
+    noexcept(noexcept(unchecked_find_cat(first, last, value, iterator_category(first)))){
+    return unchecked_find_cat(first, last, value, iterator_category(first));
+}
+
+// 连续的整数区间（不含 bool）：按元素宽度调用 simd 的比较加 movemask 内核
+    // value 先转换为元素类型，转换后不再等于 value（如在 unsigned char 中找 -1）时没有元素可能与它相等
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_integral<typename std::remove_const<Tp>::type>::value &&
+    !std::is_same<typename std::remove_const<Tp>::type, bool>::value &&
+    std::is_integral<Up>::value, Tp*>::type
+    unchecked_find(Tp* first, Tp* last, const Up& value) noexcept{
+    if(mystl::is_constant_evaluated()){
+        while(first!=last && !(*first==value)){
+            ++first;
+        }
+        return first;
+    }
+    const auto v=static_cast<typename std::remove_const<Tp>::type>(value);
+    if(!(v==value)){
+        return last;
+    }
+    return first+mystl::simd::find_n(first, v, static_cast<size_t>(last-first));
+}
+
+template <class InputIter, class T>
+constexpr InputIter find(InputIter first, InputIter last, const T& value)
+    noexcept(noexcept(unchecked_find(first, last, value))){
+    return unchecked_find(first, last, value);
+}
+
+// 16.find_if：在 [first, last)区间内找到第一个令一元操作 unary_pred 为 true 的元素，没有时返回 last
+template <class InputIter, class UnaryPredicate>
+constexpr InputIter unchecked_find_if_cat(InputIter first, InputIter last, UnaryPredicate unary_pred,
+    mystl::input_iterator_tag)
+    noexcept(noexcept(unary_pred(*first)) && noexcept(first!=last) && noexcept(++first) &&
+             std::is_nothrow_copy_constructible<InputIter>::value){
+    while(first!=last && !unary_pred(*first)){
+        ++first;
+    }
+    return first;
+}
+
+template <class RandomIter, class UnaryPredicate>
+constexpr RandomIter unchecked_find_if_cat(RandomIter first, RandomIter last, UnaryPredicate unary_pred,
+    mystl::random_access_iterator_tag)
+    noexcept(noexcept(unary_pred(*first)) && noexcept(last-first) && noexcept(++first) &&
+             std::is_nothrow_copy_constructible<RandomIter>::value){
+    for(auto trip=(last-first)>>2; trip>0; --trip){
+        if(unary_pred(*first)) return first;
+        ++first;
+        if(unary_pred(*first)) return first;
+        ++first;
+        if(unary_pred(*first)) return first;
+        ++first;
+        if(unary_pred(*first)) return first;
+        ++first;
+    }
+    for(auto n=last-first; n>0; --n, ++first){
+        if(unary_pred(*first)) return first;
+    }
+    return last;
+}
+
+template <class InputIter, class UnaryPredicate>
+constexpr InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred)
+    noexcept(noexcept(unchecked_find_if_cat(first, last, unary_pred, iterator_category(first)))){
+    return unchecked_find_if_cat(first, last, unary_pred, iterator_category(first));
+}
+
+// 17.count：统计 [first, last)区间内等于 value 的元素个数
+template <class InputIter, class T>
+constexpr typename iterator_traits<InputIter>::difference_type
+    unchecked_count(InputIter first, InputIter last, const T& value)
+    noexcept(noexcept(*first==value) && noexcept(first!=last) && noexcept(++first)){
+    typename iterator_traits<InputIter>::difference_type n=0;
+    for(; first!=last; ++first){
+        if(*first==value){
+            ++n;
+        }
+    }
+    return n;
+}
+
+// 连续的整数区间：与 find 相同的转换规则，计数由 simd 内核对每个向量的匹配掩码做 popcount
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_integral<typename std::remove_const<Tp>::type>::value &&
+    !std::is_same<typename std::remove_const<Tp>::type, bool>::value &&
+    std::is_integral<Up>::value, ptrdiff_t>::type
+    unchecked_count(Tp* first, Tp* last, const Up& value) noexcept{
+    if(mystl::is_constant_evaluated()){
+        ptrdiff_t n=0;
+        for(; first!=last; ++first){
+            if(*first==value){
+                ++n;
+            }
+        }
+        return n;
+    }
+    const auto v=static_cast<typename std::remove_const<Tp>::type>(value);
+    if(!(v==value)){
+        return 0;
+    }
+    return static_cast<ptrdiff_t>(mystl::simd::count_n(first, v, static_cast<size_t>(last-first)));
+}
+
+template <class InputIter, class T>
+constexpr typename iterator_traits<InputIter>::difference_type
+    count(InputIter first, InputIter last, const T& value)
+    noexcept(noexcept(unchecked_count(first, last, value))){
+    return unchecked_count(first, last, value);
+}
+
+// 18.count_if：统计 [first, last)区间内令一元操作 unary_pred 为 true 的元素个数
+template <class InputIter, class UnaryPredicate>
+constexpr typename iterator_traits<InputIter>::difference_type
+    count_if(InputIter first, InputIter last, UnaryPredicate unary_pred)
+    noexcept(noexcept(unary_pred(*first)) && noexcept(first!=last) && noexcept(++first)){
+    typename iterator_traits<InputIter>::difference_type n=0;
+    for(; first!=last; ++first){
+        if(unary_pred(*first)){
+            ++n;
+        }
+    }
+    return n;
+}
+
+// 19.search：在 [first1, last1)中查找 [first2, last2)第一次出现的位置，没有时返回 last1
+template <class ForwardIter1, class ForwardIter2>
+constexpr ForwardIter1 unchecked_search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2)
+    noexcept(noexcept(*first1==*first2) && noexcept(first1!=last1) && noexcept(first2!=last2) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<ForwardIter1>::value &&
+             std::is_nothrow_copy_constructible<ForwardIter2>::value){
+    auto d1=mystl::distance(first1, last1);
+    auto d2=mystl::distance(first2, last2);
+    if(d1<d2){
+        return last1;
+    }
+    auto current1=first1;
+    auto current2=first2;
+    while(current2!=last2){
+        if(*current1==*current2){
+            ++current1;
+            ++current2;
+        }
+        else{
+            // 剩余长度与子序列相同时已经不可能再匹配
+            if(d1==d2){
+                return last1;
+            }
+            current1=++first1;
+            current2=first2;
+            --d1;
+        }
+    }
+    return first1;
+}
+
+// 连续的同类型整数区间
+    // 单字节元素调用 search_bytes 内核，同时用首尾两个字节筛选候选位置；
+    // 更宽的元素用 find 内核找首元素，再用 mismatch_bytes 验证其余部分
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+    std::is_integral<typename std::remove_const<Tp>::type>::value &&
+    !std::is_same<typename std::remove_const<Tp>::type, bool>::value, Tp*>::type
+    unchecked_search(Tp* first1, Tp* last1, Up* first2, Up* last2) noexcept{
+    const auto n=static_cast<size_t>(last1-first1);
+    const auto m=static_cast<size_t>(last2-first2);
+    if(mystl::is_constant_evaluated()){
+        if(m>n){
+            return last1;
+        }
+        for(size_t i=0; i+m<=n; ++i){
+            size_t j=0;
+            while(j<m && first1[i+j]==first2[j]){
+                ++j;
+            }
+            if(j==m){
+                return first1+i;
+            }
+        }
+        return last1;
+    }
+    if(sizeof(Tp)==1){
+        const size_t k=mystl::simd::search_bytes(first1, n, first2, m);
+        return k==n? last1: first1+k;
+    }
+    if(m==0){
+        return first1;
+    }
+    if(m>n){
+        return last1;
+    }
+    const size_t candidates=n-m+1;
+    const size_t rest=(m-1)*sizeof(Tp);
+    for(size_t i=0; i<candidates; ++i){
+        i+=mystl::simd::find_n(first1+i, *first2, candidates-i);
+        if(i==candidates){
+            break;
+        }
+        if(mystl::simd::mismatch_bytes(first1+i+1, first2+1, rest)==rest){
+            return first1+i;
+        }
+    }
+    return last1;
+}
+
+template <class ForwardIter1, class ForwardIter2>
+constexpr ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2)
+    noexcept(noexcept(unchecked_search(first1, last1, first2, last2))){
+    return unchecked_search(first1, last1, first2, last2);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter1, class ForwardIter2, class Compared>
+constexpr ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
+    ForwardIter2 first2, ForwardIter2 last2, Compared comp)
+    noexcept(noexcept(comp(*first1, *first2)) && noexcept(first1!=last1) && noexcept(first2!=last2) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<ForwardIter1>::value &&
+             std::is_nothrow_copy_constructible<ForwardIter2>::value){
+    auto d1=mystl::distance(first1, last1);
+    auto d2=mystl::distance(first2, last2);
+    if(d1<d2){
+        return last1;
+    }
+    auto current1=first1;
+    auto current2=first2;
+    while(current2!=last2){
+        if(comp(*current1, *current2)){
+            ++current1;
+            ++current2;
+        }
+        else{
+            if(d1==d2){
+                return last1;
+            }
+            current1=++first1;
+            current2=first2;
+            --d1;
+        }
+    }
+    return first1;
+}
+
+// 20.find_first_of：在 [first1, last1)中查找第一个等于 [first2, last2)中某个元素的元素，没有时返回 last1
+template <class InputIter, class ForwardIter>
+constexpr InputIter unchecked_find_first_of(InputIter first1, InputIter last1, ForwardIter first2, ForwardIter last2)
+    noexcept(noexcept(*first1==*first2) && noexcept(first1!=last1) && noexcept(first2!=last2) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<ForwardIter>::value){
+    for(; first1!=last1; ++first1){
+        for(auto iter=first2; iter!=last2; ++iter){
+            if(*first1==*iter){
+                return first1;
+            }
+        }
+    }
+    return last1;
+}
+
+// 单字节的同类型整数区间：候选集合较小时与每个候选字节的广播向量比较，较大时用查找表
+template <class Tp, class Up>
+constexpr typename std::enable_if<
+    std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+    std::is_integral<typename std::remove_const<Tp>::type>::value &&
+    !std::is_same<typename std::remove_const<Tp>::type, bool>::value && sizeof(Tp)==1, Tp*>::type
+    unchecked_find_first_of(Tp* first1, Tp* last1, Up* first2, Up* last2) noexcept{
+    if(mystl::is_constant_evaluated()){
+        for(; first1!=last1; ++first1){
+            for(auto iter=first2; iter!=last2; ++iter){
+                if(*first1==*iter){
+                    return first1;
+                }
+            }
+        }
+        return last1;
+    }
+    return first1+mystl::simd::find_first_of_bytes(first1, static_cast<size_t>(last1-first1),
+        first2, static_cast<size_t>(last2-first2));
+}
+
+template <class InputIter, class ForwardIter>
+constexpr InputIter find_first_of(InputIter first1, InputIter last1, ForwardIter first2, ForwardIter last2)
+    noexcept(noexcept(unchecked_find_first_of(first1, last1, first2, last2))){
+    return unchecked_find_first_of(first1, last1, first2, last2);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class InputIter, class ForwardIter, class Compared>
+constexpr InputIter find_first_of(InputIter first1, InputIter last1,
+    ForwardIter first2, ForwardIter last2, Compared comp)
+    noexcept(noexcept(comp(*first1, *first2)) && noexcept(first1!=last1) && noexcept(first2!=last2) &&
+             noexcept(++first1) && noexcept(++first2) &&
+             std::is_nothrow_copy_constructible<ForwardIter>::value){
+    for(; first1!=last1; ++first1){
+        for(auto iter=first2; iter!=last2; ++iter){
+            if(comp(*first1, *iter)){
+                return first1;
+            }
+        }
+    }
+    return last1;
+}
+
+// 21.max_element：返回 [first, last)中第一个最大元素的迭代器，区间为空时返回 last
+template <class ForwardIter>
+constexpr ForwardIter unchecked_max_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(*first<*first) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    if(first==last){
+        return first;
+    }
+    auto result=first;
+    while(++first!=last){
+        if(*result<*first){
+            result=first;
+        }
+    }
+    return result;
+}
+
+// 连续的算术类型区间：simd 内核先用向量求出最大值，再找到它第一次出现的位置
+template <class Tp>
+constexpr typename std::enable_if<
+    mystl::simd::is_reducible<typename std::remove_const<Tp>::type>::value, Tp*>::type
+    unchecked_max_element(Tp* first, Tp* last) noexcept{
+    if(mystl::is_constant_evaluated() || first==last){
+        if(first==last){
+            return first;
+        }
+        auto result=first;
+        while(++first!=last){
+            if(*result<*first){
+                result=first;
+            }
+        }
+        return result;
+    }
+    return first+mystl::simd::max_element_n(first, static_cast<size_t>(last-first));
+}
+
+template <class ForwardIter>
+constexpr ForwardIter max_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(unchecked_max_element(first, last))){
+    return unchecked_max_element(first, last);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter, class Compared>
+constexpr ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp)
+    noexcept(noexcept(comp(*first, *first)) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    if(first==last){
+        return first;
+    }
+    auto result=first;
+    while(++first!=last){
+        if(comp(*result, *first)){
+            result=first;
+        }
+    }
+    return result;
+}
+
+// 22.min_element：返回 [first, last)中第一个最小元素的迭代器，区间为空时返回 last
+template <class ForwardIter>
+constexpr ForwardIter unchecked_min_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(*first<*first) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    if(first==last){
+        return first;
+    }
+    auto result=first;
+    while(++first!=last){
+        if(*first<*result){
+            result=first;
+        }
+    }
+    return result;
+}
+
+template <class Tp>
+constexpr typename std::enable_if<
+    mystl::simd::is_reducible<typename std::remove_const<Tp>::type>::value, Tp*>::type
+    unchecked_min_element(Tp* first, Tp* last) noexcept{
+    if(mystl::is_constant_evaluated() || first==last){
+        if(first==last){
+            return first;
+        }
+        auto result=first;
+        while(++first!=last){
+            if(*first<*result){
+                result=first;
+            }
+        }
+        return result;
+    }
+    return first+mystl::simd::min_element_n(first, static_cast<size_t>(last-first));
+}
+
+template <class ForwardIter>
+constexpr ForwardIter min_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(unchecked_min_element(first, last))){
+    return unchecked_min_element(first, last);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ForwardIter, class Compared>
+constexpr ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp)
+    noexcept(noexcept(comp(*first, *first)) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    if(first==last){
+        return first;
+    }
+    auto result=first;
+    while(++first!=last){
+        if(comp(*first, *result)){
+            result=first;
+        }
+    }
+    return result;
+}
+
+// 23.minmax_element：返回一对迭代器，分别指向第一个最小元素和最后一个最大元素，区间为空时都是 last
+template <class ForwardIter, class Compared>
+constexpr mystl::pair<ForwardIter, ForwardIter> minmax_element(ForwardIter first, ForwardIter last, Compared comp)
+    noexcept(noexcept(comp(*first, *first)) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    auto lo=first, hi=first;
+    if(first==last){
+        return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+    }
+    while(++first!=last){
+        if(comp(*first, *lo)){
+            lo=first;
+        }
+        if(!comp(*first, *hi)){
+            hi=first;
+        }
+    }
+    return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+}
+
+template <class ForwardIter>
+constexpr mystl::pair<ForwardIter, ForwardIter> unchecked_minmax_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(*first<*first) && noexcept(++first!=last) &&
+             std::is_nothrow_copy_assignable<ForwardIter>::value){
+    auto lo=first, hi=first;
+    if(first==last){
+        return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+    }
+    while(++first!=last){
+        if(*first<*lo){
+            lo=first;
+        }
+        if(!(*first<*hi)){
+            hi=first;
+        }
+    }
+    return mystl::pair<ForwardIter, ForwardIter>(lo, hi);
+}
+
+// 连续的算术类型区间：一遍同时求出最小值和最大值，再分别从前、从后定位
+    // 含 NaN 时结果也与上面逐个比较的版本相同（最大值按 !(x<hi) 更新，见 kernels_impl.h）
+template <class Tp>
+constexpr typename std::enable_if<
+    mystl::simd::is_reducible<typename std::remove_const<Tp>::type>::value, mystl::pair<Tp*, Tp*>>::type
+    unchecked_minmax_element(Tp* first, Tp* last) noexcept{
+    if(mystl::is_constant_evaluated() || first==last){
+        auto lo=first, hi=first;
+        if(first==last){
+            return mystl::pair<Tp*, Tp*>(lo, hi);
+        }
+        while(++first!=last){
+            if(*first<*lo){
+                lo=first;
+            }
+            if(!(*first<*hi)){
+                hi=first;
+            }
+        }
+        return mystl::pair<Tp*, Tp*>(lo, hi);
+    }
+    size_t lo=0, hi=0;
+    mystl::simd::minmax_element_n(first, static_cast<size_t>(last-first), lo, hi);
+    return mystl::pair<Tp*, Tp*>(first+lo, first+hi);
+}
+
+template <class ForwardIter>
+constexpr mystl::pair<ForwardIter, ForwardIter> minmax_element(ForwardIter first, ForwardIter last)
+    noexcept(noexcept(unchecked_minmax_element(first, last))){
+    return unchecked_minmax_element(first, last);
+}
+
 } // namespace mystl
 
 #endif
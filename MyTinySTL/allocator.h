@@ -7,6 +7,10 @@
 namespace mystl
 {
 
+// is_over_aligned：T 的对齐要求超过 operator new 默认保证的对齐
+template <class T>
+struct is_over_aligned: std::integral_constant<bool, (alignof(T)>__STDCPP_DEFAULT_NEW_ALIGNMENT__)> {};
+
 // 模板类声明
 template <class T>
 class allocator
@@ -21,6 +25,11 @@ public:
     typedef ptrdiff_t   difference_type;
 
 public:
+    // 无状态，任意两个 allocator 都可以互相转换（rebind 后用于分配节点、控制块）
+    allocator() noexcept=default;
+    template <class U>
+    allocator(const allocator<U>&) noexcept {}
+
     // 内存配置
     static T* allocate();
     // 存储n个T对象
@@ -41,11 +50,49 @@ public:
     // 对象析构
     static void destroy(T* ptr);
     static void destroy(T* first, T* last);
+
+private:
+    // alignof(T) 超过 operator new 默认保证的对齐（如按缓存行对齐的类型）时使用带 align_val_t 的版本
+    static void* raw_allocate(size_type bytes, std::false_type) { return ::operator new(bytes); }
+    static void* raw_allocate(size_type bytes, std::true_type){
+        return ::operator new(bytes, std::align_val_t(alignof(T)));
+    }
+    static void raw_deallocate(T* ptr, std::false_type) noexcept { ::operator delete(ptr); }
+    static void raw_deallocate(T* ptr, std::true_type) noexcept{
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+    }
+};
+
+// rebind_alloc：由 Alloc<T> 得到 Alloc<U>，用于为控制块、链表节点等内部类型分配内存
+    // Alloc 自带 rebind 时优先使用，否则替换第一个模板参数
+template <class Alloc, class U>
+struct rebind_first_arg;
+
+template <template <class, class...> class Alloc, class T, class... Rest, class U>
+struct rebind_first_arg<Alloc<T, Rest...>, U>
+{
+    typedef Alloc<U, Rest...> type;
+};
+
+template <class Alloc, class U, class=void>
+struct rebind_alloc_helper
+{
+    typedef typename rebind_first_arg<Alloc, U>::type type;
 };
 
+template <class Alloc, class U>
+struct rebind_alloc_helper<Alloc, U,
+    typename std::conditional<false, typename Alloc::template rebind<U>::other, void>::type>
+{
+    typedef typename Alloc::template rebind<U>::other type;
+};
+
+template <class Alloc, class U>
+using rebind_alloc=typename rebind_alloc_helper<Alloc, U>::type;
+
 template <class T>
 T* allocator<T>::allocate(){
-    return static_cast<T*>(::operator new(sizeof(T)));
+    return static_cast<T*>(raw_allocate(sizeof(T), is_over_aligned<T>()));
 }
 
 template <class T>
@@ -53,7 +100,7 @@ T* allocator<T>::allocate(size_type n){
     if(n==0){
         return nullptr;
     }
-    return static_cast<T*>(::operator new(n * sizeof(T)));
+    return static_cast<T*>(raw_allocate(n * sizeof(T), is_over_aligned<T>()));
 }
 
 template <class T>
@@ -61,7 +108,7 @@ void allocator<T>::deallocate(T* ptr){
     if(ptr==nullptr){
         return;
     }
-    ::operator delete(ptr);
+    raw_deallocate(ptr, is_over_aligned<T>());
 }
 
 template <class T>
@@ -69,7 +116,7 @@ void allocator<T>::deallocate(T* ptr, size_type){
     if(ptr==nullptr){
         return;
     }
-    ::operator delete(ptr);
+    raw_deallocate(ptr, is_over_aligned<T>());
 }
 
 template <class T>
@@ -95,13 +142,91 @@ void allocator<T>::construct(T* ptr, Args&& ...args){
 
 template <class T>
 void allocator<T>::destroy(T* ptr){
-    mystl::detroy(ptr);
+    mystl::destroy(ptr);
 }
 
 template <class T>
 void allocator<T>::destroy(T* first, T* last){
     mystl::destroy(first,last);
 }
+
+// 无状态，任意两个 allocator 都相等
+template <class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept{
+    return false;
+}
+
+// default_init_allocator：不带参数的 construct 做默认初始化（new T，不带括号），其余操作交给 Alloc
+    // 平凡类型的元素构造时不写内存，容器可以 resize 到目标大小，随后由 I/O 或向量化内核直接覆盖；
+    // 元素的初值是不确定的，读取之前必须先写入
+template <class T, class Alloc=mystl::allocator<T>>
+class default_init_allocator: public Alloc
+{
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef default_init_allocator<U, mystl::rebind_alloc<Alloc, U>> other;
+    };
+
+public:
+    default_init_allocator() noexcept(noexcept(Alloc()))=default;
+    default_init_allocator(const Alloc& alloc) noexcept: Alloc(alloc) {}
+    template <class U, class A>
+    default_init_allocator(const default_init_allocator<U, A>& rhs) noexcept
+        : Alloc(static_cast<const A&>(rhs)) {}
+
+    T* allocate(size_type n){
+        return static_cast<T*>(Alloc::allocate(n));
+    }
+
+    void deallocate(T* ptr, size_type n){
+        Alloc::deallocate(ptr, n);
+    }
+
+    template <class U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible<U>::value){
+        mystl::construct_default(ptr);
+    }
+
+    template <class U, class... Args>
+    void construct(U* ptr, Args&& ...args){
+        mystl::construct(ptr, mystl::forward<Args>(args)...);
+    }
+
+    template <class U>
+    void destroy(U* ptr){
+        mystl::destroy(ptr);
+    }
+
+    void destroy(T* first, T* last){
+        mystl::destroy(first, last);
+    }
+};
+
+// 比较转交给被包装的分配器：有状态的 Alloc 不相等时，容器不能互相释放对方的内存
+template <class T, class A1, class U, class A2>
+bool operator==(const default_init_allocator<T, A1>& a, const default_init_allocator<U, A2>& b) noexcept{
+    return static_cast<const A1&>(a)==static_cast<const A2&>(b);
+}
+
+template <class T, class A1, class U, class A2>
+bool operator!=(const default_init_allocator<T, A1>& a, const default_init_allocator<U, A2>& b) noexcept{
+    return !(a==b);
+}
 } // namespace mystl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,807 @@
+#ifndef MYTINYSTL_BASIC_STRING_H_
+#define MYTINYSTL_BASIC_STRING_H_
+
+// 这个头文件包含一个模板类 basic_string，以及 string、wstring、u16string、u32string
+// 短字符串优化（SSO）：对象本身 24 字节（64 位平台），短字符串直接存放在对象内，char 最多 23 个字符
+    // 长字符串时三个字存放指针、长度和容量，容量的最高位作为“长”标志；
+    // 短字符串时最后一个字符位置存放“剩余容量”，长度等于内联容量时它恰好为 0，兼作结尾的空字符
+    // 小端序下容量的最高位与最后一个字符的最高位在同一个字节，短字符串的剩余容量不会超过 0x7f，所以两种状态不会混淆
+// 字符类型必须是平凡类型：扩容用 uninitialized_copy_n（平凡类型就是 memmove），插入、删除时用 memmove 平移
+// find/compare 等转交给 basic_string_view，由 algorithm_base.h 中连续区间的快速路径和 simd.h 的向量化内核完成；
+// 比较按无符号字符进行，与 std::char_traits<char>::compare（memcmp）的结果一致
+// resize_and_overwrite 只扩大容量、不填充新字符，由调用者直接写入，避免先清零再覆盖
+
+#include <cstring>
+#include <initializer_list>
+#include <iosfwd>
+
+#include "algorithm_base.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "string_view.h"
+#include "uninitialized.h"
+#include "util.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__==__ORDER_BIG_ENDIAN__
+#error "mystl::basic_string's inline layout assumes a little-endian target"
+#endif
+
+namespace mystl
+{
+
+// 模板参数 CharT 代表字符类型，Alloc 代表分配器类型
+template <class CharT, class Alloc=mystl::allocator<CharT>>
+class basic_string
+{
+public:
+    typedef Alloc                                    allocator_type;
+    typedef CharT                                    value_type;
+    typedef CharT*                                   pointer;
+    typedef const CharT*                             const_pointer;
+    typedef CharT&                                   reference;
+    typedef const CharT&                             const_reference;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+
+    typedef CharT*                                   iterator;
+    typedef const CharT*                             const_iterator;
+    typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+    typedef basic_string_view<CharT>                 view_type;
+
+    static constexpr size_type npos=static_cast<size_type>(-1);
+
+    static_assert(std::is_trivial<CharT>::value && std::is_standard_layout<CharT>::value,
+        "basic_string requires a trivial standard-layout character type");
+
+private:
+    struct long_rep
+    {
+        CharT* data;
+        size_type size;
+        size_type cap;          // 最高位是“长”标志
+    };
+
+    static constexpr size_type sso_buffer=sizeof(long_rep)/sizeof(CharT);
+    static constexpr size_type long_flag=static_cast<size_type>(1)<<(sizeof(size_type)*8-1);
+
+public:
+    // 不分配内存时能存放的最大长度
+    static constexpr size_type sso_capacity=sso_buffer-1;
+
+private:
+    union rep
+    {
+        long_rep l;
+        CharT s[sso_buffer];
+    };
+
+    // 分配器和字符串表示放在一起，无状态分配器不占空间
+    mystl::compressed_pair<allocator_type, rep> m_pair;
+
+public:
+    // 构造、复制、移动、析构函数
+    basic_string() noexcept { set_short_size(0); }
+
+    explicit basic_string(const allocator_type& a) noexcept: m_pair(a, rep()) { set_short_size(0); }
+
+    basic_string(const CharT* s, size_type n, const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        init(s, n);
+    }
+
+    basic_string(const CharT* s, const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        init(s, string_length(s));
+    }
+
+    basic_string(size_type n, CharT ch, const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        set_short_size(0);
+        append(n, ch);
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    basic_string(Iter first, Iter last, const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        set_short_size(0);
+        append(first, last);
+    }
+
+    // 从视图构造要复制字符，所以是 explicit 的
+    explicit basic_string(view_type v, const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        init(v.data(), v.size());
+    }
+
+    basic_string(std::initializer_list<CharT> ilist, const allocator_type& a=allocator_type())
+        : basic_string(ilist.begin(), ilist.size(), a) {}
+
+    basic_string(const basic_string& rhs, size_type pos, size_type n=npos,
+        const allocator_type& a=allocator_type()): m_pair(a, rep()){
+        THROW_OUT_OF_RANGE_IF(pos>rhs.size(), "basic_string<CharT>'s position out of range");
+        init(rhs.data()+pos, mystl::min(n, rhs.size()-pos));
+    }
+
+    // 短字符串整体复制 24 字节的表示，不逐个字符复制
+    basic_string(const basic_string& rhs): m_pair(rhs.m_pair.first(), rep()){
+        if(rhs.is_long()){
+            init(rhs.data(), rhs.size());
+        }
+        else{
+            m_pair.second()=rhs.m_pair.second();
+        }
+    }
+
+    // 移动构造只转移表示，源对象变为空字符串
+    basic_string(basic_string&& rhs) noexcept
+        : m_pair(mystl::move(rhs.m_pair.first()), rhs.m_pair.second()){
+        rhs.set_short_size(0);
+    }
+
+    basic_string& operator=(const basic_string& rhs){
+        if(this!=&rhs){
+            assign(rhs.data(), rhs.size());
+        }
+        return *this;
+    }
+
+    basic_string& operator=(basic_string&& rhs) noexcept{
+        if(this!=&rhs){
+            deallocate_buffer();
+            m_pair.first()=mystl::move(rhs.m_pair.first());
+            m_pair.second()=rhs.m_pair.second();
+            rhs.set_short_size(0);
+        }
+        return *this;
+    }
+
+    basic_string& operator=(const CharT* s) { return assign(s, string_length(s)); }
+
+    basic_string& operator=(CharT ch) { return assign(static_cast<size_type>(1), ch); }
+
+    basic_string& operator=(std::initializer_list<CharT> ilist) { return assign(ilist.begin(), ilist.size()); }
+
+    ~basic_string() { deallocate_buffer(); }
+
+public:
+    // 迭代器相关操作
+    iterator               begin()         noexcept { return data(); }
+    const_iterator         begin()   const noexcept { return data(); }
+    iterator               end()           noexcept { return data()+size(); }
+    const_iterator         end()     const noexcept { return data()+size(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return size()==0; }
+    size_type size()     const noexcept { return is_long()? storage().l.size: sso_capacity-storage().s[sso_capacity]; }
+    size_type length()   const noexcept { return size(); }
+    size_type capacity() const noexcept { return is_long()? storage().l.cap&~long_flag: sso_capacity; }
+    size_type max_size() const noexcept{
+        return mystl::min(long_flag-1, static_cast<size_type>(-1)/sizeof(CharT))-1;
+    }
+
+    allocator_type get_allocator() const { return m_pair.first(); }
+
+    // 转换为视图不复制字符，视图在字符串修改或析构后失效
+    operator view_type() const noexcept { return view_type(data(), size()); }
+
+    // 保证容量至少为 n，只复制已有的字符
+    // 与追加相同，至少把容量翻倍，紧接着的几次追加不必再分配
+    void reserve(size_type n){
+        if(n>capacity()){
+            const size_type sz=size();
+            reallocate(grow_capacity(sz, n-sz));
+        }
+    }
+
+    // 长度放得进对象内时回到短字符串，否则缩小到与长度相同的容量
+    void shrink_to_fit(){
+        if(!is_long() || capacity()==size()){
+            return;
+        }
+        const size_type n=size();
+        if(n<=sso_capacity){
+            long_rep old=storage().l;
+            mystl::uninitialized_copy_n(old.data, n, storage().s);
+            set_short_size(n);
+            m_pair.first().deallocate(old.data, (old.cap&~long_flag)+1);
+        }
+        else{
+            reallocate(n);
+        }
+    }
+
+    // 访问元素相关操作
+    reference operator[](size_type n){
+        MYSTL_DEBUG(n<=size());
+        return data()[n];
+    }
+    const_reference operator[](size_type n) const{
+        MYSTL_DEBUG(n<=size());
+        return data()[n];
+    }
+
+    reference at(size_type n){
+        THROW_OUT_OF_RANGE_IF(n>=size(), "basic_string<CharT>::at() subscript out of range");
+        return data()[n];
+    }
+    const_reference at(size_type n) const{
+        THROW_OUT_OF_RANGE_IF(n>=size(), "basic_string<CharT>::at() subscript out of range");
+        return data()[n];
+    }
+
+    reference front(){
+        MYSTL_DEBUG(!empty());
+        return data()[0];
+    }
+    const_reference front() const{
+        MYSTL_DEBUG(!empty());
+        return data()[0];
+    }
+    reference back(){
+        MYSTL_DEBUG(!empty());
+        return data()[size()-1];
+    }
+    const_reference back() const{
+        MYSTL_DEBUG(!empty());
+        return data()[size()-1];
+    }
+
+    CharT*       data()        noexcept { return is_long()? storage().l.data: storage().s; }
+    const CharT* data()  const noexcept { return is_long()? storage().l.data: storage().s; }
+    const CharT* c_str() const noexcept { return data(); }
+
+    // 调整容器相关操作
+    // 1.assign
+    basic_string& assign(const CharT* s, size_type n){
+        THROW_LENGTH_ERROR_IF(n>max_size(), "basic_string<CharT>'s size too big");
+        if(n<=capacity()){
+            move_chars(data(), s, n);   // s 可能指向自身
+            set_size(n);
+        }
+        else{
+            CharT* buf=allocate_buffer(n);
+            mystl::uninitialized_copy_n(s, n, buf);
+            deallocate_buffer();
+            set_long(buf, n, n);
+        }
+        return *this;
+    }
+
+    basic_string& assign(const CharT* s) { return assign(s, string_length(s)); }
+
+    basic_string& assign(view_type v) { return assign(v.data(), v.size()); }
+
+    basic_string& assign(const basic_string& str) { return *this=str; }
+
+    basic_string& assign(basic_string&& str) noexcept { return *this=mystl::move(str); }
+
+    basic_string& assign(size_type n, CharT ch){
+        set_size(0);
+        return append(n, ch);
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    basic_string& assign(Iter first, Iter last){
+        basic_string tmp(first, last, get_allocator());
+        return *this=mystl::move(tmp);
+    }
+
+    // 2.append：容量不足时按两倍扩容，新缓冲区里只复制已有字符和追加的字符
+    basic_string& append(const CharT* s, size_type n){
+        const size_type sz=size();
+        if(n<=capacity()-sz){
+            // 追加的字符即使来自自身，也位于 [data, data+sz) 中，与目标位置不重叠
+            mystl::uninitialized_copy_n(s, n, data()+sz);
+            set_size(sz+n);
+            return *this;
+        }
+        const size_type cap=grow_capacity(sz, n);
+        CharT* buf=allocate_buffer(cap);
+        mystl::uninitialized_copy_n(s, n, mystl::uninitialized_copy_n(data(), sz, buf));
+        deallocate_buffer();    // s 指向自身时，到这里才失效
+        set_long(buf, sz+n, cap);
+        return *this;
+    }
+
+    basic_string& append(const CharT* s) { return append(s, string_length(s)); }
+
+    basic_string& append(const basic_string& str) { return append(str.data(), str.size()); }
+
+    basic_string& append(const basic_string& str, size_type pos, size_type n=npos){
+        THROW_OUT_OF_RANGE_IF(pos>str.size(), "basic_string<CharT>'s position out of range");
+        return append(str.data()+pos, mystl::min(n, str.size()-pos));
+    }
+
+    basic_string& append(size_type n, CharT ch){
+        const size_type sz=size();
+        if(n>capacity()-sz){
+            reallocate(grow_capacity(sz, n));
+        }
+        mystl::fill_n(data()+sz, n, ch);
+        set_size(sz+n);
+        return *this;
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    basic_string& append(Iter first, Iter last){
+        append_range(first, last, iterator_category(first));
+        return *this;
+    }
+
+    basic_string& append(std::initializer_list<CharT> ilist) { return append(ilist.begin(), ilist.size()); }
+
+    basic_string& append(view_type v) { return append(v.data(), v.size()); }
+
+    basic_string& operator+=(const basic_string& str) { return append(str.data(), str.size()); }
+    basic_string& operator+=(const CharT* s) { return append(s, string_length(s)); }
+    basic_string& operator+=(CharT ch) { push_back(ch); return *this; }
+    basic_string& operator+=(view_type v) { return append(v.data(), v.size()); }
+    basic_string& operator+=(std::initializer_list<CharT> ilist) { return append(ilist.begin(), ilist.size()); }
+
+    void push_back(CharT ch){
+        const size_type sz=size();
+        if(sz==capacity()){
+            reallocate(grow_capacity(sz, 1));
+        }
+        data()[sz]=ch;
+        set_size(sz+1);
+    }
+
+    void pop_back(){
+        MYSTL_DEBUG(!empty());
+        set_size(size()-1);
+    }
+
+    // 3.insert/erase/replace：都归结为把 [pos, pos+n1) 替换为 [s, s+n2)
+    basic_string& insert(size_type pos, const CharT* s, size_type n) { return replace(pos, 0, s, n); }
+    basic_string& insert(size_type pos, const CharT* s) { return replace(pos, 0, s, string_length(s)); }
+    basic_string& insert(size_type pos, const basic_string& str) { return replace(pos, 0, str.data(), str.size()); }
+    basic_string& insert(size_type pos, view_type v) { return replace(pos, 0, v.data(), v.size()); }
+    basic_string& insert(size_type pos, size_type n, CharT ch) { return replace(pos, 0, n, ch); }
+
+    iterator insert(const_iterator pos, CharT ch){
+        const size_type i=static_cast<size_type>(pos-begin());
+        replace(i, 0, static_cast<size_type>(1), ch);
+        return begin()+i;
+    }
+
+    iterator insert(const_iterator pos, size_type n, CharT ch){
+        const size_type i=static_cast<size_type>(pos-begin());
+        replace(i, 0, n, ch);
+        return begin()+i;
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    iterator insert(const_iterator pos, Iter first, Iter last){
+        const size_type i=static_cast<size_type>(pos-begin());
+        const basic_string tmp(first, last, get_allocator());
+        replace(i, 0, tmp.data(), tmp.size());
+        return begin()+i;
+    }
+
+    basic_string& erase(size_type pos=0, size_type n=npos){
+        THROW_OUT_OF_RANGE_IF(pos>size(), "basic_string<CharT>'s position out of range");
+        n=mystl::min(n, size()-pos);
+        CharT* d=data();
+        move_chars(d+pos, d+pos+n, size()-pos-n);
+        set_size(size()-n);
+        return *this;
+    }
+
+    iterator erase(const_iterator pos){
+        MYSTL_DEBUG(pos!=cend());
+        const size_type i=static_cast<size_type>(pos-begin());
+        erase(i, 1);
+        return begin()+i;
+    }
+
+    iterator erase(const_iterator first, const_iterator last){
+        const size_type i=static_cast<size_type>(first-begin());
+        erase(i, static_cast<size_type>(last-first));
+        return begin()+i;
+    }
+
+    // 把 [pos, pos+n1) 替换为 [s, s+n2)；s 可以指向自身
+    basic_string& replace(size_type pos, size_type n1, const CharT* s, size_type n2){
+        const size_type sz=size();
+        THROW_OUT_OF_RANGE_IF(pos>sz, "basic_string<CharT>'s position out of range");
+        n1=mystl::min(n1, sz-pos);
+        THROW_LENGTH_ERROR_IF(n2>n1 && n2-n1>max_size()-sz, "basic_string<CharT>'s size too big");
+        const size_type new_size=sz-n1+n2;
+        if(new_size>capacity()){
+            // 在新缓冲区中依次拼出前缀、新内容和后缀，旧缓冲区最后释放，s 指向自身也没有问题
+            const size_type cap=grow_capacity(sz, new_size-sz);
+            CharT* buf=allocate_buffer(cap);
+            const CharT* d=data();
+            CharT* cur=mystl::uninitialized_copy_n(d, pos, buf);
+            cur=mystl::uninitialized_copy_n(s, n2, cur);
+            mystl::uninitialized_copy_n(d+pos+n1, sz-pos-n1, cur);
+            deallocate_buffer();
+            set_long(buf, new_size, cap);
+            return *this;
+        }
+        CharT* d=data();
+        if(s+n2>d && s<d+sz){
+            // 原地平移会改变 s 指向的内容，先复制一份
+            const basic_string tmp(s, n2, get_allocator());
+            return replace(pos, n1, tmp.data(), n2);
+        }
+        move_chars(d+pos+n2, d+pos+n1, sz-pos-n1);
+        move_chars(d+pos, s, n2);
+        set_size(new_size);
+        return *this;
+    }
+
+    basic_string& replace(size_type pos, size_type n1, const CharT* s){
+        return replace(pos, n1, s, string_length(s));
+    }
+
+    basic_string& replace(size_type pos, size_type n1, const basic_string& str){
+        return replace(pos, n1, str.data(), str.size());
+    }
+
+    basic_string& replace(size_type pos, size_type n1, view_type v){
+        return replace(pos, n1, v.data(), v.size());
+    }
+
+    basic_string& replace(size_type pos, size_type n1, size_type n2, CharT ch){
+        const size_type sz=size();
+        THROW_OUT_OF_RANGE_IF(pos>sz, "basic_string<CharT>'s position out of range");
+        n1=mystl::min(n1, sz-pos);
+        THROW_LENGTH_ERROR_IF(n2>n1 && n2-n1>max_size()-sz, "basic_string<CharT>'s size too big");
+        const size_type new_size=sz-n1+n2;
+        if(new_size>capacity()){
+            reallocate(grow_capacity(sz, new_size-sz));
+        }
+        CharT* d=data();
+        move_chars(d+pos+n2, d+pos+n1, sz-pos-n1);
+        mystl::fill_n(d+pos, n2, ch);
+        set_size(new_size);
+        return *this;
+    }
+
+    void clear() noexcept { set_size(0); }
+
+    void resize(size_type n) { resize(n, CharT()); }
+
+    void resize(size_type n, CharT ch){
+        const size_type sz=size();
+        if(n>sz){
+            append(n-sz, ch);
+        }
+        else{
+            set_size(n);
+        }
+    }
+
+    // 把容量扩大到至少 n，调用 op(data(), n)，op 写入字符并返回最终长度（不超过 n）
+        // 新增的位置不初始化，适合直接由读取、格式化等操作填充的缓冲区
+    template <class Operation>
+    void resize_and_overwrite(size_type n, Operation op){
+        THROW_LENGTH_ERROR_IF(n>max_size(), "basic_string<CharT>'s size too big");
+        reserve(n);
+        const size_type r=static_cast<size_type>(op(data(), n));
+        MYSTL_DEBUG(r<=n);
+        set_size(r);
+    }
+
+    void swap(basic_string& rhs) noexcept{
+        mystl::swap(m_pair.first(), rhs.m_pair.first());
+        const rep tmp=m_pair.second();
+        m_pair.second()=rhs.m_pair.second();
+        rhs.m_pair.second()=tmp;
+    }
+
+    // 4.子串和复制
+    basic_string substr(size_type pos=0, size_type n=npos) const{
+        return basic_string(*this, pos, n, get_allocator());
+    }
+
+    size_type copy(CharT* dest, size_type n, size_type pos=0) const{
+        THROW_OUT_OF_RANGE_IF(pos>size(), "basic_string<CharT>'s position out of range");
+        n=mystl::min(n, size()-pos);
+        mystl::uninitialized_copy_n(data()+pos, n, dest);
+        return n;
+    }
+
+    // 5.compare：返回负数、0 或正数
+    int compare(const basic_string& str) const noexcept { return view().compare(str.view()); }
+    int compare(view_type v) const noexcept { return view().compare(v); }
+    int compare(const CharT* s) const noexcept { return view().compare(s); }
+
+    int compare(size_type pos, size_type n, const basic_string& str) const{
+        return view().compare(pos, n, str.view());
+    }
+
+    int compare(size_type pos, size_type n, const CharT* s, size_type count) const{
+        return view().compare(pos, n, view_type(s, count));
+    }
+
+    bool starts_with(const CharT* s, size_type n) const noexcept { return view().starts_with(view_type(s, n)); }
+    bool starts_with(view_type v) const noexcept { return view().starts_with(v); }
+    bool starts_with(const CharT* s) const noexcept { return view().starts_with(s); }
+    bool starts_with(CharT ch) const noexcept { return view().starts_with(ch); }
+
+    bool ends_with(const CharT* s, size_type n) const noexcept { return view().ends_with(view_type(s, n)); }
+    bool ends_with(view_type v) const noexcept { return view().ends_with(v); }
+    bool ends_with(const CharT* s) const noexcept { return view().ends_with(s); }
+    bool ends_with(CharT ch) const noexcept { return view().ends_with(ch); }
+
+    // 6.查找：找不到时返回 npos，都转交给 basic_string_view
+    size_type find(CharT ch, size_type pos=0) const noexcept { return view().find(ch, pos); }
+    size_type find(const CharT* s, size_type pos, size_type n) const noexcept { return view().find(s, pos, n); }
+    size_type find(const CharT* s, size_type pos=0) const noexcept { return view().find(s, pos); }
+    size_type find(view_type v, size_type pos=0) const noexcept { return view().find(v, pos); }
+
+    bool contains(CharT ch) const noexcept { return view().contains(ch); }
+    bool contains(const CharT* s) const noexcept { return view().contains(s); }
+    bool contains(view_type v) const noexcept { return view().contains(v); }
+
+    size_type rfind(CharT ch, size_type pos=npos) const noexcept { return view().rfind(ch, pos); }
+    size_type rfind(const CharT* s, size_type pos, size_type n) const noexcept { return view().rfind(s, pos, n); }
+    size_type rfind(const CharT* s, size_type pos=npos) const noexcept { return view().rfind(s, pos); }
+    size_type rfind(view_type v, size_type pos=npos) const noexcept { return view().rfind(v, pos); }
+
+    size_type find_first_of(CharT ch, size_type pos=0) const noexcept { return view().find_first_of(ch, pos); }
+    size_type find_first_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        return view().find_first_of(s, pos, n);
+    }
+    size_type find_first_of(const CharT* s, size_type pos=0) const noexcept { return view().find_first_of(s, pos); }
+    size_type find_first_of(view_type v, size_type pos=0) const noexcept { return view().find_first_of(v, pos); }
+
+    size_type find_first_not_of(CharT ch, size_type pos=0) const noexcept { return view().find_first_not_of(ch, pos); }
+    size_type find_first_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        return view().find_first_not_of(s, pos, n);
+    }
+    size_type find_first_not_of(const CharT* s, size_type pos=0) const noexcept{
+        return view().find_first_not_of(s, pos);
+    }
+    size_type find_first_not_of(view_type v, size_type pos=0) const noexcept{
+        return view().find_first_not_of(v, pos);
+    }
+
+    size_type find_last_of(CharT ch, size_type pos=npos) const noexcept { return view().find_last_of(ch, pos); }
+    size_type find_last_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        return view().find_last_of(s, pos, n);
+    }
+    size_type find_last_of(const CharT* s, size_type pos=npos) const noexcept { return view().find_last_of(s, pos); }
+    size_type find_last_of(view_type v, size_type pos=npos) const noexcept { return view().find_last_of(v, pos); }
+
+    size_type find_last_not_of(CharT ch, size_type pos=npos) const noexcept{
+        return view().find_last_not_of(ch, pos);
+    }
+    size_type find_last_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        return view().find_last_not_of(s, pos, n);
+    }
+    size_type find_last_not_of(const CharT* s, size_type pos=npos) const noexcept{
+        return view().find_last_not_of(s, pos);
+    }
+    size_type find_last_not_of(view_type v, size_type pos=npos) const noexcept{
+        return view().find_last_not_of(v, pos);
+    }
+
+private:
+    view_type view() const noexcept { return view_type(data(), size()); }
+
+    rep& storage() noexcept { return m_pair.second(); }
+    const rep& storage() const noexcept { return m_pair.second(); }
+
+    bool is_long() const noexcept { return (storage().l.cap&long_flag)!=0; }
+
+    // 短字符串：最后一个位置存放剩余容量，长度为 n 的位置写入空字符
+    void set_short_size(size_type n) noexcept{
+        storage().s[sso_capacity]=static_cast<CharT>(sso_capacity-n);
+        storage().s[n]=CharT();
+    }
+
+    void set_long(CharT* p, size_type n, size_type cap) noexcept{
+        storage().l.data=p;
+        storage().l.size=n;
+        storage().l.cap=cap|long_flag;
+        p[n]=CharT();
+    }
+
+    void set_size(size_type n) noexcept{
+        if(is_long()){
+            storage().l.size=n;
+            storage().l.data[n]=CharT();
+        }
+        else{
+            set_short_size(n);
+        }
+    }
+
+    void init(const CharT* s, size_type n){
+        if(n<=sso_capacity){
+            mystl::uninitialized_copy_n(s, n, storage().s);
+            set_short_size(n);
+        }
+        else{
+            THROW_LENGTH_ERROR_IF(n>max_size(), "basic_string<CharT>'s size too big");
+            CharT* buf=allocate_buffer(n);
+            mystl::uninitialized_copy_n(s, n, buf);
+            set_long(buf, n, n);
+        }
+    }
+
+    // 多分配一个位置存放结尾的空字符
+    CharT* allocate_buffer(size_type cap) { return m_pair.first().allocate(cap+1); }
+
+    void deallocate_buffer() noexcept{
+        if(is_long()){
+            m_pair.first().deallocate(storage().l.data, capacity()+1);
+        }
+    }
+
+    // 在长度 sz 的基础上追加 n 个字符所需的新容量：至少翻倍
+    size_type grow_capacity(size_type sz, size_type n) const{
+        THROW_LENGTH_ERROR_IF(n>max_size()-sz, "basic_string<CharT>'s size too big");
+        const size_type cap=capacity();
+        const size_type doubled=cap>max_size()/2? max_size(): cap*2;
+        return mystl::max(sz+n, doubled);
+    }
+
+    // 换到容量为 cap 的新缓冲区，只复制已有的字符
+    void reallocate(size_type cap){
+        const size_type n=size();
+        CharT* buf=allocate_buffer(cap);
+        mystl::uninitialized_copy_n(data(), n, buf);
+        deallocate_buffer();
+        set_long(buf, n, cap);
+    }
+
+    // 可能重叠的区间之间复制字符
+    static void move_chars(CharT* dst, const CharT* src, size_type n) noexcept{
+        if(n!=0){
+            std::memmove(dst, src, n*sizeof(CharT));
+        }
+    }
+
+    template <class InputIter>
+    void append_range(InputIter first, InputIter last, mystl::input_iterator_tag){
+        for(; first!=last; ++first){
+            push_back(*first);
+        }
+    }
+
+    // 前向迭代器可以先求出长度，一次扩容
+    template <class ForwardIter>
+    void append_range(ForwardIter first, ForwardIter last, mystl::forward_iterator_tag){
+        const size_type sz=size();
+        const size_type n=static_cast<size_type>(mystl::distance(first, last));
+        if(n>capacity()-sz){
+            reallocate(grow_capacity(sz, n));
+        }
+        mystl::uninitialized_copy_n(first, n, data()+sz);
+        set_size(sz+n);
+    }
+};
+
+// 重载比较操作符：相等比较先比长度，再比较内容
+template <class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return lhs.size()==rhs.size() && basic_string_view<CharT>::equal_chars(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) noexcept{
+    const size_t n=string_length(rhs);
+    return lhs.size()==n && basic_string_view<CharT>::equal_chars(lhs.data(), rhs, n);
+}
+
+template <class CharT, class Alloc>
+bool operator==(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) noexcept { return rhs==lhs; }
+
+template <class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+template <class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) noexcept { return !(lhs==rhs); }
+
+template <class CharT, class Alloc>
+bool operator!=(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) noexcept { return !(rhs==lhs); }
+
+template <class CharT, class Alloc>
+bool operator<(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return lhs.compare(rhs)<0;
+}
+
+template <class CharT, class Alloc>
+bool operator<=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return lhs.compare(rhs)<=0;
+}
+
+template <class CharT, class Alloc>
+bool operator>(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return lhs.compare(rhs)>0;
+}
+
+template <class CharT, class Alloc>
+bool operator>=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) noexcept{
+    return lhs.compare(rhs)>=0;
+}
+
+// 重载 operator+：先按总长度预留一次容量；左操作数是右值时直接在它上面追加
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs){
+    basic_string<CharT, Alloc> result(lhs.get_allocator());
+    result.reserve(lhs.size()+rhs.size());
+    result.append(lhs).append(rhs);
+    return result;
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, const CharT* rhs){
+    const size_t n=string_length(rhs);
+    basic_string<CharT, Alloc> result(lhs.get_allocator());
+    result.reserve(lhs.size()+n);
+    result.append(lhs).append(rhs, n);
+    return result;
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const CharT* lhs, const basic_string<CharT, Alloc>& rhs){
+    const size_t n=string_length(lhs);
+    basic_string<CharT, Alloc> result(rhs.get_allocator());
+    result.reserve(n+rhs.size());
+    result.append(lhs, n).append(rhs);
+    return result;
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, CharT rhs){
+    basic_string<CharT, Alloc> result(lhs.get_allocator());
+    result.reserve(lhs.size()+1);
+    result.append(lhs).push_back(rhs);
+    return result;
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(basic_string<CharT, Alloc>&& lhs, const basic_string<CharT, Alloc>& rhs){
+    return mystl::move(lhs.append(rhs));
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(basic_string<CharT, Alloc>&& lhs, const CharT* rhs){
+    return mystl::move(lhs.append(rhs));
+}
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(basic_string<CharT, Alloc>&& lhs, CharT rhs){
+    lhs.push_back(rhs);
+    return mystl::move(lhs);
+}
+
+// 重载 mystl 的 swap
+template <class CharT, class Alloc>
+void swap(basic_string<CharT, Alloc>& lhs, basic_string<CharT, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+// 输出到标准流，使用时需要包含 <ostream>
+template <class CharT, class Traits, class Alloc>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os,
+    const basic_string<CharT, Alloc>& str){
+    return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+typedef basic_string<char>      string;
+typedef basic_string<wchar_t>   wstring;
+typedef basic_string<char16_t>  u16string;
+typedef basic_string<char32_t>  u32string;
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,461 @@
+// 基准测试框架的实现：注册表、统计、命令行和报告输出
+#include "bench.h"
+#include "perf_counters.h"
+#include "../simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <new>
+#include <thread>
+
+// 统计全局 operator new 的调用次数，报告中给出每次调用的分配次数
+static std::atomic<size_t> g_alloc_count(0);
+
+void* operator new(size_t n){
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if(void* p=std::malloc(n==0? 1: n)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t n){
+    return ::operator new(n);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace mybench
+{
+
+namespace
+{
+
+struct benchmark
+{
+    std::string name;
+    std::function<void(state&)> fn;
+    std::vector<size_t> sizes;
+};
+
+std::vector<benchmark>& registry(){
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+// 排序后按最近秩取分位数
+double percentile(const std::vector<double>& sorted, double p){
+    if(sorted.empty()){
+        return 0;
+    }
+    size_t rank=size_t(std::ceil(p*sorted.size()));
+    rank= rank==0? 0: rank-1;
+    return sorted[std::min(rank, sorted.size()-1)];
+}
+
+std::vector<size_t> parse_sizes(const char* s){
+    std::vector<size_t> sizes;
+    while(*s){
+        char* end=nullptr;
+        unsigned long long v=std::strtoull(s, &end, 0);
+        if(end==s){
+            break;
+        }
+        // 支持 k/m 后缀，如 64k、1m
+        if(*end=='k' || *end=='K'){
+            v<<=10;
+            ++end;
+        }
+        else if(*end=='m' || *end=='M'){
+            v<<=20;
+            ++end;
+        }
+        sizes.push_back(size_t(v));
+        s= *end==','? end+1: end;
+    }
+    return sizes;
+}
+
+void print_usage(const char* prog){
+    std::printf(
+        "usage: %s [options]\n"
+        "  --filter=SUBSTR        only run benchmarks whose name contains SUBSTR\n"
+        "  --sizes=N[,N...]       override the size sweep (k/m suffixes allowed)\n"
+        "  --max-size=N           skip sizes larger than N\n"
+        "  --repetitions=N        samples per benchmark and size (default 20)\n"
+        "  --warmup-ms=MS         warmup time before sampling (default 2)\n"
+        "  --sample-us=US         minimum time per sample (default 500)\n"
+        "  --json=PATH            write results as JSON to PATH ('-' for stdout)\n"
+        "  --isa=LEVEL            use the scalar, sse2, avx2 or avx512 kernels (default: best supported)\n"
+        "  --perf                 report hardware counters (cycles, instructions, cache and\n"
+        "                         branch misses) per item and per byte when the kernel allows it\n"
+        "  --quick                a fast smoke run: 3 repetitions, short samples, sizes <= 4096\n"
+        "  --list                 list benchmark names and exit\n", prog);
+}
+
+// 解析 --key=value 形式的参数，失败时返回 false
+bool parse_args(int argc, char** argv, options& opt){
+    for(int i=1; i<argc; ++i){
+        const char* arg=argv[i];
+        const char* eq=std::strchr(arg, '=');
+        std::string key= eq? std::string(arg, eq): std::string(arg);
+        const char* value= eq? eq+1: "";
+        if(key=="--filter"){
+            opt.filter=value;
+        }
+        else if(key=="--sizes"){
+            opt.sizes=parse_sizes(value);
+        }
+        else if(key=="--max-size"){
+            auto v=parse_sizes(value);
+            opt.max_size= v.empty()? 0: v[0];
+        }
+        else if(key=="--repetitions"){
+            opt.repetitions=std::max<size_t>(1, std::strtoul(value, nullptr, 10));
+        }
+        else if(key=="--warmup-ms"){
+            opt.warmup_ms=std::atof(value);
+        }
+        else if(key=="--sample-us"){
+            opt.sample_us=std::atof(value);
+        }
+        else if(key=="--json"){
+            opt.json_path=value;
+        }
+        else if(key=="--quick"){
+            opt.repetitions=3;
+            opt.warmup_ms=0.1;
+            opt.sample_us=20;
+            opt.max_size=4096;
+        }
+        else if(key=="--isa"){
+            mystl::simd::isa level;
+            if(!mystl::simd::parse_isa(value, level) || !mystl::simd::force_isa(level)){
+                std::fprintf(stderr, "unsupported isa level '%s', this CPU supports up to %s\n",
+                    value, mystl::simd::isa_name(mystl::simd::detected_isa()));
+                return false;
+            }
+        }
+        else if(key=="--perf"){
+            opt.perf=true;
+        }
+        else if(key=="--list"){
+            opt.list_only=true;
+        }
+        else{
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// 名字按 "算法/实现/类型" 拆分，用于匹配 mystl 与 std 的同名基准
+bool split_name(const std::string& name, std::string& group, std::string& impl, std::string& type){
+    size_t a=name.find('/');
+    if(a==std::string::npos){
+        return false;
+    }
+    size_t b=name.find('/', a+1);
+    group=name.substr(0, a);
+    impl= b==std::string::npos? name.substr(a+1): name.substr(a+1, b-a-1);
+    type= b==std::string::npos? std::string(): name.substr(b+1);
+    return true;
+}
+
+std::string json_escape(const std::string& s){
+    std::string out;
+    for(char c: s){
+        if(c=='"' || c=='\\'){
+            out+='\\';
+            out+=c;
+        }
+        else if((unsigned char)c<0x20){
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out+=buf;
+        }
+        else{
+            out+=c;
+        }
+    }
+    return out;
+}
+
+std::string cpu_model(){
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while(std::getline(in, line)){
+        if(line.compare(0, 10, "model name")==0){
+            size_t colon=line.find(':');
+            if(colon!=std::string::npos){
+                return line.substr(line.find_first_not_of(' ', colon+1));
+            }
+        }
+    }
+    return "unknown";
+}
+
+void write_json(std::FILE* out, const options& opt, const std::vector<result>& results){
+    char date[64];
+    std::time_t now=std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": \"%s\",\n", date);
+    std::fprintf(out, "    \"cpu\": \"%s\",\n", json_escape(cpu_model()).c_str());
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(out, "    \"compiler\": \"%s\",\n", json_escape(__VERSION__).c_str());
+#ifdef NDEBUG
+    std::fprintf(out, "    \"build_type\": \"release\",\n");
+#else
+    std::fprintf(out, "    \"build_type\": \"debug\",\n");
+#endif
+    std::fprintf(out, "    \"isa\": \"%s\",\n", mystl::simd::isa_name(mystl::simd::active_isa()));
+    std::fprintf(out, "    \"repetitions\": %zu,\n", opt.repetitions);
+    std::fprintf(out, "    \"warmup_ms\": %g,\n", opt.warmup_ms);
+    std::fprintf(out, "    \"sample_us\": %g,\n", opt.sample_us);
+    std::fprintf(out, "    \"perf_counters\": \"%s\"\n", json_escape(opt.perf_status).c_str());
+    std::fprintf(out, "  },\n  \"benchmarks\": [");
+    for(size_t i=0; i<results.size(); ++i){
+        const result& r=results[i];
+        std::string group, impl, type;
+        split_name(r.name, group, impl, type);
+        double per_item= r.items? r.median/r.items: 0;
+        double gbps= r.median>0? double(r.items*r.bytes_per_item)/r.median: 0;
+        std::fprintf(out, "%s\n    {\"name\": \"%s\", \"group\": \"%s\", \"impl\": \"%s\", \"type\": \"%s\",",
+            i? ",": "", json_escape(r.name).c_str(), json_escape(group).c_str(),
+            json_escape(impl).c_str(), json_escape(type).c_str());
+        std::fprintf(out, " \"size\": %zu, \"items\": %zu, \"bytes_per_item\": %zu, \"calls\": %zu,",
+            r.size, r.items, r.bytes_per_item, r.calls);
+        std::fprintf(out, " \"median_ns\": %.3f, \"p99_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f,"
+            " \"min_ns\": %.3f, \"ns_per_item\": %.4f, \"gb_per_s\": %.3f, \"allocs_per_call\": %.3f",
+            r.median, r.p99, r.mean, r.stddev, r.min, per_item, gbps, r.allocs_per_call);
+        std::fprintf(out, ", \"counters\": {");
+        for(size_t c=0; c<r.counters.size(); ++c){
+            std::fprintf(out, "%s\"%s\": %.6g", c? ", ": "",
+                json_escape(r.counters[c].first).c_str(), r.counters[c].second);
+        }
+        std::fprintf(out, "}}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+void print_header(){
+    std::printf("%-44s %9s %12s %10s %12s %7s %9s %8s %7s\n",
+        "benchmark", "size", "median(ns)", "ns/item", "p99(ns)", "cv%", "GB/s", "allocs", "vs std");
+}
+
+void print_row(const result& r, double ratio){
+    double per_item= r.items? r.median/r.items: 0;
+    double gbps= r.median>0? double(r.items*r.bytes_per_item)/r.median: 0;
+    double cv= r.mean>0? 100.0*r.stddev/r.mean: 0;
+    std::printf("%-44s %9zu %12.1f %10.3f %12.1f %7.1f ", r.name.c_str(), r.size, r.median, per_item, r.p99, cv);
+    if(r.bytes_per_item){
+        std::printf("%9.2f ", gbps);
+    }
+    else{
+        std::printf("%9s ", "-");
+    }
+    std::printf("%8.2f ", r.allocs_per_call);
+    if(ratio>0){
+        std::printf("%6.2fx", ratio);
+    }
+    for(const auto& c: r.counters){
+        std::printf("  %s=%.3g", c.first.c_str(), c.second);
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+void state::begin_samples(){
+    m_alloc_before=alloc_count();
+    if(m_opt.counters!=nullptr){
+        m_opt.counters->start();
+    }
+}
+
+void state::end_samples(size_t calls){
+    std::vector<std::pair<const char*, double>> events;
+    if(m_opt.counters!=nullptr){
+        events=m_opt.counters->stop();
+    }
+    m_calls=calls;
+    m_allocs_per_call=double(alloc_count()-m_alloc_before)/calls;
+    m_finished=true;
+
+    // 计数器按每个元素和每个字节归一化，便于判断是受限于访存还是分支
+    double cycles=0, instructions=0;
+    for(const auto& e: events){
+        double per_call=e.second/calls;
+        if(m_items){
+            counter(std::string(e.first)+"_per_item", per_call/m_items);
+        }
+        if(m_items && m_bytes_per_item){
+            counter(std::string(e.first)+"_per_byte", per_call/(m_items*m_bytes_per_item));
+        }
+        if(std::strcmp(e.first, "cycles")==0){
+            cycles=e.second;
+        }
+        else if(std::strcmp(e.first, "instructions")==0){
+            instructions=e.second;
+        }
+    }
+    if(cycles>0 && instructions>0){
+        counter("ipc", instructions/cycles);
+    }
+}
+
+result state::make_result(const std::string& name) const{
+    result r;
+    r.name=name;
+    r.size=m_size;
+    r.items=m_items;
+    r.bytes_per_item=m_bytes_per_item;
+    r.calls=m_calls;
+    r.allocs_per_call=m_allocs_per_call;
+    r.counters=m_counters;
+
+    std::vector<double> sorted(m_samples);
+    std::sort(sorted.begin(), sorted.end());
+    if(!sorted.empty()){
+        size_t n=sorted.size();
+        r.median= n%2? sorted[n/2]: (sorted[n/2-1]+sorted[n/2])/2;
+        r.p99=percentile(sorted, 0.99);
+        r.min=sorted.front();
+        double sum=0;
+        for(double x: sorted){
+            sum+=x;
+        }
+        r.mean=sum/n;
+        double sq=0;
+        for(double x: sorted){
+            sq+=(x-r.mean)*(x-r.mean);
+        }
+        r.stddev= n>1? std::sqrt(sq/(n-1)): 0;
+    }
+    return r;
+}
+
+std::vector<size_t> default_sizes(){
+    return {16, 256, 4096, 65536, 1048576};
+}
+
+void add(const std::string& name, std::function<void(state&)> fn, std::vector<size_t> sizes){
+    registry().push_back(benchmark{name, std::move(fn), std::move(sizes)});
+}
+
+void add(const std::string& name, std::function<void(state&)> fn){
+    add(name, std::move(fn), default_sizes());
+}
+
+size_t alloc_count() noexcept{
+    return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+int run_main(int argc, char** argv){
+    options opt;
+    if(!parse_args(argc, argv, opt)){
+        return 1;
+    }
+
+    // 计数器不可用时（如容器中没有 PMU 或 perf_event_paranoid 过高）只报告时间
+    perf_counters counters;
+    if(opt.perf && !opt.list_only){
+        bool ok=counters.open();
+        if(ok){
+            opt.counters=&counters;
+            opt.perf_status=counters.event_names();
+        }
+        else{
+            opt.perf_status="unavailable";
+        }
+        if(!counters.error().empty()){
+            std::fprintf(stderr, "perf counters %s: %s\n", ok? "partially available": "unavailable",
+                counters.error().c_str());
+            opt.perf_status+=" ("+counters.error()+")";
+        }
+    }
+    else{
+        opt.perf_status="disabled";
+    }
+
+    std::vector<result> results;
+    // 以 "算法/类型/规模" 为键记录 std 实现的中位数，用于计算 mystl 的耗时比
+    std::map<std::string, double> std_median;
+    bool header=false;
+    // JSON 输出到标准输出时不打印表格，避免混在一起
+    bool quiet= opt.json_path=="-";
+
+    for(const benchmark& b: registry()){
+        if(!opt.filter.empty() && b.name.find(opt.filter)==std::string::npos){
+            continue;
+        }
+        if(opt.list_only){
+            std::printf("%s\n", b.name.c_str());
+            continue;
+        }
+        const std::vector<size_t>& sizes= opt.sizes.empty()? b.sizes: opt.sizes;
+        for(size_t n: sizes){
+            if(opt.max_size!=0 && n>opt.max_size){
+                continue;
+            }
+            state s(opt, n);
+            b.fn(s);
+            if(!s.finished()){
+                continue;  // 基准没有调用 run，如当前环境不支持
+            }
+            result r=s.make_result(b.name);
+
+            std::string group, impl, type;
+            double ratio=0;
+            if(split_name(b.name, group, impl, type)){
+                std::string key=group+"/"+type+"/"+std::to_string(n);
+                if(impl=="std"){
+                    std_median[key]=r.median;
+                }
+                else if(impl=="mystl"){
+                    auto it=std_median.find(key);
+                    if(it!=std_median.end() && it->second>0){
+                        ratio=r.median/it->second;
+                    }
+                }
+            }
+            if(!quiet){
+                if(!header){
+                    print_header();
+                    header=true;
+                }
+                print_row(r, ratio);
+                std::fflush(stdout);
+            }
+            results.push_back(std::move(r));
+        }
+    }
+
+    if(!opt.json_path.empty() && !opt.list_only){
+        std::FILE* out= quiet? stdout: std::fopen(opt.json_path.c_str(), "w");
+        if(out==nullptr){
+            std::fprintf(stderr, "cannot open %s\n", opt.json_path.c_str());
+            return 1;
+        }
+        write_json(out, opt, results);
+        if(!quiet){
+            std::fclose(out);
+        }
+    }
+    return 0;
+}
+
+} // namespace mybench
@@ -0,0 +1,181 @@
+#ifndef MYTINYSTL_BENCH_BENCH_H_
+#define MYTINYSTL_BENCH_BENCH_H_
+
+// 这个头文件包含一个简单的微基准测试框架
+// 每个基准在若干规模（元素个数）下运行：先预热，再标定每个样本的批量，最后重复采样
+// 报告每次调用耗时的中位数、p99、均值、标准差，以及每个元素的耗时和吞吐量
+// 结果可以输出为 JSON，方便跟踪性能回退
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mybench
+{
+
+class perf_counters;
+
+// 防止编译器把被测代码的结果优化掉
+template <class T>
+inline void do_not_optimize(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// 让编译器认为所有内存都可能被读写，防止写操作被消除
+inline void clobber_memory(){
+    asm volatile("" : : : "memory");
+}
+
+// 运行参数，由命令行解析得到
+struct options
+{
+    std::string filter;                 // 只运行名字中包含该子串的基准
+    std::vector<size_t> sizes;          // 覆盖基准自带的规模；为空时使用基准自己的规模
+    size_t max_size=0;                  // 跳过大于该值的规模，0 表示不限制
+    size_t repetitions=20;              // 样本个数
+    double warmup_ms=2.0;               // 每个规模正式采样前的预热时间
+    double sample_us=500.0;             // 每个样本的最短时间，不足时把多次调用合成一个样本
+    std::string json_path;              // 非空时输出 JSON，"-" 表示标准输出
+    bool list_only=false;
+    bool perf=false;                    // 是否统计硬件性能计数器
+    perf_counters* counters=nullptr;    // --perf 且计数器可用时指向已打开的计数器
+    std::string perf_status;            // 计数器的事件名或不可用的原因，写入 JSON
+};
+
+// 一个基准在一个规模下的统计结果，时间单位都是每次调用的纳秒数
+struct result
+{
+    std::string name;
+    size_t size=0;
+    size_t items=0;                     // 每次调用处理的元素个数
+    size_t bytes_per_item=0;
+    size_t calls=0;                     // 采样阶段的总调用次数
+    double median=0, p99=0, mean=0, stddev=0, min=0;
+    double allocs_per_call=0;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+// 传给基准函数的状态：基准先做准备工作，再把被测代码交给 run
+class state
+{
+public:
+    state(const options& opt, size_t size): m_opt(opt), m_size(size), m_items(size) {}
+
+    size_t size() const noexcept { return m_size; }
+
+    // 每次调用处理的元素个数，默认等于 size()
+    void set_items(size_t items) noexcept { m_items=items; }
+    // 每个元素的字节数，用于计算吞吐量
+    void set_bytes_per_item(size_t bytes) noexcept { m_bytes_per_item=bytes; }
+    // 附加的自定义指标，按每次调用给出
+    void counter(const std::string& name, double value){ m_counters.emplace_back(name, value); }
+
+    // 计时被测代码 f，每次调用 f 处理 set_items 个元素
+    template <class F>
+    void run(F f);
+
+    bool finished() const noexcept { return m_finished; }
+    result make_result(const std::string& name) const;
+
+private:
+    using clock=std::chrono::steady_clock;
+
+    static double elapsed_ns(clock::time_point start, clock::time_point end){
+        return std::chrono::duration<double, std::nano>(end-start).count();
+    }
+
+    void begin_samples();
+    void end_samples(size_t calls);
+
+private:
+    const options& m_opt;
+    size_t m_size;
+    size_t m_items;
+    size_t m_bytes_per_item=0;
+    std::vector<double> m_samples;
+    size_t m_calls=0;
+    size_t m_alloc_before=0;
+    double m_allocs_per_call=0;
+    std::vector<std::pair<std::string, double>> m_counters;
+    bool m_finished=false;
+};
+
+template <class F>
+void state::run(F f){
+    // 1.预热：让缓存、分支预测器和页表进入稳定状态
+    auto warm_start=clock::now();
+    size_t warm_calls=0;
+    do{
+        f();
+        ++warm_calls;
+    } while(elapsed_ns(warm_start, clock::now())<m_opt.warmup_ms*1e6 && warm_calls<(1u<<20));
+
+    // 2.标定：单次调用太短时，把 batch 次调用合成一个样本，减小计时开销的影响
+    size_t batch=1;
+    for(;;){
+        auto start=clock::now();
+        for(size_t i=0; i<batch; ++i){
+            f();
+        }
+        double ns=elapsed_ns(start, clock::now());
+        if(ns>=m_opt.sample_us*1e3 || batch>=(size_t(1)<<30)){
+            break;
+        }
+        // 按已测得的速度估计所需批量，至少翻倍
+        size_t guess= ns>0? size_t(batch*m_opt.sample_us*1e3/ns*1.2): batch*10;
+        batch= guess>batch*2? guess: batch*2;
+    }
+
+    // 3.采样
+    m_samples.clear();
+    m_samples.reserve(m_opt.repetitions);
+    begin_samples();
+    for(size_t r=0; r<m_opt.repetitions; ++r){
+        auto start=clock::now();
+        for(size_t i=0; i<batch; ++i){
+            f();
+        }
+        m_samples.push_back(elapsed_ns(start, clock::now())/batch);
+    }
+    end_samples(batch*m_opt.repetitions);
+}
+
+// 默认的规模扫描：从放得进 L1 到远超 LLC
+std::vector<size_t> default_sizes();
+
+// 注册基准：name 约定为 "算法/实现/元素类型"，如 "copy/mystl/int"
+    // 实现为 mystl 和 std 的同名基准会在报告中给出耗时比
+void add(const std::string& name, std::function<void(state&)> fn, std::vector<size_t> sizes);
+void add(const std::string& name, std::function<void(state&)> fn);
+
+// 同一个基准函数体分别用 std 和 mystl 的实现注册一次，先运行 std 作为对照
+    // body 的形式为 body(state&, algo)，algo 是被比较的算法
+template <class Body, class MystlAlgo, class StdAlgo>
+void compare(const std::string& group, const std::string& type, Body body,
+    MystlAlgo mystl_algo, StdAlgo std_algo, std::vector<size_t> sizes){
+    add(group+"/std/"+type, [=](state& s){ body(s, std_algo); }, sizes);
+    add(group+"/mystl/"+type, [=](state& s){ body(s, mystl_algo); }, sizes);
+}
+
+template <class Body, class MystlAlgo, class StdAlgo>
+void compare(const std::string& group, const std::string& type, Body body,
+    MystlAlgo mystl_algo, StdAlgo std_algo){
+    compare(group, type, body, mystl_algo, std_algo, default_sizes());
+}
+
+// 进程启动以来 operator new 的调用次数
+size_t alloc_count() noexcept;
+
+// 解析命令行、运行所有匹配的基准并输出报告，返回进程退出码
+int run_main(int argc, char** argv);
+
+} // namespace mybench
+
+// 把重载的函数模板包装成可以按值传递的函数对象，如 MYBENCH_FN(mystl::copy)
+#define MYBENCH_FN(f) \
+    [](auto&&... args) -> decltype(auto) { return f(std::forward<decltype(args)>(args)...); }
+
+#endif
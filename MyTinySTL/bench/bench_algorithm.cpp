@@ -0,0 +1,386 @@
+// algorithm_base.h 中各算法与 std:: 对应算法的对比
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../algorithm_base.h"
+#include "bench.h"
+#include "bench_data.h"
+
+namespace
+{
+
+using mybench::state;
+
+// copy_if 的谓词：大约选中一半元素
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type keep(const T& x){
+    return (uint64_t(x)&1)==0;
+}
+
+inline bool keep(const std::string& x){
+    return (x.back()&1)==0;
+}
+
+template <class T>
+struct equal_pred
+{
+    bool operator()(const T& x, const T& y) const { return x==y; }
+};
+
+template <class T>
+struct less_pred
+{
+    bool operator()(const T& x, const T& y) const { return x<y; }
+};
+
+// 1.拷贝和移动：copy、copy_backward、copy_n、copy_if、move、move_backward
+template <class T>
+void register_copy_family(const char* type){
+    mybench::compare("copy", type, [](state& s, auto copy){
+        const auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(copy(a.data(), a.data()+a.size(), b.data()));
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::copy), MYBENCH_FN(std::copy));
+
+    mybench::compare("copy_backward", type, [](state& s, auto copy_backward){
+        const auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(copy_backward(a.data(), a.data()+a.size(), b.data()+b.size()));
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::copy_backward), MYBENCH_FN(std::copy_backward));
+
+    mybench::compare("copy_n", type, [](state& s, auto copy_n){
+        const auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(copy_n(a.data(), a.size(), b.data()));
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::copy_n), MYBENCH_FN(std::copy_n));
+
+    mybench::compare("copy_if", type, [](state& s, auto copy_if){
+        const auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(copy_if(a.data(), a.data()+a.size(), b.data(),
+                [](const T& x){ return keep(x); }));
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::copy_if), MYBENCH_FN(std::copy_if));
+
+    // 移动后交换两个缓冲区，下一次调用的源总是有效的原始数据
+    mybench::compare("move", type, [](state& s, auto move){
+        auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(move(a.data(), a.data()+a.size(), b.data()));
+            a.swap(b);
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::move), MYBENCH_FN(std::move));
+
+    mybench::compare("move_backward", type, [](state& s, auto move_backward){
+        auto a=mybench::make_data<T>(s.size());
+        std::vector<T> b(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(move_backward(a.data(), a.data()+a.size(), b.data()+b.size()));
+            a.swap(b);
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::move_backward), MYBENCH_FN(std::move_backward));
+}
+
+// 2.填充：fill、fill_n
+template <class T>
+void register_fill_family(const char* type){
+    mybench::compare("fill", type, [](state& s, auto fill){
+        std::vector<T> a(s.size());
+        const T value=mybench::make_value<T>(7);
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            fill(a.data(), a.data()+a.size(), value);
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::fill), MYBENCH_FN(std::fill));
+
+    mybench::compare("fill_n", type, [](state& s, auto fill_n){
+        std::vector<T> a(s.size());
+        const T value=mybench::make_value<T>(7);
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(fill_n(a.data(), a.size(), value));
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::fill_n), MYBENCH_FN(std::fill_n));
+}
+
+// 3.比较：equal、mismatch、lexicographical_compare 及其带谓词的版本
+    // 两个序列只在最后一个元素处不同（equal 则完全相同），算法必须扫描整个区间
+    // 输入用 const 指针传入，与调用者持有 const 数据时匹配到的重载一致
+template <class T>
+void register_compare_family(const char* type){
+    struct ranges
+    {
+        std::vector<T> a, b;
+        explicit ranges(size_t n, bool differ_at_end): a(mybench::make_data<T>(n)), b(a) {
+            if(differ_at_end && n>0){
+                b.back()=mybench::make_value<T>(n+1);
+                if(b.back()==a.back()){
+                    b.back()=mybench::make_value<T>(n+2);
+                }
+            }
+        }
+        const T* first1() const { return a.data(); }
+        const T* last1() const { return a.data()+a.size(); }
+        const T* first2() const { return b.data(); }
+        const T* last2() const { return b.data()+b.size(); }
+    };
+
+    mybench::compare("equal", type, [](state& s, auto equal){
+        const ranges r(s.size(), false);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(equal(r.first1(), r.last1(), r.first2())); });
+    }, MYBENCH_FN(mystl::equal), MYBENCH_FN(std::equal));
+
+    mybench::compare("equal_pred", type, [](state& s, auto equal){
+        const ranges r(s.size(), false);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(equal(r.first1(), r.last1(), r.first2(), equal_pred<T>())); });
+    }, MYBENCH_FN(mystl::equal), MYBENCH_FN(std::equal));
+
+    mybench::compare("mismatch", type, [](state& s, auto mismatch){
+        const ranges r(s.size(), true);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(mismatch(r.first1(), r.last1(), r.first2()).first); });
+    }, MYBENCH_FN(mystl::mismatch), MYBENCH_FN(std::mismatch));
+
+    mybench::compare("mismatch_pred", type, [](state& s, auto mismatch){
+        const ranges r(s.size(), true);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(mismatch(r.first1(), r.last1(), r.first2(), equal_pred<T>()).first); });
+    }, MYBENCH_FN(mystl::mismatch), MYBENCH_FN(std::mismatch));
+
+    mybench::compare("lexicographical_compare", type, [](state& s, auto lexicographical_compare){
+        const ranges r(s.size(), true);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(lexicographical_compare(r.first1(), r.last1(), r.first2(), r.last2()));
+        });
+    }, MYBENCH_FN(mystl::lexicographical_compare), MYBENCH_FN(std::lexicographical_compare));
+
+    mybench::compare("lexicographical_compare_pred", type, [](state& s, auto lexicographical_compare){
+        const ranges r(s.size(), true);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(lexicographical_compare(r.first1(), r.last1(), r.first2(), r.last2(),
+                less_pred<T>()));
+        });
+    }, MYBENCH_FN(mystl::lexicographical_compare), MYBENCH_FN(std::lexicographical_compare));
+}
+
+// 4.单个元素的操作：max、min、iter_swap，每次调用对 size() 对元素各执行一次
+template <class T>
+void register_element_family(const char* type){
+    mybench::compare("max", type, [](state& s, auto max){
+        const auto a=mybench::make_data<T>(s.size());
+        const auto b=mybench::make_data<T>(s.size()+1);
+        s.run([&]{
+            for(size_t i=0; i<a.size(); ++i){
+                mybench::do_not_optimize(max(a[i], b[i+1]));
+            }
+        });
+    }, MYBENCH_FN(mystl::max), MYBENCH_FN(std::max));
+
+    mybench::compare("min", type, [](state& s, auto min){
+        const auto a=mybench::make_data<T>(s.size());
+        const auto b=mybench::make_data<T>(s.size()+1);
+        s.run([&]{
+            for(size_t i=0; i<a.size(); ++i){
+                mybench::do_not_optimize(min(a[i], b[i+1]));
+            }
+        });
+    }, MYBENCH_FN(mystl::min), MYBENCH_FN(std::min));
+
+    mybench::compare("iter_swap", type, [](state& s, auto iter_swap){
+        auto a=mybench::make_data<T>(s.size());
+        auto b=mybench::make_data<T>(s.size()+1);
+        s.set_bytes_per_item(2*sizeof(T));
+        s.run([&]{
+            for(size_t i=0; i<a.size(); ++i){
+                iter_swap(a.data()+i, b.data()+i);
+            }
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::iter_swap), MYBENCH_FN(std::iter_swap));
+}
+
+// 5.查找：find、find_if、count、count_if、search、find_first_of
+    // 要找的值只放在最后一个元素上，find 类算法扫描整个区间；count 统计区间中间那个元素的值
+template <class T>
+void register_find_family(const char* type){
+    struct haystack
+    {
+        std::vector<T> a;
+        T target;
+        explicit haystack(size_t n): a(mybench::make_data<T>(n)), target(mybench::make_value<T>(n+1)) {
+            if(n>0){
+                a.back()=target;
+            }
+        }
+        const T* first() const { return a.data(); }
+        const T* last() const { return a.data()+a.size(); }
+    };
+
+    mybench::compare("find", type, [](state& s, auto find){
+        const haystack h(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(find(h.first(), h.last(), h.target)); });
+    }, MYBENCH_FN(mystl::find), MYBENCH_FN(std::find));
+
+    mybench::compare("find_if", type, [](state& s, auto find_if){
+        const haystack h(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        const T target=h.target;
+        s.run([&]{ mybench::do_not_optimize(find_if(h.first(), h.last(), [&](const T& x){ return x==target; })); });
+    }, MYBENCH_FN(mystl::find_if), MYBENCH_FN(std::find_if));
+
+    mybench::compare("count", type, [](state& s, auto count){
+        const haystack h(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        const T value=h.a.empty()? h.target: h.a[h.a.size()/2];
+        s.run([&]{ mybench::do_not_optimize(count(h.first(), h.last(), value)); });
+    }, MYBENCH_FN(mystl::count), MYBENCH_FN(std::count));
+
+    mybench::compare("count_if", type, [](state& s, auto count_if){
+        const haystack h(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(count_if(h.first(), h.last(), [](const T& x){ return keep(x); })); });
+    }, MYBENCH_FN(mystl::count_if), MYBENCH_FN(std::count_if));
+
+    // 子序列是区间的最后 8 个元素
+    mybench::compare("search", type, [](state& s, auto search){
+        const haystack h(s.size());
+        const std::vector<T> needle(h.a.end()-std::min<size_t>(8, h.a.size()), h.a.end());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(search(h.first(), h.last(), needle.data(), needle.data()+needle.size()));
+        });
+    }, MYBENCH_FN(mystl::search), MYBENCH_FN(std::search));
+
+    // 4 个候选值，只有最后一个元素等于其中之一
+    mybench::compare("find_first_of", type, [](state& s, auto find_first_of){
+        const haystack h(s.size());
+        std::vector<T> set;
+        for(size_t i=2; i<=4; ++i){
+            const T v=mybench::make_value<T>(s.size()+i);
+            if(std::find(h.a.begin(), h.a.end(), v)==h.a.end()){
+                set.push_back(v);
+            }
+        }
+        set.push_back(h.target);
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(find_first_of(h.first(), h.last(), set.data(), set.data()+set.size()));
+        });
+    }, MYBENCH_FN(mystl::find_first_of), MYBENCH_FN(std::find_first_of));
+}
+
+// 6.最值：min_element、max_element、minmax_element
+template <class T>
+void register_extreme_family(const char* type){
+    mybench::compare("min_element", type, [](state& s, auto min_element){
+        const auto a=mybench::make_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(min_element(a.data(), a.data()+a.size())); });
+    }, MYBENCH_FN(mystl::min_element), MYBENCH_FN(std::min_element));
+
+    mybench::compare("max_element", type, [](state& s, auto max_element){
+        const auto a=mybench::make_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(max_element(a.data(), a.data()+a.size())); });
+    }, MYBENCH_FN(mystl::max_element), MYBENCH_FN(std::max_element));
+
+    mybench::compare("minmax_element", type, [](state& s, auto minmax_element){
+        const auto a=mybench::make_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(minmax_element(a.data(), a.data()+a.size()).first); });
+    }, MYBENCH_FN(mystl::minmax_element), MYBENCH_FN(std::minmax_element));
+}
+
+// 7.字符串键的字典序比较：模拟有序索引中相邻键的比较
+    // 键形如 "tenant-0042/user/000012345678/profile"，相邻键共享较长的前缀，第一个不同的位置在中部
+    // size() 是键的个数，每次调用比较每对相邻的键
+template <class CharT>
+std::vector<std::basic_string<CharT>> make_keys(size_t n){
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    for(size_t i=0; i<n; ++i){
+        char id[16];
+        std::snprintf(id, sizeof(id), "%012u", mybench::make_value<uint32_t>(i));
+        keys.push_back("tenant-"+std::to_string(i*4/(n+1))+"/user/"+id+"/profile");
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::basic_string<CharT>> result;
+    result.reserve(n);
+    for(const std::string& k: keys){
+        result.emplace_back(k.begin(), k.end());
+    }
+    return result;
+}
+
+template <class CharT>
+void register_key_compare(const char* type){
+    mybench::compare("lexicographical_compare_keys", type, [](state& s, auto lexicographical_compare){
+        const auto keys=make_keys<CharT>(s.size()+1);
+        size_t chars=0;
+        for(size_t i=0; i<s.size(); ++i){
+            chars+=keys[i].size()+keys[i+1].size();
+        }
+        s.set_bytes_per_item(chars*sizeof(CharT)/(s.size()>0? s.size(): 1));
+        s.run([&]{
+            for(size_t i=0; i<s.size(); ++i){
+                const CharT* a=keys[i].data();
+                const CharT* b=keys[i+1].data();
+                mybench::do_not_optimize(lexicographical_compare(a, a+keys[i].size(), b, b+keys[i+1].size()));
+            }
+        });
+    }, MYBENCH_FN(mystl::lexicographical_compare), MYBENCH_FN(std::lexicographical_compare),
+       std::vector<size_t>{16, 256, 4096, 65536});
+}
+
+template <class T>
+void register_all(const char* type){
+    register_copy_family<T>(type);
+    register_fill_family<T>(type);
+    register_compare_family<T>(type);
+    register_find_family<T>(type);
+    register_extreme_family<T>(type);
+    register_element_family<T>(type);
+}
+
+} // namespace
+
+void register_algorithm_benchmarks(){
+    register_all<unsigned char>("u8");
+    register_all<int>("int");
+    register_all<uint64_t>("u64");
+    register_all<std::string>("string");
+    register_extreme_family<float>("float");
+    register_extreme_family<double>("double");
+    register_key_compare<char>("char");
+    register_key_compare<uint16_t>("u16");
+}
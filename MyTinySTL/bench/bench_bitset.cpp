@@ -0,0 +1,210 @@
+// bitset 的基准：mystl::bitset<N> 与 std::bitset<N> 对比，dynamic_bitset 与 std::vector<bool> 对比
+    // size() 是位数；bitset 的大小是模板参数，由 with_bit_count 把运行时的 size() 映射到编译期常量
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../bitset.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+const std::vector<size_t> bit_sizes={1024, 65536, 1048576};
+
+template <class F>
+void with_bit_count(size_t n, F f){
+    switch(n){
+    case 1024:    f(std::integral_constant<size_t, 1024>()); break;
+    case 65536:   f(std::integral_constant<size_t, 65536>()); break;
+    case 1048576: f(std::integral_constant<size_t, 1048576>()); break;
+    default: break;
+    }
+}
+
+struct mystl_tag
+{
+    template <size_t N>
+    using fixed=mystl::bitset<N>;
+    typedef mystl::dynamic_bitset<> dynamic;
+
+    template <size_t N>
+    static size_t and_count(const fixed<N>& a, const fixed<N>& b) { return a.intersection_count(b); }
+    template <size_t N>
+    static size_t first(const fixed<N>& a) { return a.find_first(); }
+    template <size_t N>
+    static size_t next(const fixed<N>& a, size_t i) { return a.find_next(i); }
+
+    static size_t and_count(const dynamic& a, const dynamic& b) { return a.intersection_count(b); }
+    static size_t first(const dynamic& a) { return a.find_first(); }
+    static size_t next(const dynamic& a, size_t i) { return a.find_next(i); }
+};
+
+struct std_tag
+{
+    template <size_t N>
+    using fixed=std::bitset<N>;
+    typedef std::vector<bool> dynamic;
+
+    // std::bitset 没有不构造交集的计数
+    template <size_t N>
+    static size_t and_count(const fixed<N>& a, const fixed<N>& b) { return (a&b).count(); }
+    // libstdc++ 的扩展
+    template <size_t N>
+    static size_t first(const fixed<N>& a) { return a._Find_first(); }
+    template <size_t N>
+    static size_t next(const fixed<N>& a, size_t i) { return a._Find_next(i); }
+
+    // vector<bool> 只能逐位通过代理对象访问
+    static size_t and_count(const dynamic& a, const dynamic& b){
+        size_t n=0;
+        for(size_t i=0; i<a.size(); ++i){
+            n+=a[i] && b[i];
+        }
+        return n;
+    }
+    static size_t first(const dynamic& a) { return next_from(a, 0); }
+    static size_t next(const dynamic& a, size_t i) { return next_from(a, i+1); }
+
+    static size_t next_from(const dynamic& a, size_t i){
+        while(i<a.size() && !a[i]){
+            ++i;
+        }
+        return i;
+    }
+};
+
+// 每一位以 1/every 的概率为 1
+template <class Bits>
+void fill_random(Bits& bits, size_t n, size_t every, uint64_t seed){
+    for(size_t i=0; i<n; ++i){
+        seed=seed*6364136223846793005ull+1442695040888963407ull;
+        if((seed>>33)%every==0){
+            bits[i]=true;
+        }
+    }
+}
+
+// 1.求交集：c=a&b，结果写入第三个位数组
+template <class Tag>
+void bench_and(state& s, Tag){
+    with_bit_count(s.size(), [&](auto size){
+        typedef typename Tag::template fixed<decltype(size)::value> bits;
+        std::unique_ptr<bits> a(new bits()), b(new bits()), c(new bits());
+        fill_random(*a, s.size(), 2, 1);
+        fill_random(*b, s.size(), 2, 2);
+        s.set_items(s.size());
+        s.run([&]{
+            *c=*a;
+            *c&=*b;
+            mybench::clobber_memory();
+        });
+    });
+}
+
+// 2.交集的大小：相似度、覆盖率计算中只需要计数
+template <class Tag>
+void bench_and_count(state& s, Tag){
+    with_bit_count(s.size(), [&](auto size){
+        typedef typename Tag::template fixed<decltype(size)::value> bits;
+        std::unique_ptr<bits> a(new bits()), b(new bits());
+        fill_random(*a, s.size(), 2, 1);
+        fill_random(*b, s.size(), 2, 2);
+        s.set_items(s.size());
+        s.run([&]{
+            mybench::do_not_optimize(Tag::and_count(*a, *b));
+        });
+    });
+}
+
+// 3.count
+template <class Tag>
+void bench_count(state& s, Tag){
+    with_bit_count(s.size(), [&](auto size){
+        typedef typename Tag::template fixed<decltype(size)::value> bits;
+        std::unique_ptr<bits> a(new bits());
+        fill_random(*a, s.size(), 2, 1);
+        s.set_items(s.size());
+        s.run([&]{
+            mybench::do_not_optimize(a->count());
+        });
+    });
+}
+
+// 4.遍历稀疏位数组中所有的 1：约 1/256 的位为 1，大多数字为 0
+template <class Tag>
+void bench_iterate(state& s, Tag){
+    with_bit_count(s.size(), [&](auto size){
+        constexpr size_t n=decltype(size)::value;
+        typedef typename Tag::template fixed<n> bits;
+        std::unique_ptr<bits> a(new bits());
+        fill_random(*a, n, 256, 3);
+        s.set_items(s.size());
+        s.run([&]{
+            size_t sum=0;
+            for(size_t i=Tag::first(*a); i<n; i=Tag::next(*a, i)){
+                sum+=i;
+            }
+            mybench::do_not_optimize(sum);
+        });
+    });
+}
+
+// 5.运行时大小的交集计数：dynamic_bitset 与逐位访问的 vector<bool>
+template <class Tag>
+void bench_dynamic_and_count(state& s, Tag){
+    typename Tag::dynamic a(s.size()), b(s.size());
+    fill_random(a, s.size(), 2, 1);
+    fill_random(b, s.size(), 2, 2);
+    s.set_items(s.size());
+    s.run([&]{
+        mybench::do_not_optimize(Tag::and_count(a, b));
+    });
+}
+
+// 6.运行时大小的稀疏遍历：BFS 的 frontier、空闲位图的分配
+template <class Tag>
+void bench_dynamic_iterate(state& s, Tag){
+    typename Tag::dynamic a(s.size());
+    fill_random(a, s.size(), 256, 3);
+    s.set_items(s.size());
+    s.run([&]{
+        size_t sum=0;
+        for(size_t i=Tag::first(a); i<a.size(); i=Tag::next(a, i)){
+            sum+=i;
+        }
+        mybench::do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+void register_bitset_benchmarks(){
+    mybench::compare("bitset_and", "bits", [](state& s, auto tag){
+        bench_and(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+
+    mybench::compare("bitset_and_count", "bits", [](state& s, auto tag){
+        bench_and_count(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+
+    mybench::compare("bitset_count", "bits", [](state& s, auto tag){
+        bench_count(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+
+    mybench::compare("bitset_iterate", "sparse", [](state& s, auto tag){
+        bench_iterate(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+
+    mybench::compare("dynamic_bitset_and_count", "bits", [](state& s, auto tag){
+        bench_dynamic_and_count(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+
+    mybench::compare("dynamic_bitset_iterate", "sparse", [](state& s, auto tag){
+        bench_dynamic_iterate(s, tag);
+    }, mystl_tag(), std_tag(), bit_sizes);
+}
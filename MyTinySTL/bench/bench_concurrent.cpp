@@ -0,0 +1,582 @@
+// 并发容器的基准：与 std::mutex 保护的 std::deque、std::unordered_map 对比
+    // 生产者和消费者各绑定到一个 CPU（只有一个 CPU 时不绑定），队列空或满时让出 CPU，
+    // 所以单核机器上测到的是线程切换的开销，而不是缓存行在核间传递的开销
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "../concurrent_hash_map.h"
+#include "../epoch.h"
+#include "../mpmc_queue.h"
+#include "../spsc_queue.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+// 把当前线程绑定到第 index 个 CPU（按可用 CPU 个数取模），析构时恢复原来的绑定
+class cpu_pin
+{
+public:
+    explicit cpu_pin(unsigned index){
+#ifdef __linux__
+        m_saved=pthread_getaffinity_np(pthread_self(), sizeof(m_old), &m_old)==0;
+        const unsigned cpus=std::thread::hardware_concurrency();
+        if(m_saved && cpus>1){
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(index%cpus, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#else
+        (void)index;
+#endif
+    }
+
+    ~cpu_pin(){
+#ifdef __linux__
+        if(m_saved){
+            pthread_setaffinity_np(pthread_self(), sizeof(m_old), &m_old);
+        }
+#endif
+    }
+
+    cpu_pin(const cpu_pin&)=delete;
+    cpu_pin& operator=(const cpu_pin&)=delete;
+
+private:
+#ifdef __linux__
+    cpu_set_t m_old;
+    bool m_saved=false;
+#endif
+};
+
+// 对照组：互斥锁保护的 std::deque，接口与 spsc_queue、mpmc_queue 相同
+template <class T>
+class locked_queue
+{
+public:
+    explicit locked_queue(size_t capacity): m_capacity(capacity) {}
+
+    bool try_push(const T& value){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_items.size()>=m_capacity){
+            return false;
+        }
+        m_items.push_back(value);
+        return true;
+    }
+
+    bool try_pop(T& value){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_items.empty()){
+            return false;
+        }
+        value=std::move(m_items.front());
+        m_items.pop_front();
+        return true;
+    }
+
+    size_t push_n(const T* first, size_t n){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t count=n<m_capacity-m_items.size()? n: m_capacity-m_items.size();
+        m_items.insert(m_items.end(), first, first+count);
+        return count;
+    }
+
+    size_t pop_n(T* result, size_t n){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t count=n<m_items.size()? n: m_items.size();
+        std::move(m_items.begin(), m_items.begin()+count, result);
+        m_items.erase(m_items.begin(), m_items.begin()+count);
+        return count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::deque<T> m_items;
+    size_t m_capacity;
+};
+
+// 作为 compare 的“算法”参数传入的队列类型
+template <class Q>
+struct queue_tag
+{
+    typedef Q type;
+};
+
+constexpr size_t queue_capacity=1024;
+constexpr size_t queue_batch=64;
+
+const std::vector<size_t> transfer_sizes={4096, 65536, 1048576};
+const std::vector<size_t> latency_sizes={1024};
+
+// 1.吞吐量：生产者放入 size() 个元素，等消费者全部取走后一次调用结束
+    // 消费者只在队列变空或每取出 queue_batch 个元素时公布进度，避免每个元素都写共享的计数器
+template <class Q, bool Batch>
+void bench_transfer(state& s){
+    Q q(queue_capacity);
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> consumed(0);
+    std::thread consumer([&]{
+        cpu_pin pin(1);
+        uint64_t buf[queue_batch];
+        size_t local=0;
+        while(!stop.load(std::memory_order_relaxed)){
+            const size_t got=Batch? q.pop_n(buf, queue_batch): q.try_pop(buf[0])? 1: 0;
+            if(got==0){
+                consumed.store(local, std::memory_order_release);
+                std::this_thread::yield();
+                continue;
+            }
+            local+=got;
+            if(local%queue_batch<got){
+                consumed.store(local, std::memory_order_release);
+            }
+        }
+    });
+    cpu_pin pin(0);
+    uint64_t buf[queue_batch];
+    for(size_t i=0; i<queue_batch; ++i){
+        buf[i]=i;
+    }
+    size_t sent=0;
+    s.set_bytes_per_item(sizeof(uint64_t));
+    s.run([&]{
+        for(size_t i=0; i<s.size();){
+            const size_t want=s.size()-i<queue_batch? s.size()-i: queue_batch;
+            const size_t put=Batch? q.push_n(buf, want): q.try_push(buf[0])? 1: 0;
+            if(put==0){
+                std::this_thread::yield();
+            }
+            i+=put;
+        }
+        sent+=s.size();
+        while(consumed.load(std::memory_order_acquire)<sent){
+            std::this_thread::yield();
+        }
+    });
+    stop.store(true, std::memory_order_relaxed);
+    consumer.join();
+}
+
+// 2.延迟：两个队列之间来回传递一个元素，每次往返计为一个元素
+template <class Q>
+void bench_ping_pong(state& s){
+    Q ping(queue_capacity), pong(queue_capacity);
+    std::atomic<bool> stop(false);
+    std::thread echo([&]{
+        cpu_pin pin(1);
+        uint64_t v=0;
+        while(!stop.load(std::memory_order_relaxed)){
+            if(ping.try_pop(v)){
+                while(!pong.try_push(v)){
+                    std::this_thread::yield();
+                }
+            }
+            else{
+                std::this_thread::yield();
+            }
+        }
+    });
+    cpu_pin pin(0);
+    s.run([&]{
+        uint64_t v=0;
+        for(size_t i=0; i<s.size(); ++i){
+            while(!ping.try_push(i)){
+                std::this_thread::yield();
+            }
+            while(!pong.try_pop(v)){
+                std::this_thread::yield();
+            }
+        }
+        mybench::do_not_optimize(v);
+    });
+    stop.store(true, std::memory_order_relaxed);
+    echo.join();
+}
+
+void register_spsc(){
+    typedef queue_tag<mystl::spsc_queue<uint64_t>> mystl_queue;
+    typedef queue_tag<locked_queue<uint64_t>> std_queue;
+
+    mybench::compare("spsc_transfer", "u64", [](state& s, auto tag){
+        bench_transfer<typename decltype(tag)::type, false>(s);
+    }, mystl_queue(), std_queue(), transfer_sizes);
+
+    mybench::compare("spsc_transfer_batch", "u64", [](state& s, auto tag){
+        bench_transfer<typename decltype(tag)::type, true>(s);
+    }, mystl_queue(), std_queue(), transfer_sizes);
+
+    mybench::compare("spsc_ping_pong", "u64", [](state& s, auto tag){
+        bench_ping_pong<typename decltype(tag)::type>(s);
+    }, mystl_queue(), std_queue(), latency_sizes);
+}
+
+// 3.多生产者多消费者：每次调用由 producers 个线程分摊放入 size() 个元素，consumers 个线程取走
+    // 线程在整个基准期间常驻，主线程递增 generation 通知生产者开始新一轮，再等消费者的计数到达目标
+template <class Q, bool Batch>
+void bench_fan(state& s, unsigned producers, unsigned consumers){
+    Q q(queue_capacity);
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> generation(0);
+    std::atomic<size_t> consumed(0);
+    std::vector<std::thread> threads;
+    for(unsigned p=0; p<producers; ++p){
+        threads.emplace_back([&, p]{
+            cpu_pin pin(p);
+            uint64_t buf[queue_batch]={};
+            size_t seen=0;
+            while(!stop.load(std::memory_order_relaxed)){
+                const size_t g=generation.load(std::memory_order_acquire);
+                if(g==seen){
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen=g;
+                const size_t share=s.size()/producers+(p==0? s.size()%producers: 0);
+                for(size_t i=0; i<share;){
+                    const size_t want=share-i<queue_batch? share-i: queue_batch;
+                    const size_t put=Batch? q.push_n(buf, want): q.try_push(buf[0])? 1: 0;
+                    if(put==0){
+                        std::this_thread::yield();
+                    }
+                    i+=put;
+                }
+            }
+        });
+    }
+    for(unsigned c=0; c<consumers; ++c){
+        threads.emplace_back([&, c]{
+            cpu_pin pin(producers+c);
+            uint64_t buf[queue_batch];
+            size_t local=0;
+            while(!stop.load(std::memory_order_relaxed)){
+                const size_t got=Batch? q.pop_n(buf, queue_batch): q.try_pop(buf[0])? 1: 0;
+                local+=got;
+                if(got==0 || local>=queue_batch){
+                    consumed.fetch_add(local, std::memory_order_release);
+                    local=0;
+                }
+                if(got==0){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    size_t target=0;
+    s.set_bytes_per_item(sizeof(uint64_t));
+    s.run([&]{
+        target+=s.size();
+        generation.fetch_add(1, std::memory_order_release);
+        while(consumed.load(std::memory_order_acquire)<target){
+            std::this_thread::yield();
+        }
+    });
+    stop.store(true, std::memory_order_relaxed);
+    for(std::thread& t: threads){
+        t.join();
+    }
+}
+
+void register_mpmc(){
+    typedef queue_tag<mystl::mpmc_queue<uint64_t>> mystl_queue;
+    typedef queue_tag<locked_queue<uint64_t>> std_queue;
+
+    for(unsigned n: {1u, 2u, 4u}){
+        const std::string shape=std::to_string(n)+"x"+std::to_string(n);
+        mybench::compare("mpmc_transfer_"+shape, "u64", [n](state& s, auto tag){
+            bench_fan<typename decltype(tag)::type, false>(s, n, n);
+        }, mystl_queue(), std_queue(), transfer_sizes);
+
+        mybench::compare("mpmc_transfer_batch_"+shape, "u64", [n](state& s, auto tag){
+            bench_fan<typename decltype(tag)::type, true>(s, n, n);
+        }, mystl_queue(), std_queue(), transfer_sizes);
+    }
+    // 扇入：多个生产者，一个消费者
+    mybench::compare("mpmc_transfer_4x1", "u64", [](state& s, auto tag){
+        bench_fan<typename decltype(tag)::type, false>(s, 4, 1);
+    }, mystl_queue(), std_queue(), transfer_sizes);
+}
+
+// 对照组：一把互斥锁保护的 std::unordered_map，接口与 concurrent_hash_map 相同
+template <class K, class V>
+class locked_map
+{
+public:
+    bool find(const K& key, V& value) const{
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it=m_items.find(key);
+        if(it==m_items.end()){
+            return false;
+        }
+        value=it->second;
+        return true;
+    }
+
+    bool insert_or_assign(const K& key, const V& value){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.insert_or_assign(key, value).second;
+    }
+
+    bool erase(const K& key){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.erase(key)!=0;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<K, V> m_items;
+};
+
+template <class M>
+struct map_tag
+{
+    typedef M type;
+};
+
+constexpr uint64_t map_keys=65536;
+const std::vector<size_t> map_sizes={65536, 1048576};
+
+// 4.读写混合：每次调用由 threads 个线程分摊 size() 次操作，其中 write_percent% 是写
+    // 键在 map_keys 个之内均匀随机，预先插入一半；写操作一半是 insert_or_assign，一半是 erase，元素个数保持稳定
+    // 线程常驻的方式与 bench_fan 相同
+template <class M>
+void bench_map_mix(state& s, unsigned threads, unsigned write_percent){
+    M m;
+    for(uint64_t k=0; k<map_keys; k+=2){
+        m.insert_or_assign(k, k);
+    }
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> generation(0);
+    std::atomic<size_t> finished(0);
+    std::vector<std::thread> workers;
+    for(unsigned t=0; t<threads; ++t){
+        workers.emplace_back([&, t]{
+            cpu_pin pin(t);
+            uint64_t x=0x9e3779b97f4a7c15ull*(t+1);
+            uint64_t found=0;
+            size_t seen=0;
+            while(!stop.load(std::memory_order_relaxed)){
+                const size_t g=generation.load(std::memory_order_acquire);
+                if(g==seen){
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen=g;
+                const size_t share=s.size()/threads+(t==0? s.size()%threads: 0);
+                for(size_t i=0; i<share; ++i){
+                    x^=x<<13;
+                    x^=x>>7;
+                    x^=x<<17;
+                    const uint64_t key=x%map_keys;
+                    if((x>>32)%100<write_percent){
+                        if(x>>63){
+                            m.insert_or_assign(key, key);
+                        }
+                        else{
+                            m.erase(key);
+                        }
+                    }
+                    else{
+                        uint64_t v=0;
+                        found+=m.find(key, v);
+                    }
+                }
+                finished.fetch_add(1, std::memory_order_release);
+            }
+            mybench::do_not_optimize(found);
+        });
+    }
+    size_t target=0;
+    s.run([&]{
+        target+=threads;
+        generation.fetch_add(1, std::memory_order_release);
+        while(finished.load(std::memory_order_acquire)<target){
+            std::this_thread::yield();
+        }
+    });
+    stop.store(true, std::memory_order_relaxed);
+    for(std::thread& t: workers){
+        t.join();
+    }
+}
+
+void register_hash_map(){
+    typedef map_tag<mystl::concurrent_hash_map<uint64_t, uint64_t>> mystl_map;
+    typedef map_tag<locked_map<uint64_t, uint64_t>> std_map;
+
+    for(unsigned n: {1u, 2u, 4u}){
+        const std::string threads=std::to_string(n)+"t";
+        mybench::compare("hash_map_read_heavy_"+threads, "u64", [n](state& s, auto tag){
+            bench_map_mix<typename decltype(tag)::type>(s, n, 5);
+        }, mystl_map(), std_map(), map_sizes);
+
+        mybench::compare("hash_map_write_heavy_"+threads, "u64", [n](state& s, auto tag){
+            bench_map_mix<typename decltype(tag)::type>(s, n, 50);
+        }, mystl_map(), std_map(), map_sizes);
+    }
+}
+
+// 5.纪元回收：读者每次读取进出一次 epoch_guard，对照组用 std::atomic_load 读取 shared_ptr（引用计数加减各一次），
+    // 另外给出不加任何保护的读取作为下限
+struct epoch_payload
+{
+    uint64_t value;
+    explicit epoch_payload(uint64_t v): value(v) {}
+};
+
+epoch_payload* new_payload(uint64_t v){
+    epoch_payload* p=mystl::allocator<epoch_payload>::allocate();
+    mystl::construct(p, v);
+    return p;
+}
+
+struct guarded_tag {};
+struct shared_ptr_tag {};
+
+void bench_epoch_read(state& s, guarded_tag){
+    std::atomic<epoch_payload*> shared(new_payload(1));
+    s.run([&]{
+        uint64_t sum=0;
+        for(size_t i=0; i<s.size(); ++i){
+            mystl::epoch_guard guard;
+            sum+=shared.load(std::memory_order_acquire)->value;
+        }
+        mybench::do_not_optimize(sum);
+    });
+    mystl::epoch_domain::instance().retire(shared.load());
+}
+
+void bench_epoch_read(state& s, shared_ptr_tag){
+    std::shared_ptr<epoch_payload> shared=std::make_shared<epoch_payload>(1);
+    s.run([&]{
+        uint64_t sum=0;
+        for(size_t i=0; i<s.size(); ++i){
+            sum+=std::atomic_load(&shared)->value;
+        }
+        mybench::do_not_optimize(sum);
+    });
+}
+
+// 写者替换共享对象：retire 旧对象，对照组是 std::atomic_store 一个新的 shared_ptr
+void bench_epoch_update(state& s, guarded_tag){
+    std::atomic<epoch_payload*> shared(new_payload(0));
+    mystl::epoch_domain& domain=mystl::epoch_domain::instance();
+    s.run([&]{
+        for(size_t i=0; i<s.size(); ++i){
+            domain.retire(shared.exchange(new_payload(i), std::memory_order_acq_rel));
+        }
+    });
+    domain.retire(shared.load());
+    domain.flush();
+}
+
+void bench_epoch_update(state& s, shared_ptr_tag){
+    std::shared_ptr<epoch_payload> shared=std::make_shared<epoch_payload>(0);
+    s.run([&]{
+        for(size_t i=0; i<s.size(); ++i){
+            std::atomic_store(&shared, std::make_shared<epoch_payload>(i));
+        }
+    });
+}
+
+// 另一个线程在整个基准期间停住（pinned 为 true 时停在 epoch_guard 之内），写者不断替换并回收，
+// 报告等待回收的对象个数的峰值：停在外面时与替换次数无关，停在里面时随替换次数线性增长
+void bench_epoch_stalled(state& s, bool pinned){
+    mystl::epoch_domain& domain=mystl::epoch_domain::instance();
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+    std::thread stalled([&]{
+        if(pinned){
+            mystl::epoch_guard guard;
+            entered.store(true);
+            while(!release.load()){
+                std::this_thread::yield();
+            }
+        }
+        else{
+            entered.store(true);
+            while(!release.load()){
+                std::this_thread::yield();
+            }
+        }
+    });
+    while(!entered.load()){
+        std::this_thread::yield();
+    }
+    std::atomic<epoch_payload*> shared(new_payload(0));
+    size_t peak=0;
+    size_t updates=0;
+    s.run([&]{
+        for(size_t i=0; i<s.size(); ++i){
+            domain.retire(shared.exchange(new_payload(i), std::memory_order_acq_rel));
+        }
+        updates+=s.size();
+        const size_t pending=domain.pending();
+        peak=pending>peak? pending: peak;
+    });
+    release.store(true);
+    stalled.join();
+    domain.retire(shared.load());
+    for(int i=0; i<3; ++i){
+        domain.flush();
+    }
+    s.counter("pending_peak", static_cast<double>(peak));
+    s.counter("retired", static_cast<double>(updates));
+}
+
+const std::vector<size_t> epoch_sizes={1024, 65536};
+
+void register_epoch(){
+    mybench::compare("epoch_read", "u64", [](state& s, auto tag){
+        bench_epoch_read(s, tag);
+    }, guarded_tag(), shared_ptr_tag(), epoch_sizes);
+
+    mybench::add("epoch_read/unprotected/u64", [](state& s){
+        std::atomic<epoch_payload*> shared(new_payload(1));
+        s.run([&]{
+            uint64_t sum=0;
+            for(size_t i=0; i<s.size(); ++i){
+                sum+=shared.load(std::memory_order_acquire)->value;
+                mybench::clobber_memory();
+            }
+            mybench::do_not_optimize(sum);
+        });
+        mystl::epoch_domain::instance().retire(shared.load());
+    }, epoch_sizes);
+
+    mybench::compare("epoch_update", "u64", [](state& s, auto tag){
+        bench_epoch_update(s, tag);
+    }, guarded_tag(), shared_ptr_tag(), epoch_sizes);
+
+    mybench::add("epoch_stalled_unpinned/mystl/u64", [](state& s){
+        bench_epoch_stalled(s, false);
+    }, epoch_sizes);
+
+    mybench::add("epoch_stalled_pinned/mystl/u64", [](state& s){
+        bench_epoch_stalled(s, true);
+    }, epoch_sizes);
+}
+
+} // namespace
+
+void register_concurrent_benchmarks(){
+    register_spsc();
+    register_mpmc();
+    register_hash_map();
+    register_epoch();
+}
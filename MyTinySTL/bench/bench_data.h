@@ -0,0 +1,58 @@
+#ifndef MYTINYSTL_BENCH_BENCH_DATA_H_
+#define MYTINYSTL_BENCH_BENCH_DATA_H_
+
+// 这个头文件包含基准测试用的数据生成函数，同一个下标总是得到同一个值，保证各次运行可比
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mybench
+{
+
+// 整数：乘法散列打乱，避免全是递增序列
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+make_value(size_t i){
+    return static_cast<T>((uint64_t(i)+1)*0x9E3779B97F4A7C15ull>>32);
+}
+
+// 字符串：长度不超过 15，落在 libstdc++ 的短字符串缓冲区内，拷贝不分配内存
+template <class T>
+typename std::enable_if<std::is_same<T, std::string>::value, T>::type
+make_value(size_t i){
+    return "key-"+std::to_string(make_value<uint32_t>(i)%100000000u);
+}
+
+// 不分配内存的非平凡类型：拷贝、移动和析构都是用户提供的，容器和 uninitialized_* 只能逐个构造
+struct nontrivial
+{
+    double x, y, z;
+
+    nontrivial() noexcept: x(0), y(0), z(0) {}
+    explicit nontrivial(double v) noexcept: x(v), y(v+1), z(v+2) {}
+    nontrivial(const nontrivial& rhs) noexcept: x(rhs.x), y(rhs.y), z(rhs.z) {}
+    nontrivial& operator=(const nontrivial& rhs) noexcept { x=rhs.x; y=rhs.y; z=rhs.z; return *this; }
+    ~nontrivial() {}
+};
+
+template <class T>
+typename std::enable_if<std::is_same<T, nontrivial>::value, T>::type
+make_value(size_t i){
+    return nontrivial(static_cast<double>(make_value<uint32_t>(i)));
+}
+
+template <class T>
+std::vector<T> make_data(size_t n){
+    std::vector<T> v;
+    v.reserve(n);
+    for(size_t i=0; i<n; ++i){
+        v.push_back(make_value<T>(i));
+    }
+    return v;
+}
+
+} // namespace mybench
+
+#endif
@@ -0,0 +1,150 @@
+// 过滤器的基准：blocked_bloom_filter、cuckoo_filter 与精确的 std::unordered_set 对比查询吞吐
+    // size() 是插入的键数；每次查询一批随机顺序的键，一半插入过、一半没有，访问模式是随机的
+    // 过滤器一侧额外报告测得的假阳性率 fpr、理论值 fpr_theory 和每个键占用的位数 bits_per_key
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "../filter.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+const std::vector<size_t> filter_sizes={16384, 262144, 4194304};
+
+// 每次 run 查询的键数
+constexpr size_t query_count=65536;
+
+uint64_t next_key(uint64_t& seed){
+    seed=seed*6364136223846793005ull+1442695040888963407ull;
+    return seed^(seed >> 29);
+}
+
+// 测假阳性率用的键数：布谷鸟过滤器的假阳性率在 1e-4 以下，需要上百万次查询才能数到几十次
+constexpr size_t fpp_sample=1 << 20;
+
+// 过滤器报告测得的假阳性率、理论值和每个键占用的位数；随机的 64 位键与插入的键重复的概率可以忽略
+template <class Set>
+void report_fpp(state& s, const Set& set, double bits_per_key){
+    uint64_t seed=~uint64_t(0);
+    size_t hits=0;
+    for(size_t i=0; i<fpp_sample; ++i){
+        hits+=set.contains(next_key(seed));
+    }
+    s.counter("fpr", static_cast<double>(hits)/fpp_sample);
+    s.counter("fpr_theory", set.expected_fpp());
+    s.counter("bits_per_key", bits_per_key);
+}
+
+// 布隆过滤器，目标假阳性率 1%
+struct bloom_tag
+{
+    typedef mystl::blocked_bloom_filter<uint64_t> set_type;
+
+    static std::unique_ptr<set_type> make(const std::vector<uint64_t>& keys){
+        std::unique_ptr<set_type> s(new set_type(keys.size(), 0.01));
+        s->insert(keys.begin(), keys.end());
+        return s;
+    }
+    static bool contains(const set_type& s, uint64_t k) { return s.contains(k); }
+    static void contains_batch(const set_type& s, const uint64_t* keys, size_t n, bool* out){
+        s.contains_batch(keys, n, out);
+    }
+    static void report(state& s, const set_type& set){
+        report_fpp(s, set, static_cast<double>(set.bit_count())/set.size());
+    }
+};
+
+struct cuckoo_tag
+{
+    typedef mystl::cuckoo_filter<uint64_t> set_type;
+
+    static std::unique_ptr<set_type> make(const std::vector<uint64_t>& keys){
+        std::unique_ptr<set_type> s(new set_type(keys.size()));
+        for(uint64_t k: keys){
+            s->insert(k);
+        }
+        return s;
+    }
+    static bool contains(const set_type& s, uint64_t k) { return s.contains(k); }
+    static void contains_batch(const set_type& s, const uint64_t* keys, size_t n, bool* out){
+        s.contains_batch(keys, n, out);
+    }
+    static void report(state& s, const set_type& set){
+        report_fpp(s, set, 64.0*set.bucket_count()/set.size());
+    }
+};
+
+// 精确的集合：没有假阳性，批量查询就是逐个查询
+struct std_tag
+{
+    typedef std::unordered_set<uint64_t> set_type;
+
+    static std::unique_ptr<set_type> make(const std::vector<uint64_t>& keys){
+        return std::unique_ptr<set_type>(new set_type(keys.begin(), keys.end()));
+    }
+    static bool contains(const set_type& s, uint64_t k) { return s.count(k)!=0; }
+    static void contains_batch(const set_type& s, const uint64_t* keys, size_t n, bool* out){
+        for(size_t i=0; i<n; ++i){
+            out[i]=s.count(keys[i])!=0;
+        }
+    }
+    static void report(state&, const set_type&) {}
+};
+
+// 插入 size() 个随机键；查询的键一半取自插入的键、一半是新的随机键，顺序随机
+template <class Tag>
+void bench_contains(state& s, Tag, bool batch){
+    uint64_t seed=s.size();
+    std::vector<uint64_t> keys(s.size()), queries(query_count);
+    for(uint64_t& k: keys){
+        k=next_key(seed);
+    }
+    for(uint64_t& q: queries){
+        const uint64_t r=next_key(seed);
+        q=(r & 1) ? keys[(r >> 1)%keys.size()] : next_key(seed);
+    }
+    auto set=Tag::make(keys);
+    Tag::report(s, *set);
+    std::unique_ptr<bool[]> out(new bool[query_count]);
+    s.set_items(query_count);
+    if(batch){
+        s.run([&]{
+            Tag::contains_batch(*set, queries.data(), query_count, out.get());
+            mybench::clobber_memory();
+        });
+    }
+    else{
+        s.run([&]{
+            size_t hits=0;
+            for(uint64_t k: queries){
+                hits+=Tag::contains(*set, k);
+            }
+            mybench::do_not_optimize(hits);
+        });
+    }
+}
+
+} // namespace
+
+void register_filter_benchmarks(){
+    mybench::compare("bloom_filter_contains", "u64", [](state& s, auto tag){
+        bench_contains(s, tag, false);
+    }, bloom_tag(), std_tag(), filter_sizes);
+
+    mybench::compare("bloom_filter_contains_batch", "u64", [](state& s, auto tag){
+        bench_contains(s, tag, true);
+    }, bloom_tag(), std_tag(), filter_sizes);
+
+    mybench::compare("cuckoo_filter_contains", "u64", [](state& s, auto tag){
+        bench_contains(s, tag, false);
+    }, cuckoo_tag(), std_tag(), filter_sizes);
+
+    mybench::compare("cuckoo_filter_contains_batch", "u64", [](state& s, auto tag){
+        bench_contains(s, tag, true);
+    }, cuckoo_tag(), std_tag(), filter_sizes);
+}
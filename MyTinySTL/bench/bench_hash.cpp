@@ -0,0 +1,91 @@
+// 哈希的基准：mystl::hash_bytes 与 std::hash<std::string_view>（libstdc++ 中是 MurmurHash2 的变体）对比
+    // hash_bytes 的 size() 是键的字节数，每次 run 哈希缓冲区中不同位置的 keys_per_run 个键
+    // hash_u64_batch 的 size() 是键数；std::hash 对整数是恒等映射，对照组按 8 字节的字节序列哈希，
+    // 这是标准库中能得到充分混合的整数哈希值的方式；MYSTL_ISA=scalar 可以得到不向量化时的耗时
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "../hash.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+const std::vector<size_t> key_lengths={4, 8, 16, 32, 64, 256, 1024, 4096};
+const std::vector<size_t> batch_sizes={1024, 65536};
+
+constexpr size_t keys_per_run=256;
+
+struct mystl_tag
+{
+    static uint64_t bytes(const unsigned char* p, size_t n) { return mystl::hash_bytes(p, n); }
+    static void batch(const uint64_t* keys, size_t n, uint64_t* out) { mystl::hash_u64_batch(keys, n, out); }
+};
+
+struct std_tag
+{
+    static uint64_t bytes(const unsigned char* p, size_t n){
+        return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char*>(p), n));
+    }
+    static void batch(const uint64_t* keys, size_t n, uint64_t* out){
+        for(size_t i=0; i<n; ++i){
+            out[i]=bytes(reinterpret_cast<const unsigned char*>(keys+i), sizeof(uint64_t));
+        }
+    }
+};
+
+std::vector<unsigned char> random_bytes(size_t n){
+    std::vector<unsigned char> v(n);
+    uint64_t x=n;
+    for(unsigned char& c: v){
+        x=x*6364136223846793005ull+1442695040888963407ull;
+        c=static_cast<unsigned char>(x >> 56);
+    }
+    return v;
+}
+
+// 1.按键长的吞吐：键首尾相接地排在缓冲区中，每个键只读一次
+template <class Tag>
+void bench_bytes(state& s, Tag){
+    const size_t len=s.size();
+    const std::vector<unsigned char> buffer=random_bytes(len*keys_per_run);
+    s.set_items(keys_per_run);
+    s.set_bytes_per_item(len);
+    s.run([&]{
+        uint64_t sum=0;
+        for(size_t i=0; i<keys_per_run; ++i){
+            sum+=Tag::bytes(buffer.data()+i*len, len);
+        }
+        mybench::do_not_optimize(sum);
+    });
+}
+
+// 2.一批整数键的哈希值，写入输出数组
+template <class Tag>
+void bench_batch(state& s, Tag){
+    std::vector<uint64_t> keys(s.size()), out(s.size());
+    for(size_t i=0; i<keys.size(); ++i){
+        keys[i]=i*0x9e3779b97f4a7c15ull;
+    }
+    s.set_items(s.size());
+    s.run([&]{
+        Tag::batch(keys.data(), keys.size(), out.data());
+        mybench::clobber_memory();
+    });
+}
+
+} // namespace
+
+void register_hash_benchmarks(){
+    mybench::compare("hash_bytes", "bytes", [](state& s, auto tag){
+        bench_bytes(s, tag);
+    }, mystl_tag(), std_tag(), key_lengths);
+
+    mybench::compare("hash_u64_batch", "u64", [](state& s, auto tag){
+        bench_batch(s, tag);
+    }, mystl_tag(), std_tag(), batch_sizes);
+}
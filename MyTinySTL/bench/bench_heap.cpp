@@ -0,0 +1,184 @@
+// 优先队列的基准：mystl::priority_queue 按叉数 2、4、8 与 std::priority_queue（二叉堆）对比
+    // size() 是队列中的元素个数，元素为 8 字节整数
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "../priority_queue.h"
+#include "bench.h"
+#include "bench_data.h"
+
+namespace
+{
+
+using mybench::state;
+
+template <size_t Arity>
+struct mystl_queue
+{
+    typedef mystl::priority_queue<uint64_t, mystl::greater<uint64_t>, Arity> type;
+};
+
+struct std_queue
+{
+    typedef std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> type;
+};
+
+const std::vector<size_t> queue_sizes={1024, 65536, 1048576};
+
+// 每次计时的操作次数，与队列大小无关
+const size_t hold_ops=4096;
+
+template <class Q>
+Q make_queue(size_t n){
+    Q q;
+    for(size_t i=0; i<n; ++i){
+        q.push(mybench::make_value<uint64_t>(i));
+    }
+    return q;
+}
+
+// 1.hold 模型（事件驱动模拟、定时器）：取出最早的事件，加上一个随机的间隔后放回，队列大小不变
+template <class Q>
+void bench_hold(state& s){
+    Q q=make_queue<Q>(s.size());
+    uint64_t x=1;
+    s.set_items(hold_ops);
+    s.run([&]{
+        for(size_t i=0; i<hold_ops; ++i){
+            const uint64_t t=q.top();
+            q.pop();
+            x=x*6364136223846793005ull+1442695040888963407ull;
+            q.push(t+(x>>40));
+        }
+        mybench::do_not_optimize(q.top());
+    });
+}
+
+// 2.全部放入后全部取出，相当于一次堆排序
+template <class Q>
+void bench_fill_drain(state& s){
+    const std::vector<uint64_t> data=mybench::make_data<uint64_t>(s.size());
+    s.set_bytes_per_item(sizeof(uint64_t));
+    s.run([&]{
+        Q q;
+        for(uint64_t v: data){
+            q.push(v);
+        }
+        uint64_t sum=0;
+        while(!q.empty()){
+            sum+=q.top();
+            q.pop();
+        }
+        mybench::do_not_optimize(sum);
+    });
+}
+
+// 3.Dijkstra：size() 个顶点、每个顶点 8 条出边的随机图
+    // mystl 用 indexed_priority_queue 的 decrease_key，std 用常见的“重复放入、取出时跳过过期项”
+struct graph
+{
+    std::vector<uint32_t> offsets;      // 顶点 u 的边为 [offsets[u], offsets[u+1])
+    std::vector<uint32_t> to;
+    std::vector<uint32_t> weight;
+};
+
+graph make_graph(size_t n){
+    const size_t degree=8;
+    graph g;
+    g.offsets.resize(n+1);
+    uint64_t x=42;
+    for(size_t u=0; u<n; ++u){
+        g.offsets[u]=static_cast<uint32_t>(u*degree);
+        for(size_t k=0; k<degree; ++k){
+            x=x*6364136223846793005ull+1442695040888963407ull;
+            g.to.push_back(static_cast<uint32_t>((x>>33)%n));
+            g.weight.push_back(static_cast<uint32_t>(1+(x>>20)%1000));
+        }
+    }
+    g.offsets[n]=static_cast<uint32_t>(n*degree);
+    return g;
+}
+
+template <size_t Arity>
+struct indexed_tag {};
+
+template <size_t Arity>
+uint64_t shortest_paths(indexed_tag<Arity>, const graph& g, std::vector<uint64_t>& dist){
+    mystl::indexed_priority_queue<uint64_t, mystl::greater<uint64_t>, Arity> q(dist.size());
+    dist[0]=0;
+    q.push(0, 0);
+    while(!q.empty()){
+        const uint32_t u=static_cast<uint32_t>(q.top());
+        q.pop();
+        for(uint32_t e=g.offsets[u]; e<g.offsets[u+1]; ++e){
+            const uint64_t d=dist[u]+g.weight[e];
+            const uint32_t v=g.to[e];
+            if(d<dist[v]){
+                dist[v]=d;
+                q.update(v, d);
+            }
+        }
+    }
+    return dist.back();
+}
+
+uint64_t shortest_paths(std_queue, const graph& g, std::vector<uint64_t>& dist){
+    typedef std::pair<uint64_t, uint32_t> item;
+    std::priority_queue<item, std::vector<item>, std::greater<item>> q;
+    dist[0]=0;
+    q.push(item(0, 0));
+    while(!q.empty()){
+        const item top=q.top();
+        q.pop();
+        if(top.first!=dist[top.second]){
+            continue;
+        }
+        const uint32_t u=top.second;
+        for(uint32_t e=g.offsets[u]; e<g.offsets[u+1]; ++e){
+            const uint64_t d=dist[u]+g.weight[e];
+            const uint32_t v=g.to[e];
+            if(d<dist[v]){
+                dist[v]=d;
+                q.push(item(d, v));
+            }
+        }
+    }
+    return dist.back();
+}
+
+template <class Tag>
+void bench_dijkstra(state& s, Tag tag){
+    const graph g=make_graph(s.size());
+    std::vector<uint64_t> dist(s.size());
+    s.run([&]{
+        std::fill(dist.begin(), dist.end(), ~uint64_t(0));
+        mybench::do_not_optimize(shortest_paths(tag, g, dist));
+    });
+}
+
+template <size_t Arity>
+void register_arity(){
+    const std::string type="u64-d"+std::to_string(Arity);
+    mybench::compare("pq_hold", type, [](state& s, auto tag){
+        bench_hold<typename decltype(tag)::type>(s);
+    }, mystl_queue<Arity>(), std_queue(), queue_sizes);
+
+    mybench::compare("pq_fill_drain", type, [](state& s, auto tag){
+        bench_fill_drain<typename decltype(tag)::type>(s);
+    }, mystl_queue<Arity>(), std_queue(), queue_sizes);
+
+    mybench::compare("pq_dijkstra", type, [](state& s, auto tag){
+        bench_dijkstra(s, tag);
+    }, indexed_tag<Arity>(), std_queue(), std::vector<size_t>{1024, 65536, 262144});
+}
+
+} // namespace
+
+void register_heap_benchmarks(){
+    register_arity<2>();
+    register_arity<4>();
+    register_arity<8>();
+}
@@ -0,0 +1,32 @@
+// 基准测试入口：注册各模块的基准后交给框架运行
+    // 用法见 mybench --help，如 mybench --filter=copy --json=result.json
+#include "bench.h"
+
+void register_algorithm_benchmarks();
+void register_uninitialized_benchmarks();
+void register_memory_benchmarks();
+void register_numeric_benchmarks();
+void register_concurrent_benchmarks();
+void register_string_benchmarks();
+void register_heap_benchmarks();
+void register_slot_map_benchmarks();
+void register_soa_benchmarks();
+void register_bitset_benchmarks();
+void register_filter_benchmarks();
+void register_hash_benchmarks();
+
+int main(int argc, char** argv){
+    register_algorithm_benchmarks();
+    register_uninitialized_benchmarks();
+    register_memory_benchmarks();
+    register_numeric_benchmarks();
+    register_concurrent_benchmarks();
+    register_string_benchmarks();
+    register_heap_benchmarks();
+    register_slot_map_benchmarks();
+    register_soa_benchmarks();
+    register_bitset_benchmarks();
+    register_filter_benchmarks();
+    register_hash_benchmarks();
+    return mybench::run_main(argc, argv);
+}
@@ -0,0 +1,160 @@
+// memory.h 中的智能指针和 intrusive.h 中的侵入式容器与 std:: 对应实现的对比
+    // 报告中的 allocs 一列给出每次调用的 operator new 次数
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "../intrusive.h"
+#include "../list.h"
+#include "../memory.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+struct payload
+{
+    long a, b, c;
+    payload(): a(1), b(2), c(3) {}
+};
+
+struct ref_payload: mystl::intrusive_ref_counter<ref_payload>
+{
+    long a, b, c;
+    ref_payload(): a(1), b(2), c(3) {}
+};
+
+struct hooked: mystl::list_base_hook<>
+{
+    long value;
+};
+
+const std::vector<size_t> ptr_sizes={1024};
+
+// 创建 size() 个对象再全部销毁：比较分配次数和耗时
+template <class Make>
+void bench_make(state& s, Make make){
+    std::vector<decltype(make())> v;
+    v.reserve(s.size());
+    s.run([&]{
+        for(size_t i=0; i<s.size(); ++i){
+            v.push_back(make());
+        }
+        v.clear();
+    });
+}
+
+// 拷贝 size() 份再全部销毁：每次拷贝一次原子加、销毁一次原子减
+template <class Ptr>
+void bench_copy(state& s, const Ptr& p){
+    std::vector<Ptr> v;
+    v.reserve(s.size());
+    s.run([&]{
+        for(size_t i=0; i<s.size(); ++i){
+            v.push_back(p);
+        }
+        v.clear();
+    });
+}
+
+void register_smart_pointer(){
+    mybench::add("make_shared/std/payload", [](state& s){
+        bench_make(s, []{ return std::make_shared<payload>(); });
+    }, ptr_sizes);
+    mybench::add("make_shared/mystl/payload", [](state& s){
+        bench_make(s, []{ return mystl::make_shared<payload>(); });
+    }, ptr_sizes);
+    mybench::add("shared_ptr_new/std/payload", [](state& s){
+        bench_make(s, []{ return std::shared_ptr<payload>(new payload()); });
+    }, ptr_sizes);
+    mybench::add("shared_ptr_new/mystl/payload", [](state& s){
+        bench_make(s, []{ return mystl::shared_ptr<payload>(new payload()); });
+    }, ptr_sizes);
+    mybench::add("allocate_shared/mystl/payload", [](state& s){
+        bench_make(s, []{ return mystl::allocate_shared<payload>(mystl::allocator<payload>()); });
+    }, ptr_sizes);
+    mybench::add("make_unique/std/payload", [](state& s){
+        bench_make(s, []{ return std::make_unique<payload>(); });
+    }, ptr_sizes);
+    mybench::add("make_unique/mystl/payload", [](state& s){
+        bench_make(s, []{ return mystl::make_unique<payload>(); });
+    }, ptr_sizes);
+    // 控制块来自线程局部内存池，不调用 operator new
+    mybench::add("make_shared/mystl_local/payload", [](state& s){
+        bench_make(s, []{ return mystl::make_local_shared<payload>(); });
+    }, ptr_sizes);
+    mybench::add("make_shared/mystl_intrusive/payload", [](state& s){
+        bench_make(s, []{ return mystl::make_intrusive<ref_payload>(); });
+    }, ptr_sizes);
+
+    mybench::add("ptr_copy/raw/payload", [](state& s){
+        payload obj;
+        bench_copy(s, &obj);
+    }, ptr_sizes);
+    mybench::add("ptr_copy/std/payload", [](state& s){
+        bench_copy(s, std::make_shared<payload>());
+    }, ptr_sizes);
+    mybench::add("ptr_copy/mystl/payload", [](state& s){
+        bench_copy(s, mystl::make_shared<payload>());
+    }, ptr_sizes);
+    mybench::add("ptr_copy/mystl_local/payload", [](state& s){
+        bench_copy(s, mystl::make_local_shared<payload>());
+    }, ptr_sizes);
+    mybench::add("ptr_copy/mystl_intrusive/payload", [](state& s){
+        bench_copy(s, mystl::make_intrusive<ref_payload>());
+    }, ptr_sizes);
+
+    // 移动不触碰引用计数
+    mybench::add("ptr_move/mystl/payload", [](state& s){
+        mystl::shared_ptr<payload> sp=mystl::make_shared<payload>();
+        s.run([&]{
+            for(size_t i=0; i<s.size(); ++i){
+                mystl::shared_ptr<payload> q(mystl::move(sp));
+                sp=mystl::move(q);
+                mybench::do_not_optimize(sp);
+            }
+        });
+    }, ptr_sizes);
+}
+
+// 在链表尾部插入、再从头部删除 size() 次
+void register_list_churn(){
+    mybench::add("list_churn/std/long", [](state& s){
+        std::list<long> l;
+        s.run([&]{
+            for(size_t i=0; i<s.size(); ++i){
+                l.push_back(long(i));
+                l.pop_front();
+            }
+        });
+    }, ptr_sizes);
+    mybench::add("list_churn/mystl/long", [](state& s){
+        mystl::list<long> l;
+        s.run([&]{
+            for(size_t i=0; i<s.size(); ++i){
+                l.push_back(long(i));
+                l.pop_front();
+            }
+        });
+    }, ptr_sizes);
+    // 对象已经存在（如对象池中的元素），只比较挂入/摘下链表的开销
+    mybench::add("list_churn/mystl_intrusive/long", [](state& s){
+        std::vector<hooked> objects(s.size());
+        mystl::intrusive_list<hooked> l;
+        s.run([&]{
+            for(size_t i=0; i<s.size(); ++i){
+                l.push_back(objects[i]);
+                l.pop_front();
+            }
+        });
+    }, ptr_sizes);
+}
+
+} // namespace
+
+void register_memory_benchmarks(){
+    register_smart_pointer();
+    register_list_churn();
+}
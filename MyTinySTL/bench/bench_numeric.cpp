@@ -0,0 +1,79 @@
+// numeric.h 中 accumulate、reduce 与 std:: 对应算法的对比
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "../numeric.h"
+#include "bench.h"
+#include "bench_data.h"
+
+namespace
+{
+
+using mybench::state;
+
+// 求和用的数据：有符号整数限制在 [-1024, 1024) 内，其他类型与 make_data 相同
+    // libstdc++ 的 std::reduce 先把相邻的元素按元素类型两两相加再并入 init，
+    // 全范围的 int 在这一步就会有符号溢出（未定义行为），即使 Acc 是 64 位
+template <class T>
+std::vector<T> make_sum_data(size_t n){
+    std::vector<T> v=mybench::make_data<T>(n);
+    if(std::is_integral<T>::value && std::is_signed<T>::value){
+        for(size_t i=0; i<n; ++i){
+            v[i]=static_cast<T>(static_cast<int>(mybench::make_value<uint32_t>(i)%2048)-1024);
+        }
+    }
+    return v;
+}
+
+// 1.accumulate 和顺序的 reduce：整数区间走求和内核，浮点数与 std 一样逐个累加
+    // Acc 是累加结果的类型，窄元素累加到较宽的类型中是分析代码中常见的写法
+template <class T, class Acc>
+void register_sum_family(const char* type){
+    mybench::compare("accumulate", type, [](state& s, auto accumulate){
+        const auto a=make_sum_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(accumulate(a.data(), a.data()+a.size(), Acc(0))); });
+    }, MYBENCH_FN(mystl::accumulate), MYBENCH_FN(std::accumulate));
+
+    // std::reduce 允许重新结合，libstdc++ 在随机访问迭代器上 4 路展开
+    mybench::compare("reduce", type, [](state& s, auto reduce){
+        const auto a=make_sum_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(reduce(a.data(), a.data()+a.size(), Acc(0))); });
+    }, MYBENCH_FN(mystl::reduce), MYBENCH_FN(std::reduce));
+}
+
+// 2.树形和并行的 reduce，与不带策略的 std::reduce 对比
+template <class T>
+void register_policy_family(const char* type){
+    auto std_reduce=[](const T* first, const T* last, T init){ return std::reduce(first, last, init); };
+
+    mybench::compare("reduce_unseq", type, [](state& s, auto reduce){
+        const auto a=make_sum_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(reduce(a.data(), a.data()+a.size(), T(0))); });
+    }, [](const T* first, const T* last, T init){ return mystl::reduce(mystl::execution::unseq, first, last, init); },
+       std_reduce);
+
+    mybench::compare("reduce_par", type, [](state& s, auto reduce){
+        const auto a=make_sum_data<T>(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{ mybench::do_not_optimize(reduce(a.data(), a.data()+a.size(), T(0))); });
+    }, [](const T* first, const T* last, T init){ return mystl::reduce(mystl::execution::par, first, last, init); },
+       std_reduce, std::vector<size_t>{4096, 65536, 1048576, 16777216});
+}
+
+} // namespace
+
+void register_numeric_benchmarks(){
+    register_sum_family<uint8_t, uint64_t>("u8");
+    register_sum_family<int, int64_t>("int");
+    register_sum_family<uint64_t, uint64_t>("u64");
+    register_sum_family<float, float>("float");
+    register_sum_family<double, double>("double");
+    register_policy_family<int64_t>("i64");
+    register_policy_family<float>("float");
+    register_policy_family<double>("double");
+}
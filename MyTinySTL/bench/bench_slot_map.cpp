@@ -0,0 +1,167 @@
+// slot_map 的基准：与节点式的 std::unordered_map（键为递增的编号）对比
+    // 元素是 32 字节的“实体”，size() 是存活的实体个数
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../slot_map.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+struct entity
+{
+    float pos[3];
+    float vel[3];
+    uint32_t id;
+    uint32_t flags;
+};
+
+entity make_entity(uint32_t id){
+    const float f=static_cast<float>(id%1000);
+    return entity{{f, f, f}, {0.5f, 0.25f, 0.125f}, id, 0};
+}
+
+const std::vector<size_t> map_sizes={1024, 65536, 1048576};
+
+// 每次计时的操作次数，与实体个数无关
+const size_t churn_ops=4096;
+
+// 两种容器的统一接口：insert 返回键，erase/find 按键操作
+struct slot_map_tag
+{
+    typedef mystl::slot_map<entity> container;
+    typedef mystl::slot_handle key;
+
+    static key insert(container& c, uint32_t id) { return c.insert(make_entity(id)); }
+    static void erase(container& c, key k) { c.erase(k); }
+    static entity* find(container& c, key k) { return c.find(k); }
+};
+
+struct node_map_tag
+{
+    // 递增的编号作为键，与 slot_map 的句柄一样不会重复
+    struct container
+    {
+        std::unordered_map<uint32_t, entity> map;
+        uint32_t next=0;
+    };
+    typedef uint32_t key;
+
+    static key insert(container& c, uint32_t id){
+        const key k=c.next++;
+        c.map.emplace(k, make_entity(id));
+        return k;
+    }
+    static void erase(container& c, key k) { c.map.erase(k); }
+    static entity* find(container& c, key k){
+        auto it=c.map.find(k);
+        return it==c.map.end()? nullptr: &it->second;
+    }
+};
+
+// 遍历所有实体，pos+=vel
+void integrate(entity& e){
+    e.pos[0]+=e.vel[0];
+    e.pos[1]+=e.vel[1];
+    e.pos[2]+=e.vel[2];
+}
+
+void iterate_all(slot_map_tag::container& c){
+    for(entity& e: c){
+        integrate(e);
+    }
+}
+
+void iterate_all(node_map_tag::container& c){
+    for(auto& kv: c.map){
+        integrate(kv.second);
+    }
+}
+
+// 先插入 n 个实体，再随机删除、插入各一半，使存储处于多次复用后的状态
+template <class Tag>
+void populate(typename Tag::container& c, std::vector<typename Tag::key>& keys, size_t n){
+    uint64_t x=7;
+    for(size_t i=0; i<n; ++i){
+        keys.push_back(Tag::insert(c, static_cast<uint32_t>(i)));
+    }
+    for(size_t i=0; i<n/2; ++i){
+        x=x*6364136223846793005ull+1442695040888963407ull;
+        const size_t k=(x>>33)%keys.size();
+        Tag::erase(c, keys[k]);
+        keys[k]=Tag::insert(c, static_cast<uint32_t>(n+i));
+    }
+}
+
+// 1.遍历：实体系统每帧更新所有实体
+template <class Tag>
+void bench_iterate(state& s, Tag){
+    typename Tag::container c;
+    std::vector<typename Tag::key> keys;
+    populate<Tag>(c, keys, s.size());
+    s.set_items(s.size());
+    s.set_bytes_per_item(sizeof(entity));
+    s.run([&]{
+        iterate_all(c);
+        mybench::clobber_memory();
+    });
+}
+
+// 2.按键随机查找
+template <class Tag>
+void bench_lookup(state& s, Tag){
+    typename Tag::container c;
+    std::vector<typename Tag::key> keys;
+    populate<Tag>(c, keys, s.size());
+    uint64_t x=11;
+    s.set_items(churn_ops);
+    s.run([&]{
+        float sum=0;
+        for(size_t i=0; i<churn_ops; ++i){
+            x=x*6364136223846793005ull+1442695040888963407ull;
+            sum+=Tag::find(c, keys[(x>>33)%keys.size()])->pos[0];
+        }
+        mybench::do_not_optimize(sum);
+    });
+}
+
+// 3.短生命周期实体的进出：删除一个随机实体，插入一个新实体，实体个数不变
+template <class Tag>
+void bench_churn(state& s, Tag){
+    typename Tag::container c;
+    std::vector<typename Tag::key> keys;
+    populate<Tag>(c, keys, s.size());
+    uint64_t x=13;
+    uint32_t id=0;
+    s.set_items(churn_ops);
+    s.run([&]{
+        for(size_t i=0; i<churn_ops; ++i){
+            x=x*6364136223846793005ull+1442695040888963407ull;
+            const size_t k=(x>>33)%keys.size();
+            Tag::erase(c, keys[k]);
+            keys[k]=Tag::insert(c, id++);
+        }
+        mybench::clobber_memory();
+    });
+}
+
+} // namespace
+
+void register_slot_map_benchmarks(){
+    mybench::compare("slot_map_iterate", "entity32", [](state& s, auto tag){
+        bench_iterate(s, tag);
+    }, slot_map_tag(), node_map_tag(), map_sizes);
+
+    mybench::compare("slot_map_lookup", "entity32", [](state& s, auto tag){
+        bench_lookup(s, tag);
+    }, slot_map_tag(), node_map_tag(), map_sizes);
+
+    mybench::compare("slot_map_churn", "entity32", [](state& s, auto tag){
+        bench_churn(s, tag);
+    }, slot_map_tag(), node_map_tag(), map_sizes);
+}
@@ -0,0 +1,190 @@
+// soa_vector 的基准：与结构体数组 std::vector<particle>（AoS）对比
+    // 粒子有 8 个 4 字节的成员，AoS 中一个粒子占 32 字节；size() 是粒子个数
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../numeric.h"
+#include "../soa_vector.h"
+#include "bench.h"
+
+namespace
+{
+
+using mybench::state;
+
+struct particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    uint32_t id;
+};
+
+const std::vector<size_t> particle_sizes={1024, 65536, 1048576};
+
+struct soa_tag
+{
+    // 列的顺序与 particle 的成员相同
+    typedef mystl::soa_vector<float, float, float, float, float, float, float, uint32_t> container;
+    enum { X, Y, Z, VX, VY, VZ, MASS, ID };
+
+    static void add(container& c, const particle& p){
+        c.emplace_back(p.x, p.y, p.z, p.vx, p.vy, p.vz, p.mass, p.id);
+    }
+};
+
+struct aos_tag
+{
+    typedef std::vector<particle> container;
+
+    static void add(container& c, const particle& p) { c.push_back(p); }
+};
+
+template <class Tag>
+typename Tag::container make_particles(size_t n){
+    typename Tag::container c;
+    for(size_t i=0; i<n; ++i){
+        const float f=static_cast<float>(i%1000);
+        Tag::add(c, particle{f, f+1, f+2, 0.5f, 0.25f, 0.125f, 1.0f+f, static_cast<uint32_t>(i)});
+    }
+    return c;
+}
+
+// 1.只读一个整数成员：两边是同一个标量循环，差别只在访问的字节数
+uint64_t sum_ids(const soa_tag::container& c){
+    const uint32_t* id=c.data<soa_tag::ID>();
+    uint64_t sum=0;
+    for(size_t i=0; i<c.size(); ++i){
+        sum+=id[i];
+    }
+    return sum;
+}
+
+uint64_t sum_ids(const aos_tag::container& c){
+    uint64_t sum=0;
+    for(size_t i=0; i<c.size(); ++i){
+        sum+=c[i].id;
+    }
+    return sum;
+}
+
+template <class Tag>
+void bench_scan_field(state& s, Tag){
+    const typename Tag::container c=make_particles<Tag>(s.size());
+    s.set_items(s.size());
+    s.set_bytes_per_item(sizeof(uint32_t));
+    s.run([&]{
+        mybench::do_not_optimize(sum_ids(c));
+    });
+}
+
+// 2.只读一个浮点成员求和：SoA 把列的 span 交给向量化的 mystl::reduce，AoS 只能逐个累加
+float total_mass(const soa_tag::container& c){
+    const auto mass=c.column<soa_tag::MASS>();
+    return mystl::reduce(mass.begin(), mass.end());
+}
+
+float total_mass(const aos_tag::container& c){
+    float sum=0;
+    for(const particle& p: c){
+        sum+=p.mass;
+    }
+    return sum;
+}
+
+template <class Tag>
+void bench_reduce_field(state& s, Tag){
+    const typename Tag::container c=make_particles<Tag>(s.size());
+    s.set_items(s.size());
+    s.set_bytes_per_item(sizeof(float));
+    s.run([&]{
+        mybench::do_not_optimize(total_mass(c));
+    });
+}
+
+// 3.读两列写一列：x+=vx，两边都是可以向量化的循环，AoS 需要跨步访问
+void advance_x(soa_tag::container& c){
+    float* x=c.data<soa_tag::X>();
+    const float* vx=c.data<soa_tag::VX>();
+    for(size_t i=0; i<c.size(); ++i){
+        x[i]+=vx[i];
+    }
+}
+
+void advance_x(aos_tag::container& c){
+    for(particle& p: c){
+        p.x+=p.vx;
+    }
+}
+
+template <class Tag>
+void bench_update_field(state& s, Tag){
+    typename Tag::container c=make_particles<Tag>(s.size());
+    s.set_items(s.size());
+    s.set_bytes_per_item(2*sizeof(float));
+    s.run([&]{
+        advance_x(c);
+        mybench::clobber_memory();
+    });
+}
+
+// 4.整行访问：通过代理迭代器读所有成员，SoA 不占优势，衡量代理迭代器的开销
+float energy(const soa_tag::container& c){
+    float e=0;
+    for(auto row: c){
+        const float vx=std::get<soa_tag::VX>(row), vy=std::get<soa_tag::VY>(row), vz=std::get<soa_tag::VZ>(row);
+        e+=std::get<soa_tag::MASS>(row)*(vx*vx+vy*vy+vz*vz)+std::get<soa_tag::X>(row)*0.0f;
+    }
+    return e;
+}
+
+float energy(const aos_tag::container& c){
+    float e=0;
+    for(const particle& p: c){
+        e+=p.mass*(p.vx*p.vx+p.vy*p.vy+p.vz*p.vz)+p.x*0.0f;
+    }
+    return e;
+}
+
+template <class Tag>
+void bench_whole_row(state& s, Tag){
+    const typename Tag::container c=make_particles<Tag>(s.size());
+    s.set_items(s.size());
+    s.run([&]{
+        mybench::do_not_optimize(energy(c));
+    });
+}
+
+// 5.逐个追加：SoA 每列各写一次，扩容时逐列搬移
+template <class Tag>
+void bench_build(state& s, Tag){
+    s.set_items(s.size());
+    s.run([&]{
+        mybench::do_not_optimize(make_particles<Tag>(s.size()).size());
+    });
+}
+
+} // namespace
+
+void register_soa_benchmarks(){
+    mybench::compare("soa_scan_field", "u32", [](state& s, auto tag){
+        bench_scan_field(s, tag);
+    }, soa_tag(), aos_tag(), particle_sizes);
+
+    mybench::compare("soa_reduce_field", "float", [](state& s, auto tag){
+        bench_reduce_field(s, tag);
+    }, soa_tag(), aos_tag(), particle_sizes);
+
+    mybench::compare("soa_update_field", "float", [](state& s, auto tag){
+        bench_update_field(s, tag);
+    }, soa_tag(), aos_tag(), particle_sizes);
+
+    mybench::compare("soa_whole_row", "float", [](state& s, auto tag){
+        bench_whole_row(s, tag);
+    }, soa_tag(), aos_tag(), particle_sizes);
+
+    mybench::compare("soa_build", "particle", [](state& s, auto tag){
+        bench_build(s, tag);
+    }, soa_tag(), aos_tag(), particle_sizes);
+}
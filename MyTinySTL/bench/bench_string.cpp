@@ -0,0 +1,237 @@
+// 字符串的基准：mystl::string 与 std::string 对比，以短键为主
+    // key15 的长度不超过 15，两者都放在对象内；key22 的长度在 16 到 22 之间，只有 mystl::string 不分配内存
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../basic_string.h"
+#include "../string_view.h"
+#include "bench.h"
+#include "bench_data.h"
+
+namespace
+{
+
+using mybench::state;
+
+// 作为 compare 的“算法”参数传入的字符串类型
+template <class S>
+struct string_tag
+{
+    typedef S type;
+};
+
+typedef string_tag<mystl::string> mystl_string;
+typedef string_tag<std::string> std_string;
+
+const std::vector<size_t> key_sizes={1024, 65536};
+const std::vector<size_t> text_sizes={64, 4096, 1048576};
+
+// 长度 16~22 的键：前缀加上 bench_data.h 中的短键，截断或补齐到目标长度
+std::string make_long_key(size_t i){
+    std::string key="session:"+mybench::make_value<std::string>(i);
+    key.resize(16+i%7, '#');
+    return key;
+}
+
+template <class S>
+std::vector<S> make_keys(size_t n, bool long_keys){
+    std::vector<S> keys;
+    keys.reserve(n);
+    for(size_t i=0; i<n; ++i){
+        const std::string k=long_keys? make_long_key(i): mybench::make_value<std::string>(i);
+        keys.emplace_back(k.data(), k.size());
+    }
+    return keys;
+}
+
+// 1.拷贝构造：短字符串只复制对象本身
+template <class S>
+void bench_copy(state& s, bool long_keys){
+    const std::vector<S> keys=make_keys<S>(s.size(), long_keys);
+    s.run([&]{
+        for(const S& k: keys){
+            S copy(k);
+            mybench::do_not_optimize(copy.data());
+        }
+    });
+}
+
+// 2.相等比较：每个键与内容相同的另一个对象比较，相当于哈希表命中后的确认
+template <class S>
+void bench_equal(state& s, bool long_keys){
+    const std::vector<S> keys=make_keys<S>(s.size(), long_keys);
+    const std::vector<S> probes=make_keys<S>(s.size(), long_keys);
+    s.run([&]{
+        size_t hits=0;
+        for(size_t i=0; i<keys.size(); ++i){
+            hits+=keys[i]==probes[i];
+        }
+        mybench::do_not_optimize(hits);
+    });
+}
+
+// 3.字典序比较：相邻的键两两比较，相当于有序容器中的一次比较
+template <class S>
+void bench_less(state& s, bool long_keys){
+    const std::vector<S> keys=make_keys<S>(s.size(), long_keys);
+    s.run([&]{
+        size_t less=0;
+        for(size_t i=1; i<keys.size(); ++i){
+            less+=keys[i-1]<keys[i];
+        }
+        mybench::do_not_optimize(less);
+    });
+}
+
+// 4.拼接键："user:" + 键 + ":name"
+template <class S>
+void bench_build(state& s, bool long_keys){
+    const std::vector<S> keys=make_keys<S>(s.size(), long_keys);
+    const S prefix("u:"), suffix(":n");
+    s.run([&]{
+        for(const S& k: keys){
+            S key=prefix+k+suffix;
+            mybench::do_not_optimize(key.data());
+        }
+    });
+}
+
+// 5.追加：从空字符串开始逐段追加 8 个字符，直到 size() 个字符
+template <class S>
+void bench_append(state& s){
+    s.set_bytes_per_item(1);
+    s.run([&]{
+        S text;
+        for(size_t i=0; i<s.size(); i+=8){
+            text.append("abcdefgh", 8);
+        }
+        mybench::do_not_optimize(text.data());
+    });
+}
+
+// 6.查找：目标位于长度为 size() 的文本末尾
+template <class S>
+void bench_find_char(state& s){
+    S text(s.size(), 'a');
+    text[s.size()-1]='z';
+    s.set_bytes_per_item(1);
+    s.run([&]{
+        mybench::do_not_optimize(text.find('z'));
+    });
+}
+
+template <class S>
+void bench_find_substr(state& s){
+    S text(s.size(), 'a');
+    std::memcpy(&text[s.size()-6], "needle", 6);
+    s.set_bytes_per_item(1);
+    s.run([&]{
+        mybench::do_not_optimize(text.find("needle"));
+    });
+}
+
+// 7.切分：长度为 size() 的一行，字段长 1~12 个字符，以逗号分隔；统计字段个数和总长度
+std::string make_csv(size_t n){
+    std::string line;
+    for(size_t i=0; line.size()<n; ++i){
+        line+=mybench::make_value<std::string>(i).substr(0, 1+i%12);
+        line+=',';
+    }
+    line.resize(n);
+    return line;
+}
+
+size_t split_fields(mystl_string, const std::string& line){
+    size_t total=0;
+    for(mystl::string_view field: mystl::split(mystl::string_view(line.data(), line.size()), ',')){
+        total+=field.size()+1;
+    }
+    return total;
+}
+
+// std 一侧用 std::string_view 手写同样的循环，同样不分配内存
+size_t split_fields(std_string, const std::string& line){
+    size_t total=0;
+    std::string_view rest(line);
+    for(;;){
+        const size_t hit=rest.find(',');
+        total+=(hit==std::string_view::npos? rest.size(): hit)+1;
+        if(hit==std::string_view::npos){
+            break;
+        }
+        rest.remove_prefix(hit+1);
+    }
+    return total;
+}
+
+template <class Tag>
+void bench_split(state& s, Tag tag){
+    const std::string line=make_csv(s.size());
+    s.set_bytes_per_item(1);
+    s.run([&]{
+        mybench::do_not_optimize(split_fields(tag, line));
+    });
+}
+
+// 以前的做法：每个字段复制成一个 std::string
+void bench_split_copy(state& s){
+    const std::string line=make_csv(s.size());
+    s.set_bytes_per_item(1);
+    s.run([&]{
+        std::vector<std::string> fields;
+        size_t begin=0;
+        for(;;){
+            const size_t hit=line.find(',', begin);
+            fields.push_back(line.substr(begin, hit==std::string::npos? std::string::npos: hit-begin));
+            if(hit==std::string::npos){
+                break;
+            }
+            begin=hit+1;
+        }
+        mybench::do_not_optimize(fields.data());
+    });
+}
+
+} // namespace
+
+void register_string_benchmarks(){
+    for(bool long_keys: {false, true}){
+        const std::string type=long_keys? "key22": "key15";
+        mybench::compare("string_copy", type, [long_keys](state& s, auto tag){
+            bench_copy<typename decltype(tag)::type>(s, long_keys);
+        }, mystl_string(), std_string(), key_sizes);
+
+        mybench::compare("string_equal", type, [long_keys](state& s, auto tag){
+            bench_equal<typename decltype(tag)::type>(s, long_keys);
+        }, mystl_string(), std_string(), key_sizes);
+
+        mybench::compare("string_less", type, [long_keys](state& s, auto tag){
+            bench_less<typename decltype(tag)::type>(s, long_keys);
+        }, mystl_string(), std_string(), key_sizes);
+
+        mybench::compare("string_build", type, [long_keys](state& s, auto tag){
+            bench_build<typename decltype(tag)::type>(s, long_keys);
+        }, mystl_string(), std_string(), key_sizes);
+    }
+
+    mybench::compare("string_append", "char", [](state& s, auto tag){
+        bench_append<typename decltype(tag)::type>(s);
+    }, mystl_string(), std_string(), text_sizes);
+
+    mybench::compare("string_find", "char", [](state& s, auto tag){
+        bench_find_char<typename decltype(tag)::type>(s);
+    }, mystl_string(), std_string(), text_sizes);
+
+    mybench::compare("string_find", "substr", [](state& s, auto tag){
+        bench_find_substr<typename decltype(tag)::type>(s);
+    }, mystl_string(), std_string(), text_sizes);
+
+    mybench::compare("string_split", "view", [](state& s, auto tag){
+        bench_split(s, tag);
+    }, mystl_string(), std_string(), text_sizes);
+
+    mybench::add("string_split/std/copy", bench_split_copy, text_sizes);
+}
@@ -0,0 +1,177 @@
+// uninitialized.h 中各算法与 std::uninitialized_* 的对比，以及 default_init_allocator 与清零的 resize 的对比
+    // 每次调用都在未初始化内存上构造 size() 个元素，再用 std::destroy 析构（两种实现共用同一析构），
+    // 因此非平凡类型的耗时包含析构
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../allocator.h"
+#include "../uninitialized.h"
+#include "bench.h"
+#include "bench_data.h"
+
+namespace
+{
+
+using mybench::state;
+
+// 一块能容纳 n 个 T 的未初始化内存
+template <class T>
+class raw_buffer
+{
+public:
+    explicit raw_buffer(size_t n)
+        : m_data(static_cast<T*>(::operator new(n*sizeof(T)))), m_size(n) {}
+    ~raw_buffer(){ ::operator delete(m_data); }
+    raw_buffer(const raw_buffer&)=delete;
+    raw_buffer& operator=(const raw_buffer&)=delete;
+
+    T* begin() const noexcept { return m_data; }
+    T* end() const noexcept { return m_data+m_size; }
+    size_t size() const noexcept { return m_size; }
+
+    void swap(raw_buffer& rhs) noexcept{
+        std::swap(m_data, rhs.m_data);
+        std::swap(m_size, rhs.m_size);
+    }
+
+private:
+    T* m_data;
+    size_t m_size;
+};
+
+template <class T>
+void register_uninitialized(const char* type){
+    mybench::compare("uninitialized_copy", type, [](state& s, auto uninitialized_copy){
+        const auto a=mybench::make_data<T>(s.size());
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(uninitialized_copy(a.data(), a.data()+a.size(), buf.begin()));
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_copy), MYBENCH_FN(std::uninitialized_copy));
+
+    mybench::compare("uninitialized_copy_n", type, [](state& s, auto uninitialized_copy_n){
+        const auto a=mybench::make_data<T>(s.size());
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(uninitialized_copy_n(a.data(), a.size(), buf.begin()));
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_copy_n), MYBENCH_FN(std::uninitialized_copy_n));
+
+    mybench::compare("uninitialized_fill", type, [](state& s, auto uninitialized_fill){
+        const T value=mybench::make_value<T>(7);
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            uninitialized_fill(buf.begin(), buf.end(), value);
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_fill), MYBENCH_FN(std::uninitialized_fill));
+
+    mybench::compare("uninitialized_fill_n", type, [](state& s, auto uninitialized_fill_n){
+        const T value=mybench::make_value<T>(7);
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(uninitialized_fill_n(buf.begin(), buf.size(), value));
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_fill_n), MYBENCH_FN(std::uninitialized_fill_n));
+
+    // 移动：从已构造的 src 移到未初始化的 dst，析构 src 后交换两者，下次调用方向相反
+    mybench::compare("uninitialized_move", type, [](state& s, auto uninitialized_move){
+        const auto a=mybench::make_data<T>(s.size());
+        raw_buffer<T> src(s.size()), dst(s.size());
+        std::uninitialized_copy(a.begin(), a.end(), src.begin());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(uninitialized_move(src.begin(), src.end(), dst.begin()));
+            std::destroy(src.begin(), src.end());
+            src.swap(dst);
+            mybench::clobber_memory();
+        });
+        std::destroy(src.begin(), src.end());
+    }, MYBENCH_FN(mystl::uninitialized_move), MYBENCH_FN(std::uninitialized_move));
+
+    mybench::compare("uninitialized_move_n", type, [](state& s, auto uninitialized_move_n){
+        const auto a=mybench::make_data<T>(s.size());
+        raw_buffer<T> src(s.size()), dst(s.size());
+        std::uninitialized_copy(a.begin(), a.end(), src.begin());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            mybench::do_not_optimize(uninitialized_move_n(src.begin(), src.size(), dst.begin()));
+            std::destroy(src.begin(), src.end());
+            src.swap(dst);
+            mybench::clobber_memory();
+        });
+        std::destroy(src.begin(), src.end());
+    }, MYBENCH_FN(mystl::uninitialized_move_n), MYBENCH_FN(std::uninitialized_move_n));
+}
+
+// 默认初始化和值初始化：平凡类型的默认初始化不写内存，值初始化是清零
+template <class T>
+void register_construct(const char* type){
+    mybench::compare("uninitialized_default_construct", type, [](state& s, auto uninitialized_default_construct){
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            uninitialized_default_construct(buf.begin(), buf.end());
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_default_construct), MYBENCH_FN(std::uninitialized_default_construct));
+
+    mybench::compare("uninitialized_value_construct", type, [](state& s, auto uninitialized_value_construct){
+        raw_buffer<T> buf(s.size());
+        s.set_bytes_per_item(sizeof(T));
+        s.run([&]{
+            uninitialized_value_construct(buf.begin(), buf.end());
+            std::destroy(buf.begin(), buf.end());
+            mybench::clobber_memory();
+        });
+    }, MYBENCH_FN(mystl::uninitialized_value_construct), MYBENCH_FN(std::uninitialized_value_construct));
+}
+
+// 先 resize 到目标大小再整体覆盖（如读文件、向量化内核的输出缓冲区）
+    // std::vector 的 resize 把新元素清零，内存要写两遍；default_init_allocator 的 resize 不写内存
+    // 每次调用都重新分配，缺页的开销由两者共同承担，最大的规模是 1GB
+template <class Vector>
+uint32_t resize_then_fill(size_t n){
+    Vector v;
+    v.resize(n);
+    mystl::fill(v.data(), v.data()+n, 0x5a5a5a5au);
+    mybench::clobber_memory();
+    return v[n/2];
+}
+
+void register_resize_fill(){
+    typedef std::vector<uint32_t, mystl::default_init_allocator<uint32_t>> mystl_vector;
+    mybench::compare("resize_fill", "u32", [](state& s, auto resize_fill){
+        s.set_bytes_per_item(sizeof(uint32_t));
+        s.run([&]{ mybench::do_not_optimize(resize_fill(s.size())); });
+    }, &resize_then_fill<mystl_vector>, &resize_then_fill<std::vector<uint32_t>>,
+       std::vector<size_t>{4096, size_t(1)<<20, size_t(1)<<28});
+}
+
+} // namespace
+
+void register_uninitialized_benchmarks(){
+    register_uninitialized<int>("int");
+    register_uninitialized<uint64_t>("u64");
+    register_uninitialized<std::string>("string");
+    register_uninitialized<mybench::nontrivial>("nontrivial");
+    register_construct<int>("int");
+    register_construct<std::string>("string");
+    register_construct<mybench::nontrivial>("nontrivial");
+    register_resize_fill();
+}
@@ -0,0 +1,142 @@
+// perf_counters 的实现，非 Linux 平台上所有事件都不可用
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mybench
+{
+
+#ifdef __linux__
+
+namespace
+{
+
+int perf_event_open(perf_event_attr* attr){
+    // pid=0、cpu=-1：统计调用线程，不限定 CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, attr, 0, -1, -1, 0));
+}
+
+std::string read_paranoid(){
+    std::FILE* f=std::fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+    if(f==nullptr){
+        return "?";
+    }
+    char buf[16]={0};
+    if(std::fgets(buf, sizeof(buf), f)==nullptr){
+        buf[0]='?';
+    }
+    std::fclose(f);
+    std::string s(buf);
+    while(!s.empty() && (s.back()=='\n' || s.back()==' ')){
+        s.pop_back();
+    }
+    return s;
+}
+
+} // namespace
+
+perf_counters::~perf_counters(){
+    for(const event& e: m_events){
+        close(e.fd);
+    }
+}
+
+bool perf_counters::open(){
+    static const event wanted[]={
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1},
+        {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, -1},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1},
+        {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS, -1},
+    };
+    for(const event& w: wanted){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size=sizeof(attr);
+        attr.type=w.type;
+        attr.config=w.config;
+        attr.disabled=1;
+        attr.exclude_kernel=1;
+        attr.exclude_hv=1;
+        attr.read_format=PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd=perf_event_open(&attr);
+        if(fd<0){
+            if(!m_error.empty()){
+                m_error+="; ";
+            }
+            m_error+=std::string(w.name)+": "+std::strerror(errno);
+            continue;
+        }
+        event e=w;
+        e.fd=fd;
+        m_events.push_back(e);
+    }
+    if(!m_error.empty()){
+        m_error+=" (perf_event_paranoid="+read_paranoid()+")";
+    }
+    return available();
+}
+
+void perf_counters::start(){
+    for(const event& e: m_events){
+        ioctl(e.fd, PERF_EVENT_IOC_RESET, 0);
+    }
+    for(const event& e: m_events){
+        ioctl(e.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+std::vector<std::pair<const char*, double>> perf_counters::stop(){
+    for(const event& e: m_events){
+        ioctl(e.fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    std::vector<std::pair<const char*, double>> values;
+    for(const event& e: m_events){
+        uint64_t buf[3]={0, 0, 0};  // value, time_enabled, time_running
+        double value=0;
+        if(read(e.fd, buf, sizeof(buf))==static_cast<ssize_t>(sizeof(buf)) && buf[2]>0){
+            value=double(buf[0])*double(buf[1])/double(buf[2]);
+        }
+        values.emplace_back(e.name, value);
+    }
+    return values;
+}
+
+#else
+
+perf_counters::~perf_counters()=default;
+
+bool perf_counters::open(){
+    m_error="perf_event_open is only available on Linux";
+    return false;
+}
+
+void perf_counters::start(){}
+
+std::vector<std::pair<const char*, double>> perf_counters::stop(){
+    return {};
+}
+
+#endif
+
+std::string perf_counters::event_names() const{
+    std::string names;
+    for(const event& e: m_events){
+        if(!names.empty()){
+            names+=",";
+        }
+        names+=e.name;
+    }
+    return names;
+}
+
+} // namespace mybench
@@ -0,0 +1,53 @@
+#ifndef MYTINYSTL_BENCH_PERF_COUNTERS_H_
+#define MYTINYSTL_BENCH_PERF_COUNTERS_H_
+
+// 这个头文件包含基于 Linux perf_event_open 的硬件性能计数器
+// 只统计本进程用户态的事件，perf_event_paranoid<=2 时不需要特权
+// 容器或虚拟机中计数器可能不可用，此时 open 返回 false 并给出原因，基准照常只报告时间
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mybench
+{
+
+class perf_counters
+{
+public:
+    struct event
+    {
+        const char* name;       // 报告中使用的名字，如 "cycles"
+        uint32_t type;
+        uint64_t config;
+        int fd;
+    };
+
+    perf_counters()=default;
+    ~perf_counters();
+    perf_counters(const perf_counters&)=delete;
+    perf_counters& operator=(const perf_counters&)=delete;
+
+    // 打开所有能打开的事件，一个都打不开时返回 false
+    bool open();
+    bool available() const noexcept { return !m_events.empty(); }
+
+    // 不可用的事件及原因，如 "cycles: No such file or directory"
+    const std::string& error() const noexcept { return m_error; }
+    // 已打开的事件名，以逗号分隔
+    std::string event_names() const;
+
+    void start();
+    // 停止计数，按事件顺序返回计数值
+        // 事件被内核轮换复用时按启用时间与运行时间之比放大
+    std::vector<std::pair<const char*, double>> stop();
+
+private:
+    std::vector<event> m_events;
+    std::string m_error;
+};
+
+} // namespace mybench
+
+#endif
@@ -0,0 +1,807 @@
+#ifndef MYTINYSTL_BITSET_H_
+#define MYTINYSTL_BITSET_H_
+
+// 这个头文件包含两个位数组：固定大小的 bitset<N> 和运行时决定大小的 dynamic_bitset
+    // 位按 64 位的字存放，第 i 位是第 i/64 个字的第 i%64 位；最后一个字中超出 size() 的位始终为 0，
+    // count、==、find_first 等因此不需要单独处理不完整的字
+    // 按字的与、或、异或、与非，count（popcount）和 find_first/find_next（先找非零字，再用 ctz 定位）
+    // 在字数较多时交给 simd.h 的向量化内核；整体置 0、置 1 走 fill_n 的快速路径
+    // operator[] 返回代理对象 bit_reference，热循环中用 test/set/reset 直接读写更快
+// find_first/find_next 没有找到时返回 size()
+
+#include <cstdint>
+
+#include "algorithm_base.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 按字操作的公共部分，bitset 和 dynamic_bitset 共用
+/*****************************************************************************************/
+
+typedef uint64_t bit_word;
+constexpr size_t bit_word_bits=64;
+
+// 字数不少于这个值时调用向量化内核，更短时内联的逐字循环省去了函数表的间接调用
+    // popcount 没有 -mpopcnt 时是库函数调用，内核从 8 个字起就更快；与、或和查找非零字这类每个字只需一两条指令的运算，
+    // 内联循环已经很快（编译器用 SSE2 向量化，或者很早就找到），字数较多、能用上更宽的向量时内核才占优
+constexpr size_t bit_kernel_words=8;
+constexpr size_t bit_wide_kernel_words=64;
+
+// 容纳 n 位所需的字数
+constexpr size_t bit_words_for(size_t n) noexcept{
+    return (n+bit_word_bits-1)/bit_word_bits;
+}
+
+// 字中最低的 1 的位置，x 不能为 0；GCC/Clang 下是一条 tzcnt（或 bsf）指令
+inline size_t bit_ctz(bit_word x) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(x));
+#else
+    size_t n=0;
+    for(; (x&1)==0; x>>=1){
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline size_t bit_popcount(bit_word x) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(x));
+#else
+    x-=(x>>1)&0x5555555555555555ull;
+    x=(x&0x3333333333333333ull)+((x>>2)&0x3333333333333333ull);
+    x=(x+(x>>4))&0x0F0F0F0F0F0F0F0Full;
+    return static_cast<size_t>((x*0x0101010101010101ull)>>56);
+#endif
+}
+
+// dst[i]=dst[i] op src[i]
+inline void bit_words_apply(simd::bit_op_kind op, bit_word* dst, const bit_word* src, size_t n) noexcept{
+    if(n>=bit_wide_kernel_words){
+        simd::bit_op(op, dst, dst, src, n);
+        return;
+    }
+    for(size_t i=0; i<n; ++i){
+        switch(op){
+        case simd::bit_op_kind::and_op:    dst[i]&=src[i]; break;
+        case simd::bit_op_kind::or_op:     dst[i]|=src[i]; break;
+        case simd::bit_op_kind::xor_op:    dst[i]^=src[i]; break;
+        case simd::bit_op_kind::andnot_op: dst[i]&=~src[i]; break;
+        }
+    }
+}
+
+inline size_t bit_words_count(const bit_word* p, size_t n) noexcept{
+    if(n>=bit_kernel_words){
+        return simd::popcount_words(p, n);
+    }
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=bit_popcount(p[i]);
+    }
+    return total;
+}
+
+// a 与 b 的交集中 1 的个数，不写出交集
+inline size_t bit_words_and_count(const bit_word* a, const bit_word* b, size_t n) noexcept{
+    if(n>=bit_kernel_words){
+        return simd::and_popcount_words(a, b, n);
+    }
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=bit_popcount(a[i]&b[i]);
+    }
+    return total;
+}
+
+inline bool bit_words_intersect(const bit_word* a, const bit_word* b, size_t n) noexcept{
+    for(size_t i=0; i<n; ++i){
+        if((a[i]&b[i])!=0){
+            return true;
+        }
+    }
+    return false;
+}
+
+// 第一个非零字的下标，没有时返回 n
+inline size_t bit_words_find_nonzero(const bit_word* p, size_t n) noexcept{
+    if(n>=bit_wide_kernel_words){
+        return simd::find_nonzero_words(p, n);
+    }
+    size_t i=0;
+    while(i<n && p[i]==0){
+        ++i;
+    }
+    return i;
+}
+
+// 下标不小于 pos 的第一个 1 的位置，没有时返回 none
+    // 先逐字内联查找一条缓存行（8 个字）：稀疏的位数组中相邻两个 1 通常只隔几个字，
+    // 这时调用内核的间接调用和向量初始化比查找本身还慢；之后剩下的字仍然很多时才交给内核
+inline size_t bit_words_find_from(const bit_word* p, size_t n, size_t pos, size_t none) noexcept{
+    size_t w=pos/bit_word_bits;
+    if(w>=n){
+        return none;
+    }
+    bit_word x=p[w]&(~bit_word(0)<<(pos%bit_word_bits));
+    const size_t scan_end=w+bit_kernel_words;
+    while(x==0){
+        if(++w>=n){
+            return none;
+        }
+        if(w==scan_end && n-w>=bit_wide_kernel_words){
+            w+=simd::find_nonzero_words(p+w, n-w);
+            if(w>=n){
+                return none;
+            }
+        }
+        x=p[w];
+    }
+    return w*bit_word_bits+bit_ctz(x);
+}
+
+// 前 bits 位是否全为 1（之后的位为 0）
+inline bool bit_words_all(const bit_word* p, size_t bits) noexcept{
+    const size_t full=bits/bit_word_bits;
+    for(size_t i=0; i<full; ++i){
+        if(p[i]!=~bit_word(0)){
+            return false;
+        }
+    }
+    const size_t rest=bits%bit_word_bits;
+    return rest==0 || p[full]==(bit_word(1)<<rest)-1;
+}
+
+// 把 [first, last) 中的位置为 value，中间的整字用 fill_n
+inline void bit_words_fill_range(bit_word* p, size_t first, size_t last, bool value) noexcept{
+    if(first>=last){
+        return;
+    }
+    const size_t fw=first/bit_word_bits, lw=(last-1)/bit_word_bits;
+    const bit_word head=~bit_word(0)<<(first%bit_word_bits);
+    const bit_word tail=~bit_word(0)>>(bit_word_bits-1-(last-1)%bit_word_bits);
+    auto apply=[&](size_t w, bit_word mask) noexcept{
+        if(value){
+            p[w]|=mask;
+        }
+        else{
+            p[w]&=~mask;
+        }
+    };
+    if(fw==lw){
+        apply(fw, head&tail);
+        return;
+    }
+    apply(fw, head);
+    mystl::fill_n(p+fw+1, lw-fw-1, value? ~bit_word(0): bit_word(0));
+    apply(lw, tail);
+}
+
+// 向高位移动 shift 位（shift<n*64），低位补 0；调用者负责清除超出 size() 的位
+inline void bit_words_shl(bit_word* p, size_t n, size_t shift) noexcept{
+    const size_t ws=shift/bit_word_bits, bs=shift%bit_word_bits;
+    if(bs==0){
+        for(size_t i=n; i-->ws;){
+            p[i]=p[i-ws];
+        }
+    }
+    else{
+        for(size_t i=n-1; i>ws; --i){
+            p[i]=(p[i-ws]<<bs)|(p[i-ws-1]>>(bit_word_bits-bs));
+        }
+        p[ws]=p[0]<<bs;
+    }
+    mystl::fill_n(p, ws, bit_word(0));
+}
+
+// 向低位移动 shift 位（shift<n*64），高位补 0
+inline void bit_words_shr(bit_word* p, size_t n, size_t shift) noexcept{
+    const size_t ws=shift/bit_word_bits, bs=shift%bit_word_bits;
+    const size_t last=n-1;
+    if(bs==0){
+        for(size_t i=0; i+ws<=last; ++i){
+            p[i]=p[i+ws];
+        }
+    }
+    else{
+        for(size_t i=0; i+ws<last; ++i){
+            p[i]=(p[i+ws]>>bs)|(p[i+ws+1]<<(bit_word_bits-bs));
+        }
+        p[last-ws]=p[last]>>bs;
+    }
+    mystl::fill_n(p+n-ws, ws, bit_word(0));
+}
+
+// 存储的对齐：不超过一条缓存行，小的位数组不因对齐而变大
+constexpr size_t bit_storage_alignment(size_t words) noexcept{
+    return words>=8? 64: words>=4? 32: words>=2? 16: 8;
+}
+
+// bit_reference：operator[] 返回的代理对象，指向一个字中的一位
+class bit_reference
+{
+private:
+    bit_word* m_word;
+    bit_word  m_mask;
+
+public:
+    bit_reference(bit_word* words, size_t pos) noexcept
+        : m_word(words+pos/bit_word_bits), m_mask(bit_word(1)<<(pos%bit_word_bits)) {}
+    bit_reference(const bit_reference&) noexcept=default;
+
+    bit_reference& operator=(bool x) noexcept{
+        if(x){
+            *m_word|=m_mask;
+        }
+        else{
+            *m_word&=~m_mask;
+        }
+        return *this;
+    }
+
+    bit_reference& operator=(const bit_reference& rhs) noexcept{
+        return *this=static_cast<bool>(rhs);
+    }
+
+    operator bool() const noexcept { return (*m_word&m_mask)!=0; }
+    bool operator~() const noexcept { return (*m_word&m_mask)==0; }
+
+    bit_reference& flip() noexcept{
+        *m_word^=m_mask;
+        return *this;
+    }
+};
+
+/*****************************************************************************************/
+// bitset：N 位的位数组，存储在对象内部
+/*****************************************************************************************/
+
+template <size_t N>
+class bitset
+{
+public:
+    typedef bit_word       word_type;
+    typedef size_t         size_type;
+    typedef bit_reference  reference;
+
+    // N 为 0 时保留一个始终为 0 的字，各操作不必特殊处理
+    static constexpr size_type word_count=N==0? 1: bit_words_for(N);
+
+private:
+    // 最后一个字中有效位的掩码
+    static constexpr word_type last_mask=
+        N==0? 0: N%bit_word_bits==0? ~word_type(0): (word_type(1)<<(N%bit_word_bits))-1;
+
+    alignas(bit_storage_alignment(word_count)) word_type m_words[word_count];
+
+public:
+    // 构造函数：全为 0，或者低 64 位取自 value
+    constexpr bitset() noexcept: m_words{} {}
+
+    constexpr bitset(unsigned long long value) noexcept
+        : m_words{static_cast<word_type>(word_count==1? value&last_mask: value)} {}
+
+    // 元素访问
+    constexpr size_type size() const noexcept { return N; }
+
+    bool operator[](size_type pos) const noexcept{
+        MYSTL_DEBUG(pos<N);
+        return (m_words[pos/bit_word_bits]>>(pos%bit_word_bits))&1;
+    }
+
+    reference operator[](size_type pos) noexcept{
+        MYSTL_DEBUG(pos<N);
+        return reference(m_words, pos);
+    }
+
+    bool test(size_type pos) const{
+        THROW_OUT_OF_RANGE_IF(pos>=N, "bitset<N>::test position out of range");
+        return (*this)[pos];
+    }
+
+    // 按字访问，供序列化和自定义的按字算法使用；超出 size() 的位为 0
+    const word_type* data() const noexcept { return m_words; }
+
+    // 修改位
+    bitset& set() noexcept{
+        mystl::fill_n(m_words, word_count, ~word_type(0));
+        sanitize();
+        return *this;
+    }
+
+    bitset& set(size_type pos, bool value=true){
+        THROW_OUT_OF_RANGE_IF(pos>=N, "bitset<N>::set position out of range");
+        reference(m_words, pos)=value;
+        return *this;
+    }
+
+    bitset& reset() noexcept{
+        mystl::fill_n(m_words, word_count, word_type(0));
+        return *this;
+    }
+
+    bitset& reset(size_type pos){
+        THROW_OUT_OF_RANGE_IF(pos>=N, "bitset<N>::reset position out of range");
+        reference(m_words, pos)=false;
+        return *this;
+    }
+
+    bitset& flip() noexcept{
+        for(size_type i=0; i<word_count; ++i){
+            m_words[i]=~m_words[i];
+        }
+        sanitize();
+        return *this;
+    }
+
+    bitset& flip(size_type pos){
+        THROW_OUT_OF_RANGE_IF(pos>=N, "bitset<N>::flip position out of range");
+        reference(m_words, pos).flip();
+        return *this;
+    }
+
+    // 统计与查找
+    size_type count() const noexcept { return bit_words_count(m_words, word_count); }
+
+    bool all() const noexcept { return bit_words_all(m_words, N); }
+    bool any() const noexcept { return bit_words_find_nonzero(m_words, word_count)<word_count; }
+    bool none() const noexcept { return !any(); }
+
+    // 第一个 1 的位置，没有时返回 size()
+    size_type find_first() const noexcept{
+        return bit_words_find_from(m_words, word_count, 0, N);
+    }
+
+    // pos 之后的第一个 1 的位置，没有时返回 size()
+    size_type find_next(size_type pos) const noexcept{
+        return bit_words_find_from(m_words, word_count, pos+1, N);
+    }
+
+    unsigned long long to_ullong() const{
+        for(size_type i=1; i<word_count; ++i){
+            THROW_OVERFLOW_ERROR_IF(m_words[i]!=0, "bitset<N>::to_ullong value does not fit");
+        }
+        return m_words[0];
+    }
+
+    // 按字的运算
+    bitset& operator&=(const bitset& rhs) noexcept{
+        bit_words_apply(simd::bit_op_kind::and_op, m_words, rhs.m_words, word_count);
+        return *this;
+    }
+
+    bitset& operator|=(const bitset& rhs) noexcept{
+        bit_words_apply(simd::bit_op_kind::or_op, m_words, rhs.m_words, word_count);
+        return *this;
+    }
+
+    bitset& operator^=(const bitset& rhs) noexcept{
+        bit_words_apply(simd::bit_op_kind::xor_op, m_words, rhs.m_words, word_count);
+        return *this;
+    }
+
+    // 差集：*this&=~rhs，不构造 ~rhs 的临时对象
+    bitset& andnot(const bitset& rhs) noexcept{
+        bit_words_apply(simd::bit_op_kind::andnot_op, m_words, rhs.m_words, word_count);
+        return *this;
+    }
+
+    bitset operator~() const noexcept{
+        bitset r(*this);
+        return r.flip();
+    }
+
+    bitset& operator<<=(size_type shift) noexcept{
+        if(shift>=N){
+            return reset();
+        }
+        bit_words_shl(m_words, word_count, shift);
+        sanitize();
+        return *this;
+    }
+
+    bitset& operator>>=(size_type shift) noexcept{
+        if(shift>=N){
+            return reset();
+        }
+        bit_words_shr(m_words, word_count, shift);
+        return *this;
+    }
+
+    bitset operator<<(size_type shift) const noexcept { return bitset(*this)<<=shift; }
+    bitset operator>>(size_type shift) const noexcept { return bitset(*this)>>=shift; }
+
+    bool operator==(const bitset& rhs) const noexcept{
+        return mystl::equal(m_words, m_words+word_count, rhs.m_words);
+    }
+
+    bool operator!=(const bitset& rhs) const noexcept { return !(*this==rhs); }
+
+    // 交集中 1 的个数，相当于 (*this&rhs).count() 但不构造交集
+    size_type intersection_count(const bitset& rhs) const noexcept{
+        return bit_words_and_count(m_words, rhs.m_words, word_count);
+    }
+
+    bool intersects(const bitset& rhs) const noexcept{
+        return bit_words_intersect(m_words, rhs.m_words, word_count);
+    }
+
+private:
+    void sanitize() noexcept { m_words[word_count-1]&=last_mask; }
+};
+
+template <size_t N>
+bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) noexcept{
+    bitset<N> r(lhs);
+    return r&=rhs;
+}
+
+template <size_t N>
+bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) noexcept{
+    bitset<N> r(lhs);
+    return r|=rhs;
+}
+
+template <size_t N>
+bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) noexcept{
+    bitset<N> r(lhs);
+    return r^=rhs;
+}
+
+/*****************************************************************************************/
+// dynamic_bitset：大小在运行时决定、可以增长的位数组
+    // 存储按 64 字节（8 个字）的块分配并对齐，容量总是整块；size() 之后直到容量末尾的位都为 0，
+    // resize 变大时只需要把新增的位置 1（value 为真时），push_back 不需要清除旧内容
+/*****************************************************************************************/
+
+// 分配的单位：64 字节对齐的 8 个字
+struct alignas(64) bit_block
+{
+    bit_word words[8];
+};
+
+// 模板参数 Alloc 代表分配器类型，会被 rebind 到 bit_block
+template <class Alloc=mystl::allocator<bit_word>>
+class dynamic_bitset
+{
+public:
+    typedef Alloc          allocator_type;
+    typedef bit_word       word_type;
+    typedef size_t         size_type;
+    typedef bit_reference  reference;
+
+    static constexpr size_type block_bits=sizeof(bit_block)*8;
+
+private:
+    typedef mystl::rebind_alloc<Alloc, bit_block>  block_allocator;
+
+    mystl::compressed_pair<block_allocator, bit_block*> m_blocks;
+    size_type m_size;   // 位数
+    size_type m_cap;    // 容量，以块计
+
+public:
+    // 构造、复制、移动、析构函数
+    dynamic_bitset() noexcept(noexcept(allocator_type())): dynamic_bitset(allocator_type()) {}
+
+    explicit dynamic_bitset(const allocator_type& a) noexcept
+        : m_blocks(block_allocator(a), nullptr), m_size(0), m_cap(0) {}
+
+    explicit dynamic_bitset(size_type n, bool value=false, const allocator_type& a=allocator_type())
+        : dynamic_bitset(a){
+        resize(n, value);
+    }
+
+    dynamic_bitset(const dynamic_bitset& rhs): dynamic_bitset(allocator_type(rhs.m_blocks.first())){
+        if(rhs.m_size==0){
+            return;
+        }
+        reallocate(blocks_for(rhs.m_size));
+        mystl::copy(rhs.words(), rhs.words()+rhs.word_count(), words());
+        m_size=rhs.m_size;
+    }
+
+    dynamic_bitset(dynamic_bitset&& rhs) noexcept: dynamic_bitset(allocator_type(rhs.m_blocks.first())){
+        swap(rhs);
+    }
+
+    dynamic_bitset& operator=(const dynamic_bitset& rhs){
+        if(this!=&rhs){
+            dynamic_bitset tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    dynamic_bitset& operator=(dynamic_bitset&& rhs) noexcept{
+        if(this!=&rhs){
+            dynamic_bitset tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~dynamic_bitset(){
+        if(m_blocks.second()!=nullptr){
+            m_blocks.first().deallocate(m_blocks.second(), m_cap);
+        }
+    }
+
+    allocator_type get_allocator() const { return allocator_type(m_blocks.first()); }
+
+    // 容量相关操作
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size==0; }
+    size_type capacity() const noexcept { return m_cap*block_bits; }
+    size_type word_count() const noexcept { return bit_words_for(m_size); }
+
+    void reserve(size_type n){
+        if(n>capacity()){
+            reallocate(blocks_for(n));
+        }
+    }
+
+    // 变大时新增的位为 value，变小时截掉的位清零以保持“size() 之后都为 0”
+    void resize(size_type n, bool value=false){
+        if(n>m_size){
+            grow_to(n);
+            if(value){
+                bit_words_fill_range(words(), m_size, n, true);
+            }
+        }
+        else{
+            bit_words_fill_range(words(), n, m_size, false);
+        }
+        m_size=n;
+    }
+
+    void push_back(bool value){
+        grow_to(m_size+1);
+        if(value){
+            words()[m_size/bit_word_bits]|=word_type(1)<<(m_size%bit_word_bits);
+        }
+        ++m_size;
+    }
+
+    void pop_back() noexcept{
+        MYSTL_DEBUG(m_size>0);
+        --m_size;
+        words()[m_size/bit_word_bits]&=~(word_type(1)<<(m_size%bit_word_bits));
+    }
+
+    void clear() noexcept{
+        mystl::fill_n(words(), word_count(), word_type(0));
+        m_size=0;
+    }
+
+    // 元素访问
+    bool operator[](size_type pos) const noexcept{
+        MYSTL_DEBUG(pos<m_size);
+        return (words()[pos/bit_word_bits]>>(pos%bit_word_bits))&1;
+    }
+
+    reference operator[](size_type pos) noexcept{
+        MYSTL_DEBUG(pos<m_size);
+        return reference(words(), pos);
+    }
+
+    bool test(size_type pos) const{
+        THROW_OUT_OF_RANGE_IF(pos>=m_size, "dynamic_bitset::test position out of range");
+        return (*this)[pos];
+    }
+
+    // 按字访问，共 word_count() 个字，超出 size() 的位为 0；空时可能是 nullptr
+    const word_type* data() const noexcept { return words(); }
+
+    // 修改位
+    dynamic_bitset& set() noexcept{
+        mystl::fill_n(words(), word_count(), ~word_type(0));
+        sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& set(size_type pos, bool value=true){
+        THROW_OUT_OF_RANGE_IF(pos>=m_size, "dynamic_bitset::set position out of range");
+        reference(words(), pos)=value;
+        return *this;
+    }
+
+    dynamic_bitset& reset() noexcept{
+        mystl::fill_n(words(), word_count(), word_type(0));
+        return *this;
+    }
+
+    dynamic_bitset& reset(size_type pos){
+        THROW_OUT_OF_RANGE_IF(pos>=m_size, "dynamic_bitset::reset position out of range");
+        reference(words(), pos)=false;
+        return *this;
+    }
+
+    dynamic_bitset& flip() noexcept{
+        word_type* w=words();
+        for(size_type i=0, n=word_count(); i<n; ++i){
+            w[i]=~w[i];
+        }
+        sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& flip(size_type pos){
+        THROW_OUT_OF_RANGE_IF(pos>=m_size, "dynamic_bitset::flip position out of range");
+        reference(words(), pos).flip();
+        return *this;
+    }
+
+    // 统计与查找
+    size_type count() const noexcept { return bit_words_count(words(), word_count()); }
+
+    bool all() const noexcept { return bit_words_all(words(), m_size); }
+    bool any() const noexcept { return bit_words_find_nonzero(words(), word_count())<word_count(); }
+    bool none() const noexcept { return !any(); }
+
+    // 第一个 1 的位置，没有时返回 size()
+    size_type find_first() const noexcept{
+        return bit_words_find_from(words(), word_count(), 0, m_size);
+    }
+
+    // pos 之后的第一个 1 的位置，没有时返回 size()
+    size_type find_next(size_type pos) const noexcept{
+        return bit_words_find_from(words(), word_count(), pos+1, m_size);
+    }
+
+    // 按字的运算，两个位数组的大小必须相同
+    dynamic_bitset& operator&=(const dynamic_bitset& rhs) noexcept{
+        return apply(simd::bit_op_kind::and_op, rhs);
+    }
+
+    dynamic_bitset& operator|=(const dynamic_bitset& rhs) noexcept{
+        return apply(simd::bit_op_kind::or_op, rhs);
+    }
+
+    dynamic_bitset& operator^=(const dynamic_bitset& rhs) noexcept{
+        return apply(simd::bit_op_kind::xor_op, rhs);
+    }
+
+    // 差集：*this&=~rhs，不构造 ~rhs 的临时对象
+    dynamic_bitset& andnot(const dynamic_bitset& rhs) noexcept{
+        return apply(simd::bit_op_kind::andnot_op, rhs);
+    }
+
+    dynamic_bitset operator~() const{
+        dynamic_bitset r(*this);
+        r.flip();
+        return r;
+    }
+
+    dynamic_bitset& operator<<=(size_type shift) noexcept{
+        if(shift>=m_size){
+            return reset();
+        }
+        bit_words_shl(words(), word_count(), shift);
+        sanitize();
+        return *this;
+    }
+
+    dynamic_bitset& operator>>=(size_type shift) noexcept{
+        if(shift>=m_size){
+            return reset();
+        }
+        bit_words_shr(words(), word_count(), shift);
+        return *this;
+    }
+
+    dynamic_bitset operator<<(size_type shift) const{
+        dynamic_bitset r(*this);
+        r<<=shift;
+        return r;
+    }
+
+    dynamic_bitset operator>>(size_type shift) const{
+        dynamic_bitset r(*this);
+        r>>=shift;
+        return r;
+    }
+
+    bool operator==(const dynamic_bitset& rhs) const noexcept{
+        return m_size==rhs.m_size && mystl::equal(words(), words()+word_count(), rhs.words());
+    }
+
+    bool operator!=(const dynamic_bitset& rhs) const noexcept { return !(*this==rhs); }
+
+    // 交集中 1 的个数，相当于 (*this&rhs).count() 但不构造交集；大小必须相同
+    size_type intersection_count(const dynamic_bitset& rhs) const noexcept{
+        MYSTL_DEBUG(m_size==rhs.m_size);
+        return bit_words_and_count(words(), rhs.words(), word_count());
+    }
+
+    bool intersects(const dynamic_bitset& rhs) const noexcept{
+        MYSTL_DEBUG(m_size==rhs.m_size);
+        return bit_words_intersect(words(), rhs.words(), word_count());
+    }
+
+    void swap(dynamic_bitset& rhs) noexcept{
+        mystl::swap(m_blocks.first(), rhs.m_blocks.first());
+        mystl::swap(m_blocks.second(), rhs.m_blocks.second());
+        mystl::swap(m_size, rhs.m_size);
+        mystl::swap(m_cap, rhs.m_cap);
+    }
+
+private:
+    word_type* words() noexcept { return reinterpret_cast<word_type*>(m_blocks.second()); }
+    const word_type* words() const noexcept { return reinterpret_cast<const word_type*>(m_blocks.second()); }
+
+    static size_type blocks_for(size_type bits) noexcept { return (bits+block_bits-1)/block_bits; }
+
+    void sanitize() noexcept{
+        if(m_size%bit_word_bits!=0){
+            words()[m_size/bit_word_bits]&=(word_type(1)<<(m_size%bit_word_bits))-1;
+        }
+    }
+
+    dynamic_bitset& apply(simd::bit_op_kind op, const dynamic_bitset& rhs) noexcept{
+        MYSTL_DEBUG(m_size==rhs.m_size);
+        bit_words_apply(op, words(), rhs.words(), word_count());
+        return *this;
+    }
+
+    // 保证容量不少于 bits 位，按两倍扩容
+    void grow_to(size_type bits){
+        if(bits>capacity()){
+            reallocate(mystl::max(blocks_for(bits), 2*m_cap));
+        }
+    }
+
+    // 换成 blocks 块的新存储，复制已有的字，其余清零
+    void reallocate(size_type blocks){
+        THROW_LENGTH_ERROR_IF(blocks>static_cast<size_type>(-1)/block_bits, "dynamic_bitset too large");
+        bit_block* b=m_blocks.first().allocate(blocks);
+        word_type* w=reinterpret_cast<word_type*>(b);
+        const size_type used=word_count();
+        if(used>0){
+            mystl::copy(words(), words()+used, w);
+        }
+        mystl::fill_n(w+used, blocks*(sizeof(bit_block)/sizeof(word_type))-used, word_type(0));
+        if(m_blocks.second()!=nullptr){
+            m_blocks.first().deallocate(m_blocks.second(), m_cap);
+        }
+        m_blocks.second()=b;
+        m_cap=blocks;
+    }
+};
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator&(const dynamic_bitset<Alloc>& lhs, const dynamic_bitset<Alloc>& rhs){
+    dynamic_bitset<Alloc> r(lhs);
+    r&=rhs;
+    return r;
+}
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator|(const dynamic_bitset<Alloc>& lhs, const dynamic_bitset<Alloc>& rhs){
+    dynamic_bitset<Alloc> r(lhs);
+    r|=rhs;
+    return r;
+}
+
+template <class Alloc>
+dynamic_bitset<Alloc> operator^(const dynamic_bitset<Alloc>& lhs, const dynamic_bitset<Alloc>& rhs){
+    dynamic_bitset<Alloc> r(lhs);
+    r^=rhs;
+    return r;
+}
+
+// 重载 mystl 的 swap
+template <class Alloc>
+void swap(dynamic_bitset<Alloc>& lhs, dynamic_bitset<Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif
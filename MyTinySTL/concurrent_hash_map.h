@@ -0,0 +1,419 @@
+#ifndef MYTINYSTL_CONCURRENT_HASH_MAP_H_
+#define MYTINYSTL_CONCURRENT_HASH_MAP_H_
+
+// 这个头文件包含一个模板类 concurrent_hash_map：多线程可以同时读写的哈希表
+// 桶是单向链表，读者不加锁，沿着 acquire 读到的指针遍历；写者按桶号锁住 stripe_count 把锁中的一把
+// 哈希函数的结果先经过 hash_mix64 打散（std::hash 对整数是恒等映射），桶号和条带号都取打散后的高位，
+// 条带号是桶号的最高几位，同一个桶总是由同一把锁保护，扩容后也是如此
+// 节点发布后不再修改：覆盖一个值时新建节点替换旧节点，被摘下的节点交给 epoch_domain 回收，
+// 等所有可能还在读它的读者离开后才释放；回收时用新构造的分配器释放内存，所以分配器必须是无状态的
+// 扩容时锁住所有条带，把全部元素复制到新的桶数组后整体替换，旧的节点和桶数组同样由纪元回收，
+// 所以正在遍历旧链表的读者不受影响；代价是 Key 和 T 需要可拷贝构造
+// 读操作不返回引用：find 把值拷贝出来，visit 在读者保护范围内把 const T& 交给回调
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include "allocator.h"
+#include "epoch.h"
+#include "functional.h"
+#include "util.h"
+
+namespace mystl
+{
+
+template <class Key, class T, class Hash=std::hash<Key>, class KeyEqual=mystl::equal_to<Key>,
+          class Alloc=mystl::allocator<T>>
+class concurrent_hash_map
+{
+public:
+    typedef Key         key_type;
+    typedef T           mapped_type;
+    typedef Hash        hasher;
+    typedef KeyEqual    key_equal;
+    typedef Alloc       allocator_type;
+    typedef size_t      size_type;
+
+    // 写者的锁按桶号的最高几位分成这么多把，桶数总是它的倍数
+    static constexpr size_type stripe_count=64;
+
+private:
+    struct node
+    {
+        std::atomic<node*> next;
+        size_t hash;
+        Key key;
+        T value;
+
+        template <class K, class... Args>
+        node(size_t h, K&& k, Args&& ...args)
+            : next(nullptr), hash(h), key(mystl::forward<K>(k)), value(mystl::forward<Args>(args)...) {}
+    };
+
+    typedef std::atomic<node*> bucket_head;
+
+    struct table
+    {
+        size_type mask;
+        unsigned shift;     // 桶号是打散后的哈希值右移 shift 位
+        bucket_head* buckets;
+    };
+
+    static constexpr unsigned hash_bits=sizeof(size_t)*8;
+    static constexpr unsigned stripe_bits=6;
+    static_assert(stripe_count==size_type(1) << stripe_bits, "stripe_count must be 2^stripe_bits");
+
+    // 条带上的元素个数超过平均份额后，每插入这么多个才检查一次全局的元素个数
+    static constexpr size_type grow_check_interval=16;
+
+    struct alignas(cache_line_size) stripe
+    {
+        std::mutex mutex;
+        std::atomic<size_type> count{0};    // 这个条带上的元素个数，只在锁内修改，size() 不加锁读取
+    };
+
+    typedef mystl::rebind_alloc<Alloc, node>   node_allocator;
+    typedef mystl::rebind_alloc<Alloc, bucket_head> bucket_allocator;
+    typedef mystl::rebind_alloc<Alloc, table>  table_allocator;
+
+    static_assert(std::is_empty<node_allocator>::value, "concurrent_hash_map requires a stateless allocator");
+
+    alignas(cache_line_size) std::atomic<table*> m_table;
+    mystl::compressed_pair<Hash, KeyEqual> m_functions;
+    node_allocator m_alloc;
+    stripe m_stripes[stripe_count];
+
+public:
+    explicit concurrent_hash_map(size_type n=stripe_count, const Hash& hash=Hash(),
+        const KeyEqual& equal=KeyEqual(), const allocator_type& a=allocator_type())
+        : m_table(nullptr), m_functions(hash, equal), m_alloc(a){
+        m_table.store(new_table(round_buckets(n)), std::memory_order_relaxed);
+    }
+
+    concurrent_hash_map(const concurrent_hash_map&)=delete;
+    concurrent_hash_map& operator=(const concurrent_hash_map&)=delete;
+
+    // 析构时不能有其他线程在访问
+    ~concurrent_hash_map(){
+        free_table(m_table.load(std::memory_order_relaxed));
+    }
+
+public:
+    // 1.读操作：不加锁
+    // 找到 key 时把值拷贝到 value 中
+    bool find(const Key& key, T& value) const{
+        return visit(key, [&](const T& v){ value=v; });
+    }
+
+    bool contains(const Key& key) const{
+        return visit(key, [](const T&){});
+    }
+
+    // 找到 key 时调用 f(const T&)，f 在读者保护范围内执行，不能保存引用，也不能修改本容器
+    template <class F>
+    bool visit(const Key& key, F f) const{
+        const size_t h=hash_of(key);
+        mystl::epoch_guard guard;
+        const table* t=m_table.load(std::memory_order_acquire);
+        for(node* n=t->buckets[bucket_index(t, h)].load(std::memory_order_acquire); n!=nullptr;
+            n=n->next.load(std::memory_order_acquire)){
+            if(n->hash==h && key_eq()(n->key, key)){
+                f(n->value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 并发修改时是一个近似值
+    size_type size() const noexcept{
+        size_type n=0;
+        for(const stripe& s: m_stripes){
+            n+=s.count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    bool empty() const noexcept { return size()==0; }
+
+    size_type bucket_count() const noexcept { return m_table.load(std::memory_order_acquire)->mask+1; }
+
+    // key 所在的桶号，扩容后会变化；桶号除以 bucket_count()/stripe_count 就是保护它的条带
+    size_type bucket(const Key& key) const{
+        return bucket_index(m_table.load(std::memory_order_acquire), hash_of(key));
+    }
+
+    hasher hash_function() const { return m_functions.first(); }
+    key_equal key_eq() const { return m_functions.second(); }
+    allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+    // 2.写操作：锁住 key 所在的条带
+    // key 不存在时插入，返回是否插入
+    template <class... Args>
+    bool emplace(const Key& key, Args&& ...args){
+        const size_t h=hash_of(key);
+        bool grow=false;
+        {
+            stripe& s=stripe_of(h);
+            std::lock_guard<std::mutex> lock(s.mutex);
+            table* t=m_table.load(std::memory_order_relaxed);
+            bucket_head& b=t->buckets[bucket_index(t, h)];
+            if(find_link(b, h, key)!=nullptr){
+                return false;
+            }
+            link_front(b, new_node(h, key, mystl::forward<Args>(args)...));
+            grow=need_grow_check(add_count(s, 1), t);
+        }
+        if(grow){
+            rehash_if_needed();
+        }
+        return true;
+    }
+
+    bool insert(const Key& key, const T& value) { return emplace(key, value); }
+
+    // key 存在时用新节点替换旧节点，否则插入，返回是否插入
+    template <class M>
+    bool insert_or_assign(const Key& key, M&& value){
+        const size_t h=hash_of(key);
+        bool grow=false;
+        {
+            stripe& s=stripe_of(h);
+            std::lock_guard<std::mutex> lock(s.mutex);
+            table* t=m_table.load(std::memory_order_relaxed);
+            bucket_head& b=t->buckets[bucket_index(t, h)];
+            if(bucket_head* link=find_link(b, h, key)){
+                replace(*link, new_node(h, key, mystl::forward<M>(value)));
+                return false;
+            }
+            link_front(b, new_node(h, key, mystl::forward<M>(value)));
+            grow=need_grow_check(add_count(s, 1), t);
+        }
+        if(grow){
+            rehash_if_needed();
+        }
+        return true;
+    }
+
+    // key 存在时对值的副本调用 f(T&)，再用副本替换旧节点，返回 key 是否存在
+    template <class F>
+    bool update(const Key& key, F f){
+        const size_t h=hash_of(key);
+        stripe& s=stripe_of(h);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        table* t=m_table.load(std::memory_order_relaxed);
+        bucket_head* link=find_link(t->buckets[bucket_index(t, h)], h, key);
+        if(link==nullptr){
+            return false;
+        }
+        node* old=link->load(std::memory_order_relaxed);
+        node* n=new_node(h, old->key, old->value);
+        try{
+            f(n->value);
+        }
+        catch(...){
+            delete_node(n);
+            throw;
+        }
+        replace(*link, n);
+        return true;
+    }
+
+    // 删除 key，返回是否存在
+    bool erase(const Key& key){
+        const size_t h=hash_of(key);
+        stripe& s=stripe_of(h);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        table* t=m_table.load(std::memory_order_relaxed);
+        bucket_head* link=find_link(t->buckets[bucket_index(t, h)], h, key);
+        if(link==nullptr){
+            return false;
+        }
+        node* n=link->load(std::memory_order_relaxed);
+        link->store(n->next.load(std::memory_order_relaxed), std::memory_order_release);
+        add_count(s, size_type(-1));
+        epoch_domain::instance().retire(n, &free_node);
+        return true;
+    }
+
+    // 换上一张空表，旧表整体回收
+    void clear(){
+        lock_all();
+        table* old=m_table.load(std::memory_order_relaxed);
+        m_table.store(new_table(old->mask+1), std::memory_order_release);
+        for(stripe& s: m_stripes){
+            s.count.store(0, std::memory_order_relaxed);
+        }
+        unlock_all();
+        epoch_domain::instance().retire(old, &free_table);
+    }
+
+private:
+    size_t hash_of(const Key& key) const{
+        return static_cast<size_t>(mystl::hash_mix64(hash_function()(key)));
+    }
+
+    static size_type bucket_index(const table* t, size_t h) noexcept { return h >> t->shift; }
+
+    stripe& stripe_of(size_t h) noexcept { return m_stripes[h >> (hash_bits-stripe_bits)]; }
+
+    // 插入后条带上有 n 个元素时是否检查扩容：超过平均份额时检查一次，之后每 grow_check_interval 个检查一次，
+    // 元素集中在少数条带上时不会每次插入都去统计全部条带
+    static bool need_grow_check(size_type n, const table* t) noexcept{
+        const size_type quota=(t->mask+1)/stripe_count;
+        return n>quota && (n-quota-1)%grow_check_interval==0;
+    }
+
+    // 持有条带锁时修改计数，不需要原子的读改写
+    static size_type add_count(stripe& s, size_type delta) noexcept{
+        const size_type n=s.count.load(std::memory_order_relaxed)+delta;
+        s.count.store(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    static size_type round_buckets(size_type n) noexcept{
+        size_type cap=stripe_count;
+        while(cap<n){
+            cap<<=1;
+        }
+        return cap;
+    }
+
+    // 返回指向 key 所在节点的链接（桶头或前一个节点的 next），没有时返回 nullptr，只在锁内调用
+    bucket_head* find_link(bucket_head& head, size_t h, const Key& key) const{
+        bucket_head* link=&head;
+        for(node* n=link->load(std::memory_order_relaxed); n!=nullptr; n=link->load(std::memory_order_relaxed)){
+            if(n->hash==h && key_eq()(n->key, key)){
+                return link;
+            }
+            link=&n->next;
+        }
+        return nullptr;
+    }
+
+    // 节点的字段写完之后才通过 release 发布，读者 acquire 读到指针时一定能看到完整的节点
+    static void link_front(bucket_head& head, node* n) noexcept{
+        n->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head.store(n, std::memory_order_release);
+    }
+
+    void replace(bucket_head& link, node* n){
+        node* old=link.load(std::memory_order_relaxed);
+        n->next.store(old->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        link.store(n, std::memory_order_release);
+        epoch_domain::instance().retire(old, &free_node);
+    }
+
+    template <class... Args>
+    node* new_node(size_t h, Args&& ...args){
+        node* n=m_alloc.allocate(1);
+        try{
+            mystl::construct(n, h, mystl::forward<Args>(args)...);
+        }
+        catch(...){
+            m_alloc.deallocate(n, 1);
+            throw;
+        }
+        return n;
+    }
+
+    static void delete_node(node* n) noexcept{
+        mystl::destroy(n);
+        node_allocator().deallocate(n, 1);
+    }
+
+    static void free_node(void* p) noexcept { delete_node(static_cast<node*>(p)); }
+
+    table* new_table(size_type buckets){
+        table_allocator ta(m_alloc);
+        bucket_allocator ba(m_alloc);
+        table* t=ta.allocate(1);
+        try{
+            t->buckets=ba.allocate(buckets);
+        }
+        catch(...){
+            ta.deallocate(t, 1);
+            throw;
+        }
+        t->mask=buckets-1;
+        t->shift=hash_bits;
+        for(size_type b=buckets; b>1; b>>=1){
+            --t->shift;
+        }
+        for(size_type i=0; i<buckets; ++i){
+            mystl::construct(t->buckets+i, nullptr);
+        }
+        return t;
+    }
+
+    // 释放桶数组和其中的所有节点
+    static void free_table(void* p) noexcept{
+        table* t=static_cast<table*>(p);
+        for(size_type i=0; i<=t->mask; ++i){
+            node* n=t->buckets[i].load(std::memory_order_relaxed);
+            while(n!=nullptr){
+                node* next=n->next.load(std::memory_order_relaxed);
+                delete_node(n);
+                n=next;
+            }
+        }
+        bucket_allocator().deallocate(t->buckets, t->mask+1);
+        table_allocator().deallocate(t, 1);
+    }
+
+    void lock_all(){
+        for(stripe& s: m_stripes){
+            s.mutex.lock();
+        }
+    }
+
+    void unlock_all() noexcept{
+        for(stripe& s: m_stripes){
+            s.mutex.unlock();
+        }
+    }
+
+    // 3.扩容：元素个数超过桶数时桶数翻倍
+        // 先不加锁地统计元素个数，不需要扩容时不去拿全部的锁
+        // 节点全部复制到新表，旧表中的链表保持原样，正在遍历旧表的读者仍能读到一致的内容
+    void rehash_if_needed(){
+        if(size()<=bucket_count()){
+            return;
+        }
+        lock_all();
+        table* old=m_table.load(std::memory_order_relaxed);
+        size_type total=0;
+        for(const stripe& s: m_stripes){
+            total+=s.count.load(std::memory_order_relaxed);
+        }
+        if(total<=old->mask+1){
+            unlock_all();   // 别的线程已经扩过容
+            return;
+        }
+        table* t=nullptr;
+        try{
+            t=new_table((old->mask+1)*2);
+            for(size_type i=0; i<=old->mask; ++i){
+                for(node* n=old->buckets[i].load(std::memory_order_relaxed); n!=nullptr;
+                    n=n->next.load(std::memory_order_relaxed)){
+                    link_front(t->buckets[bucket_index(t, n->hash)], new_node(n->hash, n->key, n->value));
+                }
+            }
+        }
+        catch(...){
+            if(t!=nullptr){
+                free_table(t);
+            }
+            unlock_all();
+            throw;
+        }
+        m_table.store(t, std::memory_order_release);
+        unlock_all();
+        epoch_domain::instance().retire(old, &free_table);
+    }
+};
+
+} // namespace mystl
+
+#endif
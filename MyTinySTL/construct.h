@@ -5,6 +5,7 @@
 
 #include "iterator.h"
 #include "type_traits.h"
+#include "util.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -21,6 +22,12 @@ void construct(Ty* ptr){
     // 允许在已分配的内存位置上构造一个对象，而不会分配新的内存
 }
 
+// 默认初始化：不带括号的 new，平凡类型不做任何写入，内容是不确定的值
+template <class Ty>
+void construct_default(Ty* ptr){
+    ::new ((void*)ptr) Ty;
+}
+
 template <class Ty1, class Ty2>
 void construct(Ty1* ptr, const Ty2& value){
     ::new ((void*)ptr) Ty1(value);
@@ -42,26 +49,26 @@ void destroy_one(Ty* pointer, std::false_type){
     }
 }
 
+template <class Ty>
+void destroy(Ty* pointer){
+    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <class ForwardIter>
 void destroy_cat(ForwardIter, ForwardIter, std::true_type){}
 
 template <class ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type){
     for(;first!=last; ++first){
-        destroy(&*first);
+        mystl::destroy(&*first);
         // 解引用取地址
     }
 }
 
-template <class Ty>
-void destroy(Ty* pointer){
-    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
-}
-
 template <class ForwardIter>
 void destroy(ForwardIter first, ForwardIter last){
     destroy_cat(first, last, std::is_trivially_destructible<
-                typename iterator_traits<ForwardIter>::value_type{});
+                typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 } // namespace mystl
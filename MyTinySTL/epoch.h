@@ -0,0 +1,284 @@
+#ifndef MYTINYSTL_EPOCH_H_
+#define MYTINYSTL_EPOCH_H_
+
+// 这个头文件包含基于纪元（epoch）的内存回收：无锁容器摘下的节点可能还有读者在访问，先交给这里，
+// 等所有读者都离开之后再释放
+// 读者用 epoch_guard 把当前线程钉（pin）在全局纪元上；所有被钉住的线程都看到了当前纪元时，全局纪元才能前进一步
+// 写者把摘下的对象 retire 到本线程的袋子（bag）里，袋子装满 batch_size 个后盖上当时的纪元，
+// 全局纪元比它大 2 时袋子里的对象一定没有读者，整袋释放
+// 一个线程停在 epoch_guard 之内时全局纪元无法前进，期间所有线程 retire 的对象都不能释放；
+// 停在 epoch_guard 之外的线程不影响回收
+
+#include <atomic>
+#include <mutex>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl
+{
+
+class epoch_domain
+{
+public:
+    // 每个袋子装的对象个数，装满后才尝试推进纪元和释放
+    static constexpr size_t batch_size=64;
+
+    typedef void (*deleter_type)(void*);
+
+private:
+    struct retired
+    {
+        void* ptr;
+        deleter_type deleter;
+    };
+
+    struct bag
+    {
+        retired items[batch_size];
+        size_t count=0;
+        size_t epoch=0;             // 封口时的全局纪元
+        bag* next=nullptr;
+    };
+
+    // 每个线程一条记录，线程退出后留给之后的线程复用，不会释放
+    struct alignas(cache_line_size) record
+    {
+        std::atomic<size_t> state{0};       // 没有被钉住时为 0，否则为 纪元*2+1
+        std::atomic<bool> in_use{true};
+        record* next=nullptr;               // 加入链表后不再改变
+        // 以下只由拥有这条记录的线程访问
+        unsigned nesting=0;
+        bag* current=nullptr;               // 正在装的袋子
+        bag* sealed_head=nullptr;           // 已封口的袋子，纪元从旧到新
+        bag* sealed_tail=nullptr;
+    };
+
+    alignas(cache_line_size) std::atomic<size_t> m_global{0};
+    alignas(cache_line_size) std::atomic<record*> m_records{nullptr};
+    std::atomic<size_t> m_pending{0};
+    // 已退出线程留下的袋子
+    std::mutex m_orphan_mutex;
+    std::atomic<bool> m_has_orphans{false};
+    bag* m_orphan_head=nullptr;
+    bag* m_orphan_tail=nullptr;
+
+    static inline thread_local record* s_record=nullptr;
+
+    epoch_domain()=default;
+
+public:
+    epoch_domain(const epoch_domain&)=delete;
+    epoch_domain& operator=(const epoch_domain&)=delete;
+
+    // 进程唯一的实例，不析构，以免退出时还在运行的线程访问到已经析构的对象
+    static epoch_domain& instance(){
+        static epoch_domain* domain=new epoch_domain;
+        return *domain;
+    }
+
+    // 把当前线程钉在全局纪元上，可以嵌套；通常通过 epoch_guard 调用
+    void pin(){
+        record* r=local_record();
+        if(r->nesting++==0){
+            r->state.store(m_global.load(std::memory_order_relaxed)<<1|1, std::memory_order_release);
+            // 之后对共享指针的读取不能提前到 state 写入之前
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void unpin() noexcept{
+        record* r=s_record;
+        if(--r->nesting==0){
+            r->state.store(0, std::memory_order_release);
+        }
+    }
+
+    // 摘下的对象在没有读者之后调用 deleter(ptr)
+    void retire(void* ptr, deleter_type deleter){
+        record* r=local_record();
+        if(r->current==nullptr){
+            r->current=new_bag();
+        }
+        bag* b=r->current;
+        b->items[b->count++]=retired{ptr, deleter};
+        if(b->count==batch_size){
+            seal(r);
+            collect(r);
+        }
+    }
+
+    // 用 Alloc 分配、mystl::construct 构造的对象，回收时 mystl::destroy 后用一个新构造的 Alloc 释放，
+    // 所以 Alloc 必须是无状态的
+    template <class T, class Alloc=mystl::allocator<T>>
+    void retire(T* ptr){
+        static_assert(std::is_empty<Alloc>::value, "epoch_domain::retire requires a stateless allocator");
+        retire(static_cast<void*>(ptr), [](void* p){
+            T* obj=static_cast<T*>(p);
+            mystl::destroy(obj);
+            Alloc().deallocate(obj, 1);
+        });
+    }
+
+    // 把当前线程没装满的袋子也封口，并尽量释放，用于线程长时间不再 retire 之前
+    void flush(){
+        record* r=local_record();
+        if(r->current!=nullptr && r->current->count!=0){
+            seal(r);
+        }
+        collect(r);
+    }
+
+    // 全局纪元前进一步，有被钉在旧纪元上的线程时返回 false
+    bool try_advance() noexcept{
+        size_t e=m_global.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(record* r=m_records.load(std::memory_order_acquire); r!=nullptr; r=r->next){
+            // acquire 与读者 unpin 的 release 配对：读到读者离开后，它之前的读取都发生在释放之前
+            const size_t s=r->state.load(std::memory_order_acquire);
+            if((s&1) && (s>>1)!=e){
+                return false;
+            }
+        }
+        return m_global.compare_exchange_strong(e, e+1, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    size_t epoch() const noexcept { return m_global.load(std::memory_order_relaxed); }
+
+    // 已封口、尚未释放的对象个数（没装满的袋子不计入），是一个近似值
+    size_t pending() const noexcept { return m_pending.load(std::memory_order_relaxed); }
+
+private:
+    record* local_record(){
+        record* r=s_record;
+        return r!=nullptr? r: register_thread();
+    }
+
+    // 线程第一次使用时复用一条空闲的记录或者新建一条，线程退出时交还
+    record* register_thread(){
+        record* r=nullptr;
+        for(record* p=m_records.load(std::memory_order_acquire); p!=nullptr; p=p->next){
+            bool expected=false;
+            if(!p->in_use.load(std::memory_order_relaxed) &&
+                p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)){
+                r=p;
+                break;
+            }
+        }
+        if(r==nullptr){
+            r=mystl::allocator<record>::allocate();
+            mystl::construct(r);
+            record* head=m_records.load(std::memory_order_relaxed);
+            do{
+                r->next=head;
+            } while(!m_records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+        }
+        struct releaser
+        {
+            record* r;
+            ~releaser(){
+                epoch_domain::instance().release_thread(r);
+                s_record=nullptr;
+            }
+        };
+        static thread_local releaser hook{r};
+        hook.r=r;
+        s_record=r;
+        return r;
+    }
+
+    void release_thread(record* r){
+        if(r->current!=nullptr && r->current->count!=0){
+            seal(r);
+        }
+        if(r->current!=nullptr){
+            delete_bag(r->current);
+            r->current=nullptr;
+        }
+        if(r->sealed_head!=nullptr){
+            std::lock_guard<std::mutex> lock(m_orphan_mutex);
+            if(m_orphan_tail!=nullptr){
+                m_orphan_tail->next=r->sealed_head;
+            }
+            else{
+                m_orphan_head=r->sealed_head;
+            }
+            m_orphan_tail=r->sealed_tail;
+            m_has_orphans.store(true, std::memory_order_relaxed);
+            r->sealed_head=r->sealed_tail=nullptr;
+        }
+        r->nesting=0;
+        r->state.store(0, std::memory_order_relaxed);
+        r->in_use.store(false, std::memory_order_release);
+    }
+
+    void seal(record* r){
+        bag* b=r->current;
+        r->current=nullptr;
+        b->epoch=m_global.load(std::memory_order_seq_cst);
+        if(r->sealed_tail!=nullptr){
+            r->sealed_tail->next=b;
+        }
+        else{
+            r->sealed_head=b;
+        }
+        r->sealed_tail=b;
+        m_pending.fetch_add(b->count, std::memory_order_relaxed);
+    }
+
+    // 尝试推进纪元，释放本线程和已退出线程留下的、已经没有读者的袋子
+    void collect(record* r){
+        try_advance();
+        const size_t e=m_global.load(std::memory_order_acquire);
+        free_until(r->sealed_head, r->sealed_tail, e);
+        if(m_has_orphans.load(std::memory_order_relaxed) && m_orphan_mutex.try_lock()){
+            free_until(m_orphan_head, m_orphan_tail, e);
+            m_has_orphans.store(m_orphan_head!=nullptr, std::memory_order_relaxed);
+            m_orphan_mutex.unlock();
+        }
+    }
+
+    // 从链表头部释放纪元不晚于 e-2 的袋子；孤儿链表由多个线程拼接而成，纪元不一定有序，
+    // 遇到第一个不能释放的袋子就停下，剩下的留到下次
+    void free_until(bag*& head, bag*& tail, size_t e){
+        while(head!=nullptr && head->epoch+2<=e){
+            bag* b=head;
+            head=b->next;
+            for(size_t i=0; i<b->count; ++i){
+                b->items[i].deleter(b->items[i].ptr);
+            }
+            m_pending.fetch_sub(b->count, std::memory_order_relaxed);
+            delete_bag(b);
+        }
+        if(head==nullptr){
+            tail=nullptr;
+        }
+    }
+
+    static bag* new_bag(){
+        bag* b=mystl::allocator<bag>::allocate();
+        mystl::construct(b);
+        return b;
+    }
+
+    static void delete_bag(bag* b) noexcept{
+        mystl::destroy(b);
+        mystl::allocator<bag>::deallocate(b);
+    }
+};
+
+// epoch_guard：在作用域内钉住当前线程，期间读到的共享指针不会被释放
+class epoch_guard
+{
+public:
+    epoch_guard() { epoch_domain::instance().pin(); }
+    ~epoch_guard() { epoch_domain::instance().unpin(); }
+
+    epoch_guard(const epoch_guard&)=delete;
+    epoch_guard& operator=(const epoch_guard&)=delete;
+};
+
+} // namespace mystl
+
+#endif
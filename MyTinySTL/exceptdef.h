@@ -0,0 +1,30 @@
+#ifndef MYTINYSTL_EXCEPTDEF_H_
+#define MYTINYSTL_EXCEPTDEF_H_
+
+// 这个文件中定义了异常相关的宏
+
+#include <stdexcept>
+#include <cassert>
+
+namespace mystl
+{
+
+// 调试断言，定义 NDEBUG 时不做检查
+#define MYSTL_DEBUG(expr) \
+    assert(expr)
+
+#define THROW_LENGTH_ERROR_IF(expr, what) \
+    if ((expr)) throw std::length_error(what)
+
+#define THROW_OUT_OF_RANGE_IF(expr, what) \
+    if ((expr)) throw std::out_of_range(what)
+
+#define THROW_RUNTIME_ERROR_IF(expr, what) \
+    if ((expr)) throw std::runtime_error(what)
+
+#define THROW_OVERFLOW_ERROR_IF(expr, what) \
+    if ((expr)) throw std::overflow_error(what)
+
+} // namespace mystl
+
+#endif
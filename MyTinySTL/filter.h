@@ -0,0 +1,691 @@
+#ifndef MYTINYSTL_FILTER_H_
+#define MYTINYSTL_FILTER_H_
+
+// 这个头文件包含两个近似成员查询的过滤器：blocked_bloom_filter 和 cuckoo_filter
+    // 过滤器只保存键的哈希值的一部分：contains 为假时键一定没有插入过，为真时有一定的概率是假阳性，
+    // 用于在访问磁盘、网络或更大的哈希表之前，廉价地排除不存在的键
+    // 键先用 Hash 求哈希值，再用 hash_mix64 打散，之后所有的位置都从这一个 64 位值中切出来，每个键只求一次哈希；
+    // 切分只用乘法、移位和掩码，没有分支，一批键可以逐个独立地计算
+    // blocked_bloom_filter：每个键只落在一个 64 字节的块（一条缓存行）中，在块的 8 个字中各置一位，
+    // 插入和查询都只访问一条缓存行；不能删除
+    // cuckoo_filter：每个桶 4 个 16 位的指纹，键放在两个候选桶之一，支持删除；查询访问两个 8 字节的桶
+    // contains_batch 先求出一批键的哈希值和要访问的缓存行并全部预取，再逐个判断，多次缓存未命中的等待相互重叠
+    // serialize/deserialize 把过滤器写成、读回一段平坦的字节缓冲区（本机字节序），可以直接写入文件或发送
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#include "allocator.h"
+#include "bitset.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 公共部分
+/*****************************************************************************************/
+
+// contains_batch 每一轮预取的键数：足以让十几次缓存未命中同时进行，哈希值和地址都放在栈上
+constexpr size_t filter_batch=16;
+
+// 块数、桶数的上限：块号和桶号取自哈希值的高 32 位
+constexpr uint64_t filter_max_slots=uint64_t(1) << 32;
+
+// 把 x 映射到 [0, n)：乘法取高位，比取模快，n 不需要是 2 的幂
+constexpr uint32_t filter_reduce(uint32_t x, uint64_t n) noexcept{
+    return static_cast<uint32_t>((static_cast<uint64_t>(x)*n) >> 32);
+}
+
+// 序列化的格式：头部之后紧跟着全部的块或桶
+constexpr uint32_t filter_version=1;
+
+struct filter_header
+{
+    uint32_t magic;     // 过滤器的种类
+    uint32_t version;
+    uint64_t slots;     // 块数或桶数
+    uint64_t count;     // 插入的键数
+    uint64_t extra;     // cuckoo_filter 暂存的指纹，blocked_bloom_filter 为 0
+};
+
+inline void filter_write(void* out, const filter_header& header, const void* slots, size_t bytes) noexcept{
+    unsigned char* p=static_cast<unsigned char*>(out);
+    std::memcpy(p, &header, sizeof(header));
+    std::memcpy(p+sizeof(header), slots, bytes);
+}
+
+// 检查 data 是否是 magic 种类、每个块或桶 slot_bytes 字节的序列化结果，返回头部
+inline filter_header filter_read_header(const void* data, size_t size, uint32_t magic, size_t slot_bytes){
+    filter_header header;
+    THROW_RUNTIME_ERROR_IF(data==nullptr || size<sizeof(header), "filter: truncated buffer");
+    std::memcpy(&header, data, sizeof(header));
+    THROW_RUNTIME_ERROR_IF(header.magic!=magic || header.version!=filter_version, "filter: bad header");
+    THROW_RUNTIME_ERROR_IF(header.slots==0 || header.slots>filter_max_slots
+                           || size-sizeof(header)!=header.slots*slot_bytes, "filter: size mismatch");
+    return header;
+}
+
+/*****************************************************************************************/
+// blocked_bloom_filter：分块的布隆过滤器
+    // 哈希值的高 32 位选出块，低 32 位分别乘以 8 个奇数常数、取乘积的高 6 位，在块的第 i 个字中选出一位
+    // 普通的布隆过滤器每个键访问 k 条随机的缓存行；分块后只有一条，代价是各块的负载不均匀，
+    // 同样的位数下假阳性率略高（负载服从泊松分布，theoretical_fpp 按此计算），构造时已经计入
+/*****************************************************************************************/
+
+// 块内选位用的乘数
+constexpr uint32_t bloom_salt[8]={
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+};
+
+// 模板参数 Key 代表键的类型，Hash 代表哈希函数，Alloc 代表分配器类型，会被 rebind 到 bit_block
+template <class Key, class Hash=std::hash<Key>, class Alloc=mystl::allocator<bit_word>>
+class blocked_bloom_filter
+{
+public:
+    typedef Key     key_type;
+    typedef Hash    hasher;
+    typedef Alloc   allocator_type;
+    typedef size_t  size_type;
+
+    static constexpr size_type block_bits=sizeof(bit_block)*8;
+    static constexpr uint32_t magic=0x464c424du;  // "MBLF"
+
+private:
+    typedef mystl::rebind_alloc<Alloc, bit_block>  block_allocator;
+
+    static constexpr size_type block_words=sizeof(bit_block)/sizeof(bit_word);
+
+    mystl::compressed_pair<block_allocator, bit_block*> m_blocks;
+    mystl::compressed_pair<hasher, size_type>           m_count;   // 哈希函数和插入的键数
+    size_type m_block_count;
+
+public:
+    // 构造、复制、移动、析构函数
+    // 按预计的键数和目标假阳性率选择块数，实际插入的键数越多，假阳性率越高
+    explicit blocked_bloom_filter(size_type expected_items, double fpp=0.01, const hasher& hash=hasher(),
+                                  const allocator_type& a=allocator_type())
+        : m_blocks(block_allocator(a), nullptr), m_count(hash, 0), m_block_count(0){
+        allocate(blocks_for(expected_items, fpp));
+    }
+
+    blocked_bloom_filter(const blocked_bloom_filter& rhs)
+        : m_blocks(rhs.m_blocks.first(), nullptr), m_count(rhs.m_count.first(), rhs.size()), m_block_count(0){
+        allocate(rhs.m_block_count);
+        mystl::copy(rhs.words(), rhs.words()+rhs.word_count(), words());
+    }
+
+    blocked_bloom_filter(blocked_bloom_filter&& rhs) noexcept
+        : m_blocks(rhs.m_blocks.first(), nullptr), m_count(rhs.m_count.first(), 0), m_block_count(0){
+        swap(rhs);
+    }
+
+    blocked_bloom_filter& operator=(const blocked_bloom_filter& rhs){
+        if(this!=&rhs){
+            blocked_bloom_filter tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    blocked_bloom_filter& operator=(blocked_bloom_filter&& rhs) noexcept{
+        if(this!=&rhs){
+            blocked_bloom_filter tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~blocked_bloom_filter(){
+        if(m_blocks.second()!=nullptr){
+            m_blocks.first().deallocate(m_blocks.second(), m_block_count);
+        }
+    }
+
+    allocator_type get_allocator() const { return allocator_type(m_blocks.first()); }
+    hasher hash_function() const { return m_count.first(); }
+
+    // 容量相关操作
+    size_type size() const noexcept { return m_count.second(); }
+    bool empty() const noexcept { return size()==0; }
+    size_type block_count() const noexcept { return m_block_count; }
+    size_type bit_count() const noexcept { return m_block_count*block_bits; }
+
+    // 被置为 1 的位数，除以 bit_count() 就是填充率
+    size_type set_bits() const noexcept { return bit_words_count(words(), word_count()); }
+
+    // 按当前的键数估计的假阳性率
+    double expected_fpp() const noexcept{
+        return theoretical_fpp(static_cast<double>(size())/static_cast<double>(m_block_count));
+    }
+
+    // 平均每块 load 个键时的假阳性率：块中有 j 个键时，每个字中查询的那一位为 1 的概率是 1-(63/64)^j，
+    // 8 个字都为 1 才是假阳性；j 服从均值为 load 的泊松分布
+    static double theoretical_fpp(double load) noexcept{
+        if(!(load>0.0)){
+            return 0.0;
+        }
+        const double spread=12.0*std::sqrt(load)+20.0;
+        const double lo=load>spread ? std::floor(load-spread) : 0.0;
+        const double hi=std::ceil(load+spread);
+        double fpp=0.0;
+        for(double j=lo; j<=hi; j+=1.0){
+            const double pmf=std::exp(j*std::log(load)-load-std::lgamma(j+1.0));
+            const double bit=1.0-std::pow(1.0-1.0/bit_word_bits, j);
+            fpp+=pmf*std::pow(bit, static_cast<double>(block_words));
+        }
+        return fpp;
+    }
+
+    // 容纳 expected_items 个键、假阳性率不超过 fpp 所需的块数：从每个键 2 位起逐步增加，每个键最多 64 位
+    static size_type blocks_for(size_type expected_items, double fpp){
+        THROW_OUT_OF_RANGE_IF(!(fpp>0.0 && fpp<1.0), "blocked_bloom_filter: fpp must be in (0, 1)");
+        double bits_per_item=2.0;
+        while(bits_per_item<64.0 && theoretical_fpp(block_bits/bits_per_item)>fpp){
+            bits_per_item+=0.25;
+        }
+        const double blocks=std::ceil(static_cast<double>(expected_items)*bits_per_item/block_bits);
+        THROW_LENGTH_ERROR_IF(blocks>static_cast<double>(filter_max_slots), "blocked_bloom_filter too large");
+        return blocks<1.0 ? 1 : static_cast<size_type>(blocks);
+    }
+
+    // 插入、查询
+    void insert(const key_type& key) { insert_hash(hash_of(key)); }
+
+    template <class InputIter>
+    void insert(InputIter first, InputIter last){
+        for(; first!=last; ++first){
+            insert(*first);
+        }
+    }
+
+    // 直接使用已经打散的 64 位哈希值，调用者自己负责哈希时使用
+    void insert_hash(uint64_t h) noexcept{
+        bit_word* w=block_of(h)->words;
+        const uint32_t lo=static_cast<uint32_t>(h);
+        for(size_type i=0; i<block_words; ++i){
+            w[i]|=bit_of(lo, i);
+        }
+        ++m_count.second();
+    }
+
+    bool contains(const key_type& key) const { return contains_hash(hash_of(key)); }
+
+    bool contains_hash(uint64_t h) const noexcept { return probe(block_of(h), static_cast<uint32_t>(h)); }
+
+    // 批量查询：out[i] 为 keys[i] 的查询结果
+    void contains_batch(const key_type* keys, size_type n, bool* out) const{
+        uint64_t hashes[filter_batch];
+        for(size_type i=0; i<n; i+=filter_batch){
+            const size_type m=mystl::min(filter_batch, n-i);
+            for(size_type j=0; j<m; ++j){
+                hashes[j]=hash_of(keys[i+j]);
+            }
+            contains_hash_batch(hashes, m, out+i);
+        }
+    }
+
+    void contains_hash_batch(const uint64_t* hashes, size_type n, bool* out) const noexcept{
+        const bit_block* blocks[filter_batch];
+        for(size_type i=0; i<n; i+=filter_batch){
+            const size_type m=mystl::min(filter_batch, n-i);
+            for(size_type j=0; j<m; ++j){
+                blocks[j]=block_of(hashes[i+j]);
+                mystl::prefetch(blocks[j]);
+            }
+            for(size_type j=0; j<m; ++j){
+                out[i+j]=probe(blocks[j], static_cast<uint32_t>(hashes[i+j]));
+            }
+        }
+    }
+
+    void clear() noexcept{
+        mystl::fill_n(words(), word_count(), bit_word(0));
+        m_count.second()=0;
+    }
+
+    // 合并另一个块数相同的过滤器，结果相当于两者插入过的键都插入到一个过滤器中
+    blocked_bloom_filter& operator|=(const blocked_bloom_filter& rhs) noexcept{
+        MYSTL_DEBUG(m_block_count==rhs.m_block_count);
+        bit_words_apply(simd::bit_op_kind::or_op, words(), rhs.words(), word_count());
+        m_count.second()+=rhs.size();
+        return *this;
+    }
+
+    // 序列化
+    size_type serialized_size() const noexcept { return sizeof(filter_header)+m_block_count*sizeof(bit_block); }
+
+    // out 至少有 serialized_size() 字节，不要求对齐
+    void serialize(void* out) const noexcept{
+        filter_header header={magic, filter_version, m_block_count, size(), 0};
+        filter_write(out, header, m_blocks.second(), m_block_count*sizeof(bit_block));
+    }
+
+    // 从 serialize 的结果恢复，缓冲区的格式或大小不对时抛出 runtime_error
+    static blocked_bloom_filter deserialize(const void* data, size_type size, const hasher& hash=hasher(),
+                                            const allocator_type& a=allocator_type()){
+        const filter_header header=filter_read_header(data, size, magic, sizeof(bit_block));
+        blocked_bloom_filter r(hash, a);
+        r.allocate(static_cast<size_type>(header.slots));
+        std::memcpy(r.m_blocks.second(), static_cast<const unsigned char*>(data)+sizeof(header),
+                    r.m_block_count*sizeof(bit_block));
+        r.m_count.second()=static_cast<size_type>(header.count);
+        return r;
+    }
+
+    bool operator==(const blocked_bloom_filter& rhs) const noexcept{
+        return m_block_count==rhs.m_block_count && mystl::equal(words(), words()+word_count(), rhs.words());
+    }
+
+    bool operator!=(const blocked_bloom_filter& rhs) const noexcept { return !(*this==rhs); }
+
+    void swap(blocked_bloom_filter& rhs) noexcept{
+        mystl::swap(m_blocks.first(), rhs.m_blocks.first());
+        mystl::swap(m_blocks.second(), rhs.m_blocks.second());
+        mystl::swap(m_count.first(), rhs.m_count.first());
+        mystl::swap(m_count.second(), rhs.m_count.second());
+        mystl::swap(m_block_count, rhs.m_block_count);
+    }
+
+private:
+    // 还没有分配存储的空过滤器，只在 deserialize 中使用
+    blocked_bloom_filter(const hasher& hash, const allocator_type& a)
+        : m_blocks(block_allocator(a), nullptr), m_count(hash, 0), m_block_count(0) {}
+
+    bit_word* words() noexcept { return reinterpret_cast<bit_word*>(m_blocks.second()); }
+    const bit_word* words() const noexcept { return reinterpret_cast<const bit_word*>(m_blocks.second()); }
+    size_type word_count() const noexcept { return m_block_count*block_words; }
+
+    uint64_t hash_of(const key_type& key) const{
+        return hash_mix64(static_cast<uint64_t>(m_count.first()(key)));
+    }
+
+    bit_block* block_of(uint64_t h) const noexcept{
+        return m_blocks.second()+filter_reduce(static_cast<uint32_t>(h >> 32), m_block_count);
+    }
+
+    static bit_word bit_of(uint32_t lo, size_type i) noexcept{
+        return bit_word(1) << ((lo*bloom_salt[i]) >> 26);
+    }
+
+    // 8 个字中选出的位都为 1 时为真；不提前退出，8 次与、或没有分支
+    static bool probe(const bit_block* block, uint32_t lo) noexcept{
+        bit_word miss=0;
+        for(size_type i=0; i<block_words; ++i){
+            miss|=~block->words[i] & bit_of(lo, i);
+        }
+        return miss==0;
+    }
+
+    // 分配 blocks 块并清零
+    void allocate(size_type blocks){
+        bit_block* b=m_blocks.first().allocate(blocks);
+        mystl::fill_n(reinterpret_cast<bit_word*>(b), blocks*block_words, bit_word(0));
+        m_blocks.second()=b;
+        m_block_count=blocks;
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class Alloc>
+void swap(blocked_bloom_filter<Key, Hash, Alloc>& lhs, blocked_bloom_filter<Key, Hash, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// cuckoo_filter：布谷鸟过滤器
+    // 每个桶是一个 64 位的字，存放 4 个 16 位的指纹，指纹为 0 表示空槽位；桶数是 2 的幂
+    // 指纹取哈希值的低 16 位，第一个候选桶取高 32 位，第二个候选桶是 i^(指纹*常数)，
+    // 只知道指纹和其中一个桶就能算出另一个，挤出指纹时不需要原来的键
+    // 两个候选桶都满时随机挤出一个指纹，把它搬到它的另一个候选桶，最多重复 max_kicks 次；
+    // 仍然失败时把最后被挤出的指纹暂存起来，过滤器视为已满，之后的 insert 返回 false，直到 erase 腾出位置
+    // 桶内的查找、找空槽位用 SWAR 一次比较 4 个指纹，没有循环
+    // erase 只能删除插入过的键，删除没有插入过的键可能删掉另一个键的指纹，使它变成假阴性
+/*****************************************************************************************/
+
+constexpr uint64_t cuckoo_lane_low=0x0001000100010001ull;
+constexpr uint64_t cuckoo_lane_high=0x8000800080008000ull;
+
+// 桶中等于 fp 的槽位，对应的 16 位的最高位为 1；更高的槽位可能因借位被误标，但最低的那个一定准确，
+// 所以只用来判断有无，或者取最低的槽位
+constexpr uint64_t cuckoo_match(uint64_t bucket, uint16_t fp) noexcept{
+    const uint64_t x=bucket^(cuckoo_lane_low*fp);
+    return (x-cuckoo_lane_low) & ~x & cuckoo_lane_high;
+}
+
+// 模板参数 Key 代表键的类型，Hash 代表哈希函数，Alloc 代表分配器类型，会被 rebind 到 uint64_t
+template <class Key, class Hash=std::hash<Key>, class Alloc=mystl::allocator<uint64_t>>
+class cuckoo_filter
+{
+public:
+    typedef Key       key_type;
+    typedef Hash      hasher;
+    typedef Alloc     allocator_type;
+    typedef size_t    size_type;
+    typedef uint16_t  fingerprint_type;
+
+    static constexpr size_type bucket_slots=4;
+    static constexpr size_type max_kicks=500;
+    static constexpr double max_load_factor=0.95;
+    static constexpr uint32_t magic=0x464b434du;  // "MCKF"
+
+private:
+    typedef mystl::rebind_alloc<Alloc, uint64_t>  bucket_allocator;
+
+    mystl::compressed_pair<bucket_allocator, uint64_t*> m_buckets;
+    mystl::compressed_pair<hasher, size_type>           m_count;   // 哈希函数和插入的键数
+    size_type m_mask;     // 桶数减一
+    uint64_t  m_victim;   // 暂存的指纹：(桶号<<16)|指纹，为 0 时没有
+    uint64_t  m_random;   // 选择挤出的槽位用的 xorshift 状态
+
+public:
+    // 构造、复制、移动、析构函数
+    // 保证能插入 capacity 个键：桶数是让负载不超过 max_load_factor 的最小的 2 的幂
+    explicit cuckoo_filter(size_type capacity, const hasher& hash=hasher(), const allocator_type& a=allocator_type())
+        : cuckoo_filter(hash, a){
+        allocate(buckets_for(capacity));
+    }
+
+    cuckoo_filter(const cuckoo_filter& rhs): cuckoo_filter(rhs.m_count.first(), allocator_type(rhs.m_buckets.first())){
+        allocate(rhs.bucket_count());
+        mystl::copy(rhs.m_buckets.second(), rhs.m_buckets.second()+rhs.bucket_count(), m_buckets.second());
+        m_count.second()=rhs.size();
+        m_victim=rhs.m_victim;
+        m_random=rhs.m_random;
+    }
+
+    cuckoo_filter(cuckoo_filter&& rhs) noexcept
+        : cuckoo_filter(rhs.m_count.first(), allocator_type(rhs.m_buckets.first())){
+        swap(rhs);
+    }
+
+    cuckoo_filter& operator=(const cuckoo_filter& rhs){
+        if(this!=&rhs){
+            cuckoo_filter tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    cuckoo_filter& operator=(cuckoo_filter&& rhs) noexcept{
+        if(this!=&rhs){
+            cuckoo_filter tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~cuckoo_filter(){
+        if(m_buckets.second()!=nullptr){
+            m_buckets.first().deallocate(m_buckets.second(), bucket_count());
+        }
+    }
+
+    allocator_type get_allocator() const { return allocator_type(m_buckets.first()); }
+    hasher hash_function() const { return m_count.first(); }
+
+    // 容量相关操作
+    size_type size() const noexcept { return m_count.second(); }
+    bool empty() const noexcept { return size()==0; }
+    size_type bucket_count() const noexcept { return m_buckets.second()==nullptr ? 0 : m_mask+1; }
+    size_type slot_count() const noexcept { return bucket_count()*bucket_slots; }
+    double load_factor() const noexcept { return static_cast<double>(size())/static_cast<double>(slot_count()); }
+
+    // 暂存了被挤出的指纹时为真，此时 insert 总是失败
+    bool full() const noexcept { return m_victim!=0; }
+
+    // 按当前负载估计的假阳性率：查询比较两个桶共 8 个槽位，每个槽位以 load_factor 的概率有指纹，
+    // 有指纹时与查询的指纹相等的概率是 1/65535
+    double expected_fpp() const noexcept { return theoretical_fpp(load_factor()); }
+
+    static double theoretical_fpp(double load) noexcept{
+        return 1.0-std::pow(1.0-1.0/65535.0, 2.0*bucket_slots*load);
+    }
+
+    static size_type buckets_for(size_type capacity){
+        const double need=std::ceil(static_cast<double>(capacity)/(bucket_slots*max_load_factor));
+        THROW_LENGTH_ERROR_IF(need>static_cast<double>(filter_max_slots), "cuckoo_filter too large");
+        size_type buckets=2;
+        while(static_cast<double>(buckets)<need){
+            buckets*=2;
+        }
+        return buckets;
+    }
+
+    // 插入、删除、查询
+    // 过滤器已满时返回 false；同一个键可以插入多次，每次占用一个槽位
+    bool insert(const key_type& key) { return insert_hash(hash_of(key)); }
+
+    bool insert_hash(uint64_t h) noexcept{
+        if(m_victim!=0){
+            return false;
+        }
+        ++m_count.second();
+        const fingerprint_type fp=fingerprint_of(h);
+        const size_type i1=index_of(h);
+        const size_type i2=alt_index(i1, fp);
+        if(!try_add(i1, fp) && !try_add(i2, fp)){
+            relocate((next_random() & 1) ? i1 : i2, fp);
+        }
+        return true;
+    }
+
+    // 删除一个键的一个指纹，没有找到时返回 false
+    bool erase(const key_type& key) { return erase_hash(hash_of(key)); }
+
+    bool erase_hash(uint64_t h) noexcept{
+        const fingerprint_type fp=fingerprint_of(h);
+        const size_type i1=index_of(h);
+        const size_type i2=alt_index(i1, fp);
+        if(try_remove(i1, fp) || try_remove(i2, fp)){
+            --m_count.second();
+            reinsert_victim();
+            return true;
+        }
+        if(victim_matches(i1, i2, fp)){
+            m_victim=0;
+            --m_count.second();
+            return true;
+        }
+        return false;
+    }
+
+    bool contains(const key_type& key) const { return contains_hash(hash_of(key)); }
+
+    bool contains_hash(uint64_t h) const noexcept{
+        const fingerprint_type fp=fingerprint_of(h);
+        const size_type i1=index_of(h);
+        return probe(i1, alt_index(i1, fp), fp);
+    }
+
+    // 批量查询：out[i] 为 keys[i] 的查询结果
+    void contains_batch(const key_type* keys, size_type n, bool* out) const{
+        uint64_t hashes[filter_batch];
+        for(size_type i=0; i<n; i+=filter_batch){
+            const size_type m=mystl::min(filter_batch, n-i);
+            for(size_type j=0; j<m; ++j){
+                hashes[j]=hash_of(keys[i+j]);
+            }
+            contains_hash_batch(hashes, m, out+i);
+        }
+    }
+
+    void contains_hash_batch(const uint64_t* hashes, size_type n, bool* out) const noexcept{
+        size_type first[filter_batch], second[filter_batch];
+        for(size_type i=0; i<n; i+=filter_batch){
+            const size_type m=mystl::min(filter_batch, n-i);
+            for(size_type j=0; j<m; ++j){
+                first[j]=index_of(hashes[i+j]);
+                second[j]=alt_index(first[j], fingerprint_of(hashes[i+j]));
+                mystl::prefetch(m_buckets.second()+first[j]);
+                mystl::prefetch(m_buckets.second()+second[j]);
+            }
+            for(size_type j=0; j<m; ++j){
+                out[i+j]=probe(first[j], second[j], fingerprint_of(hashes[i+j]));
+            }
+        }
+    }
+
+    void clear() noexcept{
+        mystl::fill_n(m_buckets.second(), bucket_count(), uint64_t(0));
+        m_count.second()=0;
+        m_victim=0;
+    }
+
+    // 序列化
+    size_type serialized_size() const noexcept { return sizeof(filter_header)+bucket_count()*sizeof(uint64_t); }
+
+    // out 至少有 serialized_size() 字节，不要求对齐
+    void serialize(void* out) const noexcept{
+        filter_header header={magic, filter_version, bucket_count(), size(), m_victim};
+        filter_write(out, header, m_buckets.second(), bucket_count()*sizeof(uint64_t));
+    }
+
+    // 从 serialize 的结果恢复，缓冲区的格式或大小不对时抛出 runtime_error
+    static cuckoo_filter deserialize(const void* data, size_type size, const hasher& hash=hasher(),
+                                     const allocator_type& a=allocator_type()){
+        const filter_header header=filter_read_header(data, size, magic, sizeof(uint64_t));
+        THROW_RUNTIME_ERROR_IF((header.slots&(header.slots-1))!=0 || header.slots<2
+                               || (header.extra>>16)>=header.slots
+                               || (header.extra!=0 && static_cast<fingerprint_type>(header.extra)==0),
+                               "cuckoo_filter: bad header");
+        cuckoo_filter r(hash, a);
+        r.allocate(static_cast<size_type>(header.slots));
+        std::memcpy(r.m_buckets.second(), static_cast<const unsigned char*>(data)+sizeof(header),
+                    r.bucket_count()*sizeof(uint64_t));
+        r.m_count.second()=static_cast<size_type>(header.count);
+        r.m_victim=header.extra;
+        return r;
+    }
+
+    bool operator==(const cuckoo_filter& rhs) const noexcept{
+        return bucket_count()==rhs.bucket_count() && m_victim==rhs.m_victim
+            && mystl::equal(m_buckets.second(), m_buckets.second()+bucket_count(), rhs.m_buckets.second());
+    }
+
+    bool operator!=(const cuckoo_filter& rhs) const noexcept { return !(*this==rhs); }
+
+    void swap(cuckoo_filter& rhs) noexcept{
+        mystl::swap(m_buckets.first(), rhs.m_buckets.first());
+        mystl::swap(m_buckets.second(), rhs.m_buckets.second());
+        mystl::swap(m_count.first(), rhs.m_count.first());
+        mystl::swap(m_count.second(), rhs.m_count.second());
+        mystl::swap(m_mask, rhs.m_mask);
+        mystl::swap(m_victim, rhs.m_victim);
+        mystl::swap(m_random, rhs.m_random);
+    }
+
+private:
+    // 还没有分配存储的空过滤器
+    cuckoo_filter(const hasher& hash, const allocator_type& a)
+        : m_buckets(bucket_allocator(a), nullptr), m_count(hash, 0), m_mask(0), m_victim(0),
+          m_random(0x9e3779b97f4a7c15ull) {}
+
+    uint64_t hash_of(const key_type& key) const{
+        return hash_mix64(static_cast<uint64_t>(m_count.first()(key)));
+    }
+
+    // 指纹不能为 0，0 表示空槽位
+    static fingerprint_type fingerprint_of(uint64_t h) noexcept{
+        const fingerprint_type fp=static_cast<fingerprint_type>(h);
+        return fp==0 ? 1 : fp;
+    }
+
+    size_type index_of(uint64_t h) const noexcept { return static_cast<size_type>(h >> 32) & m_mask; }
+
+    // 另一个候选桶：异或同一个值两次回到原来的桶
+    size_type alt_index(size_type i, fingerprint_type fp) const noexcept{
+        return (i^(static_cast<uint32_t>(fp)*0x5bd1e995u)) & m_mask;
+    }
+
+    bool victim_matches(size_type i1, size_type i2, fingerprint_type fp) const noexcept{
+        const size_type i=static_cast<size_type>(m_victim >> 16);
+        return m_victim!=0 && static_cast<fingerprint_type>(m_victim)==fp && (i==i1 || i==i2);
+    }
+
+    bool probe(size_type i1, size_type i2, fingerprint_type fp) const noexcept{
+        const uint64_t* b=m_buckets.second();
+        return (cuckoo_match(b[i1], fp) | cuckoo_match(b[i2], fp))!=0 || victim_matches(i1, i2, fp);
+    }
+
+    // 放入桶 i 的第一个空槽位
+    bool try_add(size_type i, fingerprint_type fp) noexcept{
+        uint64_t& b=m_buckets.second()[i];
+        const uint64_t empty=cuckoo_match(b, 0);
+        if(empty==0){
+            return false;
+        }
+        b|=static_cast<uint64_t>(fp) << (bit_ctz(empty)-15);
+        return true;
+    }
+
+    // 删除桶 i 中的一个 fp
+    bool try_remove(size_type i, fingerprint_type fp) noexcept{
+        uint64_t& b=m_buckets.second()[i];
+        const uint64_t found=cuckoo_match(b, fp);
+        if(found==0){
+            return false;
+        }
+        b&=~(uint64_t(0xffff) << (bit_ctz(found)-15));
+        return true;
+    }
+
+    // fp 属于桶 i 而桶 i 已满：挤出一个随机的指纹，放入它的另一个候选桶，直到有空槽位或达到 max_kicks
+    void relocate(size_type i, fingerprint_type fp) noexcept{
+        for(size_type kick=0; kick<max_kicks; ++kick){
+            const size_type shift=(next_random() & (bucket_slots-1))*16;
+            uint64_t& b=m_buckets.second()[i];
+            const fingerprint_type out=static_cast<fingerprint_type>(b >> shift);
+            b=(b & ~(uint64_t(0xffff) << shift)) | (static_cast<uint64_t>(fp) << shift);
+            fp=out;
+            i=alt_index(i, fp);
+            if(try_add(i, fp)){
+                return;
+            }
+        }
+        m_victim=(static_cast<uint64_t>(i) << 16) | fp;
+    }
+
+    // erase 腾出槽位后，把暂存的指纹放回表中
+    void reinsert_victim() noexcept{
+        if(m_victim==0){
+            return;
+        }
+        const size_type i=static_cast<size_type>(m_victim >> 16);
+        const fingerprint_type fp=static_cast<fingerprint_type>(m_victim);
+        m_victim=0;
+        if(!try_add(i, fp) && !try_add(alt_index(i, fp), fp)){
+            relocate(i, fp);
+        }
+    }
+
+    uint64_t next_random() noexcept{
+        m_random^=m_random << 13;
+        m_random^=m_random >> 7;
+        m_random^=m_random << 17;
+        return m_random >> 32;
+    }
+
+    // 分配 buckets 个桶并清零，buckets 是 2 的幂
+    void allocate(size_type buckets){
+        uint64_t* b=m_buckets.first().allocate(buckets);
+        mystl::fill_n(b, buckets, uint64_t(0));
+        m_buckets.second()=b;
+        m_mask=buckets-1;
+    }
+};
+
+// 重载 mystl 的 swap
+template <class Key, class Hash, class Alloc>
+void swap(cuckoo_filter<Key, Hash, Alloc>& lhs, cuckoo_filter<Key, Hash, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef MYTINYSTL_FUNCTIONAL_H_
+#define MYTINYSTL_FUNCTIONAL_H_
+
+// 这个头文件包含了 mystl 的函数对象（仿函数）
+// 都是无状态的空类，作为容器的比较器存放在 compressed_pair 中时不占空间
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mystl
+{
+
+// 算术类仿函数
+template <class T>
+struct plus
+{
+    constexpr T operator()(const T& x, const T& y) const { return x + y; }
+};
+
+template <class T>
+struct minus
+{
+    constexpr T operator()(const T& x, const T& y) const { return x - y; }
+};
+
+template <class T>
+struct multiplies
+{
+    constexpr T operator()(const T& x, const T& y) const { return x * y; }
+};
+
+// 关系运算类仿函数
+template <class T>
+struct equal_to
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x == y; }
+};
+
+template <class T>
+struct not_equal_to
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x != y; }
+};
+
+template <class T>
+struct greater
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x > y; }
+};
+
+template <class T>
+struct less
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x < y; }
+};
+
+template <class T>
+struct greater_equal
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x >= y; }
+};
+
+template <class T>
+struct less_equal
+{
+    constexpr bool operator()(const T& x, const T& y) const { return x <= y; }
+};
+
+// 证同函数：不改变元素，返回本身
+template <class T>
+struct identity
+{
+    constexpr const T& operator()(const T& x) const { return x; }
+};
+
+// 哈希值的混合（splitmix64 的终结函数）：输入的每一位都影响输出的每一位
+    // std::hash 对整数是恒等映射，低位、高位往往集中在很小的范围；需要从一个哈希值中切出多段独立的位时
+    // （过滤器的块号和块内的位、桶号和指纹），先用它打散；只有移位、异或和乘法，对一批哈希值逐个调用时没有分支
+constexpr uint64_t hash_mix64(uint64_t x) noexcept{
+    x^=x >> 30;
+    x*=0xbf58476d1ce4e5b9ull;
+    x^=x >> 27;
+    x*=0x94d049bb133111ebull;
+    x^=x >> 31;
+    return x;
+}
+
+} // namespace mystl
+
+#endif
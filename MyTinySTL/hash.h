@@ -0,0 +1,271 @@
+#ifndef MYTINYSTL_HASH_H_
+#define MYTINYSTL_HASH_H_
+
+// 这个头文件包含哈希函数：字节序列的哈希、整数的混合、组合，以及供容器使用的函数对象 hash<T>
+    // hash_bytes：wyhash 风格，每次把两个 64 位字分别与常数异或后做一次 64x64->128 位乘法，把高低两半异或在一起；
+    // 超过 48 字节时三条链交替进行，乘法之间没有依赖；不超过 16 字节的键用几次重叠的读取一次取完，没有循环
+    // hash_u64：整数用 splitmix64 的终结函数（functional.h 的 hash_mix64），是 64 位上的双射，不同的整数没有碰撞
+    // hash_u64_batch：一批整数键交给 simd.h 的向量化内核，与逐个调用 hash_u64 的结果相同
+    // hash<T>：整数、枚举、指针、浮点数、mystl/std 的字符串和字符串视图、mystl::pair（按 is_pair 识别）
+    // 有专门的实现，其他类型先用 std::hash 再用 hash_u64 打散
+// 读取多字节字时使用本机字节序，哈希值只在同一种字节序的机器之间一致；不同版本之间不保证相同，不要持久化
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "basic_string.h"
+#include "functional.h"
+#include "simd.h"
+#include "string_view.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 基本运算
+/*****************************************************************************************/
+
+// wyhash 的常数：每个字节中恰好 4 位为 1 的奇数
+constexpr uint64_t hash_secret[4]={
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+// 64x64->128 位乘法，a 得到低 64 位，b 得到高 64 位
+inline void hash_mum128(uint64_t& a, uint64_t& b) noexcept{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r=static_cast<unsigned __int128>(a)*b;
+    a=static_cast<uint64_t>(r);
+    b=static_cast<uint64_t>(r >> 64);
+#else
+    const uint64_t ha=a >> 32, hb=b >> 32, la=static_cast<uint32_t>(a), lb=static_cast<uint32_t>(b);
+    const uint64_t rh=ha*hb, rm0=ha*lb, rm1=hb*la, rl=la*lb;
+    const uint64_t t=rl+(rm0 << 32);
+    uint64_t c=t<rl;
+    const uint64_t lo=t+(rm1 << 32);
+    c+=lo<t;
+    b=rh+(rm0 >> 32)+(rm1 >> 32)+c;
+    a=lo;
+#endif
+}
+
+// 乘积的高低两半异或：输入的每一位都会影响输出的多数位
+inline uint64_t hash_mum(uint64_t a, uint64_t b) noexcept{
+    hash_mum128(a, b);
+    return a^b;
+}
+
+inline uint64_t hash_read64(const unsigned char* p) noexcept{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t hash_read32(const unsigned char* p) noexcept{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1~3 字节：首、中、尾三个字节拼成一个数，长度不同时在 hash_bytes 的最后一步区分
+inline uint64_t hash_read_small(const unsigned char* p, size_t n) noexcept{
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n-1];
+}
+
+/*****************************************************************************************/
+// 字节序列、整数的哈希与组合
+/*****************************************************************************************/
+
+// 长度为 n 的字节序列的 64 位哈希值
+inline uint64_t hash_bytes(const void* data, size_t n, uint64_t seed=0) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(data);
+    seed^=hash_mum(seed^hash_secret[0], hash_secret[1]);
+    uint64_t a=0, b=0;
+    if(n<=16){
+        if(n>=4){
+            // 4~16 字节：从两端各读两个可能重叠的 32 位字
+            const size_t mid=(n >> 3) << 2;
+            a=(hash_read32(p) << 32) | hash_read32(p+mid);
+            b=(hash_read32(p+n-4) << 32) | hash_read32(p+n-4-mid);
+        }
+        else if(n>0){
+            a=hash_read_small(p, n);
+        }
+    }
+    else{
+        size_t i=n;
+        if(i>48){
+            uint64_t seed1=seed, seed2=seed;
+            do{
+                seed=hash_mum(hash_read64(p)^hash_secret[1], hash_read64(p+8)^seed);
+                seed1=hash_mum(hash_read64(p+16)^hash_secret[2], hash_read64(p+24)^seed1);
+                seed2=hash_mum(hash_read64(p+32)^hash_secret[3], hash_read64(p+40)^seed2);
+                p+=48;
+                i-=48;
+            } while(i>48);
+            seed^=seed1^seed2;
+        }
+        while(i>16){
+            seed=hash_mum(hash_read64(p)^hash_secret[1], hash_read64(p+8)^seed);
+            p+=16;
+            i-=16;
+        }
+        // 最后 16 字节可能与已经处理过的部分重叠，总长度大于 16，不会越过开头
+        a=hash_read64(p+i-16);
+        b=hash_read64(p+i-8);
+    }
+    a^=hash_secret[1];
+    b^=seed;
+    hash_mum128(a, b);
+    return hash_mum(a^hash_secret[0]^n, b^hash_secret[1]);
+}
+
+// 整数的哈希：seed 相同时是 64 位上的双射
+constexpr uint64_t hash_u64(uint64_t x, uint64_t seed=0) noexcept{
+    return hash_mix64(x^seed);
+}
+
+// out[i]=hash_u64(keys[i], seed)，按当前指令集向量化；out 可以与 keys 是同一个数组
+inline void hash_u64_batch(const uint64_t* keys, size_t n, uint64_t* out, uint64_t seed=0) noexcept{
+    simd::hash_words(keys, n, seed, out);
+}
+
+// 把哈希值 h 组合进 seed，组合的顺序不同结果不同；固定其中一个参数时对另一个是双射
+constexpr uint64_t hash_combine(uint64_t seed, uint64_t h) noexcept{
+    return hash_mix64((seed*0x9e3779b97f4a7c15ull)^h);
+}
+
+/*****************************************************************************************/
+// hash_value：按类型选择哈希方式，hash<T> 和 hash_batch 都通过它计算
+/*****************************************************************************************/
+
+struct hash_integer_tag {};
+struct hash_float_tag {};
+struct hash_pointer_tag {};
+struct hash_pair_tag {};
+struct hash_fallback_tag {};
+
+template <class T>
+using hash_category=
+    typename std::conditional<std::is_integral<T>::value || std::is_enum<T>::value, hash_integer_tag,
+    typename std::conditional<std::is_same<T, float>::value || std::is_same<T, double>::value, hash_float_tag,
+    typename std::conditional<std::is_pointer<T>::value, hash_pointer_tag,
+    typename std::conditional<mystl::is_pair<T>::value, hash_pair_tag,
+                              hash_fallback_tag>::type>::type>::type>::type;
+
+template <class T>
+uint64_t hash_value(const T& x);
+
+// 字符串按内容哈希，同样内容的 mystl、std 字符串和字符串视图哈希值相同
+template <class CharT>
+uint64_t hash_value(const basic_string_view<CharT>& s) noexcept{
+    return hash_bytes(s.data(), s.size()*sizeof(CharT));
+}
+
+template <class CharT, class Alloc>
+uint64_t hash_value(const basic_string<CharT, Alloc>& s) noexcept{
+    return hash_bytes(s.data(), s.size()*sizeof(CharT));
+}
+
+template <class CharT, class Traits, class Alloc>
+uint64_t hash_value(const std::basic_string<CharT, Traits, Alloc>& s) noexcept{
+    return hash_bytes(s.data(), s.size()*sizeof(CharT));
+}
+
+template <class CharT, class Traits>
+uint64_t hash_value(const std::basic_string_view<CharT, Traits>& s) noexcept{
+    return hash_bytes(s.data(), s.size()*sizeof(CharT));
+}
+
+template <class T>
+uint64_t hash_value_aux(const T& x, hash_integer_tag) noexcept{
+    return hash_u64(static_cast<uint64_t>(x));
+}
+
+// +0.0 与 -0.0 相等，哈希值也必须相同；float 先转为 double，同一个值的 float 和 double 哈希值相同
+template <class T>
+uint64_t hash_value_aux(const T& x, hash_float_tag) noexcept{
+    const double d=x==0 ? 0.0 : static_cast<double>(x);
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return hash_u64(bits);
+}
+
+// 指针按地址哈希，与 std::hash 相同，const char* 不按字符串内容
+template <class T>
+uint64_t hash_value_aux(const T& x, hash_pointer_tag) noexcept{
+    return hash_u64(reinterpret_cast<uintptr_t>(x));
+}
+
+template <class T>
+uint64_t hash_value_aux(const T& x, hash_pair_tag){
+    return hash_combine(hash_value(x.first), hash_value(x.second));
+}
+
+template <class T>
+uint64_t hash_value_aux(const T& x, hash_fallback_tag){
+    return hash_u64(static_cast<uint64_t>(std::hash<T>()(x)));
+}
+
+template <class T>
+uint64_t hash_value(const T& x){
+    return hash_value_aux(x, hash_category<T>());
+}
+
+// 容器使用的哈希函数对象
+template <class T>
+struct hash
+{
+    size_t operator()(const T& x) const { return static_cast<size_t>(hash_value(x)); }
+};
+
+/*****************************************************************************************/
+// hash_batch：一次计算 n 个键的哈希值，out[i]=hash_value(keys[i])
+    // 整数键（含枚举）走向量化内核：64 位的整数直接传入，更窄的整数和枚举先分段扩展到 64 位；其他类型逐个计算
+/*****************************************************************************************/
+
+// 更窄的整数每段扩展的个数
+constexpr size_t hash_batch_chunk=64;
+
+template <class T>
+void hash_batch_aux(const T* keys, size_t n, uint64_t* out, m_true_type){
+    hash_u64_batch(reinterpret_cast<const uint64_t*>(keys), n, out);
+}
+
+template <class T>
+void hash_batch_aux(const T* keys, size_t n, uint64_t* out, m_false_type){
+    uint64_t wide[hash_batch_chunk];
+    for(size_t i=0; i<n; i+=hash_batch_chunk){
+        const size_t m=mystl::min(hash_batch_chunk, n-i);
+        for(size_t j=0; j<m; ++j){
+            wide[j]=static_cast<uint64_t>(keys[i+j]);
+        }
+        hash_u64_batch(wide, m, out+i);
+    }
+}
+
+template <class T>
+void hash_batch_aux(const T* keys, size_t n, uint64_t* out, hash_integer_tag){
+    hash_batch_aux(keys, n, out, m_bool_constant<std::is_integral<T>::value && sizeof(T)==sizeof(uint64_t)>());
+}
+
+template <class T, class Tag>
+void hash_batch_aux(const T* keys, size_t n, uint64_t* out, Tag){
+    for(size_t i=0; i<n; ++i){
+        out[i]=hash_value(keys[i]);
+    }
+}
+
+template <class T>
+void hash_batch(const T* keys, size_t n, uint64_t* out){
+    hash_batch_aux(keys, n, out, hash_category<T>());
+}
+
+} // namespace mystl
+
+#endif
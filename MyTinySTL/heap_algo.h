@@ -0,0 +1,254 @@
+#ifndef MYTINYSTL_HEAP_ALGO_H_
+#define MYTINYSTL_HEAP_ALGO_H_
+
+// 这个头文件包含堆的算法：push_heap、pop_heap、make_heap、sort_heap、is_heap、is_heap_until
+// 以及它们的 d 叉版本（dary_*），模板参数 Arity 为每个节点的孩子个数，Arity 为 2 时与二叉版本的布局相同
+    // 下标为 i 的节点的孩子为 Arity*i+1 ~ Arity*i+Arity，父节点为 (i-1)/Arity
+    // 孩子在内存中相邻，Arity 为 4、元素为 8 字节时一个节点的 4 个孩子只占半条缓存行，
+    // 树高是二叉堆的一半，下沉时访问的缓存行更少，代价是每层多比较几次
+// 与标准库一致：comp(a, b) 为真表示 a 的优先级低于 b，堆顶是“最大”的元素
+
+#include "algorithm_base.h"
+#include "functional.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl
+{
+
+/*****************************************************************************************/
+// 内部实现：用“空洞”代替交换，沿途的元素只移动一次，最后再把值放进空洞
+/*****************************************************************************************/
+
+// 把 value 从空洞 hole 向上移动，不越过 top
+template <size_t Arity, class RandomIter, class Distance, class T, class Compare>
+void dary_sift_up(RandomIter first, Distance hole, Distance top, T&& value, Compare& comp){
+    Distance parent=(hole-1)/static_cast<Distance>(Arity);
+    while(hole>top && comp(*(first+parent), value)){
+        *(first+hole)=mystl::move(*(first+parent));
+        hole=parent;
+        parent=(hole-1)/static_cast<Distance>(Arity);
+    }
+    *(first+hole)=mystl::move(value);
+}
+
+// dary_select：pick_b 为真时返回 b，否则返回 a
+    // 用掩码而不是 ?:，GCC 对依赖内存读取的 ?: 常常生成分支，而哪个孩子最大是随机的，分支每层都要预测失败
+template <class Distance>
+Distance dary_select(bool pick_b, Distance a, Distance b) noexcept{
+    return a^((a^b)&-static_cast<Distance>(pick_b));
+}
+
+// dary_tournament：[first+lo, first+lo+Count) 中最大的元素的下标，两半各自选出一个再比较一次（锦标赛）
+    // Count 是编译期常量，递归在编译期展开，依赖链只有 log2(Count) 次比较而不是 Count-1 次
+template <size_t Count>
+struct dary_tournament
+{
+    template <class RandomIter, class Distance, class Compare>
+    static Distance best(RandomIter first, Distance lo, Compare& comp){
+        const Distance a=dary_tournament<Count/2>::best(first, lo, comp);
+        const Distance b=dary_tournament<Count-Count/2>::best(first, lo+static_cast<Distance>(Count/2), comp);
+        return dary_select(comp(*(first+a), *(first+b)), a, b);
+    }
+};
+
+template <>
+struct dary_tournament<1>
+{
+    template <class RandomIter, class Distance, class Compare>
+    static Distance best(RandomIter, Distance lo, Compare&){
+        return lo;
+    }
+};
+
+// [child, child+Arity) 中最大的孩子（不超过 len）
+template <size_t Arity, class RandomIter, class Distance, class Compare>
+Distance dary_best_child(RandomIter first, Distance child, Distance len, Compare& comp){
+    if(child+static_cast<Distance>(Arity)<=len){
+        return dary_tournament<Arity>::best(first, child, comp);
+    }
+    // 循环上限同时写出 Arity：次数不超过 Arity-1，也使各个 Arity 的这段代码不同，
+    // GCC 12 会把不同 Arity 中相同的这段循环合并（-fipa-icf），却保留了其中一个推出的 len 的范围，结果出错
+    Distance best=child;
+    for(size_t k=1; k<Arity && child+static_cast<Distance>(k)<len; ++k){
+        const Distance c=child+static_cast<Distance>(k);
+        best=dary_select(comp(*(first+best), *(first+c)), best, c);
+    }
+    return best;
+}
+
+// 从空洞 hole 开始，每层把最大的孩子移上来，空洞一直下沉到叶子，再把 value 从叶子向上移动
+    // pop_heap 放进来的是原来的最后一个元素，通常属于底层，这样每层只需 Arity-1 次比较，省去与 value 的比较
+    // 条件选择使下一层的地址依赖本层的比较结果，CPU 无法像分支那样猜测着提前访问，堆大于缓存时每层都要等一次内存；
+    // 而节点的 Arity*Arity 个孙子在内存中也是相邻的（从 Arity*child+1 开始），比较本层之前先预取它们
+template <size_t Arity, class RandomIter, class Distance, class T, class Compare>
+void dary_adjust_heap(RandomIter first, Distance hole, Distance len, T&& value, Compare& comp){
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const Distance top=hole;
+    const Distance arity=static_cast<Distance>(Arity);
+    const Distance per_line=static_cast<Distance>(
+        sizeof(value_type)<cache_line_size? cache_line_size/sizeof(value_type): 1);
+    Distance child=arity*hole+1;
+    while(child<len){
+        // 按下标步进，地址不超出 [first, first+len)
+        const Distance grandchild=arity*child+1;
+        const Distance grandchild_end=mystl::min(grandchild+arity*arity, len);
+        for(Distance g=grandchild; g<grandchild_end; g+=per_line){
+            mystl::prefetch(&*(first+g));
+        }
+        const Distance best=dary_best_child<Arity>(first, child, len, comp);
+        *(first+hole)=mystl::move(*(first+best));
+        hole=best;
+        child=arity*hole+1;
+    }
+    dary_sift_up<Arity>(first, hole, top, mystl::move(value), comp);
+}
+
+/*****************************************************************************************/
+// d 叉堆
+/*****************************************************************************************/
+
+// dary_push_heap：[first, last-1) 已是堆，把 last-1 处的新元素放到合适的位置
+template <size_t Arity, class RandomIter, class Compare>
+void dary_push_heap(RandomIter first, RandomIter last, Compare comp){
+    static_assert(Arity>=2, "heap arity must be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type distance;
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const distance len=last-first;
+    if(len>1){
+        value_type value=mystl::move(*(last-1));
+        dary_sift_up<Arity>(first, len-1, distance(0), mystl::move(value), comp);
+    }
+}
+
+template <size_t Arity, class RandomIter>
+void dary_push_heap(RandomIter first, RandomIter last){
+    dary_push_heap<Arity>(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// dary_pop_heap：把堆顶移到 last-1，[first, last-1) 重新成为堆
+template <size_t Arity, class RandomIter, class Compare>
+void dary_pop_heap(RandomIter first, RandomIter last, Compare comp){
+    static_assert(Arity>=2, "heap arity must be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type distance;
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const distance len=last-first;
+    if(len>1){
+        value_type value=mystl::move(*(last-1));
+        *(last-1)=mystl::move(*first);
+        dary_adjust_heap<Arity>(first, distance(0), len-1, mystl::move(value), comp);
+    }
+}
+
+template <size_t Arity, class RandomIter>
+void dary_pop_heap(RandomIter first, RandomIter last){
+    dary_pop_heap<Arity>(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// dary_make_heap：从最后一个非叶子节点开始向前逐个调整，O(n)
+template <size_t Arity, class RandomIter, class Compare>
+void dary_make_heap(RandomIter first, RandomIter last, Compare comp){
+    static_assert(Arity>=2, "heap arity must be at least 2");
+    typedef typename iterator_traits<RandomIter>::difference_type distance;
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const distance len=last-first;
+    if(len<2){
+        return;
+    }
+    for(distance parent=(len-2)/static_cast<distance>(Arity)+1; parent>0; --parent){
+        value_type value=mystl::move(*(first+(parent-1)));
+        dary_adjust_heap<Arity>(first, parent-1, len, mystl::move(value), comp);
+    }
+}
+
+template <size_t Arity, class RandomIter>
+void dary_make_heap(RandomIter first, RandomIter last){
+    dary_make_heap<Arity>(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// dary_sort_heap：不断 pop_heap，结果按 comp 升序排列
+template <size_t Arity, class RandomIter, class Compare>
+void dary_sort_heap(RandomIter first, RandomIter last, Compare comp){
+    while(last-first>1){
+        dary_pop_heap<Arity>(first, last--, comp);
+    }
+}
+
+template <size_t Arity, class RandomIter>
+void dary_sort_heap(RandomIter first, RandomIter last){
+    dary_sort_heap<Arity>(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// dary_is_heap_until：第一个比父节点大的元素，没有时返回 last
+template <size_t Arity, class RandomIter, class Compare>
+RandomIter dary_is_heap_until(RandomIter first, RandomIter last, Compare comp){
+    typedef typename iterator_traits<RandomIter>::difference_type distance;
+    const distance len=last-first;
+    for(distance i=1; i<len; ++i){
+        if(comp(*(first+(i-1)/static_cast<distance>(Arity)), *(first+i))){
+            return first+i;
+        }
+    }
+    return last;
+}
+
+template <size_t Arity, class RandomIter>
+RandomIter dary_is_heap_until(RandomIter first, RandomIter last){
+    return dary_is_heap_until<Arity>(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+template <size_t Arity, class RandomIter, class Compare>
+bool dary_is_heap(RandomIter first, RandomIter last, Compare comp){
+    return dary_is_heap_until<Arity>(first, last, comp)==last;
+}
+
+template <size_t Arity, class RandomIter>
+bool dary_is_heap(RandomIter first, RandomIter last){
+    return dary_is_heap_until<Arity>(first, last)==last;
+}
+
+/*****************************************************************************************/
+// 二叉堆：与 std 的堆算法布局相同，可以混用
+/*****************************************************************************************/
+
+template <class RandomIter>
+void push_heap(RandomIter first, RandomIter last) { dary_push_heap<2>(first, last); }
+
+template <class RandomIter, class Compare>
+void push_heap(RandomIter first, RandomIter last, Compare comp) { dary_push_heap<2>(first, last, comp); }
+
+template <class RandomIter>
+void pop_heap(RandomIter first, RandomIter last) { dary_pop_heap<2>(first, last); }
+
+template <class RandomIter, class Compare>
+void pop_heap(RandomIter first, RandomIter last, Compare comp) { dary_pop_heap<2>(first, last, comp); }
+
+template <class RandomIter>
+void make_heap(RandomIter first, RandomIter last) { dary_make_heap<2>(first, last); }
+
+template <class RandomIter, class Compare>
+void make_heap(RandomIter first, RandomIter last, Compare comp) { dary_make_heap<2>(first, last, comp); }
+
+template <class RandomIter>
+void sort_heap(RandomIter first, RandomIter last) { dary_sort_heap<2>(first, last); }
+
+template <class RandomIter, class Compare>
+void sort_heap(RandomIter first, RandomIter last, Compare comp) { dary_sort_heap<2>(first, last, comp); }
+
+template <class RandomIter>
+RandomIter is_heap_until(RandomIter first, RandomIter last) { return dary_is_heap_until<2>(first, last); }
+
+template <class RandomIter, class Compare>
+RandomIter is_heap_until(RandomIter first, RandomIter last, Compare comp){
+    return dary_is_heap_until<2>(first, last, comp);
+}
+
+template <class RandomIter>
+bool is_heap(RandomIter first, RandomIter last) { return dary_is_heap<2>(first, last); }
+
+template <class RandomIter, class Compare>
+bool is_heap(RandomIter first, RandomIter last, Compare comp) { return dary_is_heap<2>(first, last, comp); }
+
+} // namespace mystl
+
+#endif
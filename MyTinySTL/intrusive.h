@@ -0,0 +1,518 @@
+#ifndef MYTINYSTL_INTRUSIVE_H_
+#define MYTINYSTL_INTRUSIVE_H_
+
+// 这个头文件包含侵入式容器 intrusive_list、intrusive_set 以及它们的挂钩（hook）
+// 侵入式容器不分配节点：对象自己内嵌链接指针（hook），容器只负责把这些 hook 串起来
+//   插入/删除不分配、不释放内存，也不构造、析构对象，对象的生命周期由使用者管理
+//   一个对象可以同时处在多个容器中（每个容器使用一个不同 Tag 的 hook）
+// intrusive_list 复用 list.h 中的链接算法，intrusive_set 复用 rb_tree.h 中的平衡算法
+
+#include <atomic>
+#include <cstddef>
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "list.h"
+#include "memory.h"
+#include "rb_tree.h"
+#include "util.h"
+
+namespace mystl
+{
+
+struct default_hook_tag {};
+
+// 挂钩-------------------------------------------------------------------------------
+// list_base_hook：对象继承它即可放入 intrusive_list，Tag 用于区分同一对象上的多个 hook
+template <class Tag=default_hook_tag>
+struct list_base_hook: public list_node_base {};
+
+// list_member_hook：作为对象的成员使用
+typedef list_base_hook<> list_member_hook;
+
+// set_base_hook：对象继承它即可放入 intrusive_set
+template <class Tag=default_hook_tag>
+struct set_base_hook: public rb_tree_node_base {};
+
+typedef set_base_hook<> set_member_hook;
+
+// hook 萃取：在对象与其 hook 之间转换---------------------------------------------------
+// base_hook：hook 是对象的基类
+template <class T, class Hook>
+struct base_hook
+{
+    typedef T     value_type;
+    typedef Hook  hook_type;
+
+    static hook_type* to_hook(T& value) noexcept { return static_cast<hook_type*>(&value); }
+    static T* to_value(hook_type* hook) noexcept { return static_cast<T*>(hook); }
+    static const T* to_value(const hook_type* hook) noexcept { return static_cast<const T*>(hook); }
+};
+
+// member_hook：hook 是对象的成员，由 hook 的地址减去成员相对对象的偏移得到对象
+    // 偏移从真实的对象上计算：容器中的 hook 都是经过 to_hook 放进去的，to_hook 记下偏移后 to_value 才可能被调用；
+    // 同一类型的对象偏移都相同，只在还没记下时写入一次；多个线程可能同时写入同一个值，用原子变量避免数据竞争
+template <class T, class Hook, Hook T::*Member>
+struct member_hook
+{
+    typedef T     value_type;
+    typedef Hook  hook_type;
+
+    static hook_type* to_hook(T& value) noexcept{
+        hook_type* hook=&(value.*Member);
+        std::atomic<ptrdiff_t>& off=offset();
+        if(off.load(std::memory_order_relaxed)<0){
+            off.store(reinterpret_cast<char*>(hook)-reinterpret_cast<char*>(mystl::address_of(value)),
+                      std::memory_order_relaxed);
+        }
+        return hook;
+    }
+
+    static T* to_value(hook_type* hook) noexcept{
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook)-known_offset());
+    }
+    static const T* to_value(const hook_type* hook) noexcept{
+        return reinterpret_cast<const T*>(reinterpret_cast<const char*>(hook)-known_offset());
+    }
+
+private:
+    static std::atomic<ptrdiff_t>& offset() noexcept{
+        static std::atomic<ptrdiff_t> off(-1);
+        return off;
+    }
+
+    static ptrdiff_t known_offset() noexcept{
+        const ptrdiff_t off=offset().load(std::memory_order_relaxed);
+        MYSTL_DEBUG(off>=0);
+        return off;
+    }
+};
+
+
+// intrusive_list-------------------------------------------------------------------
+template <class T, class HookTraits>
+struct intrusive_list_iterator: public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+    typedef T                                      value_type;
+    typedef T*                                     pointer;
+    typedef T&                                     reference;
+    typedef intrusive_list_iterator<T, HookTraits> self;
+
+    list_node_base* node;
+
+    intrusive_list_iterator() noexcept: node(nullptr) {}
+    explicit intrusive_list_iterator(list_node_base* x) noexcept: node(x) {}
+
+    reference operator*() const{
+        return *HookTraits::to_value(static_cast<typename HookTraits::hook_type*>(node));
+    }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++(){
+        node=node->next;
+        return *this;
+    }
+    self operator++(int){
+        self tmp=*this;
+        node=node->next;
+        return tmp;
+    }
+    self& operator--(){
+        node=node->prev;
+        return *this;
+    }
+    self operator--(int){
+        self tmp=*this;
+        node=node->prev;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node==rhs.node; }
+    bool operator!=(const self& rhs) const { return node!=rhs.node; }
+};
+
+// intrusive_list：侵入式双向链表
+    // HookTraits 默认为 base_hook<T, list_base_hook<>>，即 T 继承 list_base_hook<>
+    // 容器不拥有对象：析构或 clear 时只把对象摘下，对象销毁前必须先从链表中移除
+template <class T, class HookTraits=base_hook<T, list_base_hook<>>>
+class intrusive_list
+{
+public:
+    typedef T                                       value_type;
+    typedef T*                                      pointer;
+    typedef T&                                      reference;
+    typedef const T&                                const_reference;
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+    typedef intrusive_list_iterator<T, HookTraits>  iterator;
+    typedef mystl::reverse_iterator<iterator>       reverse_iterator;
+
+private:
+    typedef typename HookTraits::hook_type          hook_type;
+
+    list_node_base m_header;
+    size_type      m_size;
+
+public:
+    intrusive_list() noexcept: m_header(), m_size(0) {}
+
+    // 不可拷贝：一个对象的 hook 只能在一个链表中
+    intrusive_list(const intrusive_list&)=delete;
+    intrusive_list& operator=(const intrusive_list&)=delete;
+
+    intrusive_list(intrusive_list&& rhs) noexcept: m_header(), m_size(rhs.m_size){
+        list_transfer(&m_header, rhs.m_header.next, &rhs.m_header);
+        rhs.m_size=0;
+    }
+
+    intrusive_list& operator=(intrusive_list&& rhs) noexcept{
+        clear();
+        list_transfer(&m_header, rhs.m_header.next, &rhs.m_header);
+        m_size=rhs.m_size;
+        rhs.m_size=0;
+        return *this;
+    }
+
+    ~intrusive_list() { clear(); }
+
+public:
+    iterator         begin()  noexcept { return iterator(m_header.next); }
+    iterator         end()    noexcept { return iterator(&m_header); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+
+    bool      empty() const noexcept { return m_size==0; }
+    size_type size()  const noexcept { return m_size; }
+
+    reference front(){
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    reference back(){
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    // 由对象得到指向它的迭代器，O(1)
+    static iterator iterator_to(reference value) noexcept{
+        return iterator(HookTraits::to_hook(value));
+    }
+
+    // 插入：只修改指针，不分配内存
+    iterator insert(iterator pos, reference value) noexcept{
+        hook_type* hook=HookTraits::to_hook(value);
+        MYSTL_DEBUG(!hook->is_linked());
+        list_link_before(pos.node, hook);
+        ++m_size;
+        return iterator(hook);
+    }
+
+    void push_front(reference value) noexcept { insert(begin(), value); }
+    void push_back(reference value)  noexcept { insert(end(), value); }
+
+    void pop_front() noexcept{
+        MYSTL_DEBUG(!empty());
+        erase(begin());
+    }
+
+    void pop_back() noexcept{
+        MYSTL_DEBUG(!empty());
+        erase(--end());
+    }
+
+    // 删除：把对象摘下，不析构对象
+    iterator erase(iterator pos) noexcept{
+        MYSTL_DEBUG(pos!=end());
+        list_node_base* next=pos.node->next;
+        list_unlink(pos.node);
+        --m_size;
+        return iterator(next);
+    }
+
+    iterator erase(iterator first, iterator last) noexcept{
+        while(first!=last){
+            first=erase(first);
+        }
+        return last;
+    }
+
+    // 直接按对象删除，无需查找
+    void remove(reference value) noexcept{
+        erase(iterator_to(value));
+    }
+
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred){
+        for(iterator cur=begin(); cur!=end();){
+            if(pred(*cur)){
+                cur=erase(cur);
+            }
+            else{
+                ++cur;
+            }
+        }
+    }
+
+    // 把所有对象摘下，每个 hook 都恢复为未链接状态
+    void clear() noexcept{
+        list_node_base* cur=m_header.next;
+        while(cur!=&m_header){
+            list_node_base* next=cur->next;
+            cur->prev=cur;
+            cur->next=cur;
+            cur=next;
+        }
+        m_header.prev=&m_header;
+        m_header.next=&m_header;
+        m_size=0;
+    }
+
+    void splice(iterator pos, intrusive_list& x) noexcept{
+        if(this!=&x && !x.empty()){
+            list_transfer(pos.node, x.m_header.next, &x.m_header);
+            m_size+=x.m_size;
+            x.m_size=0;
+        }
+    }
+
+    void splice(iterator pos, intrusive_list& x, iterator it) noexcept{
+        if(pos.node!=it.node && pos.node!=it.node->next){
+            list_transfer(pos.node, it.node, it.node->next);
+            --x.m_size;
+            ++m_size;
+        }
+    }
+
+    void reverse() noexcept{
+        if(m_size>1){
+            list_reverse(&m_header);
+        }
+    }
+
+    void swap(intrusive_list& rhs) noexcept{
+        list_swap(&m_header, &rhs.m_header);
+        mystl::swap(m_size, rhs.m_size);
+    }
+};
+
+
+// intrusive_set----------------------------------------------------------------------
+template <class T, class HookTraits>
+struct intrusive_set_iterator: public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+    typedef T                                     value_type;
+    typedef T*                                    pointer;
+    typedef T&                                    reference;
+    typedef intrusive_set_iterator<T, HookTraits> self;
+
+    rb_tree_node_base* node;
+
+    intrusive_set_iterator() noexcept: node(nullptr) {}
+    explicit intrusive_set_iterator(rb_tree_node_base* x) noexcept: node(x) {}
+
+    reference operator*() const{
+        return *HookTraits::to_value(static_cast<typename HookTraits::hook_type*>(node));
+    }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++(){
+        node=rb_tree_increment(node);
+        return *this;
+    }
+    self operator++(int){
+        self tmp=*this;
+        node=rb_tree_increment(node);
+        return tmp;
+    }
+    self& operator--(){
+        node=rb_tree_decrement(node);
+        return *this;
+    }
+    self operator--(int){
+        self tmp=*this;
+        node=rb_tree_decrement(node);
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node==rhs.node; }
+    bool operator!=(const self& rhs) const { return node!=rhs.node; }
+};
+
+// intrusive_set：侵入式有序集合（红黑树）
+    // insert 不允许重复键，insert_equal 允许重复键
+    // 比较器放在 compressed_pair 中，无状态比较器不占空间
+template <class T, class Compare=mystl::less<T>, class HookTraits=base_hook<T, set_base_hook<>>>
+class intrusive_set
+{
+public:
+    typedef T                                      value_type;
+    typedef T&                                     reference;
+    typedef Compare                                key_compare;
+    typedef size_t                                 size_type;
+    typedef intrusive_set_iterator<T, HookTraits>  iterator;
+    typedef mystl::reverse_iterator<iterator>      reverse_iterator;
+
+private:
+    typedef typename HookTraits::hook_type         hook_type;
+
+    mystl::compressed_pair<key_compare, rb_tree_node_base> m_header;
+    size_type m_size;
+
+public:
+    intrusive_set(): m_header(), m_size(0) { rb_tree_reset_header(header()); }
+
+    explicit intrusive_set(const key_compare& comp): m_header(comp, rb_tree_node_base()), m_size(0){
+        rb_tree_reset_header(header());
+    }
+
+    intrusive_set(const intrusive_set&)=delete;
+    intrusive_set& operator=(const intrusive_set&)=delete;
+
+    ~intrusive_set() { clear(); }
+
+public:
+    iterator         begin()  noexcept { return iterator(header()->left); }
+    iterator         end()    noexcept { return iterator(header()); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+
+    bool      empty() const noexcept { return m_size==0; }
+    size_type size()  const noexcept { return m_size; }
+
+    key_compare key_comp() const { return m_header.first(); }
+
+    static iterator iterator_to(reference value) noexcept{
+        return iterator(HookTraits::to_hook(value));
+    }
+
+    // 插入不重复的对象，已存在等价对象时返回它和 false
+    mystl::pair<iterator, bool> insert(reference value){
+        rb_tree_node_base* y=header();
+        rb_tree_node_base* x=root();
+        bool go_left=true;
+        while(x!=nullptr){
+            y=x;
+            go_left=comp()(value, value_of(x));
+            x=go_left? x->left: x->right;
+        }
+        // y 是插入点的父节点，检查它的前驱（或它本身）是否与 value 等价
+        iterator j(y);
+        if(go_left){
+            if(j==begin()){
+                return mystl::pair<iterator, bool>(link(true, y, value), true);
+            }
+            --j;
+        }
+        if(comp()(*j, value)){
+            return mystl::pair<iterator, bool>(link(go_left, y, value), true);
+        }
+        return mystl::pair<iterator, bool>(j, false);
+    }
+
+    // 插入对象，允许重复，等价对象按插入顺序排列
+    iterator insert_equal(reference value){
+        rb_tree_node_base* y=header();
+        rb_tree_node_base* x=root();
+        bool go_left=true;
+        while(x!=nullptr){
+            y=x;
+            go_left=comp()(value, value_of(x));
+            x=go_left? x->left: x->right;
+        }
+        return link(go_left, y, value);
+    }
+
+    // 删除：把对象摘下并重新平衡，不析构对象
+    iterator erase(iterator pos) noexcept{
+        MYSTL_DEBUG(pos!=end());
+        iterator next=pos;
+        ++next;
+        rb_tree_node_base* node=rb_tree_erase_and_rebalance(pos.node, header());
+        node->parent=nullptr;  // 恢复为未链接状态
+        node->left=nullptr;
+        node->right=nullptr;
+        --m_size;
+        return next;
+    }
+
+    void remove(reference value) noexcept { erase(iterator_to(value)); }
+
+    // 查找与 key 等价的对象，Key 可以是任何能与 T 用 Compare 比较的类型
+    template <class Key>
+    iterator find(const Key& key){
+        iterator it=lower_bound(key);
+        return (it==end() || comp()(key, *it))? end(): it;
+    }
+
+    template <class Key>
+    iterator lower_bound(const Key& key){
+        rb_tree_node_base* y=header();
+        rb_tree_node_base* x=root();
+        while(x!=nullptr){
+            if(!comp()(value_of(x), key)){
+                y=x;
+                x=x->left;
+            }
+            else{
+                x=x->right;
+            }
+        }
+        return iterator(y);
+    }
+
+    template <class Key>
+    iterator upper_bound(const Key& key){
+        rb_tree_node_base* y=header();
+        rb_tree_node_base* x=root();
+        while(x!=nullptr){
+            if(comp()(key, value_of(x))){
+                y=x;
+                x=x->left;
+            }
+            else{
+                x=x->right;
+            }
+        }
+        return iterator(y);
+    }
+
+    // 把所有对象摘下（后序遍历，不需要重新平衡）
+    void clear() noexcept{
+        unlink_subtree(root());
+        rb_tree_reset_header(header());
+        m_size=0;
+    }
+
+private:
+    rb_tree_node_base* header() noexcept { return &m_header.second(); }
+    rb_tree_node_base* root() noexcept { return m_header.second().parent; }
+    key_compare& comp() noexcept { return m_header.first(); }
+
+    static T& value_of(rb_tree_node_base* x) noexcept{
+        return *HookTraits::to_value(static_cast<hook_type*>(x));
+    }
+
+    iterator link(bool insert_left, rb_tree_node_base* parent, reference value) noexcept{
+        hook_type* hook=HookTraits::to_hook(value);
+        MYSTL_DEBUG(!hook->is_linked());
+        rb_tree_insert_and_rebalance(insert_left, hook, parent, header());
+        ++m_size;
+        return iterator(hook);
+    }
+
+    static void unlink_subtree(rb_tree_node_base* x) noexcept{
+        while(x!=nullptr){
+            unlink_subtree(x->right);
+            rb_tree_node_base* left=x->left;
+            x->parent=nullptr;
+            x->left=nullptr;
+            x->right=nullptr;
+            x=left;
+        }
+    }
+};
+
+} // namespace mystl
+
+#endif
@@ -1,5 +1,9 @@
+#ifndef MYTINYSTL_ITERATOR_H_
+#define MYTINYSTL_ITERATOR_H_
+
 // 实现迭代器
 #include <cstddef>
+#include <iterator>
 #include "type_traits.h"
 
 namespace mystl{
@@ -44,6 +48,21 @@ public:
     static const bool value=sizeof(test<T>(0))==sizeof(char);
 };
 
+// 1.5iterator_cat_adapter：把标准库的迭代器类型映射为mystl的迭代器类型，使std容器的迭代器也能参与萃取和分派
+template <class Category>
+struct iterator_cat_adapter { typedef Category type; };
+
+template <>
+struct iterator_cat_adapter<std::input_iterator_tag> { typedef input_iterator_tag type; };
+template <>
+struct iterator_cat_adapter<std::output_iterator_tag> { typedef output_iterator_tag type; };
+template <>
+struct iterator_cat_adapter<std::forward_iterator_tag> { typedef forward_iterator_tag type; };
+template <>
+struct iterator_cat_adapter<std::bidirectional_iterator_tag> { typedef bidirectional_iterator_tag type; };
+template <>
+struct iterator_cat_adapter<std::random_access_iterator_tag> { typedef random_access_iterator_tag type; };
+
 // 1.4iterator_traits_impl类型迭代器萃取接口
 template <class Iterator, bool>
 struct iterator_traits_impl{};
@@ -51,7 +70,8 @@ struct iterator_traits_impl{};
 template <class Iterator>
 struct iterator_traits_impl<Iterator, true>
 {
-    typedef typename Iterator::iterator_category iterator_catory;
+    typedef typename iterator_cat_adapter<
+        typename Iterator::iterator_category>::type iterator_category;
     typedef typename Iterator::value_type        value_type;
     typedef typename Iterator::pointer           pointer;
     typedef typename Iterator::reference         reference;
@@ -67,8 +87,10 @@ struct iterator_traits_helper{};
 // 调用iterator_traits_iml，对input/output_iterator_tag类型的迭代器进行萃取
 template <class Iterator>
 struct iterator_traits_helper<Iterator, true>: public iterator_traits_impl<Iterator,
-    std::is_convertible<typename Iterator::iterator_category, input_iterator_tag>::value ||
-    std::is_convertible<typename Iterator::iterator_category, output_iterator_tag>::value>{};
+    std::is_convertible<typename iterator_cat_adapter<
+        typename Iterator::iterator_category>::type, input_iterator_tag>::value ||
+    std::is_convertible<typename iterator_cat_adapter<
+        typename Iterator::iterator_category>::type, output_iterator_tag>::value>{};
 
 
 // 1.1iterator_traits从上述过程继承得到类型指针的迭代器
@@ -101,12 +123,12 @@ struct iterator_traits<const T*>
 
 // 特征萃取---------------------------------------------------------
 // 判断迭代器类型的继承关系
-template <class T, class U>
-struct has_iterator_cat_of<T,U,false>:public m_false_type{};
-
 template <class T, class U, bool=has_iterator_cat<iterator_traits<T>>::value>
 struct has_iterator_cat_of: public m_bool_constant<std::is_convertible<
-    typename iterator_traits<T>::iterator_category,U>::value{};
+    typename iterator_traits<T>::iterator_category,U>::value>{};
+
+template <class T, class U>
+struct has_iterator_cat_of<T,U,false>:public m_false_type{};
 
 // 判断五种类型
 template <class Iter>
@@ -131,7 +153,7 @@ struct is_iterator: public m_bool_constant<is_input_iterator<Iterator>::value ||
 
 // 萃取迭代器类型
 template <class Iterator>
-typename iterator_traits<Iterator>::iterator_category iterator_category(const Iterator&){
+constexpr typename iterator_traits<Iterator>::iterator_category iterator_category(const Iterator&) noexcept{
     typedef typename iterator_traits<Iterator>::iterator_category Category;
     return Category();
 }
@@ -151,7 +173,7 @@ typename iterator_traits<Iterator>::value_type* value_type(const Iterator&){
 // distance计算迭代器之间的距离
 // input_iterator_tag版本（只能逐步向前累加）
 template <class InputIterator>
-typename iterator_traits<InputIterator>::difference_type 
+constexpr typename iterator_traits<InputIterator>::difference_type
     distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag){
     typename iterator_traits<InputIterator>::difference_type n=0;
     while(first!=last){
@@ -163,13 +185,13 @@ typename iterator_traits<InputIterator>::difference_type
 
 // random_access_iterator_tag版本（可以直接作差得到，效率更高）
 template <class RandomIter>
-typename iterator_traits<RandomIter>::difference_type
+constexpr typename iterator_traits<RandomIter>::difference_type
     distance_dispatch(RandomIter first, RandomIter last, random_access_iterator_tag){
     return last-first;
 }
 
 template <class InputIterator>
-typename iterator_traits<InputIterator>::difference_type
+constexpr typename iterator_traits<InputIterator>::difference_type
 distance(InputIterator first, InputIterator last){
     return distance_dispatch(first,last,iterator_category(first));
 }
@@ -178,7 +200,7 @@ distance(InputIterator first, InputIterator last){
 // advance让迭代器前进n个距离
 // input_iterator_tag版本
 template <class InputIterator, class Distance>
-void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag){
+constexpr void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag){
     while(n--){
         ++i;
     }
@@ -186,7 +208,7 @@ void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag){
 
 // bidirectional_iterator_tag（根据n的正负前后移动）
 template <class BidirectionalIterator, class Distance>
-void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterator_tag){
+constexpr void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterator_tag){
     if(n>=0){
         while(n--){
             ++i;
@@ -201,12 +223,12 @@ void advance_dispatch(BidirectionalIterator& i, Distance n, bidirectional_iterat
 
 // random_access_iterator_tag
 template <class RandomIter, class Distance>
-void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag){
+constexpr void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag){
     i+=n;
 }
 
 template <class InputIterator, class Distance>
-void advance(InputIterator& i, Distance n){
+constexpr void advance(InputIterator& i, Distance n){
     advance_dispatch(i,n,iterator_category(i));
 }
 
@@ -337,4 +359,6 @@ bool operator>=(const reverse_iterator<Iterator>& lhs, const reverse_iterator<It
 }
 
 
-}
\ No newline at end of file
+}
+
+#endif
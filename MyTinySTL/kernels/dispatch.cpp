@@ -0,0 +1,577 @@
+// 内核的运行时分派：检测 CPU、选择函数表，以及不依赖任何指令集扩展的标量内核
+#include <cstdlib>
+#include <cstring>
+
+#include "../simd.h"
+
+namespace mystl
+{
+namespace simd
+{
+
+// 各指令集的函数表定义在对应的 kernels_<isa>.cpp 中，由构建系统按编译器和目标架构决定是否编译
+#ifdef MYSTL_HAVE_SSE2_KERNELS
+extern const kernel_table sse2_kernels;
+#endif
+#ifdef MYSTL_HAVE_AVX2_KERNELS
+extern const kernel_table avx2_kernels;
+#endif
+#ifdef MYSTL_HAVE_AVX512_KERNELS
+extern const kernel_table avx512_kernels;
+#endif
+
+namespace
+{
+
+// 1.标量内核
+void scalar_copy_bytes(void* dst, const void* src, size_t n) noexcept{
+    std::memmove(dst, src, n);
+}
+
+void scalar_fill8(void* dst, uint8_t value, size_t count) noexcept{
+    std::memset(dst, value, count);
+}
+
+template <class T>
+void scalar_fill(void* dst, T value, size_t count) noexcept{
+    unsigned char* d=static_cast<unsigned char*>(dst);
+    for(size_t i=0; i<count; ++i){
+        std::memcpy(d+i*sizeof(T), &value, sizeof(T));
+    }
+}
+
+size_t scalar_mismatch_bytes(const void* pa, const void* pb, size_t n) noexcept{
+    const unsigned char* a=static_cast<const unsigned char*>(pa);
+    const unsigned char* b=static_cast<const unsigned char*>(pb);
+    size_t i=0;
+    for(; i+8<=n; i+=8){
+        uint64_t x, y;
+        std::memcpy(&x, a+i, 8);
+        std::memcpy(&y, b+i, 8);
+        if(x!=y){
+            break;
+        }
+    }
+    for(; i<n; ++i){
+        if(a[i]!=b[i]){
+            return i;
+        }
+    }
+    return n;
+}
+
+template <class T>
+size_t scalar_find(const void* p, T value, size_t count) noexcept{
+    const unsigned char* b=static_cast<const unsigned char*>(p);
+    for(size_t i=0; i<count; ++i){
+        T x;
+        std::memcpy(&x, b+i*sizeof(T), sizeof(T));
+        if(x==value){
+            return i;
+        }
+    }
+    return count;
+}
+
+size_t scalar_find8(const void* p, uint8_t value, size_t count) noexcept{
+    if(count==0){
+        return 0;  // 空区间的指针可能是 nullptr，不能传给 memchr
+    }
+    const void* q=std::memchr(p, value, count);
+    return q!=nullptr? static_cast<size_t>(static_cast<const unsigned char*>(q)-static_cast<const unsigned char*>(p)): count;
+}
+
+template <class T>
+size_t scalar_count(const void* p, T value, size_t count) noexcept{
+    const unsigned char* b=static_cast<const unsigned char*>(p);
+    size_t n=0;
+    for(size_t i=0; i<count; ++i){
+        T x;
+        std::memcpy(&x, b+i*sizeof(T), sizeof(T));
+        n+=x==value;
+    }
+    return n;
+}
+
+size_t scalar_find_first_of8(const void* p, size_t n, const void* set, size_t m) noexcept{
+    const unsigned char* b=static_cast<const unsigned char*>(p);
+    const unsigned char* c=static_cast<const unsigned char*>(set);
+    bool table[256]={};
+    for(size_t k=0; k<m; ++k){
+        table[c[k]]=true;
+    }
+    for(size_t i=0; i<n; ++i){
+        if(table[b[i]]){
+            return i;
+        }
+    }
+    return n;
+}
+
+size_t scalar_search8(const void* p, size_t n, const void* needle, size_t m) noexcept{
+    const unsigned char* h=static_cast<const unsigned char*>(p);
+    const unsigned char* nd=static_cast<const unsigned char*>(needle);
+    if(m==0){
+        return 0;
+    }
+    for(size_t i=0; i+m<=n; ++i){
+        if(h[i]==nd[0] && std::memcmp(h+i+1, nd+1, m-1)==0){
+            return i;
+        }
+    }
+    return n;
+}
+
+template <class T>
+T scalar_load(const void* p, size_t i) noexcept{
+    T x;
+    std::memcpy(&x, static_cast<const unsigned char*>(p)+i*sizeof(T), sizeof(T));
+    return x;
+}
+
+template <class T>
+size_t scalar_min_element(const void* p, size_t n) noexcept{
+    size_t k=0;
+    T lo=scalar_load<T>(p, 0);
+    for(size_t i=1; i<n; ++i){
+        const T x=scalar_load<T>(p, i);
+        if(x<lo){
+            lo=x;
+            k=i;
+        }
+    }
+    return k;
+}
+
+template <class T>
+size_t scalar_max_element(const void* p, size_t n) noexcept{
+    size_t k=0;
+    T hi=scalar_load<T>(p, 0);
+    for(size_t i=1; i<n; ++i){
+        const T x=scalar_load<T>(p, i);
+        if(hi<x){
+            hi=x;
+            k=i;
+        }
+    }
+    return k;
+}
+
+template <class T>
+void scalar_minmax_element(const void* p, size_t n, size_t* min_index, size_t* max_index) noexcept{
+    size_t a=0, b=0;
+    T lo=scalar_load<T>(p, 0), hi=lo;
+    for(size_t i=1; i<n; ++i){
+        const T x=scalar_load<T>(p, i);
+        if(x<lo){
+            lo=x;
+            a=i;
+        }
+        if(!(x<hi)){
+            hi=x;
+            b=i;
+        }
+    }
+    *min_index=a;
+    *max_index=b;
+}
+
+template <class T>
+uint64_t scalar_sum_int(const void* p, size_t n) noexcept{
+    uint64_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=static_cast<uint64_t>(scalar_load<T>(p, i));
+    }
+    return total;
+}
+
+// 与向量内核相同的树形拆分，块内逐个累加
+template <class T>
+T scalar_sum_float(const void* p, size_t n) noexcept{
+    if(n<=256){
+        T total=0;
+        for(size_t i=0; i<n; ++i){
+            total+=scalar_load<T>(p, i);
+        }
+        return total;
+    }
+    const size_t h=(n/256/2)*256;
+    const size_t left=h>0? h: 256;
+    return scalar_sum_float<T>(p, left)+
+           scalar_sum_float<T>(static_cast<const unsigned char*>(p)+left*sizeof(T), n-left);
+}
+
+template <int Op>
+void scalar_bit_op(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    for(size_t i=0; i<n; ++i){
+        switch(static_cast<bit_op_kind>(Op)){
+        case bit_op_kind::and_op:    dst[i]=a[i]&b[i]; break;
+        case bit_op_kind::or_op:     dst[i]=a[i]|b[i]; break;
+        case bit_op_kind::xor_op:    dst[i]=a[i]^b[i]; break;
+        case bit_op_kind::andnot_op: dst[i]=a[i]&~b[i]; break;
+        }
+    }
+}
+
+size_t scalar_popcount64(const uint64_t* p, size_t n) noexcept{
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=static_cast<size_t>(__builtin_popcountll(p[i]));
+    }
+    return total;
+}
+
+size_t scalar_and_popcount64(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=static_cast<size_t>(__builtin_popcountll(a[i]&b[i]));
+    }
+    return total;
+}
+
+size_t scalar_find_nonzero64(const uint64_t* p, size_t n) noexcept{
+    size_t i=0;
+    while(i<n && p[i]==0){
+        ++i;
+    }
+    return i;
+}
+
+void scalar_hash64(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept{
+    for(size_t i=0; i<n; ++i){
+        out[i]=hash_mix64(keys[i]^seed);
+    }
+}
+
+const kernel_table scalar_kernels={
+    isa::scalar,
+    &scalar_copy_bytes,
+    &scalar_fill8,
+    &scalar_fill<uint16_t>,
+    &scalar_fill<uint32_t>,
+    &scalar_fill<uint64_t>,
+    &scalar_mismatch_bytes,
+    &scalar_find8,
+    &scalar_find<uint16_t>,
+    &scalar_find<uint32_t>,
+    &scalar_find<uint64_t>,
+    &scalar_count<uint8_t>,
+    &scalar_count<uint16_t>,
+    &scalar_count<uint32_t>,
+    &scalar_count<uint64_t>,
+    &scalar_find_first_of8,
+    &scalar_search8,
+    {
+        &scalar_min_element<int8_t>, &scalar_min_element<uint8_t>,
+        &scalar_min_element<int16_t>, &scalar_min_element<uint16_t>,
+        &scalar_min_element<int32_t>, &scalar_min_element<uint32_t>,
+        &scalar_min_element<int64_t>, &scalar_min_element<uint64_t>,
+        &scalar_min_element<float>, &scalar_min_element<double>,
+    },
+    {
+        &scalar_max_element<int8_t>, &scalar_max_element<uint8_t>,
+        &scalar_max_element<int16_t>, &scalar_max_element<uint16_t>,
+        &scalar_max_element<int32_t>, &scalar_max_element<uint32_t>,
+        &scalar_max_element<int64_t>, &scalar_max_element<uint64_t>,
+        &scalar_max_element<float>, &scalar_max_element<double>,
+    },
+    {
+        &scalar_minmax_element<int8_t>, &scalar_minmax_element<uint8_t>,
+        &scalar_minmax_element<int16_t>, &scalar_minmax_element<uint16_t>,
+        &scalar_minmax_element<int32_t>, &scalar_minmax_element<uint32_t>,
+        &scalar_minmax_element<int64_t>, &scalar_minmax_element<uint64_t>,
+        &scalar_minmax_element<float>, &scalar_minmax_element<double>,
+    },
+    {
+        &scalar_sum_int<int8_t>, &scalar_sum_int<uint8_t>,
+        &scalar_sum_int<int16_t>, &scalar_sum_int<uint16_t>,
+        &scalar_sum_int<int32_t>, &scalar_sum_int<uint32_t>,
+        &scalar_sum_int<int64_t>, &scalar_sum_int<uint64_t>,
+    },
+    &scalar_sum_float<float>,
+    &scalar_sum_float<double>,
+    {
+        &scalar_bit_op<0>, &scalar_bit_op<1>, &scalar_bit_op<2>, &scalar_bit_op<3>,
+    },
+    &scalar_popcount64,
+    &scalar_and_popcount64,
+    &scalar_find_nonzero64,
+    &scalar_hash64,
+};
+
+// 2.按级别查找函数表，未编译进来的级别返回 nullptr
+const kernel_table* table_for(isa level) noexcept{
+    switch(level){
+    case isa::scalar:
+        return &scalar_kernels;
+#ifdef MYSTL_HAVE_SSE2_KERNELS
+    case isa::sse2:
+        return &sse2_kernels;
+#endif
+#ifdef MYSTL_HAVE_AVX2_KERNELS
+    case isa::avx2:
+        return &avx2_kernels;
+#endif
+#ifdef MYSTL_HAVE_AVX512_KERNELS
+    case isa::avx512:
+        return &avx512_kernels;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+isa detect() noexcept{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // __builtin_cpu_supports 同时检查了操作系统是否通过 XSAVE 保存对应的寄存器
+    __builtin_cpu_init();
+    const bool bits=__builtin_cpu_supports("bmi") && __builtin_cpu_supports("popcnt");
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && bits){
+        return isa::avx512;
+    }
+    if(__builtin_cpu_supports("avx2") && bits){
+        return isa::avx2;
+    }
+    if(__builtin_cpu_supports("sse2")){
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+// 不超过 level 的、已编译进来的最高级别
+const kernel_table* best_table(isa level) noexcept{
+    for(int i=static_cast<int>(level); i>=0; --i){
+        if(const kernel_table* t=table_for(static_cast<isa>(i))){
+            return t;
+        }
+    }
+    return &scalar_kernels;
+}
+
+// 3.解析表：第一次调用任何内核时选出函数表，之后的调用不再经过这里
+    // 多个线程同时解析时结果相同，重复写入无害
+const kernel_table& resolve() noexcept{
+    isa level=detected_isa();
+    isa forced;
+    const char* env=std::getenv("MYSTL_ISA");
+    if(env!=nullptr && parse_isa(env, forced) && forced<level){
+        level=forced;
+    }
+    const kernel_table* t=best_table(level);
+    detail::active_kernels.store(t, std::memory_order_relaxed);
+    return *t;
+}
+
+void resolve_copy_bytes(void* dst, const void* src, size_t n) noexcept{
+    resolve().copy_bytes(dst, src, n);
+}
+
+void resolve_fill8(void* dst, uint8_t value, size_t count) noexcept{
+    resolve().fill8(dst, value, count);
+}
+
+void resolve_fill16(void* dst, uint16_t value, size_t count) noexcept{
+    resolve().fill16(dst, value, count);
+}
+
+void resolve_fill32(void* dst, uint32_t value, size_t count) noexcept{
+    resolve().fill32(dst, value, count);
+}
+
+void resolve_fill64(void* dst, uint64_t value, size_t count) noexcept{
+    resolve().fill64(dst, value, count);
+}
+
+size_t resolve_mismatch_bytes(const void* a, const void* b, size_t n) noexcept{
+    return resolve().mismatch_bytes(a, b, n);
+}
+
+size_t resolve_find8(const void* p, uint8_t value, size_t count) noexcept{
+    return resolve().find8(p, value, count);
+}
+
+size_t resolve_find16(const void* p, uint16_t value, size_t count) noexcept{
+    return resolve().find16(p, value, count);
+}
+
+size_t resolve_find32(const void* p, uint32_t value, size_t count) noexcept{
+    return resolve().find32(p, value, count);
+}
+
+size_t resolve_find64(const void* p, uint64_t value, size_t count) noexcept{
+    return resolve().find64(p, value, count);
+}
+
+size_t resolve_count8(const void* p, uint8_t value, size_t count) noexcept{
+    return resolve().count8(p, value, count);
+}
+
+size_t resolve_count16(const void* p, uint16_t value, size_t count) noexcept{
+    return resolve().count16(p, value, count);
+}
+
+size_t resolve_count32(const void* p, uint32_t value, size_t count) noexcept{
+    return resolve().count32(p, value, count);
+}
+
+size_t resolve_count64(const void* p, uint64_t value, size_t count) noexcept{
+    return resolve().count64(p, value, count);
+}
+
+size_t resolve_find_first_of8(const void* p, size_t n, const void* set, size_t m) noexcept{
+    return resolve().find_first_of8(p, n, set, m);
+}
+
+size_t resolve_search8(const void* p, size_t n, const void* needle, size_t m) noexcept{
+    return resolve().search8(p, n, needle, m);
+}
+
+// 按元素类型分的内核用下标 K 区分
+template <int K>
+size_t resolve_min_element(const void* p, size_t n) noexcept{
+    return resolve().min_element[K](p, n);
+}
+
+template <int K>
+size_t resolve_max_element(const void* p, size_t n) noexcept{
+    return resolve().max_element[K](p, n);
+}
+
+template <int K>
+void resolve_minmax_element(const void* p, size_t n, size_t* min_index, size_t* max_index) noexcept{
+    resolve().minmax_element[K](p, n, min_index, max_index);
+}
+
+template <int K>
+uint64_t resolve_sum_int(const void* p, size_t n) noexcept{
+    return resolve().sum_int[K](p, n);
+}
+
+float resolve_sum_f32(const void* p, size_t n) noexcept{
+    return resolve().sum_f32(p, n);
+}
+
+double resolve_sum_f64(const void* p, size_t n) noexcept{
+    return resolve().sum_f64(p, n);
+}
+
+template <int Op>
+void resolve_bit_op(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    resolve().bit_op[Op](dst, a, b, n);
+}
+
+size_t resolve_popcount64(const uint64_t* p, size_t n) noexcept{
+    return resolve().popcount64(p, n);
+}
+
+size_t resolve_and_popcount64(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    return resolve().and_popcount64(a, b, n);
+}
+
+size_t resolve_find_nonzero64(const uint64_t* p, size_t n) noexcept{
+    return resolve().find_nonzero64(p, n);
+}
+
+void resolve_hash64(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept{
+    resolve().hash64(keys, n, seed, out);
+}
+
+const kernel_table resolver_kernels={
+    isa::scalar,
+    &resolve_copy_bytes,
+    &resolve_fill8,
+    &resolve_fill16,
+    &resolve_fill32,
+    &resolve_fill64,
+    &resolve_mismatch_bytes,
+    &resolve_find8,
+    &resolve_find16,
+    &resolve_find32,
+    &resolve_find64,
+    &resolve_count8,
+    &resolve_count16,
+    &resolve_count32,
+    &resolve_count64,
+    &resolve_find_first_of8,
+    &resolve_search8,
+    {
+        &resolve_min_element<0>, &resolve_min_element<1>, &resolve_min_element<2>, &resolve_min_element<3>,
+        &resolve_min_element<4>, &resolve_min_element<5>, &resolve_min_element<6>, &resolve_min_element<7>,
+        &resolve_min_element<8>, &resolve_min_element<9>,
+    },
+    {
+        &resolve_max_element<0>, &resolve_max_element<1>, &resolve_max_element<2>, &resolve_max_element<3>,
+        &resolve_max_element<4>, &resolve_max_element<5>, &resolve_max_element<6>, &resolve_max_element<7>,
+        &resolve_max_element<8>, &resolve_max_element<9>,
+    },
+    {
+        &resolve_minmax_element<0>, &resolve_minmax_element<1>, &resolve_minmax_element<2>,
+        &resolve_minmax_element<3>, &resolve_minmax_element<4>, &resolve_minmax_element<5>,
+        &resolve_minmax_element<6>, &resolve_minmax_element<7>, &resolve_minmax_element<8>,
+        &resolve_minmax_element<9>,
+    },
+    {
+        &resolve_sum_int<0>, &resolve_sum_int<1>, &resolve_sum_int<2>, &resolve_sum_int<3>,
+        &resolve_sum_int<4>, &resolve_sum_int<5>, &resolve_sum_int<6>, &resolve_sum_int<7>,
+    },
+    &resolve_sum_f32,
+    &resolve_sum_f64,
+    {
+        &resolve_bit_op<0>, &resolve_bit_op<1>, &resolve_bit_op<2>, &resolve_bit_op<3>,
+    },
+    &resolve_popcount64,
+    &resolve_and_popcount64,
+    &resolve_find_nonzero64,
+    &resolve_hash64,
+};
+
+} // namespace
+
+namespace detail
+{
+// 常量初始化，不依赖静态初始化顺序，其他翻译单元的静态对象构造时也可以安全调用
+std::atomic<const kernel_table*> active_kernels(&resolver_kernels);
+} // namespace detail
+
+isa detected_isa() noexcept{
+    static const isa level=detect();
+    return level;
+}
+
+isa active_isa() noexcept{
+    const kernel_table* t=detail::active_kernels.load(std::memory_order_relaxed);
+    return t==&resolver_kernels? resolve().level: t->level;
+}
+
+bool force_isa(isa level) noexcept{
+    const kernel_table* t=table_for(level);
+    if(t==nullptr || level>detected_isa()){
+        return false;
+    }
+    detail::active_kernels.store(t, std::memory_order_relaxed);
+    return true;
+}
+
+const char* isa_name(isa level) noexcept{
+    switch(level){
+    case isa::scalar: return "scalar";
+    case isa::sse2:   return "sse2";
+    case isa::avx2:   return "avx2";
+    case isa::avx512: return "avx512";
+    }
+    return "unknown";
+}
+
+bool parse_isa(const char* name, isa& level) noexcept{
+    for(int i=static_cast<int>(isa::scalar); i<=static_cast<int>(isa::avx512); ++i){
+        if(std::strcmp(name, isa_name(static_cast<isa>(i)))==0){
+            level=static_cast<isa>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace simd
+} // namespace mystl
@@ -0,0 +1,87 @@
+// AVX2 内核：32 字节向量，以 -mavx2 -mbmi -mpopcnt 编译，只在 CPU 支持时由 dispatch.cpp 选用
+#include <immintrin.h>
+
+#include "kernels_impl.h"
+
+namespace mystl
+{
+namespace simd
+{
+namespace
+{
+
+struct vec_avx2
+{
+    using type = __m256i;
+    static constexpr size_t size = 32;
+    static constexpr uint64_t full_mask = 0xFFFFFFFFu;
+
+    static type load(const void* p) noexcept { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    static void store(void* p, type v) noexcept { _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+
+    static type set1(uint8_t v) noexcept { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static type set1(uint16_t v) noexcept { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static type set1(uint32_t v) noexcept { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static type set1(uint64_t v) noexcept { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+
+    static uint64_t eq_mask(type a, type b) noexcept{
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+
+    static constexpr size_t mask_stride(size_t elem_size) noexcept { return elem_size; }
+
+    template <class T>
+    static uint64_t match(type a, type b) noexcept{
+        __m256i c;
+        if constexpr(sizeof(T)==1){
+            c=_mm256_cmpeq_epi8(a, b);
+        }
+        else if constexpr(sizeof(T)==2){
+            c=_mm256_cmpeq_epi16(a, b);
+        }
+        else if constexpr(sizeof(T)==4){
+            c=_mm256_cmpeq_epi32(a, b);
+        }
+        else{
+            c=_mm256_cmpeq_epi64(a, b);
+        }
+        return static_cast<uint32_t>(_mm256_movemask_epi8(c));
+    }
+
+    // 16~31 字节用两个可能重叠的 16 字节向量
+    static void copy_small(unsigned char* d, const unsigned char* s, size_t n) noexcept{
+        if(n>=16){
+            __m128i a=_mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            __m128i b=_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+n-16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d+n-16), b);
+            return;
+        }
+        copy_lt16(d, s, n);
+    }
+
+    static size_t mismatch_small(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+        if(n>=16){
+            unsigned m0=static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)))));
+            if(m0!=0xFFFF){
+                return ctz64(~m0);
+            }
+            const size_t j=n-16;
+            unsigned m1=static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+j)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+j)))));
+            return m1!=0xFFFF? j+ctz64(~m1): n;
+        }
+        return mismatch_lt16(a, b, n);
+    }
+};
+
+} // namespace
+
+extern const kernel_table avx2_kernels;
+const kernel_table avx2_kernels = make_table<vec_avx2>(isa::avx2);
+
+} // namespace simd
+} // namespace mystl
@@ -0,0 +1,87 @@
+// AVX-512 内核：64 字节向量，以 -mavx512f -mavx512bw -mbmi -mpopcnt 编译，只在 CPU 支持时由 dispatch.cpp 选用
+    // 比较时不足一个向量的部分用字节掩码的读处理，不需要逐字节的尾部循环
+#include <immintrin.h>
+
+#include "kernels_impl.h"
+
+namespace mystl
+{
+namespace simd
+{
+namespace
+{
+
+struct vec_avx512
+{
+    using type = __m512i;
+    static constexpr size_t size = 64;
+    static constexpr uint64_t full_mask = ~uint64_t(0);
+
+    static type load(const void* p) noexcept { return _mm512_loadu_si512(p); }
+    static void store(void* p, type v) noexcept { _mm512_storeu_si512(p, v); }
+
+    static type set1(uint8_t v) noexcept { return _mm512_set1_epi8(static_cast<char>(v)); }
+    static type set1(uint16_t v) noexcept { return _mm512_set1_epi16(static_cast<short>(v)); }
+    static type set1(uint32_t v) noexcept { return _mm512_set1_epi32(static_cast<int>(v)); }
+    static type set1(uint64_t v) noexcept { return _mm512_set1_epi64(static_cast<long long>(v)); }
+
+    static uint64_t eq_mask(type a, type b) noexcept{
+        return _mm512_cmpeq_epi8_mask(a, b);
+    }
+
+    // 比较直接得到每个元素一位的掩码
+    static constexpr size_t mask_stride(size_t) noexcept { return 1; }
+
+    template <class T>
+    static uint64_t match(type a, type b) noexcept{
+        if constexpr(sizeof(T)==1){
+            return _mm512_cmpeq_epi8_mask(a, b);
+        }
+        else if constexpr(sizeof(T)==2){
+            return _mm512_cmpeq_epi16_mask(a, b);
+        }
+        else if constexpr(sizeof(T)==4){
+            return _mm512_cmpeq_epi32_mask(a, b);
+        }
+        else{
+            return _mm512_cmpeq_epi64_mask(a, b);
+        }
+    }
+
+    static __mmask64 tail_mask(size_t n) noexcept{
+        return n==0? 0: ~uint64_t(0)>>(64-n);
+    }
+
+    // 带掩码的写在很多实现上比普通写慢得多，拷贝的尾部仍用两个可能重叠的较短向量
+    static void copy_small(unsigned char* d, const unsigned char* s, size_t n) noexcept{
+        if(n>=32){
+            __m256i a=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+            __m256i b=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+n-32));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d+n-32), b);
+        }
+        else if(n>=16){
+            __m128i a=_mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            __m128i b=_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+n-16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d+n-16), b);
+        }
+        else{
+            copy_lt16(d, s, n);
+        }
+    }
+
+    static size_t mismatch_small(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+        const __mmask64 k=tail_mask(n);
+        uint64_t ne=_mm512_mask_cmpneq_epi8_mask(k, _mm512_maskz_loadu_epi8(k, a), _mm512_maskz_loadu_epi8(k, b));
+        return ne!=0? ctz64(ne): n;
+    }
+};
+
+} // namespace
+
+extern const kernel_table avx512_kernels;
+const kernel_table avx512_kernels = make_table<vec_avx512>(isa::avx512);
+
+} // namespace simd
+} // namespace mystl
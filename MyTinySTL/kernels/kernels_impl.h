@@ -0,0 +1,1081 @@
+#ifndef MYTINYSTL_KERNELS_KERNELS_IMPL_H_
+#define MYTINYSTL_KERNELS_KERNELS_IMPL_H_
+
+// 这个头文件包含与指令集无关的内核模板，由各 kernels_<isa>.cpp 以各自的向量类型 V 实例化
+// V 需要提供：
+//   size                        向量字节数
+//   type load(const void*) / void store(void*, type)       非对齐读写
+//   type set1(uint8_t|uint16_t|uint32_t|uint64_t)          广播
+//   uint64_t eq_mask(type, type)                           逐字节相等的位掩码，full_mask 表示全部相等
+//   uint64_t match<T>(type, type)                          按 T 的宽度逐元素比较相等的位掩码，
+//                                                          每个元素占 mask_stride(sizeof(T)) 位
+//   void copy_small(unsigned char*, const unsigned char*, size_t n)      n<size 的拷贝
+//   size_t mismatch_small(const unsigned char*, const unsigned char*, size_t n)  n<size 的比较
+//
+// 第 8 节以后的归约内核、位数组内核和哈希内核只用到 V::size
+//
+// 注意：这些翻译单元以不同的 -m 选项编译，这里的所有函数都必须放在匿名命名空间中，
+// 而且不能调用标准库的内联函数或模板（如 std::min），否则链接器可能把带 AVX 指令的副本
+// 选给其他翻译单元使用，在不支持的 CPU 上崩溃。只使用内建函数、intrinsic 和 libc 函数
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <type_traits>
+
+#include <emmintrin.h>
+
+#include "../simd.h"
+
+namespace mystl
+{
+namespace simd
+{
+namespace
+{
+
+inline size_t ctz64(uint64_t x) noexcept{
+    return static_cast<size_t>(__builtin_ctzll(x));
+}
+
+// 固定大小的 memcpy 会被编译为一条普通的读或写指令
+template <class U>
+inline U load_word(const void* p) noexcept{
+    U v;
+    __builtin_memcpy(&v, p, sizeof(U));
+    return v;
+}
+
+template <class U>
+inline void store_word(void* p, U v) noexcept{
+    __builtin_memcpy(p, &v, sizeof(U));
+}
+
+// 少于 16 字节的拷贝：先读后写两个可能重叠的字，所以允许源和目的重叠
+inline void copy_lt16(unsigned char* d, const unsigned char* s, size_t n) noexcept{
+    if(n>=8){
+        uint64_t a=load_word<uint64_t>(s), b=load_word<uint64_t>(s+n-8);
+        store_word(d, a);
+        store_word(d+n-8, b);
+    }
+    else if(n>=4){
+        uint32_t a=load_word<uint32_t>(s), b=load_word<uint32_t>(s+n-4);
+        store_word(d, a);
+        store_word(d+n-4, b);
+    }
+    else if(n>=2){
+        uint16_t a=load_word<uint16_t>(s), b=load_word<uint16_t>(s+n-2);
+        store_word(d, a);
+        store_word(d+n-2, b);
+    }
+    else if(n==1){
+        *d=*s;
+    }
+}
+
+// 少于 16 字节的比较：按 8 字节的字异或，小端序下最低的非零位所在字节就是第一个不同的字节
+inline size_t mismatch_lt16(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+    size_t i=0;
+    if(n>=8){
+        uint64_t x=load_word<uint64_t>(a)^load_word<uint64_t>(b);
+        if(x!=0){
+            return ctz64(x)/8;
+        }
+        i=8;
+    }
+    for(; i<n; ++i){
+        if(a[i]!=b[i]){
+            return i;
+        }
+    }
+    return n;
+}
+
+// 16 字节的 SSE2 向量：SSE2 级别的内核直接使用，更高级别的内核用它处理不足一个长向量的小块
+struct vec128
+{
+    using type = __m128i;
+    static constexpr size_t size = 16;
+    static constexpr uint64_t full_mask = 0xFFFF;
+
+    static type load(const void* p) noexcept { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    static void store(void* p, type v) noexcept { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+
+    static type set1(uint8_t v) noexcept { return _mm_set1_epi8(static_cast<char>(v)); }
+    static type set1(uint16_t v) noexcept { return _mm_set1_epi16(static_cast<short>(v)); }
+    static type set1(uint32_t v) noexcept { return _mm_set1_epi32(static_cast<int>(v)); }
+    static type set1(uint64_t v) noexcept { return _mm_set1_epi64x(static_cast<long long>(v)); }
+
+    static uint64_t eq_mask(type a, type b) noexcept{
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    }
+
+    // movemask 按字节取位，每个元素占 sizeof(T) 位
+    static constexpr size_t mask_stride(size_t elem_size) noexcept { return elem_size; }
+
+    template <class T>
+    static uint64_t match(type a, type b) noexcept{
+        __m128i c;
+        if constexpr(sizeof(T)==1){
+            c=_mm_cmpeq_epi8(a, b);
+        }
+        else if constexpr(sizeof(T)==2){
+            c=_mm_cmpeq_epi16(a, b);
+        }
+        else if constexpr(sizeof(T)==4){
+            c=_mm_cmpeq_epi32(a, b);
+        }
+        else{
+            // SSE2 没有 64 位比较：两个 32 位的半字都相等才算相等
+            c=_mm_cmpeq_epi32(a, b);
+            c=_mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+        return static_cast<unsigned>(_mm_movemask_epi8(c));
+    }
+
+    static void copy_small(unsigned char* d, const unsigned char* s, size_t n) noexcept{
+        copy_lt16(d, s, n);
+    }
+
+    static size_t mismatch_small(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+        return mismatch_lt16(a, b, n);
+    }
+};
+
+// 1.copy_bytes：memmove 语义
+    // libc 的 memmove 已经按 CPU 分派，大块时使用 rep movsb 或非临时写；这里只处理不超过 4 个向量的小块，
+    // 省去函数调用和 libc 内部的长度分支，更大的块直接交给 libc
+template <class V>
+void copy_bytes(void* dst, const void* src, size_t n) noexcept{
+    unsigned char* d=static_cast<unsigned char*>(dst);
+    const unsigned char* s=static_cast<const unsigned char*>(src);
+    const size_t vs=V::size;
+    if(n<vs){
+        V::copy_small(d, s, n);
+        return;
+    }
+    if(n<=2*vs){
+        auto a=V::load(s), b=V::load(s+n-vs);
+        V::store(d, a);
+        V::store(d+n-vs, b);
+        return;
+    }
+    if(n<=4*vs){
+        // 先全部读出再写，源和目的重叠时也正确
+        auto a=V::load(s), b=V::load(s+vs), c=V::load(s+n-2*vs), e=V::load(s+n-vs);
+        V::store(d, a);
+        V::store(d+vs, b);
+        V::store(d+n-2*vs, c);
+        V::store(d+n-vs, e);
+        return;
+    }
+    std::memmove(d, s, n);
+}
+
+// 2.fill：把 count 个 T 填充为 value
+    // 单字节的大块填充交给 libc 的 memset；多字节元素 libc 没有对应的函数，全部在这里用向量写完成
+template <class V, class T>
+void fill(void* dst, T value, size_t count) noexcept{
+    unsigned char* d=static_cast<unsigned char*>(dst);
+    const size_t n=count*sizeof(T);
+    const size_t vs=V::size;
+    if(n<vs){
+        T* p=static_cast<T*>(dst);
+        for(size_t i=0; i<count; ++i){
+            store_word(p+i, value);
+        }
+        return;
+    }
+    if(sizeof(T)==1 && n>4*vs){
+        std::memset(d, static_cast<int>(value), n);
+        return;
+    }
+    const auto v=V::set1(value);
+    size_t i=0;
+    for(; i+4*vs<=n; i+=4*vs){
+        V::store(d+i, v);
+        V::store(d+i+vs, v);
+        V::store(d+i+2*vs, v);
+        V::store(d+i+3*vs, v);
+    }
+    for(; i+vs<=n; i+=vs){
+        V::store(d+i, v);
+    }
+    // n 和 vs 都是 sizeof(T) 的倍数，最后一个重叠的向量与已写入的内容对齐
+    if(i<n){
+        V::store(d+n-vs, v);
+    }
+}
+
+// 3.mismatch_bytes：第一个不同字节的下标
+template <class V>
+size_t mismatch_bytes(const void* pa, const void* pb, size_t n) noexcept{
+    const unsigned char* a=static_cast<const unsigned char*>(pa);
+    const unsigned char* b=static_cast<const unsigned char*>(pb);
+    const size_t vs=V::size;
+    if(n<vs){
+        return V::mismatch_small(a, b, n);
+    }
+    size_t i=0;
+    // 每次比较 4 个向量，只在有不同时再逐个定位
+    for(; i+4*vs<=n; i+=4*vs){
+        uint64_t m0=V::eq_mask(V::load(a+i), V::load(b+i));
+        uint64_t m1=V::eq_mask(V::load(a+i+vs), V::load(b+i+vs));
+        uint64_t m2=V::eq_mask(V::load(a+i+2*vs), V::load(b+i+2*vs));
+        uint64_t m3=V::eq_mask(V::load(a+i+3*vs), V::load(b+i+3*vs));
+        if((m0&m1&m2&m3)!=V::full_mask){
+            if(m0!=V::full_mask) return i+ctz64(~m0);
+            if(m1!=V::full_mask) return i+vs+ctz64(~m1);
+            if(m2!=V::full_mask) return i+2*vs+ctz64(~m2);
+            return i+3*vs+ctz64(~m3);
+        }
+    }
+    for(; i+vs<=n; i+=vs){
+        uint64_t m=V::eq_mask(V::load(a+i), V::load(b+i));
+        if(m!=V::full_mask){
+            return i+ctz64(~m);
+        }
+    }
+    if(i<n){
+        // 最后一个向量与已比较的部分重叠，重叠部分都相等，不影响第一个不同位置的判断
+        const size_t j=n-vs;
+        uint64_t m=V::eq_mask(V::load(a+j), V::load(b+j));
+        if(m!=V::full_mask){
+            return j+ctz64(~m);
+        }
+    }
+    return n;
+}
+
+// 4.find：第一个等于 value 的元素的下标，没有时返回 count
+    // 要求 count 不少于一个向量的元素个数；最后一个向量与已查找的部分重叠，重叠部分没有匹配，不影响结果
+template <class V, class T>
+size_t find_vec(const unsigned char* p, T value, size_t count) noexcept{
+    const size_t lanes=V::size/sizeof(T);
+    const size_t stride=V::mask_stride(sizeof(T));
+    const auto v=V::set1(value);
+    // 先单独查找第一个向量：切分、解析时目标常在开头几个字节内，不必先载入展开的 4 个向量
+    const uint64_t first=V::template match<T>(V::load(p), v);
+    if(first!=0){
+        return ctz64(first)/stride;
+    }
+    size_t i=lanes;
+    for(; i+4*lanes<=count; i+=4*lanes){
+        const unsigned char* q=p+i*sizeof(T);
+        uint64_t m0=V::template match<T>(V::load(q), v);
+        uint64_t m1=V::template match<T>(V::load(q+V::size), v);
+        uint64_t m2=V::template match<T>(V::load(q+2*V::size), v);
+        uint64_t m3=V::template match<T>(V::load(q+3*V::size), v);
+        if((m0|m1|m2|m3)!=0){
+            if(m0!=0) return i+ctz64(m0)/stride;
+            if(m1!=0) return i+lanes+ctz64(m1)/stride;
+            if(m2!=0) return i+2*lanes+ctz64(m2)/stride;
+            return i+3*lanes+ctz64(m3)/stride;
+        }
+    }
+    for(; i+lanes<=count; i+=lanes){
+        uint64_t m=V::template match<T>(V::load(p+i*sizeof(T)), v);
+        if(m!=0){
+            return i+ctz64(m)/stride;
+        }
+    }
+    if(i<count){
+        const size_t j=count-lanes;
+        uint64_t m=V::template match<T>(V::load(p+j*sizeof(T)), v);
+        if(m!=0){
+            return j+ctz64(m)/stride;
+        }
+    }
+    return count;
+}
+
+template <class V, class T>
+size_t find(const void* ptr, T value, size_t count) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    if(count*sizeof(T)>=V::size){
+        return find_vec<V>(p, value, count);
+    }
+    // 不足一个长向量时先尝试 16 字节向量
+    if(V::size>vec128::size && count*sizeof(T)>=vec128::size){
+        return find_vec<vec128>(p, value, count);
+    }
+    for(size_t i=0; i<count; ++i){
+        if(load_word<T>(p+i*sizeof(T))==value){
+            return i;
+        }
+    }
+    return count;
+}
+
+// 5.count：等于 value 的元素个数，每个向量的匹配掩码用 popcount 计数
+template <class V, class T>
+size_t count_vec(const unsigned char* p, T value, size_t count) noexcept{
+    const size_t lanes=V::size/sizeof(T);
+    const size_t stride=V::mask_stride(sizeof(T));
+    const auto v=V::set1(value);
+    size_t bits=0;
+    size_t i=0;
+    for(; i+2*lanes<=count; i+=2*lanes){
+        const unsigned char* q=p+i*sizeof(T);
+        bits+=static_cast<size_t>(__builtin_popcountll(V::template match<T>(V::load(q), v)));
+        bits+=static_cast<size_t>(__builtin_popcountll(V::template match<T>(V::load(q+V::size), v)));
+    }
+    for(; i+lanes<=count; i+=lanes){
+        bits+=static_cast<size_t>(__builtin_popcountll(V::template match<T>(V::load(p+i*sizeof(T)), v)));
+    }
+    if(i<count){
+        // 重叠的向量去掉已经计数过的前 i-j 个元素
+        const size_t j=count-lanes;
+        uint64_t m=V::template match<T>(V::load(p+j*sizeof(T)), v)>>((i-j)*stride);
+        bits+=static_cast<size_t>(__builtin_popcountll(m));
+    }
+    return bits/stride;
+}
+
+template <class V, class T>
+size_t count(const void* ptr, T value, size_t count) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    if(count*sizeof(T)>=V::size){
+        return count_vec<V>(p, value, count);
+    }
+    if(V::size>vec128::size && count*sizeof(T)>=vec128::size){
+        return count_vec<vec128>(p, value, count);
+    }
+    size_t n=0;
+    for(size_t i=0; i<count; ++i){
+        n+=load_word<T>(p+i*sizeof(T))==value;
+    }
+    return n;
+}
+
+// 6.find_first_of8：第一个属于字节集合 set 的字节的下标
+    // 集合不超过 16 个字节时每个向量与每个候选字节比较后合并掩码，否则用 256 项的查找表逐字节判断
+constexpr size_t max_vector_set=16;
+
+template <class V>
+size_t find_first_of_vec(const unsigned char* p, size_t n, const unsigned char* set, size_t m) noexcept{
+    typename V::type needles[max_vector_set];
+    for(size_t k=0; k<m; ++k){
+        needles[k]=V::set1(static_cast<uint8_t>(set[k]));
+    }
+    auto any=[&](const unsigned char* q) noexcept{
+        const auto x=V::load(q);
+        uint64_t mask=0;
+        for(size_t k=0; k<m; ++k){
+            mask|=V::eq_mask(x, needles[k]);
+        }
+        return mask;
+    };
+    size_t i=0;
+    for(; i+V::size<=n; i+=V::size){
+        uint64_t mask=any(p+i);
+        if(mask!=0){
+            return i+ctz64(mask);
+        }
+    }
+    if(i<n){
+        const size_t j=n-V::size;
+        uint64_t mask=any(p+j);
+        if(mask!=0){
+            return j+ctz64(mask);
+        }
+    }
+    return n;
+}
+
+template <class V>
+size_t find_first_of8(const void* ptr, size_t n, const void* set_ptr, size_t m) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    const unsigned char* set=static_cast<const unsigned char*>(set_ptr);
+    if(m<=max_vector_set){
+        if(n>=V::size){
+            return find_first_of_vec<V>(p, n, set, m);
+        }
+        if(V::size>vec128::size && n>=vec128::size){
+            return find_first_of_vec<vec128>(p, n, set, m);
+        }
+        for(size_t i=0; i<n; ++i){
+            for(size_t k=0; k<m; ++k){
+                if(p[i]==set[k]){
+                    return i;
+                }
+            }
+        }
+        return n;
+    }
+    bool table[256]={};
+    for(size_t k=0; k<m; ++k){
+        table[set[k]]=true;
+    }
+    for(size_t i=0; i<n; ++i){
+        if(table[p[i]]){
+            return i;
+        }
+    }
+    return n;
+}
+
+// 7.search8：子串 needle 第一次出现的下标，没有时返回 n
+    // 同时比较候选位置上的首字节和尾字节，两者都相等的位置才用 memcmp 验证中间部分，
+    // 与只按首字节筛选（memchr 再 memcmp）相比，重复字符多的文本中误报少得多
+    // search_vec 要求候选位置不少于一个向量的字节数；最后一个向量与已检查的部分重叠，重叠部分的候选位置移出掩码
+template <class V>
+size_t search_vec(const unsigned char* h, size_t n, const unsigned char* nd, size_t m) noexcept{
+    const size_t cnt=n-m+1;  // 候选位置的个数
+    const auto first=V::set1(static_cast<uint8_t>(nd[0]));
+    const auto last=V::set1(static_cast<uint8_t>(nd[m-1]));
+    // 在以 i 开始的向量中验证 mask 标出的候选位置
+    auto verify=[&](size_t i, uint64_t mask) noexcept{
+        while(mask!=0){
+            const size_t k=i+ctz64(mask);
+            if(std::memcmp(h+k+1, nd+1, m-2)==0){
+                return k;
+            }
+            mask&=mask-1;
+        }
+        return n;
+    };
+    size_t i=0;
+    for(; i+V::size<=cnt; i+=V::size){
+        uint64_t mask=V::eq_mask(V::load(h+i), first)&V::eq_mask(V::load(h+i+m-1), last);
+        const size_t k=verify(i, mask);
+        if(k!=n){
+            return k;
+        }
+    }
+    if(i<cnt){
+        const size_t j=cnt-V::size;
+        uint64_t mask=V::eq_mask(V::load(h+j), first)&V::eq_mask(V::load(h+j+m-1), last);
+        return verify(i, mask>>(i-j));
+    }
+    return n;
+}
+
+template <class V>
+size_t search8(const void* hay_ptr, size_t n, const void* needle_ptr, size_t m) noexcept{
+    const unsigned char* h=static_cast<const unsigned char*>(hay_ptr);
+    const unsigned char* nd=static_cast<const unsigned char*>(needle_ptr);
+    if(m==0){
+        return 0;
+    }
+    if(m>n){
+        return n;
+    }
+    if(m==1){
+        return find<V, uint8_t>(h, nd[0], n);
+    }
+    const size_t cnt=n-m+1;
+    if(cnt>=V::size){
+        return search_vec<V>(h, n, nd, m);
+    }
+    if(V::size>vec128::size && cnt>=vec128::size){
+        return search_vec<vec128>(h, n, nd, m);
+    }
+    // 不足 16 个候选位置：逐个比较首尾字节，中间部分也逐字节比较，避免 memcmp 的调用开销
+    for(size_t i=0; i<cnt; ++i){
+        if(h[i]==nd[0] && h[i+m-1]==nd[m-1]){
+            size_t j=1;
+            while(j<m-1 && h[i+j]==nd[j]){
+                ++j;
+            }
+            if(j>=m-1){
+                return i;
+            }
+        }
+    }
+    return n;
+}
+
+// 以下归约内核用 GCC/Clang 的通用向量扩展写成，VS 是向量字节数
+    // 编译器按所在翻译单元的 -m 选项选择指令（如 AVX2 下的 vpminsd、vpmovsxbd），不需要为每种元素类型手写 intrinsic
+template <class T, size_t VS>
+struct gvec
+{
+    typedef T type __attribute__((vector_size(VS)));
+    static constexpr size_t lanes=VS/sizeof(T);
+
+    static type load(const unsigned char* p) noexcept{
+        type v;
+        __builtin_memcpy(&v, p, VS);
+        return v;
+    }
+
+    static void store(unsigned char* p, type v) noexcept{
+        __builtin_memcpy(p, &v, VS);
+    }
+
+    static type broadcast(T x) noexcept{
+        type v;
+        for(size_t k=0; k<lanes; ++k){
+            v[k]=x;
+        }
+        return v;
+    }
+
+    // 比较结果的任意一个通道非零
+    template <class M>
+    static bool any(M m) noexcept{
+        uint64_t w[VS/8>0? VS/8: 1]={};
+        __builtin_memcpy(w, &m, VS);
+        uint64_t r=0;
+        for(size_t k=0; k<(VS/8>0? VS/8: 1); ++k){
+            r|=w[k];
+        }
+        return r!=0;
+    }
+};
+
+// 8.min_element/max_element/minmax_element：先用向量求出最小值和最大值，再定位它们的下标
+    // 每个通道都以第 0 个元素为初值，只在严格小于（大于）时更新，与逐个比较的顺序语义一致：
+    // 第 0 个元素是 NaN 时结果就是它，之后的 NaN 比较总是 false，不会被选中
+    // Nan 为 true 时同一遍中顺便记录区间里是否有 NaN（x!=x），供 minmax_element 使用
+template <size_t VS, class T, bool Min, bool Max, bool Nan=false>
+void extremes(const unsigned char* p, size_t n, T& lo, T& hi, bool* has_nan=nullptr) noexcept{
+    using G=gvec<T, VS>;
+    const size_t L=G::lanes;
+    lo=hi=load_word<T>(p);
+    auto vlo=G::broadcast(lo), vhi=G::broadcast(hi);
+    decltype(vlo!=vlo) vnan={};
+    size_t i=0;
+    for(; i+2*L<=n; i+=2*L){
+        const auto x=G::load(p+i*sizeof(T)), y=G::load(p+(i+L)*sizeof(T));
+        if(Nan){
+            vnan|=(x!=x) | (y!=y);
+        }
+        if(Min){
+            vlo=x<vlo? x: vlo;
+            vlo=y<vlo? y: vlo;
+        }
+        if(Max){
+            vhi=vhi<x? x: vhi;
+            vhi=vhi<y? y: vhi;
+        }
+    }
+    for(; i+L<=n; i+=L){
+        const auto x=G::load(p+i*sizeof(T));
+        if(Nan) vnan|=x!=x;
+        if(Min) vlo=x<vlo? x: vlo;
+        if(Max) vhi=vhi<x? x: vhi;
+    }
+    for(size_t k=0; k<L; ++k){
+        if(Min && vlo[k]<lo) lo=vlo[k];
+        if(Max && hi<vhi[k]) hi=vhi[k];
+    }
+    bool nan=Nan && G::any(vnan);
+    for(; i<n; ++i){
+        const T x=load_word<T>(p+i*sizeof(T));
+        if(Nan && x!=x) nan=true;
+        if(Min && x<lo) lo=x;
+        if(Max && hi<x) hi=x;
+    }
+    if(Nan){
+        *has_nan=nan;
+    }
+}
+
+// 第一个（最后一个）等于 value 的元素的下标，用 == 比较，浮点数的 +0.0 与 -0.0 相等
+template <size_t VS, class T>
+size_t find_equal(const unsigned char* p, size_t n, T value) noexcept{
+    using G=gvec<T, VS>;
+    const size_t L=G::lanes;
+    const auto v=G::broadcast(value);
+    size_t i=0;
+    for(; i+L<=n; i+=L){
+        const auto m=G::load(p+i*sizeof(T))==v;
+        if(G::any(m)){
+            for(size_t k=0; k<L; ++k){
+                if(m[k]) return i+k;
+            }
+        }
+    }
+    for(; i<n; ++i){
+        if(load_word<T>(p+i*sizeof(T))==value) return i;
+    }
+    return n;
+}
+
+template <size_t VS, class T>
+size_t rfind_equal(const unsigned char* p, size_t n, T value) noexcept{
+    using G=gvec<T, VS>;
+    const size_t L=G::lanes;
+    const auto v=G::broadcast(value);
+    size_t i=n;
+    for(; i>=L; i-=L){
+        const auto m=G::load(p+(i-L)*sizeof(T))==v;
+        if(G::any(m)){
+            for(size_t k=L; k>0; --k){
+                if(m[k-1]) return i-L+k-1;
+            }
+        }
+    }
+    for(; i>0; --i){
+        if(load_word<T>(p+(i-1)*sizeof(T))==value) return i-1;
+    }
+    return n;
+}
+
+// 最后一个 NaN 的下标，没有时返回 n
+template <size_t VS, class T>
+size_t rfind_nan(const unsigned char* p, size_t n) noexcept{
+    using G=gvec<T, VS>;
+    const size_t L=G::lanes;
+    size_t i=n;
+    for(; i>=L; i-=L){
+        const auto x=G::load(p+(i-L)*sizeof(T));
+        const auto m=x!=x;
+        if(G::any(m)){
+            for(size_t k=L; k>0; --k){
+                if(m[k-1]) return i-L+k-1;
+            }
+        }
+    }
+    for(; i>0; --i){
+        const T x=load_word<T>(p+(i-1)*sizeof(T));
+        if(x!=x) return i-1;
+    }
+    return n;
+}
+
+template <size_t VS, class T>
+size_t min_element(const void* ptr, size_t n) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    T lo, hi;
+    extremes<VS, T, true, false>(p, n, lo, hi);
+    const size_t k=find_equal<VS>(p, n, lo);
+    return k==n? 0: k;  // 只有第 0 个元素是 NaN 时找不到
+}
+
+template <size_t VS, class T>
+size_t max_element(const void* ptr, size_t n) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    T lo, hi;
+    extremes<VS, T, false, true>(p, n, lo, hi);
+    const size_t k=find_equal<VS>(p, n, hi);
+    return k==n? 0: k;
+}
+
+// 与 std::minmax_element 相同：第一个最小值和最后一个最大值，最大值按 !(x<hi) 逐个更新
+    // 没有 NaN 时就是最后一个等于最大值的元素；NaN 总会被选中，紧随其后的元素又总会替换它，
+    // 所以有 NaN 时结果只取决于最后一个 NaN 之后的部分：NaN 在末尾时就是它，否则是后面这段中最后一个最大值
+template <size_t VS, class T>
+void minmax_element(const void* ptr, size_t n, size_t* min_index, size_t* max_index) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    T lo, hi;
+    bool nan=false;
+    extremes<VS, T, true, true, std::is_floating_point<T>::value>(p, n, lo, hi, &nan);
+    const size_t a=find_equal<VS>(p, n, lo);
+    *min_index=a==n? 0: a;
+    if(!nan){
+        const size_t b=rfind_equal<VS>(p, n, hi);
+        *max_index=b==n? 0: b;
+        return;
+    }
+    const size_t j=rfind_nan<VS, T>(p, n);
+    if(j+1==n){
+        *max_index=j;
+        return;
+    }
+    const unsigned char* tail=p+(j+1)*sizeof(T);
+    extremes<VS, T, false, true>(tail, n-j-1, lo, hi);
+    *max_index=j+1+rfind_equal<VS>(tail, n-j-1, hi);
+}
+
+// 9.sum_int：整数求和，结果是各元素符号（或零）扩展后的和模 2^64
+    // 元素不逐个扩展，而是把向量看成两倍宽的通道，用移位取出每个宽通道中的高低两个元素相加（pair_sum），
+    // 在通道溢出之前再并入更宽的通道
+
+// 把 W 通道看成两个半宽的元素，返回两者（按 W 的符号扩展后）之和
+template <class W, class V>
+V pair_sum(V v) noexcept{
+    constexpr int h=4*sizeof(W);
+    return ((v<<h)>>h)+(v>>h);
+}
+
+template <size_t VS, class E>
+uint64_t sum_int(const void* ptr, size_t n) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(ptr);
+    constexpr bool is_signed=static_cast<E>(-1)<static_cast<E>(0);
+    using W16=typename std::conditional<is_signed, int16_t, uint16_t>::type;
+    using W32=typename std::conditional<is_signed, int32_t, uint32_t>::type;
+    using W64=typename std::conditional<is_signed, int64_t, uint64_t>::type;
+    // 每次处理一个向量的元素
+    constexpr size_t lanes=VS/sizeof(E);
+    uint64_t total=0;
+    size_t i=0;
+    if constexpr(sizeof(E)==8){
+        using G=gvec<uint64_t, VS>;
+        typename G::type a=G::broadcast(0), b=G::broadcast(0);
+        for(; i+2*G::lanes<=n; i+=2*G::lanes){
+            a+=G::load(p+i*8);
+            b+=G::load(p+(i+G::lanes)*8);
+        }
+        a+=b;
+        for(size_t k=0; k<G::lanes; ++k){
+            total+=a[k];
+        }
+    }
+    else if constexpr(sizeof(E)==4){
+        // 按无符号数扩展到 64 位通道相加；有符号时每个负数多算了 2^32，另外统计负数的个数减去
+            // 负数个数在 32 位通道中按 2^32 取模，乘以 2^32 后模 2^64 的结果不变
+        using G=gvec<uint64_t, VS>;
+        using S=gvec<int32_t, VS>;
+        typename G::type acc=G::broadcast(0);
+        typename S::type neg=S::broadcast(0);
+        for(; i+lanes<=n; i+=lanes){
+            acc+=pair_sum<uint64_t>(G::load(p+i*4));
+            if constexpr(is_signed){
+                neg+=S::load(p+i*4)>>31;
+            }
+        }
+        for(size_t k=0; k<G::lanes; ++k){
+            total+=acc[k];
+        }
+        if constexpr(is_signed){
+            uint32_t count=0;
+            for(size_t k=0; k<S::lanes; ++k){
+                count-=static_cast<uint32_t>(neg[k]);
+            }
+            total-=static_cast<uint64_t>(count)<<32;
+        }
+    }
+    else{
+        // 16 位元素：每次给 32 位通道加上两个元素，绝对值不超过 2^17，累加 2^14 次不会溢出
+        // 8 位元素：先在 16 位通道中累加 64 次（不超过 2^15），再并入 32 位通道
+        using G32=gvec<W32, VS>;
+        using G16=gvec<W16, VS>;
+        constexpr size_t inner=sizeof(E)==1? 64: 1;
+        constexpr size_t outer=size_t(1)<<14;
+        while(i+lanes<=n){
+            typename G32::type acc=G32::broadcast(0);
+            for(size_t r=0; r<outer && i+lanes<=n; ++r){
+                if constexpr(sizeof(E)==1){
+                    typename G16::type acc16=G16::broadcast(0);
+                    for(size_t t=0; t<inner && i+lanes<=n; ++t, i+=lanes){
+                        acc16+=pair_sum<W16>(G16::load(p+i));
+                    }
+                    typename G32::type wide;
+                    __builtin_memcpy(&wide, &acc16, VS);
+                    acc+=pair_sum<W32>(wide);
+                }
+                else{
+                    acc+=pair_sum<W32>(G32::load(p+i*2));
+                    i+=lanes;
+                }
+            }
+            for(size_t k=0; k<G32::lanes; ++k){
+                total+=static_cast<uint64_t>(static_cast<W64>(acc[k]));
+            }
+        }
+    }
+    for(; i<n; ++i){
+        total+=static_cast<uint64_t>(load_word<E>(p+i*sizeof(E)));
+    }
+    return total;
+}
+
+// 10.sum_float：浮点数的树形求和
+    // 区间对半递归拆分到不超过 sum_block 个元素，块内用 4 个向量累加器，最后按通道两两相加，
+    // 舍入误差随 log(n) 而不是 n 增长，结果与逐个累加不同，所以只用于显式选择的 reduce
+constexpr size_t sum_block=256;
+
+template <size_t VS, class T>
+T sum_float_block(const unsigned char* p, size_t n) noexcept{
+    using G=gvec<T, VS>;
+    const size_t L=G::lanes;
+    auto a0=G::broadcast(0), a1=G::broadcast(0), a2=G::broadcast(0), a3=G::broadcast(0);
+    size_t i=0;
+    for(; i+4*L<=n; i+=4*L){
+        a0+=G::load(p+i*sizeof(T));
+        a1+=G::load(p+(i+L)*sizeof(T));
+        a2+=G::load(p+(i+2*L)*sizeof(T));
+        a3+=G::load(p+(i+3*L)*sizeof(T));
+    }
+    for(; i+L<=n; i+=L){
+        a0+=G::load(p+i*sizeof(T));
+    }
+    auto a=(a0+a1)+(a2+a3);
+    for(size_t w=L/2; w>0; w/=2){
+        for(size_t k=0; k<w; ++k){
+            a[k]+=a[k+w];
+        }
+    }
+    T tail=0;
+    for(; i<n; ++i){
+        tail+=load_word<T>(p+i*sizeof(T));
+    }
+    return a[0]+tail;
+}
+
+template <size_t VS, class T>
+T sum_float_tree(const unsigned char* p, size_t n) noexcept{
+    if(n<=sum_block){
+        return sum_float_block<VS, T>(p, n);
+    }
+    const size_t h=(n/sum_block/2)*sum_block;
+    const size_t left=h>0? h: sum_block;
+    return sum_float_tree<VS, T>(p, left)+sum_float_tree<VS, T>(p+left*sizeof(T), n-left);
+}
+
+template <size_t VS, class T>
+T sum_float(const void* ptr, size_t n) noexcept{
+    return sum_float_tree<VS, T>(static_cast<const unsigned char*>(ptr), n);
+}
+
+// 11.位数组：按 64 位字的与、或、异或、与非，popcount 和查找非零字
+template <int Op, class W>
+inline W apply_bit_op(W a, W b) noexcept{
+    if constexpr(Op==static_cast<int>(bit_op_kind::and_op)){
+        return a&b;
+    }
+    else if constexpr(Op==static_cast<int>(bit_op_kind::or_op)){
+        return a|b;
+    }
+    else if constexpr(Op==static_cast<int>(bit_op_kind::xor_op)){
+        return a^b;
+    }
+    else{
+        return a&~b;
+    }
+}
+
+// 每次先读出两个向量的操作数再写，dst 与 a 或 b 是同一个数组时也正确
+template <size_t VS, int Op>
+void bit_op(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    using G=gvec<uint64_t, VS>;
+    const size_t L=G::lanes;
+    unsigned char* d=reinterpret_cast<unsigned char*>(dst);
+    const unsigned char* pa=reinterpret_cast<const unsigned char*>(a);
+    const unsigned char* pb=reinterpret_cast<const unsigned char*>(b);
+    size_t i=0;
+    for(; i+2*L<=n; i+=2*L){
+        const auto x=apply_bit_op<Op>(G::load(pa+i*8), G::load(pb+i*8));
+        const auto y=apply_bit_op<Op>(G::load(pa+(i+L)*8), G::load(pb+(i+L)*8));
+        G::store(d+i*8, x);
+        G::store(d+(i+L)*8, y);
+    }
+    for(; i<n; ++i){
+        dst[i]=apply_bit_op<Op>(a[i], b[i]);
+    }
+}
+
+// 按通道的 popcount：每个字节得到其中 1 的个数（0~8）
+    // AVX2 没有按字节的 popcount 指令，与逐字用 popcnt 相比，这样每条指令处理一个向量，而且不依赖 -mpopcnt
+template <class Vec>
+inline Vec byte_popcount(Vec v) noexcept{
+    v-=(v>>1)&0x5555555555555555ull;
+    v=(v&0x3333333333333333ull)+((v>>2)&0x3333333333333333ull);
+    return (v+(v>>4))&0x0F0F0F0F0F0F0F0Full;
+}
+
+// 把每个 64 位通道中 8 个字节的计数加成一个数，字节计数不超过 255
+template <class Vec>
+inline Vec fold_byte_counts(Vec v) noexcept{
+    v=(v&0x00FF00FF00FF00FFull)+((v>>8)&0x00FF00FF00FF00FFull);
+    v=(v&0x0000FFFF0000FFFFull)+((v>>16)&0x0000FFFF0000FFFFull);
+    return (v&0x00000000FFFFFFFFull)+(v>>32);
+}
+
+// 字节计数在按 64 位相加时不会进位到相邻字节：每次加上不超过 8，累加 31 次不超过 248
+constexpr size_t popcount_fold_period=31;
+
+// 进位保留加法器：把 a、b、c 三个向量同一位上的 1 相加，和的低位写入 l、进位写入 h
+template <class Vec>
+inline void carry_save_add(Vec& h, Vec& l, Vec a, Vec b, Vec c) noexcept{
+    const Vec u=a^b;
+    h=(a&b)|(u&c);
+    l=u^c;
+}
+
+// And 为真时统计 a[i]&b[i]，否则只统计 a[i]（b 不使用）
+    // 大块用 Harley-Seal 方法：每 16 个向量经过进位保留加法器树，只有权为 16 的进位需要做一次 popcount，
+    // 权为 1、2、4、8 的部分和留在 ones、twos、fours、eights 中，最后各做一次；按字节的 popcount 约 12 条指令，
+    // 树中每个向量约 5 条，整体比每个向量都做 popcount 快一倍左右
+template <size_t VS, bool And>
+size_t popcount_words(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    using G=gvec<uint64_t, VS>;
+    using vec=typename G::type;
+    const size_t L=G::lanes;
+    const unsigned char* pa=reinterpret_cast<const unsigned char*>(a);
+    const unsigned char* pb=reinterpret_cast<const unsigned char*>(b);
+    auto load=[&](size_t i) noexcept{
+        if constexpr(And){
+            return G::load(pa+i*8)&G::load(pb+i*8);
+        }
+        else{
+            return G::load(pa+i*8);
+        }
+    };
+    vec total=G::broadcast(0);
+    size_t i=0;
+    if(n>=16*L){
+        vec ones=G::broadcast(0), twos=ones, fours=ones, eights=ones;
+        vec twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+        vec sixteens_count=G::broadcast(0);
+        for(; i+16*L<=n; i+=16*L){
+            carry_save_add(twos_a, ones, ones, load(i), load(i+L));
+            carry_save_add(twos_b, ones, ones, load(i+2*L), load(i+3*L));
+            carry_save_add(fours_a, twos, twos, twos_a, twos_b);
+            carry_save_add(twos_a, ones, ones, load(i+4*L), load(i+5*L));
+            carry_save_add(twos_b, ones, ones, load(i+6*L), load(i+7*L));
+            carry_save_add(fours_b, twos, twos, twos_a, twos_b);
+            carry_save_add(eights_a, fours, fours, fours_a, fours_b);
+            carry_save_add(twos_a, ones, ones, load(i+8*L), load(i+9*L));
+            carry_save_add(twos_b, ones, ones, load(i+10*L), load(i+11*L));
+            carry_save_add(fours_a, twos, twos, twos_a, twos_b);
+            carry_save_add(twos_a, ones, ones, load(i+12*L), load(i+13*L));
+            carry_save_add(twos_b, ones, ones, load(i+14*L), load(i+15*L));
+            carry_save_add(fours_b, twos, twos, twos_a, twos_b);
+            carry_save_add(eights_b, fours, fours, fours_a, fours_b);
+            carry_save_add(sixteens, eights, eights, eights_a, eights_b);
+            sixteens_count+=fold_byte_counts(byte_popcount(sixteens));
+        }
+        total=(sixteens_count<<4)+(fold_byte_counts(byte_popcount(eights))<<3)+
+              (fold_byte_counts(byte_popcount(fours))<<2)+(fold_byte_counts(byte_popcount(twos))<<1)+
+              fold_byte_counts(byte_popcount(ones));
+    }
+    while(i+L<=n){
+        vec acc=G::broadcast(0);
+        for(size_t r=0; r<popcount_fold_period && i+L<=n; ++r, i+=L){
+            acc+=byte_popcount(load(i));
+        }
+        total+=fold_byte_counts(acc);
+    }
+    size_t count=0;
+    for(size_t k=0; k<L; ++k){
+        count+=static_cast<size_t>(total[k]);
+    }
+    for(; i<n; ++i){
+        count+=static_cast<size_t>(__builtin_popcountll(And? a[i]&b[i]: a[i]));
+    }
+    return count;
+}
+
+template <size_t VS>
+size_t popcount64(const uint64_t* p, size_t n) noexcept{
+    return popcount_words<VS, false>(p, p, n);
+}
+
+template <size_t VS>
+size_t and_popcount64(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    return popcount_words<VS, true>(a, b, n);
+}
+
+// 每次把 4 个向量或在一起判断，有非零字时再逐字定位
+template <size_t VS>
+size_t find_nonzero64(const uint64_t* p, size_t n) noexcept{
+    using G=gvec<uint64_t, VS>;
+    const size_t L=G::lanes;
+    const unsigned char* q=reinterpret_cast<const unsigned char*>(p);
+    size_t i=0;
+    for(; i+4*L<=n; i+=4*L){
+        const auto v=(G::load(q+i*8)|G::load(q+(i+L)*8))|(G::load(q+(i+2*L)*8)|G::load(q+(i+3*L)*8));
+        if(G::any(v)){
+            break;
+        }
+    }
+    for(; i<n; ++i){
+        if(p[i]!=0){
+            return i;
+        }
+    }
+    return n;
+}
+
+// 12.哈希：一批 64 位键的 splitmix64 终结函数，与 functional.h 的 hash_mix64(key^seed) 逐位相同
+    // 不能调用 hash_mix64（见文件开头的注意），向量和标量尾部共用这个模板；
+    // 没有 64 位乘法指令的级别（SSE2、AVX2、不带 DQ 的 AVX-512）由编译器用 32 位乘法拼出
+template <class W>
+inline W mix64_lanes(W x) noexcept{
+    x^=x>>30;
+    x*=0xbf58476d1ce4e5b9ull;
+    x^=x>>27;
+    x*=0x94d049bb133111ebull;
+    x^=x>>31;
+    return x;
+}
+
+// 先读出两个向量再写，out 可以与 keys 是同一个数组
+template <size_t VS>
+void hash64(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept{
+    using G=gvec<uint64_t, VS>;
+    const size_t L=G::lanes;
+    const unsigned char* p=reinterpret_cast<const unsigned char*>(keys);
+    unsigned char* d=reinterpret_cast<unsigned char*>(out);
+    const auto s=G::broadcast(seed);
+    size_t i=0;
+    for(; i+2*L<=n; i+=2*L){
+        const auto x=mix64_lanes(G::load(p+i*8)^s);
+        const auto y=mix64_lanes(G::load(p+(i+L)*8)^s);
+        G::store(d+i*8, x);
+        G::store(d+(i+L)*8, y);
+    }
+    for(; i<n; ++i){
+        out[i]=mix64_lanes(keys[i]^seed);
+    }
+}
+
+template <class V>
+constexpr kernel_table make_table(isa level) noexcept{
+    return kernel_table{
+        level,
+        &copy_bytes<V>,
+        &fill<V, uint8_t>,
+        &fill<V, uint16_t>,
+        &fill<V, uint32_t>,
+        &fill<V, uint64_t>,
+        &mismatch_bytes<V>,
+        &find<V, uint8_t>,
+        &find<V, uint16_t>,
+        &find<V, uint32_t>,
+        &find<V, uint64_t>,
+        &count<V, uint8_t>,
+        &count<V, uint16_t>,
+        &count<V, uint32_t>,
+        &count<V, uint64_t>,
+        &find_first_of8<V>,
+        &search8<V>,
+        {
+            &min_element<V::size, int8_t>, &min_element<V::size, uint8_t>,
+            &min_element<V::size, int16_t>, &min_element<V::size, uint16_t>,
+            &min_element<V::size, int32_t>, &min_element<V::size, uint32_t>,
+            &min_element<V::size, int64_t>, &min_element<V::size, uint64_t>,
+            &min_element<V::size, float>, &min_element<V::size, double>,
+        },
+        {
+            &max_element<V::size, int8_t>, &max_element<V::size, uint8_t>,
+            &max_element<V::size, int16_t>, &max_element<V::size, uint16_t>,
+            &max_element<V::size, int32_t>, &max_element<V::size, uint32_t>,
+            &max_element<V::size, int64_t>, &max_element<V::size, uint64_t>,
+            &max_element<V::size, float>, &max_element<V::size, double>,
+        },
+        {
+            &minmax_element<V::size, int8_t>, &minmax_element<V::size, uint8_t>,
+            &minmax_element<V::size, int16_t>, &minmax_element<V::size, uint16_t>,
+            &minmax_element<V::size, int32_t>, &minmax_element<V::size, uint32_t>,
+            &minmax_element<V::size, int64_t>, &minmax_element<V::size, uint64_t>,
+            &minmax_element<V::size, float>, &minmax_element<V::size, double>,
+        },
+        {
+            &sum_int<V::size, int8_t>, &sum_int<V::size, uint8_t>,
+            &sum_int<V::size, int16_t>, &sum_int<V::size, uint16_t>,
+            &sum_int<V::size, int32_t>, &sum_int<V::size, uint32_t>,
+            &sum_int<V::size, uint64_t>, &sum_int<V::size, uint64_t>,
+        },
+        &sum_float<V::size, float>,
+        &sum_float<V::size, double>,
+        {
+            &bit_op<V::size, 0>, &bit_op<V::size, 1>, &bit_op<V::size, 2>, &bit_op<V::size, 3>,
+        },
+        &popcount64<V::size>,
+        &and_popcount64<V::size>,
+        &find_nonzero64<V::size>,
+        &hash64<V::size>,
+    };
+}
+
+} // namespace
+} // namespace simd
+} // namespace mystl
+
+#endif
@@ -0,0 +1,13 @@
+// SSE2 内核：16 字节向量，x86-64 上总是可用，向量类型 vec128 定义在 kernels_impl.h 中
+#include "kernels_impl.h"
+
+namespace mystl
+{
+namespace simd
+{
+
+extern const kernel_table sse2_kernels;
+const kernel_table sse2_kernels = make_table<vec128>(isa::sse2);
+
+} // namespace simd
+} // namespace mystl
@@ -1,6 +1,11 @@
 #ifndef MYTINYSTL_LIST_H_
 #define MYTINYSTL_LIST_H_
 
+// 这个头文件包含了一个模板类 list
+// list : 双向链表
+// 链表的链接操作（插入、摘除、拼接、反转）只依赖于 list_node_base，不涉及元素和内存分配
+// list 与 intrusive.h 中的 intrusive_list 共用这些算法
+
 #include <initializer_list>
 
 #include "iterator.h"
@@ -11,8 +16,606 @@
 
 namespace mystl
 {
-    
-} // namespace mystl
 
+// list_node_base：只含前后指针的节点基类
+    // 环形结构：头节点（哨兵）的 next 是第一个元素，prev 是最后一个元素
+    // 自己指向自己表示空链表，或者节点不在任何链表中
+struct list_node_base
+{
+    list_node_base* prev;
+    list_node_base* next;
+
+    list_node_base() noexcept: prev(this), next(this) {}
+
+    // 拷贝节点不拷贝链接关系，新节点总是未链接的
+    list_node_base(const list_node_base&) noexcept: prev(this), next(this) {}
+    list_node_base& operator=(const list_node_base&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next!=this; }
+};
+
+// 链接算法-----------------------------------------------------------------------------
+// 1.list_link_before：把 node 链接到 pos 之前
+inline void list_link_before(list_node_base* pos, list_node_base* node) noexcept{
+    node->prev=pos->prev;
+    node->next=pos;
+    pos->prev->next=node;
+    pos->prev=node;
+}
+
+// 2.list_unlink：把 node 从链表中摘下，并恢复为自环（未链接）状态
+inline void list_unlink(list_node_base* node) noexcept{
+    node->prev->next=node->next;
+    node->next->prev=node->prev;
+    node->prev=node;
+    node->next=node;
+}
+
+// 3.list_transfer：把 [first, last) 移动到 pos 之前，pos 不能位于 [first, last) 中
+    // 只修改六个指针，与区间长度无关，splice 和 swap 都基于它
+inline void list_transfer(list_node_base* pos, list_node_base* first, list_node_base* last) noexcept{
+    if(pos==last || first==last){
+        return;
+    }
+    list_node_base* tail=last->prev;
+    // 从原链表中断开
+    first->prev->next=last;
+    last->prev=first->prev;
+    // 接到 pos 之前
+    tail->next=pos;
+    first->prev=pos->prev;
+    pos->prev->next=first;
+    pos->prev=tail;
+}
+
+// 4.list_reverse：反转以 header 为头节点的链表，即交换每个节点（包括头节点）的前后指针
+inline void list_reverse(list_node_base* header) noexcept{
+    list_node_base* node=header;
+    do{
+        mystl::swap(node->prev, node->next);
+        node=node->prev;  // 交换后 prev 指向原来的下一个节点
+    }while(node!=header);
+}
+
+// 5.list_swap：交换两个链表的全部节点
+inline void list_swap(list_node_base* lhs, list_node_base* rhs) noexcept{
+    list_node_base tmp;
+    list_transfer(&tmp, lhs->next, lhs);
+    list_transfer(lhs, rhs->next, rhs);
+    list_transfer(rhs, tmp.next, &tmp);
+}
+
+
+// list 的节点与迭代器-----------------------------------------------------------------
+template <class T>
+struct list_node: public list_node_base
+{
+    T value;
+};
+
+template <class T>
+struct list_const_iterator;
+
+template <class T>
+struct list_iterator: public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+    typedef T                 value_type;
+    typedef T*                pointer;
+    typedef T&                reference;
+    typedef list_iterator<T>  self;
+
+    list_node_base* node;
+
+    list_iterator() noexcept: node(nullptr) {}
+    explicit list_iterator(list_node_base* x) noexcept: node(x) {}
+
+    reference operator*()  const { return static_cast<list_node<T>*>(node)->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++(){
+        node=node->next;
+        return *this;
+    }
+    self operator++(int){
+        self tmp=*this;
+        node=node->next;
+        return tmp;
+    }
+    self& operator--(){
+        node=node->prev;
+        return *this;
+    }
+    self operator--(int){
+        self tmp=*this;
+        node=node->prev;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node==rhs.node; }
+    bool operator!=(const self& rhs) const { return node!=rhs.node; }
+};
+
+template <class T>
+struct list_const_iterator: public mystl::iterator<mystl::bidirectional_iterator_tag, T>
+{
+    typedef T                       value_type;
+    typedef const T*                pointer;
+    typedef const T&                reference;
+    typedef list_const_iterator<T>  self;
+
+    const list_node_base* node;
+
+    list_const_iterator() noexcept: node(nullptr) {}
+    explicit list_const_iterator(const list_node_base* x) noexcept: node(x) {}
+    list_const_iterator(const list_iterator<T>& rhs) noexcept: node(rhs.node) {}
+
+    reference operator*()  const { return static_cast<const list_node<T>*>(node)->value; }
+    pointer   operator->() const { return &(operator*()); }
+
+    self& operator++(){
+        node=node->next;
+        return *this;
+    }
+    self operator++(int){
+        self tmp=*this;
+        node=node->next;
+        return tmp;
+    }
+    self& operator--(){
+        node=node->prev;
+        return *this;
+    }
+    self operator--(int){
+        self tmp=*this;
+        node=node->prev;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node==rhs.node; }
+    bool operator!=(const self& rhs) const { return node!=rhs.node; }
+};
+
+
+// 模板类 list
+// 模板参数 T 代表数据类型，Alloc 代表分配器类型
+template <class T, class Alloc=mystl::allocator<T>>
+class list
+{
+public:
+    typedef Alloc                                    allocator_type;
+    typedef T                                        value_type;
+    typedef T*                                       pointer;
+    typedef const T*                                 const_pointer;
+    typedef T&                                       reference;
+    typedef const T&                                 const_reference;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+
+    typedef list_iterator<T>                         iterator;
+    typedef list_const_iterator<T>                   const_iterator;
+    typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+private:
+    typedef list_node<T>                             node_type;
+    typedef mystl::rebind_alloc<Alloc, node_type>    node_allocator;
+
+    // 节点分配器和头节点放在一起，无状态分配器不占空间
+    mystl::compressed_pair<node_allocator, list_node_base> m_header;
+    size_type m_size;
+
+public:
+    // 构造、复制、移动、析构函数
+    list(): m_header(), m_size(0) {}
+
+    explicit list(const allocator_type& a): m_header(node_allocator(a), list_node_base()), m_size(0) {}
+
+    explicit list(size_type n): list(){
+        for(; n>0; --n){
+            emplace_back();
+        }
+    }
+
+    list(size_type n, const value_type& value): list(){
+        insert(end(), n, value);
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    list(Iter first, Iter last, const allocator_type& a=allocator_type())
+        : m_header(node_allocator(a), list_node_base()), m_size(0){
+        try{
+            for(; first!=last; ++first){
+                emplace_back(*first);
+            }
+        }
+        catch(...){
+            clear();
+            throw;
+        }
+    }
+
+    list(std::initializer_list<value_type> ilist): list(ilist.begin(), ilist.end()) {}
+
+    list(const list& rhs): list(rhs.begin(), rhs.end(), rhs.get_allocator()) {}
+
+    // 移动构造只转移节点，不分配内存
+    list(list&& rhs) noexcept: m_header(mystl::move(rhs.m_header.first()), list_node_base()), m_size(rhs.m_size){
+        list_transfer(header(), rhs.header()->next, rhs.header());
+        rhs.m_size=0;
+    }
+
+    list& operator=(const list& rhs){
+        if(this!=&rhs){
+            assign(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+
+    list& operator=(list&& rhs) noexcept{
+        clear();
+        list_transfer(header(), rhs.header()->next, rhs.header());
+        m_size=rhs.m_size;
+        rhs.m_size=0;
+        return *this;
+    }
+
+    list& operator=(std::initializer_list<value_type> ilist){
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~list() { clear(); }
+
+public:
+    // 迭代器相关操作
+    iterator               begin()         noexcept { return iterator(header()->next); }
+    const_iterator         begin()   const noexcept { return const_iterator(header()->next); }
+    iterator               end()           noexcept { return iterator(header()); }
+    const_iterator         end()     const noexcept { return const_iterator(header()); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return m_size==0; }
+    size_type size()     const noexcept { return m_size; }
+    size_type max_size() const noexcept { return static_cast<size_type>(-1)/sizeof(node_type); }
+
+    allocator_type get_allocator() const { return allocator_type(m_header.first()); }
+
+    // 访问元素相关操作
+    reference front(){
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    const_reference front() const{
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    reference back(){
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+    const_reference back() const{
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    // 调整容器相关操作
+    // assign：复用已有节点，多出的删除，不足的补上
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    void assign(Iter first, Iter last){
+        iterator cur=begin();
+        for(; cur!=end() && first!=last; ++cur, ++first){
+            *cur=*first;
+        }
+        if(first==last){
+            erase(cur, end());
+        }
+        else{
+            insert(end(), first, last);
+        }
+    }
+
+    void assign(size_type n, const value_type& value){
+        iterator cur=begin();
+        for(; cur!=end() && n>0; ++cur, --n){
+            *cur=value;
+        }
+        if(n==0){
+            erase(cur, end());
+        }
+        else{
+            insert(end(), n, value);
+        }
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args){
+        node_type* node=create_node(mystl::forward<Args>(args)...);
+        list_link_before(const_cast<list_node_base*>(pos.node), node);
+        ++m_size;
+        return iterator(node);
+    }
+
+    template <class... Args>
+    reference emplace_front(Args&&... args){
+        return *emplace(begin(), mystl::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args){
+        return *emplace(end(), mystl::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const value_type& value){
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value){
+        return emplace(pos, mystl::move(value));
+    }
+
+    // 批量插入：先在临时链表中构造好，再整体拼接，构造失败时原链表不变
+    iterator insert(const_iterator pos, size_type n, const value_type& value){
+        list tmp(get_allocator());
+        for(; n>0; --n){
+            tmp.emplace_back(value);
+        }
+        return splice_all(pos, tmp);
+    }
+
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    iterator insert(const_iterator pos, Iter first, Iter last){
+        list tmp(first, last, get_allocator());
+        return splice_all(pos, tmp);
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist){
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_front(value_type&& value)      { emplace_front(mystl::move(value)); }
+    void push_back(const value_type& value)  { emplace_back(value); }
+    void push_back(value_type&& value)       { emplace_back(mystl::move(value)); }
+
+    void pop_front(){
+        MYSTL_DEBUG(!empty());
+        erase(begin());
+    }
+
+    void pop_back(){
+        MYSTL_DEBUG(!empty());
+        erase(--end());
+    }
+
+    iterator erase(const_iterator pos){
+        MYSTL_DEBUG(pos!=cend());
+        list_node_base* node=const_cast<list_node_base*>(pos.node);
+        list_node_base* next=node->next;
+        list_unlink(node);
+        destroy_node(static_cast<node_type*>(node));
+        --m_size;
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last){
+        while(first!=last){
+            first=erase(first);
+        }
+        return iterator(const_cast<list_node_base*>(last.node));
+    }
+
+    void clear() noexcept{
+        list_node_base* cur=header()->next;
+        while(cur!=header()){
+            list_node_base* next=cur->next;
+            destroy_node(static_cast<node_type*>(cur));
+            cur=next;
+        }
+        header()->prev=header();
+        header()->next=header();
+        m_size=0;
+    }
+
+    void resize(size_type n) { resize(n, value_type()); }
+
+    void resize(size_type n, const value_type& value){
+        if(n<m_size){
+            iterator cur=begin();
+            mystl::advance(cur, n);
+            erase(cur, end());
+        }
+        else{
+            insert(end(), n-m_size, value);
+        }
+    }
+
+    void swap(list& rhs) noexcept{
+        list_swap(header(), rhs.header());
+        mystl::swap(m_size, rhs.m_size);
+    }
+
+    // list 相关操作：都只修改指针，不分配内存，也不拷贝元素
+    // 将 x 全部接合到 pos 之前
+    void splice(const_iterator pos, list& x){
+        if(this!=&x){
+            splice_all(pos, x);
+        }
+    }
+
+    void splice(const_iterator pos, list&& x) { splice(pos, x); }
+
+    // 将 x 中 it 所指的节点接合到 pos 之前
+    void splice(const_iterator pos, list& x, const_iterator it){
+        list_node_base* node=const_cast<list_node_base*>(it.node);
+        list_node_base* p=const_cast<list_node_base*>(pos.node);
+        if(p!=node && p!=node->next){
+            list_transfer(p, node, node->next);
+            --x.m_size;
+            ++m_size;
+        }
+    }
+
+    // 将 x 中 [first, last) 的节点接合到 pos 之前
+    void splice(const_iterator pos, list& x, const_iterator first, const_iterator last){
+        if(first==last){
+            return;
+        }
+        if(this!=&x){
+            size_type n=static_cast<size_type>(mystl::distance(first, last));
+            x.m_size-=n;
+            m_size+=n;
+        }
+        list_transfer(const_cast<list_node_base*>(pos.node),
+                      const_cast<list_node_base*>(first.node),
+                      const_cast<list_node_base*>(last.node));
+    }
+
+    // value 可能引用本链表中的元素（如 l.remove(l.front())），这个节点留到最后删除，比较时它一直有效
+    void remove(const value_type& value){
+        iterator self=end();
+        for(iterator cur=begin(); cur!=end();){
+            if(*cur==value){
+                if(mystl::address_of(*cur)==mystl::address_of(value)){
+                    self=cur++;
+                    continue;
+                }
+                cur=erase(cur);
+            }
+            else{
+                ++cur;
+            }
+        }
+        if(self!=end()){
+            erase(self);
+        }
+    }
+
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred){
+        for(iterator cur=begin(); cur!=end();){
+            if(pred(*cur)){
+                cur=erase(cur);
+            }
+            else{
+                ++cur;
+            }
+        }
+    }
+
+    // 删除相邻的重复元素
+    void unique(){
+        unique(mystl::equal_to<value_type>());
+    }
+
+    template <class BinaryPredicate>
+    void unique(BinaryPredicate pred){
+        if(m_size<2){
+            return;
+        }
+        iterator prev=begin();
+        iterator cur=prev;
+        for(++cur; cur!=end();){
+            if(pred(*prev, *cur)){
+                cur=erase(cur);
+            }
+            else{
+                prev=cur++;
+            }
+        }
+    }
+
+    void reverse() noexcept{
+        if(m_size>1){
+            list_reverse(header());
+        }
+    }
+
+private:
+    list_node_base* header() noexcept { return &m_header.second(); }
+    const list_node_base* header() const noexcept { return &m_header.second(); }
+
+    template <class... Args>
+    node_type* create_node(Args&&... args){
+        node_allocator& a=m_header.first();
+        node_type* p=a.allocate(1);
+        try{
+            ::new ((void*)static_cast<list_node_base*>(p)) list_node_base();
+            mystl::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+        }
+        catch(...){
+            a.deallocate(p, 1);
+            throw;
+        }
+        return p;
+    }
+
+    void destroy_node(node_type* p) noexcept{
+        mystl::destroy(mystl::address_of(p->value));
+        m_header.first().deallocate(p, 1);
+    }
+
+    // 把 x 的全部节点接到 pos 之前，返回第一个被接入的节点（x 为空时返回 pos）
+    iterator splice_all(const_iterator pos, list& x){
+        list_node_base* p=const_cast<list_node_base*>(pos.node);
+        if(x.empty()){
+            return iterator(p);
+        }
+        list_node_base* first=x.header()->next;
+        list_transfer(p, first, x.header());
+        m_size+=x.m_size;
+        x.m_size=0;
+        return iterator(first);
+    }
+};
+
+// 重载比较操作符
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return lhs.size()==rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return !(lhs==rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return rhs<lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return !(rhs<lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs){
+    return !(lhs<rhs);
+}
+
+// 重载 mystl 的 swap
+template <class T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
 
-#endif
\ No newline at end of file
+#endif
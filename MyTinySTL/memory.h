@@ -2,11 +2,15 @@
 #define MYTINYSTL_MEMORY_H_
 
 // 这个头文件负责更高级的动态内存管理
-// 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr
+// 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及智能指针 auto_ptr、unique_ptr、shared_ptr、local_shared_ptr、intrusive_ptr
 
+#include <atomic>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <climits>
+#include <thread>
 
 #include "algorithm_base.h"
 #include "allocator.h"
@@ -194,6 +198,1049 @@ public:
 };
 
 
+// default_delete：unique_ptr 默认的删除器，无状态，放在 compressed_pair 中不占空间
+template <class T>
+struct default_delete
+{
+    constexpr default_delete() noexcept=default;
+
+    // 允许 default_delete<Derived> 转换为 default_delete<Base>
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    default_delete(const default_delete<U>&) noexcept {}
+
+    void operator()(T* ptr) const noexcept{
+        static_assert(sizeof(T)>0, "can't delete an incomplete type");
+        delete ptr;
+    }
+};
+
+template <class T>
+struct default_delete<T[]>
+{
+    constexpr default_delete() noexcept=default;
+
+    void operator()(T* ptr) const noexcept{
+        static_assert(sizeof(T)>0, "can't delete an incomplete type");
+        delete[] ptr;
+    }
+};
+
+// unique_ptr：独占所有权的智能指针，只能移动不能拷贝
+    // 与 auto_ptr 不同，所有权转移必须显式 move，因此可以安全地放进容器、在扩容时移动
+    // 指针和删除器存放在 compressed_pair 中，无状态删除器不占空间，unique_ptr<T> 与 T* 一样大
+template <class T, class Deleter=default_delete<T>>
+class unique_ptr
+{
+public:
+    typedef T        element_type;
+    typedef T*       pointer;
+    typedef Deleter  deleter_type;
+
+private:
+    mystl::compressed_pair<pointer, deleter_type> m_pair;  // 实际指针 + 删除器
+
+public:
+    constexpr unique_ptr() noexcept: m_pair() {}
+    constexpr unique_ptr(std::nullptr_t) noexcept: m_pair() {}
+    explicit unique_ptr(pointer p) noexcept: m_pair(p, deleter_type()) {}
+
+    unique_ptr(pointer p, const deleter_type& d) noexcept: m_pair(p, d) {}
+    unique_ptr(pointer p, deleter_type&& d) noexcept: m_pair(p, mystl::move(d)) {}
+
+    // 移动构造：接管 rhs 的指针和删除器
+    unique_ptr(unique_ptr&& rhs) noexcept
+        : m_pair(rhs.release(), mystl::forward<deleter_type>(rhs.get_deleter())) {}
+
+    // 从 unique_ptr<U, E> 移动构造（如派生类指针转基类指针）
+    template <class U, class E,
+        typename std::enable_if<
+            !std::is_array<U>::value &&
+            std::is_convertible<typename unique_ptr<U, E>::pointer, pointer>::value &&
+            std::is_convertible<E, deleter_type>::value, int>::type=0>
+    unique_ptr(unique_ptr<U, E>&& rhs) noexcept
+        : m_pair(rhs.release(), mystl::forward<E>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&)=delete;
+    unique_ptr& operator=(const unique_ptr&)=delete;
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept{
+        reset(rhs.release());
+        get_deleter()=mystl::forward<deleter_type>(rhs.get_deleter());
+        return *this;
+    }
+
+    template <class U, class E,
+        typename std::enable_if<
+            !std::is_array<U>::value &&
+            std::is_convertible<typename unique_ptr<U, E>::pointer, pointer>::value &&
+            std::is_assignable<deleter_type&, E&&>::value, int>::type=0>
+    unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept{
+        reset(rhs.release());
+        get_deleter()=mystl::forward<E>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept{
+        reset();
+        return *this;
+    }
+
+    ~unique_ptr() { reset(); }
+
+public:
+    typename std::add_lvalue_reference<T>::type operator*() const { return *get(); }
+    pointer operator->() const noexcept { return get(); }
+
+    pointer get() const noexcept { return m_pair.first(); }
+    deleter_type& get_deleter() noexcept { return m_pair.second(); }
+    const deleter_type& get_deleter() const noexcept { return m_pair.second(); }
+
+    explicit operator bool() const noexcept { return get()!=nullptr; }
+
+    // 释放所有权，返回所管理资源的指针
+    pointer release() noexcept{
+        pointer tmp=m_pair.first();
+        m_pair.first()=nullptr;
+        return tmp;
+    }
+
+    // 先替换再删除旧指针，即使删除器间接访问 *this 也能看到新的状态
+    void reset(pointer p=pointer()) noexcept{
+        pointer old=m_pair.first();
+        m_pair.first()=p;
+        if(old!=nullptr){
+            get_deleter()(old);
+        }
+    }
+
+    void swap(unique_ptr& rhs) noexcept { m_pair.swap(rhs.m_pair); }
+};
+
+// 数组版本：提供 operator[]，不提供 operator* 和 operator->
+template <class T, class Deleter>
+class unique_ptr<T[], Deleter>
+{
+public:
+    typedef T        element_type;
+    typedef T*       pointer;
+    typedef Deleter  deleter_type;
+
+private:
+    mystl::compressed_pair<pointer, deleter_type> m_pair;
+
+public:
+    constexpr unique_ptr() noexcept: m_pair() {}
+    constexpr unique_ptr(std::nullptr_t) noexcept: m_pair() {}
+    explicit unique_ptr(pointer p) noexcept: m_pair(p, deleter_type()) {}
+    unique_ptr(pointer p, const deleter_type& d) noexcept: m_pair(p, d) {}
+    unique_ptr(pointer p, deleter_type&& d) noexcept: m_pair(p, mystl::move(d)) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept
+        : m_pair(rhs.release(), mystl::forward<deleter_type>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&)=delete;
+    unique_ptr& operator=(const unique_ptr&)=delete;
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept{
+        reset(rhs.release());
+        get_deleter()=mystl::forward<deleter_type>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept{
+        reset();
+        return *this;
+    }
+
+    ~unique_ptr() { reset(); }
+
+public:
+    T& operator[](size_t i) const { return get()[i]; }
+
+    pointer get() const noexcept { return m_pair.first(); }
+    deleter_type& get_deleter() noexcept { return m_pair.second(); }
+    const deleter_type& get_deleter() const noexcept { return m_pair.second(); }
+
+    explicit operator bool() const noexcept { return get()!=nullptr; }
+
+    pointer release() noexcept{
+        pointer tmp=m_pair.first();
+        m_pair.first()=nullptr;
+        return tmp;
+    }
+
+    void reset(pointer p=pointer()) noexcept{
+        pointer old=m_pair.first();
+        m_pair.first()=p;
+        if(old!=nullptr){
+            get_deleter()(old);
+        }
+    }
+
+    void swap(unique_ptr& rhs) noexcept { m_pair.swap(rhs.m_pair); }
+};
+
+template <class T, class D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs){
+    return lhs.get()==rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs){
+    return !(lhs==rhs);
+}
+
+template <class T, class D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept{
+    return !lhs;
+}
+
+template <class T, class D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept{
+    return static_cast<bool>(lhs);
+}
+
+// make_unique：单个对象版本
+template <class T, class... Args>
+typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type
+    make_unique(Args&&... args){
+    return unique_ptr<T>(new T(mystl::forward<Args>(args)...));
+}
+
+// make_unique：数组版本，元素值初始化
+template <class T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value==0, unique_ptr<T>>::type
+    make_unique(size_t n){
+    typedef typename std::remove_extent<T>::type elem_type;
+    return unique_ptr<T>(new elem_type[n]());
+}
+
+
+// shared_ptr 的控制块-------------------------------------------------------------------
+// shared_count_base：保存引用计数，计数归零时通过虚函数销毁对象、释放控制块
+    // 计数是原子的，多个线程可以同时拷贝、销毁指向同一对象的 shared_ptr
+    // 增加计数只需保证原子性（relaxed）；减少计数需要 acq_rel，保证其他线程对对象的写入在销毁前可见
+class shared_count_base
+{
+private:
+    std::atomic<long> m_use_count;
+
+public:
+    shared_count_base() noexcept: m_use_count(1) {}
+    virtual ~shared_count_base()=default;
+
+    shared_count_base(const shared_count_base&)=delete;
+    shared_count_base& operator=(const shared_count_base&)=delete;
+
+    // 销毁所管理的对象
+    virtual void dispose() noexcept=0;
+    // 释放控制块自身
+    virtual void destroy() noexcept=0;
+
+    void add_ref() noexcept{
+        m_use_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept{
+        if(m_use_count.fetch_sub(1, std::memory_order_acq_rel)==1){
+            dispose();
+            destroy();
+        }
+    }
+
+    long use_count() const noexcept{
+        return m_use_count.load(std::memory_order_relaxed);
+    }
+};
+
+// shared_count_ptr：对象由调用者单独分配，控制块保存指针和删除器（两次分配）
+template <class Ptr, class Deleter>
+class shared_count_ptr: public shared_count_base
+{
+private:
+    mystl::compressed_pair<Ptr, Deleter> m_pair;
+
+public:
+    shared_count_ptr(Ptr p, Deleter d) noexcept: m_pair(p, mystl::move(d)) {}
+
+    void dispose() noexcept override { m_pair.second()(m_pair.first()); }
+    void destroy() noexcept override { delete this; }
+};
+
+// shared_count_inplace：对象和控制块在同一块内存中（make_shared/allocate_shared，一次分配）
+    // 分配器放在 compressed_pair 中，无状态分配器不占空间
+template <class T, class Alloc>
+class shared_count_inplace: public shared_count_base
+{
+private:
+    typedef mystl::rebind_alloc<Alloc, shared_count_inplace> block_allocator;
+
+    mystl::compressed_pair<Alloc, typename std::aligned_storage<sizeof(T), alignof(T)>::type> m_storage;
+
+public:
+    template <class... Args>
+    explicit shared_count_inplace(const Alloc& a, Args&&... args): m_storage(a, {}){
+        mystl::construct(ptr(), mystl::forward<Args>(args)...);
+    }
+
+    T* ptr() noexcept { return reinterpret_cast<T*>(&m_storage.second()); }
+
+    void dispose() noexcept override { mystl::destroy(ptr()); }
+
+    void destroy() noexcept override{
+        block_allocator a(m_storage.first());
+        this->~shared_count_inplace();
+        a.deallocate(this, 1);
+    }
+};
+
+
+// 标记类型：从已经建立好的控制块构造 shared_ptr，与 (U* p, Deleter d) 构造函数区分
+struct shared_count_tag {};
+
+// shared_ptr：共享所有权的智能指针，最后一个 shared_ptr 销毁时释放对象
+template <class T>
+class shared_ptr
+{
+public:
+    typedef T element_type;
+
+private:
+    T*                 m_ptr;    // 所指对象
+    shared_count_base* m_count;  // 控制块
+
+    template <class U> friend class shared_ptr;
+
+    template <class U, class Alloc, class... Args>
+    friend shared_ptr<U> allocate_shared(const Alloc& a, Args&&... args);
+
+    // 供 allocate_shared 使用：接管已经建立好的控制块
+    shared_ptr(shared_count_tag, T* p, shared_count_base* count) noexcept: m_ptr(p), m_count(count) {}
+
+public:
+    constexpr shared_ptr() noexcept: m_ptr(nullptr), m_count(nullptr) {}
+    constexpr shared_ptr(std::nullptr_t) noexcept: m_ptr(nullptr), m_count(nullptr) {}
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    explicit shared_ptr(U* p): shared_ptr(p, default_delete<U>()) {}
+
+    // 控制块分配失败时用删除器释放 p，再抛出异常，避免泄漏
+    template <class U, class Deleter,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    shared_ptr(U* p, Deleter d): m_ptr(p), m_count(nullptr){
+        try{
+            m_count=new shared_count_ptr<U*, Deleter>(p, d);
+        }
+        catch(...){
+            d(p);
+            throw;
+        }
+    }
+
+    // 别名构造：与 rhs 共享控制块，但指向 p（如指向对象的某个成员）
+    template <class U>
+    shared_ptr(const shared_ptr<U>& rhs, T* p) noexcept: m_ptr(p), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    shared_ptr(const shared_ptr& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    shared_ptr(const shared_ptr<U>& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    // 移动不改变引用计数，避免一次原子操作
+    shared_ptr(shared_ptr&& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        rhs.m_ptr=nullptr;
+        rhs.m_count=nullptr;
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    shared_ptr(shared_ptr<U>&& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        rhs.m_ptr=nullptr;
+        rhs.m_count=nullptr;
+    }
+
+    // 从 unique_ptr 接管所有权
+    template <class U, class Deleter,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    shared_ptr(unique_ptr<U, Deleter>&& rhs): m_ptr(rhs.get()), m_count(nullptr){
+        if(m_ptr){
+            m_count=new shared_count_ptr<U*, Deleter>(rhs.get(), mystl::move(rhs.get_deleter()));
+            rhs.release();
+        }
+    }
+
+    ~shared_ptr(){
+        if(m_count){
+            m_count->release();
+        }
+    }
+
+    // 拷贝-交换：同时处理自赋值和异常安全
+    shared_ptr& operator=(const shared_ptr& rhs) noexcept{
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    shared_ptr& operator=(const shared_ptr<U>& rhs) noexcept{
+        shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    shared_ptr& operator=(shared_ptr&& rhs) noexcept{
+        shared_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    shared_ptr& operator=(shared_ptr<U>&& rhs) noexcept{
+        shared_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U, class Deleter>
+    shared_ptr& operator=(unique_ptr<U, Deleter>&& rhs){
+        shared_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+public:
+    typename std::add_lvalue_reference<T>::type operator*() const noexcept { return *m_ptr; }
+    T* operator->() const noexcept { return m_ptr; }
+
+    T* get() const noexcept { return m_ptr; }
+
+    long use_count() const noexcept { return m_count? m_count->use_count(): 0; }
+
+    explicit operator bool() const noexcept { return m_ptr!=nullptr; }
+
+    void reset() noexcept { shared_ptr().swap(*this); }
+
+    template <class U>
+    void reset(U* p) { shared_ptr(p).swap(*this); }
+
+    template <class U, class Deleter>
+    void reset(U* p, Deleter d) { shared_ptr(p, d).swap(*this); }
+
+    void swap(shared_ptr& rhs) noexcept{
+        mystl::swap(m_ptr, rhs.m_ptr);
+        mystl::swap(m_count, rhs.m_count);
+    }
+};
+
+template <class T>
+void swap(shared_ptr<T>& lhs, shared_ptr<T>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+template <class T, class U>
+bool operator==(const shared_ptr<T>& lhs, const shared_ptr<U>& rhs) noexcept{
+    return lhs.get()==rhs.get();
+}
+
+template <class T, class U>
+bool operator!=(const shared_ptr<T>& lhs, const shared_ptr<U>& rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+template <class T>
+bool operator==(const shared_ptr<T>& lhs, std::nullptr_t) noexcept{
+    return !lhs;
+}
+
+template <class T>
+bool operator!=(const shared_ptr<T>& lhs, std::nullptr_t) noexcept{
+    return static_cast<bool>(lhs);
+}
+
+// allocate_shared：用分配器 a 一次性分配控制块和对象
+    // 对象紧跟在引用计数之后，解引用时与计数在同一条缓存行上
+template <class T, class Alloc, class... Args>
+shared_ptr<T> allocate_shared(const Alloc& a, Args&&... args){
+    typedef shared_count_inplace<T, Alloc> block_type;
+    mystl::rebind_alloc<Alloc, block_type> block_alloc(a);
+    block_type* block=block_alloc.allocate(1);
+    try{
+        ::new ((void*)block) block_type(a, mystl::forward<Args>(args)...);
+    }
+    catch(...){
+        block_alloc.deallocate(block, 1);
+        throw;
+    }
+    return shared_ptr<T>(shared_count_tag(), block->ptr(), block);
+}
+
+// make_shared：使用 mystl::allocator 的 allocate_shared
+template <class T, class... Args>
+shared_ptr<T> make_shared(Args&&... args){
+    return mystl::allocate_shared<T>(mystl::allocator<T>(), mystl::forward<Args>(args)...);
+}
+
+// fixed_block_pool：固定大小内存块的线程局部内存池
+    // 每个线程、每种 (Size, Align) 各有一条空闲链表，分配和释放只是链表的头部插入/删除，不需要加锁
+    // 内存按 chunk 批量申请，线程退出时释放
+    // 使用约定：块必须由申请它的线程归还，并且在这个线程退出（内存池析构）之前归还；
+    // 归还到别的线程的链表里，会让两个线程的 chunk 交错使用，一方退出时释放的 chunk 可能还在另一方的空闲链表中
+    // 调试模式下检查这两条约定；发布模式下线程退出时若还有块没有归还则保留全部 chunk，让这些块不至于悬空
+template <size_t Size, size_t Align>
+class fixed_block_pool
+{
+private:
+    union block
+    {
+        block* next;
+        typename std::aligned_storage<Size, Align>::type storage;
+    };
+
+    struct chunk
+    {
+        chunk* next;
+    };
+
+    static constexpr size_t blocks_per_chunk=64;
+    // 块数组紧跟在 chunk 头之后，按 block 的对齐要求对齐
+    static constexpr size_t header_size=(sizeof(chunk)+alignof(block)-1)/alignof(block)*alignof(block);
+
+    block* m_free_list;
+    chunk* m_chunks;
+    size_t m_in_use;
+
+    fixed_block_pool() noexcept: m_free_list(nullptr), m_chunks(nullptr), m_in_use(0) {}
+
+    ~fixed_block_pool(){
+        assert(m_in_use==0 && "mystl::fixed_block_pool: blocks outlive the thread that allocated them");
+        if(m_in_use!=0){
+            return;
+        }
+        while(m_chunks){
+            chunk* next=m_chunks->next;
+            ::operator delete(m_chunks);
+            m_chunks=next;
+        }
+    }
+
+    // 申请一个新的 chunk，把其中的块全部挂到空闲链表上
+    void refill(){
+        static_assert(alignof(block)<=alignof(std::max_align_t), "over-aligned blocks are not supported");
+        void* mem=::operator new(header_size+blocks_per_chunk*sizeof(block));
+        chunk* c=static_cast<chunk*>(mem);
+        c->next=m_chunks;
+        m_chunks=c;
+        block* blocks=reinterpret_cast<block*>(static_cast<char*>(mem)+header_size);
+        for(size_t i=0; i<blocks_per_chunk; ++i){
+            blocks[i].next=m_free_list;
+            m_free_list=&blocks[i];
+        }
+    }
+
+    // p 是否位于本线程的某个 chunk 中，只在断言中使用
+    bool owns(const void* p) const noexcept{
+        const uintptr_t addr=reinterpret_cast<uintptr_t>(p);
+        for(const chunk* c=m_chunks; c!=nullptr; c=c->next){
+            const uintptr_t first=reinterpret_cast<uintptr_t>(c)+header_size;
+            if(addr>=first && addr<first+blocks_per_chunk*sizeof(block)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    fixed_block_pool(const fixed_block_pool&)=delete;
+    fixed_block_pool& operator=(const fixed_block_pool&)=delete;
+
+    static fixed_block_pool& local(){
+        static thread_local fixed_block_pool pool;
+        return pool;
+    }
+
+    void* allocate(){
+        if(m_free_list==nullptr){
+            refill();
+        }
+        block* b=m_free_list;
+        m_free_list=b->next;
+        ++m_in_use;
+        return b;
+    }
+
+    void deallocate(void* p) noexcept{
+        assert(owns(p) && "mystl::fixed_block_pool: block freed by a thread other than its owner");
+        block* b=static_cast<block*>(p);
+        b->next=m_free_list;
+        m_free_list=b;
+        --m_in_use;
+    }
+};
+
+// local_shared_ptr 的控制块-----------------------------------------------------------
+// local_count_base：非原子的引用计数，只能在一个线程内使用
+    // 拷贝/销毁只是普通的加减，没有 lock 前缀指令和内存屏障，适合单线程的热路径
+    // 调试模式（未定义 NDEBUG）下记录创建控制块的线程，在其他线程中修改计数时触发断言
+class local_count_base
+{
+private:
+    long m_use_count;
+#ifndef NDEBUG
+    std::thread::id m_owner;
+#endif
+
+protected:
+    void check_owner() const noexcept{
+#ifndef NDEBUG
+        assert(m_owner==std::this_thread::get_id() &&
+               "mystl::local_shared_ptr shared across threads, use mystl::shared_ptr instead");
+#endif
+    }
+
+public:
+    local_count_base() noexcept: m_use_count(1)
+#ifndef NDEBUG
+        , m_owner(std::this_thread::get_id())
+#endif
+    {}
+    virtual ~local_count_base()=default;
+
+    local_count_base(const local_count_base&)=delete;
+    local_count_base& operator=(const local_count_base&)=delete;
+
+    virtual void dispose() noexcept=0;
+    virtual void destroy() noexcept=0;
+
+    void add_ref() noexcept{
+        check_owner();
+        ++m_use_count;
+    }
+
+    void release() noexcept{
+        check_owner();
+        if(--m_use_count==0){
+            dispose();
+            destroy();
+        }
+    }
+
+    long use_count() const noexcept { return m_use_count; }
+};
+
+// local_count_ptr：保存指针和删除器，控制块来自内存池
+template <class Ptr, class Deleter>
+class local_count_ptr: public local_count_base
+{
+private:
+    mystl::compressed_pair<Ptr, Deleter> m_pair;
+
+    local_count_ptr(Ptr p, Deleter d) noexcept: m_pair(p, mystl::move(d)) {}
+
+    static auto& pool(){
+        return fixed_block_pool<sizeof(local_count_ptr), alignof(local_count_ptr)>::local();
+    }
+
+public:
+    static local_count_ptr* create(Ptr p, Deleter d){
+        return ::new (pool().allocate()) local_count_ptr(p, mystl::move(d));
+    }
+
+    void dispose() noexcept override { m_pair.second()(m_pair.first()); }
+
+    void destroy() noexcept override{
+        this->~local_count_ptr();
+        pool().deallocate(this);
+    }
+};
+
+// local_count_inplace：对象与控制块在同一个池块中（make_local_shared）
+template <class T>
+class local_count_inplace: public local_count_base
+{
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+
+    template <class... Args>
+    explicit local_count_inplace(Args&&... args){
+        mystl::construct(ptr(), mystl::forward<Args>(args)...);
+    }
+
+    static auto& pool(){
+        return fixed_block_pool<sizeof(local_count_inplace), alignof(local_count_inplace)>::local();
+    }
+
+public:
+    template <class... Args>
+    static local_count_inplace* create(Args&&... args){
+        void* mem=pool().allocate();
+        try{
+            return ::new (mem) local_count_inplace(mystl::forward<Args>(args)...);
+        }
+        catch(...){
+            pool().deallocate(mem);
+            throw;
+        }
+    }
+
+    T* ptr() noexcept { return reinterpret_cast<T*>(&m_storage); }
+
+    void dispose() noexcept override { mystl::destroy(ptr()); }
+
+    void destroy() noexcept override{
+        this->~local_count_inplace();
+        pool().deallocate(this);
+    }
+};
+
+
+// local_shared_ptr：单线程版本的 shared_ptr
+    // 接口与 shared_ptr 相同，但引用计数不是原子的，控制块从线程局部内存池分配
+    // 只能在创建它的线程中拷贝和销毁；需要跨线程共享时使用 shared_ptr
+template <class T>
+class local_shared_ptr
+{
+public:
+    typedef T element_type;
+
+private:
+    T*                m_ptr;
+    local_count_base* m_count;
+
+    template <class U> friend class local_shared_ptr;
+
+    template <class U, class... Args>
+    friend local_shared_ptr<U> make_local_shared(Args&&... args);
+
+    local_shared_ptr(shared_count_tag, T* p, local_count_base* count) noexcept: m_ptr(p), m_count(count) {}
+
+public:
+    constexpr local_shared_ptr() noexcept: m_ptr(nullptr), m_count(nullptr) {}
+    constexpr local_shared_ptr(std::nullptr_t) noexcept: m_ptr(nullptr), m_count(nullptr) {}
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    explicit local_shared_ptr(U* p): local_shared_ptr(p, default_delete<U>()) {}
+
+    template <class U, class Deleter,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    local_shared_ptr(U* p, Deleter d): m_ptr(p), m_count(nullptr){
+        try{
+            m_count=local_count_ptr<U*, Deleter>::create(p, d);
+        }
+        catch(...){
+            d(p);
+            throw;
+        }
+    }
+
+    // 别名构造
+    template <class U>
+    local_shared_ptr(const local_shared_ptr<U>& rhs, T* p) noexcept: m_ptr(p), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    local_shared_ptr(const local_shared_ptr& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    local_shared_ptr(const local_shared_ptr<U>& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        if(m_count){
+            m_count->add_ref();
+        }
+    }
+
+    local_shared_ptr(local_shared_ptr&& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        rhs.m_ptr=nullptr;
+        rhs.m_count=nullptr;
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    local_shared_ptr(local_shared_ptr<U>&& rhs) noexcept: m_ptr(rhs.m_ptr), m_count(rhs.m_count){
+        rhs.m_ptr=nullptr;
+        rhs.m_count=nullptr;
+    }
+
+    template <class U, class Deleter,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    local_shared_ptr(unique_ptr<U, Deleter>&& rhs): m_ptr(rhs.get()), m_count(nullptr){
+        if(m_ptr){
+            m_count=local_count_ptr<U*, Deleter>::create(rhs.get(), mystl::move(rhs.get_deleter()));
+            rhs.release();
+        }
+    }
+
+    ~local_shared_ptr(){
+        if(m_count){
+            m_count->release();
+        }
+    }
+
+    local_shared_ptr& operator=(const local_shared_ptr& rhs) noexcept{
+        local_shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    local_shared_ptr& operator=(const local_shared_ptr<U>& rhs) noexcept{
+        local_shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    local_shared_ptr& operator=(local_shared_ptr&& rhs) noexcept{
+        local_shared_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+    local_shared_ptr& operator=(local_shared_ptr<U>&& rhs) noexcept{
+        local_shared_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+public:
+    typename std::add_lvalue_reference<T>::type operator*() const noexcept { return *m_ptr; }
+    T* operator->() const noexcept { return m_ptr; }
+
+    T* get() const noexcept { return m_ptr; }
+
+    long use_count() const noexcept { return m_count? m_count->use_count(): 0; }
+
+    explicit operator bool() const noexcept { return m_ptr!=nullptr; }
+
+    void reset() noexcept { local_shared_ptr().swap(*this); }
+
+    template <class U>
+    void reset(U* p) { local_shared_ptr(p).swap(*this); }
+
+    template <class U, class Deleter>
+    void reset(U* p, Deleter d) { local_shared_ptr(p, d).swap(*this); }
+
+    void swap(local_shared_ptr& rhs) noexcept{
+        mystl::swap(m_ptr, rhs.m_ptr);
+        mystl::swap(m_count, rhs.m_count);
+    }
+};
+
+template <class T>
+void swap(local_shared_ptr<T>& lhs, local_shared_ptr<T>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+template <class T, class U>
+bool operator==(const local_shared_ptr<T>& lhs, const local_shared_ptr<U>& rhs) noexcept{
+    return lhs.get()==rhs.get();
+}
+
+template <class T, class U>
+bool operator!=(const local_shared_ptr<T>& lhs, const local_shared_ptr<U>& rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+template <class T>
+bool operator==(const local_shared_ptr<T>& lhs, std::nullptr_t) noexcept{
+    return !lhs;
+}
+
+template <class T>
+bool operator!=(const local_shared_ptr<T>& lhs, std::nullptr_t) noexcept{
+    return static_cast<bool>(lhs);
+}
+
+// make_local_shared：对象和控制块在同一个池块中，不经过 operator new
+template <class T, class... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args){
+    local_count_inplace<T>* block=local_count_inplace<T>::create(mystl::forward<Args>(args)...);
+    return local_shared_ptr<T>(shared_count_tag(), block->ptr(), block);
+}
+
+// intrusive_ptr：侵入式引用计数指针
+    // 引用计数保存在对象内部，没有单独的控制块，创建对象只需要一次分配，intrusive_ptr 与裸指针一样大
+    // 通过 ADL 调用 intrusive_ptr_add_ref(T*) 和 intrusive_ptr_release(T*)，一般由 intrusive_ref_counter 提供
+template <class T>
+class intrusive_ptr
+{
+public:
+    typedef T element_type;
+
+private:
+    T* m_ptr;
+
+    template <class U> friend class intrusive_ptr;
+
+public:
+    constexpr intrusive_ptr() noexcept: m_ptr(nullptr) {}
+
+    // add_ref 为 false 时接管一个已经计过数的指针
+    intrusive_ptr(T* p, bool add_ref=true): m_ptr(p){
+        if(m_ptr!=nullptr && add_ref){
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    intrusive_ptr(const intrusive_ptr& rhs): m_ptr(rhs.m_ptr){
+        if(m_ptr!=nullptr){
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    intrusive_ptr(const intrusive_ptr<U>& rhs): m_ptr(rhs.get()){
+        if(m_ptr!=nullptr){
+            intrusive_ptr_add_ref(m_ptr);
+        }
+    }
+
+    intrusive_ptr(intrusive_ptr&& rhs) noexcept: m_ptr(rhs.m_ptr){
+        rhs.m_ptr=nullptr;
+    }
+
+    template <class U,
+        typename std::enable_if<std::is_convertible<U*, T*>::value, int>::type=0>
+    intrusive_ptr(intrusive_ptr<U>&& rhs) noexcept: m_ptr(rhs.m_ptr){
+        rhs.m_ptr=nullptr;
+    }
+
+    ~intrusive_ptr(){
+        if(m_ptr!=nullptr){
+            intrusive_ptr_release(m_ptr);
+        }
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& rhs){
+        intrusive_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& rhs) noexcept{
+        intrusive_ptr(mystl::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(T* p){
+        intrusive_ptr(p).swap(*this);
+        return *this;
+    }
+
+public:
+    T& operator*()  const noexcept { return *m_ptr; }
+    T* operator->() const noexcept { return m_ptr; }
+    T* get()        const noexcept { return m_ptr; }
+
+    explicit operator bool() const noexcept { return m_ptr!=nullptr; }
+
+    // 放弃所有权但不减少计数
+    T* detach() noexcept{
+        T* tmp=m_ptr;
+        m_ptr=nullptr;
+        return tmp;
+    }
+
+    void reset() { intrusive_ptr().swap(*this); }
+    void reset(T* p) { intrusive_ptr(p).swap(*this); }
+
+    void swap(intrusive_ptr& rhs) noexcept { mystl::swap(m_ptr, rhs.m_ptr); }
+};
+
+template <class T>
+void swap(intrusive_ptr<T>& lhs, intrusive_ptr<T>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+template <class T, class U>
+bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept{
+    return lhs.get()==rhs.get();
+}
+
+template <class T, class U>
+bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+// 计数策略：thread_safe_counter 使用原子计数，thread_unsafe_counter 使用普通整数
+struct thread_safe_counter
+{
+    typedef std::atomic<long> type;
+
+    static void increment(type& count) noexcept { count.fetch_add(1, std::memory_order_relaxed); }
+    static long decrement(type& count) noexcept { return count.fetch_sub(1, std::memory_order_acq_rel)-1; }
+    static long load(const type& count) noexcept { return count.load(std::memory_order_relaxed); }
+};
+
+struct thread_unsafe_counter
+{
+    typedef long type;
+
+    static void increment(type& count) noexcept { ++count; }
+    static long decrement(type& count) noexcept { return --count; }
+    static long load(const type& count) noexcept { return count; }
+};
+
+// intrusive_ref_counter：把引用计数嵌入 Derived 中，并提供 intrusive_ptr 需要的两个函数
+    // 用法：struct node: mystl::intrusive_ref_counter<node> { ... };
+template <class Derived, class CounterPolicy=thread_safe_counter>
+class intrusive_ref_counter
+{
+private:
+    mutable typename CounterPolicy::type m_ref_count;
+
+public:
+    intrusive_ref_counter() noexcept: m_ref_count(0) {}
+    // 拷贝对象不拷贝计数
+    intrusive_ref_counter(const intrusive_ref_counter&) noexcept: m_ref_count(0) {}
+    intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept { return *this; }
+
+    long use_count() const noexcept { return CounterPolicy::load(m_ref_count); }
+
+    friend void intrusive_ptr_add_ref(const intrusive_ref_counter* p) noexcept{
+        CounterPolicy::increment(p->m_ref_count);
+    }
+
+    friend void intrusive_ptr_release(const intrusive_ref_counter* p) noexcept{
+        if(CounterPolicy::decrement(p->m_ref_count)==0){
+            destroy(p);
+        }
+    }
+
+private:
+    // 计数归零的路径不内联，调用点只保留一次递减和一次比较
+    MYSTL_NOINLINE static void destroy(const intrusive_ref_counter* p) noexcept{
+        delete static_cast<const Derived*>(p);
+    }
+
+protected:
+    ~intrusive_ref_counter()=default;
+};
+
+// make_intrusive：创建对象并由 intrusive_ptr 管理
+template <class T, class... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args){
+    return intrusive_ptr<T>(new T(mystl::forward<Args>(args)...));
+}
+
 } // namespace mystl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,365 @@
+#ifndef MYTINYSTL_MPMC_QUEUE_H_
+#define MYTINYSTL_MPMC_QUEUE_H_
+
+// 这个头文件包含一个模板类 mpmc_queue：多生产者、多消费者的有界队列（Dmitry Vyukov 的算法）
+// 每个槽位带一个序号：序号等于 pos 时槽位空闲，等待第 pos 个元素写入；等于 pos+1 时第 pos 个元素可以读出；
+// 读出后序号加上容量，留给下一圈的生产者。生产者和消费者只用 CAS 认领位置，不需要互斥锁
+// try_* 系列函数不阻塞；push/pop 先自旋，仍不成功时在条件变量上休眠（park），由对方的操作唤醒
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl
+{
+
+template <class T, class Alloc=mystl::allocator<T>>
+class mpmc_queue
+{
+public:
+    typedef Alloc       allocator_type;
+    typedef T           value_type;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+
+    // 认领槽位之后不能再放弃，所以构造可能抛出异常的元素先在槽位外构造好，认领后再移动进去
+    static_assert(std::is_nothrow_move_constructible<T>::value, "mpmc_queue requires nothrow move constructible elements");
+    static_assert(std::is_nothrow_destructible<T>::value, "mpmc_queue requires nothrow destructible elements");
+
+private:
+    struct cell
+    {
+        std::atomic<size_type> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        explicit cell(size_type seq) noexcept: sequence(seq) {}
+        T* value() noexcept { return reinterpret_cast<T*>(&storage); }
+    };
+
+    // 在 push/pop 中休眠的线程，count 不为 0 时对方才需要加锁唤醒
+    struct waiter
+    {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::atomic<unsigned>   count;
+
+        waiter() noexcept: count(0) {}
+    };
+
+    typedef mystl::rebind_alloc<Alloc, cell> cell_allocator;
+
+    // 自旋的次数，之后开始休眠
+    static constexpr unsigned spin_count=128;
+    // 唤醒者只读一次 count（不加内存屏障），可能错过正要休眠的线程，休眠最多等这么久后自己重新检查
+    static constexpr std::chrono::microseconds park_timeout{1000};
+
+    alignas(cache_line_size) std::atomic<size_type> m_enqueue_pos;
+    alignas(cache_line_size) std::atomic<size_type> m_dequeue_pos;
+    alignas(cache_line_size) mystl::compressed_pair<cell_allocator, cell*> m_storage;
+    size_type m_mask;
+    alignas(cache_line_size) waiter m_not_empty;    // 等待元素的消费者
+    alignas(cache_line_size) waiter m_not_full;     // 等待空位的生产者
+
+public:
+    // 容量向上取整到 2 的幂，至少为 2
+    explicit mpmc_queue(size_type capacity, const allocator_type& a=allocator_type())
+        : m_enqueue_pos(0), m_dequeue_pos(0), m_storage(cell_allocator(a), nullptr),
+          m_mask(round_capacity(capacity)-1){
+        cell* cells=m_storage.first().allocate(m_mask+1);
+        for(size_type i=0; i<=m_mask; ++i){
+            mystl::construct(cells+i, i);
+        }
+        m_storage.second()=cells;
+    }
+
+    mpmc_queue(const mpmc_queue&)=delete;
+    mpmc_queue& operator=(const mpmc_queue&)=delete;
+
+    ~mpmc_queue(){
+        const size_type tail=m_enqueue_pos.load(std::memory_order_relaxed);
+        for(size_type pos=m_dequeue_pos.load(std::memory_order_relaxed); pos!=tail; ++pos){
+            mystl::destroy(cells()[pos&m_mask].value());
+        }
+        mystl::destroy(cells(), cells()+m_mask+1);
+        m_storage.first().deallocate(cells(), m_mask+1);
+    }
+
+public:
+    size_type capacity() const noexcept { return m_mask+1; }
+
+    // 有线程在操作时只是一个近似值
+    size_type size() const noexcept{
+        const size_type head=m_dequeue_pos.load(std::memory_order_acquire);
+        const size_type tail=m_enqueue_pos.load(std::memory_order_acquire);
+        const ptrdiff_t n=static_cast<ptrdiff_t>(tail-head);
+        return n<0? 0: n>static_cast<ptrdiff_t>(capacity())? capacity(): static_cast<size_type>(n);
+    }
+
+    bool empty() const noexcept { return size()==0; }
+
+    allocator_type get_allocator() const { return allocator_type(m_storage.first()); }
+
+    // 1.try_emplace/try_push：在队尾构造一个元素，队列满时返回 false
+    template <class... Args>
+    bool try_emplace(Args&& ...args){
+        return emplace_impl(std::is_nothrow_constructible<T, Args&&...>{}, mystl::forward<Args>(args)...);
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value) { return try_emplace(mystl::move(value)); }
+
+    // 2.try_pop：把队首元素移动到 value 中，队列空时返回 false
+    bool try_pop(value_type& value){
+        return pop_impl(value, std::is_nothrow_move_assignable<T>{});
+    }
+
+    // 3.push_n：从 first 开始最多放入 n 个元素，返回放入的个数
+        // 元素可以不抛异常地构造时，用一次 CAS 认领一段连续的位置再逐个构造，否则逐个 try_push
+    template <class ForwardIter>
+    size_type push_n(ForwardIter first, size_type n){
+        return push_n_impl(first, n,
+            std::is_nothrow_constructible<T, typename iterator_traits<ForwardIter>::reference>{});
+    }
+
+    // 4.pop_n：最多取出 n 个元素，依次移动赋值到 result 开始的位置，返回取出的个数
+    template <class OutputIter>
+    size_type pop_n(OutputIter result, size_type n){
+        return pop_n_impl(result, n, std::is_nothrow_move_assignable<T>{});
+    }
+
+    // 5.push/pop：阻塞版本，先自旋 spin_count 次，再休眠直到成功
+    void push(const value_type& value){
+        wait_until(m_not_full, [&]{ return try_push(value); }, [this]{ return !looks_full(); });
+    }
+
+    void push(value_type&& value){
+        // try_push 只在认领到槽位后才移动 value，失败的尝试不会改变它
+        wait_until(m_not_full, [&]{ return try_push(mystl::move(value)); }, [this]{ return !looks_full(); });
+    }
+
+    void pop(value_type& value){
+        wait_until(m_not_empty, [&]{ return try_pop(value); }, [this]{ return !looks_empty(); });
+    }
+
+private:
+    cell* cells() const noexcept { return m_storage.second(); }
+
+    static size_type round_capacity(size_type n){
+        THROW_LENGTH_ERROR_IF(n>(size_type(-1)>>1)/sizeof(cell), "mpmc_queue<T>'s capacity too big");
+        size_type cap=2;
+        while(cap<n){
+            cap<<=1;
+        }
+        return cap;
+    }
+
+    bool looks_empty() const noexcept{
+        return m_enqueue_pos.load(std::memory_order_acquire)==m_dequeue_pos.load(std::memory_order_acquire);
+    }
+
+    bool looks_full() const noexcept { return size()>=capacity(); }
+
+    // 生产者认领 pos 处的槽位，队列满时返回 nullptr
+    cell* claim_push(size_type& pos) noexcept{
+        pos=m_enqueue_pos.load(std::memory_order_relaxed);
+        for(;;){
+            cell* c=cells()+(pos&m_mask);
+            const ptrdiff_t dif=static_cast<ptrdiff_t>(c->sequence.load(std::memory_order_acquire)-pos);
+            if(dif==0){
+                if(m_enqueue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)){
+                    return c;
+                }
+            }
+            else if(dif<0){
+                return nullptr;
+            }
+            else{
+                pos=m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 消费者认领 pos 处的元素，队列空时返回 nullptr
+    cell* claim_pop(size_type& pos) noexcept{
+        pos=m_dequeue_pos.load(std::memory_order_relaxed);
+        for(;;){
+            cell* c=cells()+(pos&m_mask);
+            const ptrdiff_t dif=static_cast<ptrdiff_t>(c->sequence.load(std::memory_order_acquire)-(pos+1));
+            if(dif==0){
+                if(m_dequeue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)){
+                    return c;
+                }
+            }
+            else if(dif<0){
+                return nullptr;
+            }
+            else{
+                pos=m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <class... Args>
+    bool emplace_impl(std::true_type, Args&& ...args){
+        size_type pos;
+        cell* c=claim_push(pos);
+        if(c==nullptr){
+            return false;
+        }
+        mystl::construct(c->value(), mystl::forward<Args>(args)...);
+        c->sequence.store(pos+1, std::memory_order_release);
+        wake(m_not_empty);
+        return true;
+    }
+
+    // 构造可能抛出异常：先在槽位外构造，再不抛异常地移动进去
+    template <class... Args>
+    bool emplace_impl(std::false_type, Args&& ...args){
+        value_type tmp(mystl::forward<Args>(args)...);
+        return emplace_impl(std::true_type(), mystl::move(tmp));
+    }
+
+    bool pop_impl(value_type& value, std::true_type){
+        size_type pos;
+        cell* c=claim_pop(pos);
+        if(c==nullptr){
+            return false;
+        }
+        value=mystl::move(*c->value());
+        release_cell(c, pos);
+        return true;
+    }
+
+    // 移动赋值可能抛出异常：先移动构造到临时对象，槽位归还后再赋值
+    bool pop_impl(value_type& value, std::false_type){
+        size_type pos;
+        cell* c=claim_pop(pos);
+        if(c==nullptr){
+            return false;
+        }
+        value_type tmp(mystl::move(*c->value()));
+        release_cell(c, pos);
+        value=mystl::move(tmp);
+        return true;
+    }
+
+    void release_cell(cell* c, size_type pos) noexcept{
+        mystl::destroy(c->value());
+        c->sequence.store(pos+m_mask+1, std::memory_order_release);
+        wake(m_not_full);
+    }
+
+    template <class ForwardIter>
+    size_type push_n_impl(ForwardIter first, size_type n, std::false_type){
+        size_type count=0;
+        for(; count<n && try_push(*first); ++count, ++first){}
+        return count;
+    }
+
+    // 按两个位置计数估计空位，一次 CAS 认领 count 个位置；
+    // 认领到的槽位上一圈的元素已经被消费者认领，可能还在移出，逐个等它的序号到位
+    template <class ForwardIter>
+    size_type push_n_impl(ForwardIter first, size_type n, std::true_type){
+        size_type pos=m_enqueue_pos.load(std::memory_order_relaxed);
+        size_type count;
+        for(;;){
+            const ptrdiff_t used=static_cast<ptrdiff_t>(pos-m_dequeue_pos.load(std::memory_order_acquire));
+            if(used<0){
+                pos=m_enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            const size_type free=static_cast<size_type>(used)>=capacity()? 0: capacity()-used;
+            count=n<free? n: free;
+            if(count==0){
+                return 0;
+            }
+            if(m_enqueue_pos.compare_exchange_weak(pos, pos+count, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        for(size_type i=0; i<count; ++i, ++first){
+            cell* c=cells()+((pos+i)&m_mask);
+            while(c->sequence.load(std::memory_order_acquire)!=pos+i){
+                mystl::cpu_relax();
+            }
+            mystl::construct(c->value(), *first);
+            c->sequence.store(pos+i+1, std::memory_order_release);
+        }
+        wake(m_not_empty);
+        return count;
+    }
+
+    template <class OutputIter>
+    size_type pop_n_impl(OutputIter result, size_type n, std::false_type){
+        size_type count=0;
+        for(; count<n && try_pop(*result); ++count, ++result){}
+        return count;
+    }
+
+    template <class OutputIter>
+    size_type pop_n_impl(OutputIter result, size_type n, std::true_type){
+        size_type pos=m_dequeue_pos.load(std::memory_order_relaxed);
+        size_type count;
+        for(;;){
+            const ptrdiff_t ready=static_cast<ptrdiff_t>(m_enqueue_pos.load(std::memory_order_acquire)-pos);
+            if(ready<0){
+                pos=m_dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            count=n<static_cast<size_type>(ready)? n: static_cast<size_type>(ready);
+            if(count==0){
+                return 0;
+            }
+            if(m_dequeue_pos.compare_exchange_weak(pos, pos+count, std::memory_order_relaxed)){
+                break;
+            }
+        }
+        for(size_type i=0; i<count; ++i, ++result){
+            cell* c=cells()+((pos+i)&m_mask);
+            while(c->sequence.load(std::memory_order_acquire)!=pos+i+1){
+                mystl::cpu_relax();
+            }
+            *result=mystl::move(*c->value());
+            mystl::destroy(c->value());
+            c->sequence.store(pos+i+m_mask+1, std::memory_order_release);
+        }
+        wake(m_not_full);
+        return count;
+    }
+
+    // 有线程休眠时加锁后唤醒，加锁保证正在检查条件、还没开始等待的线程不会错过通知
+    static void wake(waiter& w){
+        if(w.count.load(std::memory_order_relaxed)!=0){
+            std::lock_guard<std::mutex> lock(w.mutex);
+            w.cv.notify_all();
+        }
+    }
+
+    // attempt 在锁外调用（它会唤醒另一侧的 waiter），ready 是不改变队列的快速检查
+    template <class Attempt, class Ready>
+    static void wait_until(waiter& w, Attempt attempt, Ready ready){
+        for(unsigned i=0; i<spin_count; ++i){
+            if(attempt()){
+                return;
+            }
+            mystl::cpu_relax();
+        }
+        while(!attempt()){
+            std::unique_lock<std::mutex> lock(w.mutex);
+            w.count.fetch_add(1, std::memory_order_relaxed);
+            w.cv.wait_for(lock, park_timeout, ready);
+            w.count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace mystl
+
+#endif
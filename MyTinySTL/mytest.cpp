@@ -1,8 +1,45 @@
 #include "algorithm_base.h"
+#include <algorithm>
+#include <bitset>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
 #include <iostream>
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
+#include "allocator.h"
+#include "basic_string.h"
+#include "bitset.h"
+#include "concurrent_hash_map.h"
+#include "epoch.h"
+#include "filter.h"
+#include "hash.h"
+#include "heap_algo.h"
+#include "intrusive.h"
+#include "list.h"
+#include "mpmc_queue.h"
+#include "memory.h"
+#include "numeric.h"
+#include "priority_queue.h"
+#include "simd.h"
+#include "slot_map.h"
+#include "soa_vector.h"
+#include "span.h"
+#include "spsc_queue.h"
+#include "string_view.h"
+#include "uninitialized.h"
 #include "util.h"
 
+// 所有测试累计的出错次数，不为 0 时 main 返回 1
+static int g_failures=0;
+
 void test_min(){
     std::cout<<__func__<<"-----------------"<<std::endl;
     int a=0;
@@ -43,7 +80,7 @@ void test_copy(){
     int exp[5], act[5];
     std::copy(arr1, arr1 + 5, exp);
     mystl::copy(arr1, arr1 + 5, act);
-    for(int i=0; i<10; i++){
+    for(int i=0; i<5; i++){
         std::cout<<act[i]<<" ";
     }
     std::cout<<std::endl;
@@ -71,12 +108,2643 @@ void test_pair(){
 void test_copy_backward(){
     std::vector<int> v1={1,2,3,4,5,6,7,8,9};
     mystl::copy_backward(v1.begin(), v1.begin()+3, v1.end());
-    for(int i=0; i<v1.size(); i++){
+    for(size_t i=0; i<v1.size(); i++){
         std::cout<<v1[i]<<" ";
     }
     std::cout<<std::endl;
 }
 
+// 无状态的比较器，模拟关联容器中的 Compare
+struct empty_less
+{
+    bool operator()(int a, int b) const { return a<b; }
+};
+
+struct tree_node
+{
+    int value;
+    tree_node* left;
+    tree_node* right;
+};
+
+// 打印 pair 与 compressed_pair 在常见容器布局下的大小
+template <class Ty1, class Ty2>
+void print_layout(const char* name){
+    std::cout<<name<<": pair "<<sizeof(mystl::pair<Ty1,Ty2>)
+             <<" -> compressed_pair "<<sizeof(mystl::compressed_pair<Ty1,Ty2>)<<std::endl;
+}
+
+int check_compressed_pair(){
+    typedef mystl::compressed_pair<empty_less, int> cp_int;
+    typedef mystl::compressed_pair<empty_less, std::string> cp_string;
+    // 比较是 constexpr，构造函数的 noexcept 跟随成员
+    typedef mystl::compressed_pair<int, char> cp_char;
+    static_assert(cp_char(1, 'a')==cp_char(1, 'a') && cp_char(1, 'a')!=cp_char(1, 'b'), "constexpr comparison");
+    static_assert(std::is_nothrow_default_constructible<cp_int>::value, "nothrow default");
+    static_assert(std::is_nothrow_constructible<cp_int, empty_less, long>::value, "nothrow forwarding");
+    static_assert(std::is_nothrow_constructible<mystl::compressed_pair<int, double>,
+                                                const mystl::compressed_pair<char, float>&>::value, "nothrow converting copy");
+    static_assert(std::is_nothrow_constructible<cp_int, mystl::pair<empty_less, short>&&>::value, "nothrow from pair");
+    static_assert(std::is_nothrow_constructible<cp_string, empty_less, std::string&&>::value, "nothrow string move");
+    static_assert(!std::is_nothrow_constructible<cp_string, empty_less, const char*>::value, "string from char* may throw");
+    static_assert(!std::is_nothrow_constructible<cp_string, const mystl::compressed_pair<empty_less, const char*>&>::value,
+                  "converting copy may throw");
+    static_assert(!std::is_nothrow_constructible<cp_string, const empty_less&, const std::string&>::value, "copy may throw");
+    int errors=0;
+    // 空类不占空间
+    errors+=sizeof(mystl::compressed_pair<std::hash<int>, size_t>)!=sizeof(size_t);
+    errors+=sizeof(mystl::compressed_pair<empty_less, tree_node*>)>=sizeof(mystl::pair<empty_less, tree_node*>);
+
+    mystl::compressed_pair<empty_less, tree_node*> root;
+    errors+=root.second()!=nullptr || !root.first()(1,2) || root.first()(2,1);
+    mystl::compressed_pair<int, char> p1(1,'A');
+    mystl::compressed_pair<double, char> p2(p1);  // 不同类型的隐式转换
+    mystl::compressed_pair<int, int> p3(mystl::make_pair(3, 4));
+    errors+=p2.first()!=1.0 || p2.second()!='A' || p3.first()!=3 || p3.second()!=4;
+    mystl::compressed_pair<int, char> p4(2,'B');
+    mystl::swap(p1,p4);
+    errors+=p1.first()!=2 || p1.second()!='B' || p4.first()!=1 || p4.second()!='A';
+
+    // 移动：空类成员之外的成员被移走
+    mystl::compressed_pair<empty_less, std::string> m1(empty_less(), std::string(32, 'm'));
+    mystl::compressed_pair<empty_less, std::string> m2(mystl::move(m1));
+    errors+=m2.second()!=std::string(32, 'm') || !m1.second().empty();
+    mystl::compressed_pair<std::string, int> m3(std::string(32, 'n'), 5), m4;
+    m4=mystl::move(m3);
+    errors+=m4.first()!=std::string(32, 'n') || m4.second()!=5 || !m3.first().empty();
+    return errors;
+}
+
+void test_compressed_pair(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    // 空类不占空间
+    static_assert(sizeof(mystl::compressed_pair<mystl::allocator<int>, int*>)==sizeof(int*), "allocator+pointer");
+    static_assert(sizeof(mystl::compressed_pair<empty_less, tree_node*>)==sizeof(tree_node*), "comparator+root");
+    static_assert(sizeof(mystl::compressed_pair<int, double>)==sizeof(mystl::pair<int, double>), "no empty member");
+    print_layout<mystl::allocator<int>, int*>("vector (allocator + pointer)");
+    print_layout<empty_less, tree_node*>("rb_tree (comparator + root)");
+    print_layout<std::hash<int>, size_t>("hashtable (hasher + bucket count)");
+    print_layout<int, double>("int + double");
+    const int errors=check_compressed_pair();
+    g_failures+=errors;
+    std::cout<<"compressed_pair: "<<errors<<" errors"<<std::endl;
+}
+
+// 编译期测试：以下 static_assert 在编译时求值，编译通过即测试通过--------------------------
+namespace constexpr_test
+{
+
+struct int_table { int v[8]; };
+struct byte_table { unsigned char v[8]; };
+
+// 在编译期用 fill/copy/copy_backward/swap 构造常量表
+constexpr int_table make_int_table(){
+    int_table t{};
+    mystl::fill(t.v, t.v+4, 7);                 // 7 7 7 7 0 0 0 0
+    mystl::copy(t.v, t.v+2, t.v+4);             // 7 7 7 7 7 7 0 0
+    t.v[0]=1;
+    mystl::copy_backward(t.v, t.v+2, t.v+8);    // 1 7 7 7 7 7 1 7
+    mystl::swap(t.v[1], t.v[6]);                // 1 1 7 7 7 7 7 7
+    mystl::move(t.v, t.v+1, t.v+2);             // 1 1 1 7 7 7 7 7
+    return t;
+}
+
+constexpr byte_table make_byte_table(unsigned char c){
+    byte_table t{};
+    mystl::fill_n(t.v, 8, c);                   // memset 快速路径在编译期退回循环
+    return t;
+}
+
+constexpr int_table table=make_int_table();
+static_assert(table.v[0]==1 && table.v[1]==1 && table.v[2]==1 && table.v[3]==7, "copy/fill/swap");
+static_assert(table.v[6]==7 && table.v[7]==7, "copy_backward");
+static_assert(mystl::equal(table.v+3, table.v+8, make_int_table().v+3), "equal");
+static_assert(mystl::mismatch(table.v, table.v+8, make_int_table().v).first==table.v+8, "mismatch");
+
+constexpr byte_table bytes_a=make_byte_table('a');
+constexpr byte_table bytes_b=make_byte_table('b');
+static_assert(bytes_a.v[7]=='a', "fill_n");
+static_assert(mystl::lexicographical_compare(bytes_a.v, bytes_a.v+8, bytes_b.v, bytes_b.v+8), "memcmp path");
+static_assert(!mystl::lexicographical_compare(bytes_a.v, bytes_a.v+8, bytes_a.v, bytes_a.v+8), "equal ranges");
+static_assert(mystl::lexicographical_compare(bytes_a.v, bytes_a.v+4, bytes_a.v, bytes_a.v+8), "shorter first");
+static_assert(mystl::lexicographical_compare(table.v, table.v+8, table.v+1, table.v+8), "integral path");
+static_assert(mystl::find(table.v, table.v+8, 7)==table.v+3 && mystl::count(table.v, table.v+8, 7)==5, "find/count");
+static_assert(mystl::find_if(table.v, table.v+8, [](int x){ return x>1; })==table.v+3, "find_if");
+static_assert(mystl::search(table.v, table.v+8, table.v+2, table.v+4)==table.v+2, "search");
+static_assert(*mystl::max_element(table.v, table.v+8)==7 && mystl::min_element(table.v, table.v+8)==table.v, "min/max_element");
+static_assert(mystl::minmax_element(table.v, table.v+8).second==table.v+7, "minmax_element");
+static_assert(mystl::accumulate(table.v, table.v+8, 0)==38 && mystl::reduce(table.v, table.v+8)==38, "accumulate/reduce");
+static_assert(mystl::find_first_of(bytes_a.v, bytes_a.v+8, bytes_b.v, bytes_b.v+1)==bytes_a.v+8, "find_first_of");
+
+static_assert(mystl::max(1, 2)==2 && mystl::min(1, 2)==1, "max/min");
+static_assert(mystl::max(1, 2, [](int a, int b){ return a>b; })==1, "max with comp");
+
+constexpr mystl::pair<int, int> swapped_pair(){
+    mystl::pair<int, int> p(1, 2);
+    mystl::pair<int, int> q(3, 4);
+    p.swap(q);
+    mystl::swap(p.first, p.second);
+    return p;
+}
+static_assert(swapped_pair().first==4 && swapped_pair().second==3, "pair swap");
+static_assert(mystl::pair<int, char>(1, 'a')<mystl::pair<int, char>(1, 'b'), "pair compare");
+static_assert(mystl::pair<long, int>(mystl::pair<int, int>(5, 6)).first==5, "converting pair");
+
+// noexcept 推导
+struct throwing_move
+{
+    throwing_move()=default;
+    throwing_move(const throwing_move&){}
+    throwing_move(throwing_move&&){}
+    throwing_move& operator=(const throwing_move&){ return *this; }
+    throwing_move& operator=(throwing_move&&){ return *this; }
+};
+
+static_assert(std::is_nothrow_move_constructible<mystl::pair<std::string, int>>::value, "pair move");
+static_assert(std::is_nothrow_move_assignable<mystl::pair<std::string, int>>::value, "pair move assign");
+static_assert(std::is_nothrow_default_constructible<mystl::pair<int, double>>::value, "pair default");
+static_assert(!std::is_nothrow_move_constructible<mystl::pair<throwing_move, int>>::value, "throwing pair move");
+static_assert(std::is_rvalue_reference<decltype(
+    mystl::move_if_noexcept(std::declval<mystl::pair<std::string, int>&>()))>::value, "move path");
+static_assert(std::is_lvalue_reference<decltype(
+    mystl::move_if_noexcept(std::declval<mystl::pair<throwing_move, int>&>()))>::value, "copy path");
+static_assert(noexcept(mystl::swap(std::declval<int&>(), std::declval<int&>())), "swap int");
+static_assert(!noexcept(mystl::swap(std::declval<throwing_move&>(), std::declval<throwing_move&>())), "swap throwing");
+static_assert(noexcept(mystl::copy((int*)0, (int*)0, (int*)0)), "copy memmove");
+static_assert(noexcept(mystl::fill((int*)0, (int*)0, 0)), "fill int");
+static_assert(!noexcept(mystl::copy((throwing_move*)0, (throwing_move*)0, (throwing_move*)0)), "copy throwing");
+
+} // namespace constexpr_test
+
+// 模拟容器扩容：元素移动构造不抛异常时走移动，否则拷贝
+template <class T>
+void relocate(T* first, T* last, void* buf){
+    T* result=static_cast<T*>(buf);
+    for(; first!=last; ++first, ++result){
+        ::new ((void*)result) T(mystl::move_if_noexcept(*first));
+    }
+}
+
+void test_move_if_noexcept(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::pair<std::string, int> old_buf[2]={
+        mystl::pair<std::string, int>(std::string(32, 'x'), 1),
+        mystl::pair<std::string, int>(std::string(32, 'y'), 2)};
+    alignas(mystl::pair<std::string, int>) unsigned char new_buf[sizeof(old_buf)];
+    relocate(old_buf, old_buf+2, new_buf);
+    auto moved=reinterpret_cast<mystl::pair<std::string, int>*>(new_buf);
+    // 走移动路径后旧元素的字符串被“窃取”
+    std::cout<<moved[1].first.size()<<" "<<old_buf[1].first.size()<<std::endl;
+    mystl::destroy(moved, moved+2);
+}
+
+// 按析构顺序记录 shape 的 id，检查智能指针何时释放对象
+static std::vector<int> g_destroyed;
+
+struct shape
+{
+    int id;
+    explicit shape(int i): id(i) {}
+    virtual ~shape() { g_destroyed.push_back(id); }
+};
+
+struct circle: shape
+{
+    explicit circle(int i): shape(i) {}
+};
+
+// 有状态的删除器，会占用空间
+struct counting_deleter
+{
+    int* count;
+    void operator()(shape* p) const { ++*count; delete p; }
+};
+
+int check_unique_ptr(){
+    int errors=0;
+    g_destroyed.clear();
+    mystl::unique_ptr<circle> c=mystl::make_unique<circle>(1);
+    mystl::unique_ptr<shape> s(mystl::move(c));   // 派生类转基类
+    errors+=c!=nullptr || s==nullptr || s->id!=1;
+
+    // 可以放进容器，扩容时移动，不会提前析构
+    std::vector<mystl::unique_ptr<shape>> v;
+    for(int i=2; i<5; ++i){
+        v.push_back(mystl::make_unique<shape>(i));
+    }
+    errors+=v[2]->id!=4 || !g_destroyed.empty();
+    v.clear();
+    errors+=g_destroyed!=std::vector<int>{2, 3, 4};
+
+    int deleted=0;
+    {
+        mystl::unique_ptr<shape, counting_deleter> d(new shape(5), counting_deleter{&deleted});
+        d.reset(new shape(6));
+        errors+=deleted!=1 || d->id!=6;
+    }
+    errors+=deleted!=2 || g_destroyed!=std::vector<int>{2, 3, 4, 5, 6};
+
+    mystl::unique_ptr<int[]> arr=mystl::make_unique<int[]>(4);
+    arr[3]=7;
+    errors+=arr[0]!=0 || arr[3]!=7;
+    s.reset();
+    errors+=s!=nullptr || g_destroyed.back()!=1 || g_destroyed.size()!=6;
+    return errors;
+}
+
+void test_unique_ptr(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    static_assert(sizeof(mystl::unique_ptr<int>)==sizeof(int*), "stateless deleter takes no space");
+    static_assert(sizeof(mystl::unique_ptr<int[]>)==sizeof(int*), "array version");
+    static_assert(!std::is_copy_constructible<mystl::unique_ptr<int>>::value, "move only");
+    static_assert(std::is_nothrow_move_constructible<mystl::unique_ptr<int>>::value, "nothrow move");
+    const int errors=check_unique_ptr();
+    g_failures+=errors;
+    std::cout<<"unique_ptr: "<<errors<<" errors"<<std::endl;
+}
+
+int check_shared_ptr(){
+    int errors=0;
+    g_destroyed.clear();
+    mystl::shared_ptr<circle> c=mystl::make_shared<circle>(1);
+    mystl::shared_ptr<shape> s=c;
+    errors+=c.use_count()!=2 || s->id!=1;
+    {
+        mystl::shared_ptr<shape> s2(s);
+        mystl::shared_ptr<shape> s3(mystl::move(s2));
+        errors+=s.use_count()!=3 || s2!=nullptr || s3.get()!=s.get();
+    }
+    errors+=s.use_count()!=2;
+    s=mystl::shared_ptr<shape>(new shape(2));
+    errors+=c.use_count()!=1 || s.use_count()!=1 || !g_destroyed.empty();
+    c.reset();
+    errors+=g_destroyed!=std::vector<int>{1};
+
+    // 从 unique_ptr 接管
+    mystl::shared_ptr<shape> from_unique(mystl::make_unique<shape>(3));
+    errors+=from_unique->id!=3 || from_unique.use_count()!=1;
+
+    // 别名构造：共享控制块，指向成员；最后一个别名释放时才析构对象
+    mystl::shared_ptr<int> id(from_unique, &from_unique->id);
+    errors+=id.use_count()!=2;
+    from_unique.reset();
+    errors+=*id!=3 || id.use_count()!=1 || g_destroyed.size()!=1;
+    id.reset();
+    errors+=g_destroyed!=std::vector<int>{1, 3};
+
+    mystl::shared_ptr<std::string> str=mystl::allocate_shared<std::string>(mystl::allocator<std::string>(), 3, 'z');
+    errors+=*str!="zzz" || str.use_count()!=1;
+    s.reset();
+    errors+=g_destroyed!=std::vector<int>{1, 3, 2};
+    return errors;
+}
+
+void test_shared_ptr(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const int errors=check_shared_ptr();
+    g_failures+=errors;
+    std::cout<<"shared_ptr: "<<errors<<" errors"<<std::endl;
+}
+
+int check_local_shared_ptr(){
+    int errors=0;
+    g_destroyed.clear();
+    mystl::local_shared_ptr<circle> c=mystl::make_local_shared<circle>(1);
+    mystl::local_shared_ptr<shape> s=c;
+    errors+=c.use_count()!=2 || s->id!=1;
+    {
+        mystl::local_shared_ptr<shape> s2(s);
+        mystl::local_shared_ptr<shape> s3(mystl::move(s2));
+        errors+=s.use_count()!=3 || s2!=nullptr || s3.get()!=s.get();
+    }
+    s=mystl::local_shared_ptr<shape>(new shape(2));
+    errors+=c.use_count()!=1 || s.use_count()!=1 || !g_destroyed.empty();
+    c.reset();
+    errors+=g_destroyed!=std::vector<int>{1};
+
+    // 控制块归还内存池后被重复使用
+    std::vector<mystl::local_shared_ptr<int>> v;
+    for(int i=0; i<100; ++i){
+        v.push_back(mystl::make_local_shared<int>(i));
+    }
+    const int* old_addr=v[99].get();
+    v.pop_back();
+    mystl::local_shared_ptr<int> reused=mystl::make_local_shared<int>(7);
+    errors+=reused.get()!=old_addr || *reused!=7;
+
+    // 别名共享 s 的控制块，s 释放后对象仍然存活，别名释放时才析构
+    mystl::local_shared_ptr<int> alias(s, &s->id);
+    errors+=alias.use_count()!=2;
+    s.reset();
+    errors+=*alias!=2 || alias.use_count()!=1 || g_destroyed.size()!=1;
+    alias.reset();
+    errors+=g_destroyed!=std::vector<int>{1, 2};
+    return errors;
+}
+
+void test_local_shared_ptr(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const int errors=check_local_shared_ptr();
+    g_failures+=errors;
+    std::cout<<"local_shared_ptr: "<<errors<<" errors"<<std::endl;
+}
+
+template <class List, class Model>
+bool same_sequence(const List& l, const Model& m){
+    return l.size()==m.size() && std::equal(m.begin(), m.end(), l.begin());
+}
+
+// 第 k 个位置的迭代器，mystl 和 std 的链表迭代器都适用
+template <class Iter>
+Iter nth(Iter it, size_t k){
+    for(; k>0; --k){
+        ++it;
+    }
+    return it;
+}
+
+// 随机操作序列，每一步都与 std::list 对比
+int check_list_model(){
+    int errors=0;
+    mystl::list<int> a, b;
+    std::list<int> ma, mb;
+    uint32_t seed=12345;
+    auto next=[&seed]{ seed=seed*1103515245u+12345u; return seed >> 8; };
+    for(int step=0; step<4000; ++step){
+        const uint32_t r=next();
+        const int v=static_cast<int>(next()%16);
+        switch(r%9){
+        case 0: a.push_back(v); ma.push_back(v); break;
+        case 1: a.push_front(v); ma.push_front(v); break;
+        case 2: b.push_back(v); mb.push_back(v); break;
+        case 3:
+            if(!a.empty()){
+                const size_t k=next()%a.size();
+                a.erase(nth(a.begin(), k));
+                ma.erase(nth(ma.begin(), k));
+            }
+            break;
+        case 4: {
+            // 把 b 的一段拼接到 a 的某个位置
+            const size_t pos=a.empty() ? 0 : next()%(a.size()+1);
+            const size_t first=b.empty() ? 0 : next()%(b.size()+1);
+            const size_t last=first+(b.size()==first ? 0 : next()%(b.size()-first+1));
+            a.splice(nth(a.begin(), pos), b, nth(b.begin(), first), nth(b.begin(), last));
+            ma.splice(nth(ma.begin(), pos), mb, nth(mb.begin(), first), nth(mb.begin(), last));
+            break;
+        }
+        case 5:
+            if(!b.empty()){
+                a.splice(a.begin(), b, b.begin());
+                ma.splice(ma.begin(), mb, mb.begin());
+            }
+            break;
+        case 6: a.reverse(); ma.reverse(); break;
+        case 7:
+            a.remove_if([v](int x){ return x%4==v%4 && x>v; });
+            ma.remove_if([v](int x){ return x%4==v%4 && x>v; });
+            break;
+        default:
+            // 引用链表自身元素的 remove
+            if(!a.empty()){
+                const int front=a.front();
+                a.remove(a.front());
+                ma.remove(front);
+            }
+            break;
+        }
+        errors+=!same_sequence(a, ma) || !same_sequence(b, mb);
+        if(a.size()>64){
+            a.splice(a.end(), b);
+            ma.splice(ma.end(), mb);
+            b.splice(b.end(), a, nth(a.begin(), 32), a.end());
+            mb.splice(mb.end(), ma, nth(ma.begin(), 32), ma.end());
+            errors+=!same_sequence(a, ma) || !same_sequence(b, mb);
+        }
+    }
+    return errors;
+}
+
+int check_list(){
+    int errors=0;
+    mystl::list<int> l1={1,2,3,4,5};
+    l1.push_front(0);
+    l1.push_back(6);
+    l1.pop_front();
+    errors+=!same_sequence(l1, std::list<int>{1,2,3,4,5,6});
+    mystl::list<int> l2(3, 9);
+    l2.insert(++l2.begin(), l1.begin(), l1.end());
+    errors+=!same_sequence(l2, std::list<int>{9,1,2,3,4,5,6,9,9});
+    l1.splice(l1.end(), l2, l2.begin());
+    l2.remove(9);
+    l2.reverse();
+    errors+=!same_sequence(l1, std::list<int>{1,2,3,4,5,6,9});
+    errors+=!same_sequence(l2, std::list<int>{6,5,4,3,2,1});
+    mystl::list<int> l3(mystl::move(l2));
+    errors+=!l2.empty() || l3!=mystl::list<int>({6,5,4,3,2,1});
+    l3.resize(2);
+    l3.swap(l1);
+    errors+=!same_sequence(l3, std::list<int>{1,2,3,4,5,6,9}) || !same_sequence(l1, std::list<int>{6,5});
+
+    // remove 的参数引用了将被删除的元素
+    mystl::list<std::string> lr={"x", "y", "x", "x", "z", "x"};
+    lr.remove(lr.front());
+    errors+=!same_sequence(lr, std::list<std::string>{"y", "z"});
+    mystl::list<std::string> ls(2, "ab");
+    ls.emplace_back(3, 'c');
+    ls.unique();
+    errors+=!same_sequence(ls, std::list<std::string>{"ab", "ccc"});
+    return errors+check_list_model();
+}
+
+void test_list(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const int errors=check_list();
+    g_failures+=errors;
+    std::cout<<"list: "<<errors<<" errors"<<std::endl;
+}
+
+// 同时内嵌链表和树的 hook，可以同时处于 intrusive_list 和 intrusive_set 中
+struct task: mystl::list_base_hook<>, mystl::set_base_hook<>
+{
+    int priority;
+    mystl::list_member_hook lru_hook;  // 成员 hook，用于第二个链表
+    explicit task(int p): priority(p) {}
+};
+
+struct task_less
+{
+    bool operator()(const task& a, const task& b) const { return a.priority<b.priority; }
+    bool operator()(const task& a, int b) const { return a.priority<b; }
+    bool operator()(int a, const task& b) const { return a<b.priority; }
+};
+
+struct ref_node: mystl::intrusive_ref_counter<ref_node>
+{
+    int value;
+    explicit ref_node(int v): value(v) {}
+    ~ref_node() { g_destroyed.push_back(value); }
+};
+
+template <class Range>
+std::vector<int> priorities(Range& r){
+    std::vector<int> out;
+    for(task& t: r){
+        out.push_back(t.priority);
+    }
+    return out;
+}
+
+int check_intrusive(){
+    int errors=0;
+    g_destroyed.clear();
+    mystl::intrusive_ptr<ref_node> p=mystl::make_intrusive<ref_node>(1);
+    mystl::intrusive_ptr<ref_node> q=p;
+    errors+=p->use_count()!=2;
+    p.reset();
+    errors+=q->use_count()!=1 || !g_destroyed.empty();
+    q=mystl::intrusive_ptr<ref_node>(new ref_node(2));
+    errors+=g_destroyed!=std::vector<int>{1};
+    q.reset();
+    errors+=g_destroyed!=std::vector<int>{1, 2};
+
+    task tasks[]={task(5), task(1), task(4), task(2), task(3)};
+    mystl::intrusive_list<task> queue;
+    mystl::intrusive_list<task, mystl::member_hook<task, mystl::list_member_hook, &task::lru_hook>> lru;
+    mystl::intrusive_set<task, task_less> by_priority;
+    for(task& t: tasks){
+        errors+=t.mystl::list_base_hook<>::is_linked() || t.lru_hook.is_linked();
+        queue.push_back(t);
+        lru.push_front(t);
+        by_priority.insert(t);
+        errors+=!t.mystl::list_base_hook<>::is_linked() || !t.lru_hook.is_linked();
+    }
+    // 同一个对象按三种顺序被访问，没有任何内存分配
+    errors+=priorities(queue)!=std::vector<int>{5, 1, 4, 2, 3};
+    errors+=priorities(lru)!=std::vector<int>{3, 2, 4, 1, 5};
+    errors+=priorities(by_priority)!=std::vector<int>{1, 2, 3, 4, 5};
+
+    // O(1) 按对象删除，只摘下对应的 hook
+    queue.remove(tasks[2]);
+    by_priority.remove(tasks[2]);
+    errors+=tasks[2].mystl::list_base_hook<>::is_linked() || !tasks[2].lru_hook.is_linked();
+    errors+=queue.size()!=4 || lru.size()!=5 || by_priority.size()!=4;
+    errors+=priorities(queue)!=std::vector<int>{5, 1, 2, 3};
+    errors+=by_priority.find(4)!=by_priority.end() || by_priority.lower_bound(4)->priority!=5;
+    errors+=by_priority.insert(tasks[0]).second || !by_priority.insert(tasks[2]).second;
+    errors+=priorities(by_priority)!=std::vector<int>{1, 2, 3, 4, 5};
+    queue.clear();
+    lru.clear();
+    by_priority.clear();
+    for(task& t: tasks){
+        errors+=t.mystl::list_base_hook<>::is_linked() || t.lru_hook.is_linked();
+    }
+    // 摘下后可以重新链接
+    queue.push_back(tasks[3]);
+    errors+=priorities(queue)!=std::vector<int>{2};
+    queue.clear();
+    return errors;
+}
+
+void test_intrusive(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    static_assert(sizeof(mystl::intrusive_ptr<ref_node>)==sizeof(ref_node*), "same as raw pointer");
+    const int errors=check_intrusive();
+    g_failures+=errors;
+    std::cout<<"intrusive: "<<errors<<" errors"<<std::endl;
+}
+
+// 向量化内核与逐字节的参考实现对比，覆盖各种长度、偏移和重叠
+    // 在 CPU 支持的每个指令集级别上各运行一遍，输出每个级别的出错次数
+
+int check_kernels(){
+    int errors=0;
+    std::vector<unsigned char> buf(2048);
+    for(size_t i=0; i<buf.size(); ++i){
+        buf[i]=static_cast<unsigned char>(i*7+3);
+    }
+    // copy_bytes：memmove 语义，包括向前和向后重叠
+    for(size_t n=0; n<=600; n+=(n<80? 1: 37)){
+        for(ptrdiff_t shift: {-33, -1, 0, 1, 5, 64, 300}){
+            std::vector<unsigned char> a(buf), b(buf);
+            unsigned char* src=a.data()+700;
+            mystl::simd::copy_bytes(src+shift, src, n);
+            std::memmove(b.data()+700+shift, b.data()+700, n);
+            errors+= a!=b;
+        }
+    }
+    // fill：各种元素大小和个数，检查没有越界写
+    for(size_t count=0; count<=200; ++count){
+        std::vector<unsigned char> a(buf), b(buf);
+        uint16_t v16=0xBEEF;
+        uint32_t v32=0xDEADBEEF;
+        uint64_t v64=0x0123456789ABCDEFull;
+        mystl::simd::fill(a.data()+1, uint8_t(0x5A), count);
+        std::memset(b.data()+1, 0x5A, count);
+        mystl::simd::fill(reinterpret_cast<uint16_t*>(a.data()+300), v16, count);
+        mystl::simd::fill(reinterpret_cast<uint32_t*>(a.data()+304), v32, count/2);
+        mystl::simd::fill(reinterpret_cast<uint64_t*>(a.data()+504), v64, count/2);
+        for(size_t i=0; i<count; ++i){
+            std::memcpy(b.data()+300+2*i, &v16, 2);
+        }
+        for(size_t i=0; i<count/2; ++i){
+            std::memcpy(b.data()+304+4*i, &v32, 4);
+        }
+        for(size_t i=0; i<count/2; ++i){
+            std::memcpy(b.data()+504+8*i, &v64, 8);
+        }
+        errors+= a!=b;
+    }
+    // mismatch_bytes：不同字节出现在每个位置，以及完全相同
+    for(size_t n=0; n<=300; ++n){
+        std::vector<unsigned char> a(buf.begin(), buf.begin()+n), b(a);
+        errors+= mystl::simd::mismatch_bytes(a.data(), b.data(), n)!=n;
+        for(size_t k=0; k<n; k+=(n<70? 1: 13)){
+            b[k]^=0x80;
+            errors+= mystl::simd::mismatch_bytes(a.data(), b.data(), n)!=k;
+            b[k]^=0x80;
+        }
+    }
+    return errors;
+}
+
+// lexicographical_compare 的快速路径与 std 的结果一致
+    // 不同的一对元素取 0x0100...与 0x00FF...（检查字节序）以及 -1 与 1（检查符号）
+template <class T>
+int check_lexicographical(){
+    int errors=0;
+    const T pairs[][2]={
+        {static_cast<T>(1), static_cast<T>(2)},
+        {static_cast<T>(-1), static_cast<T>(1)},
+        {static_cast<T>(static_cast<T>(1)<<(sizeof(T)*8-8)), static_cast<T>(0xFF)},
+    };
+    for(size_t n=0; n<=100; n+=(n<40? 1: 13)){
+        std::vector<T> a(n+1);
+        for(size_t i=0; i<a.size(); ++i){
+            a[i]=static_cast<T>(i*37+5);
+        }
+        std::vector<T> b(a);
+        for(size_t p=0; p<n; p+=(p<20? 1: 7)){
+            for(const auto& d: pairs){
+                for(int side=0; side<2; ++side){
+                    b=a;
+                    a[p]=d[side];
+                    b[p]=d[1-side];
+                    for(size_t m: {n, n+1}){
+                        bool expect=std::lexicographical_compare(a.data(), a.data()+n, b.data(), b.data()+m);
+                        if(mystl::lexicographical_compare(a.data(), a.data()+n, b.data(), b.data()+m)!=expect){
+                            ++errors;
+                        }
+                    }
+                    a=b;
+                    a[p]=static_cast<T>(p*37+5);
+                }
+            }
+        }
+        // 一个是另一个的前缀
+        b=a;
+        if(!mystl::lexicographical_compare(a.data(), a.data()+n, b.data(), b.data()+n+1) ||
+           mystl::lexicographical_compare(a.data(), a.data()+n+1, b.data(), b.data()+n) ||
+           mystl::lexicographical_compare(a.data(), a.data()+n, b.data(), b.data()+n)){
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+// find/count/search/find_first_of 的快速路径与 std 的结果一致
+    // 数据只取少数几个值，使匹配出现在每个向量的不同位置上，包括重叠的尾部向量
+template <class T>
+int check_search(){
+    int errors=0;
+    for(size_t n=0; n<=300; n+=(n<70? 1: 23)){
+        std::vector<T> a(n);
+        for(size_t i=0; i<n; ++i){
+            a[i]=static_cast<T>((i*i+3*i)%7==0? 3: 1);
+        }
+        const T* first=a.data();
+        const T* last=a.data()+n;
+        for(int v: {0, 1, 3, -1}){
+            if(mystl::find(first, last, static_cast<T>(v))!=std::find(first, last, static_cast<T>(v)) ||
+               mystl::count(first, last, static_cast<T>(v))!=std::count(first, last, static_cast<T>(v))){
+                ++errors;
+            }
+        }
+        // 只出现在最后一个元素
+        if(n>0){
+            a.back()=static_cast<T>(5);
+            if(mystl::find(first, last, static_cast<T>(5))!=last-1 || mystl::count(first, last, static_cast<T>(5))!=1){
+                ++errors;
+            }
+        }
+        // 子序列取自 a 的不同位置，加上一个不存在的
+        for(size_t m: {size_t(0), size_t(1), size_t(2), size_t(3), size_t(7), size_t(33)}){
+            for(size_t pos: {size_t(0), n/2, n>m? n-m: size_t(0)}){
+                if(pos+m>n){
+                    continue;
+                }
+                std::vector<T> needle(a.begin()+pos, a.begin()+pos+m);
+                if(mystl::search(first, last, needle.data(), needle.data()+m)!=
+                   std::search(first, last, needle.data(), needle.data()+m)){
+                    ++errors;
+                }
+                if(m>0){
+                    needle.back()=static_cast<T>(9);
+                    if(mystl::search(first, last, needle.data(), needle.data()+m)!=
+                       std::search(first, last, needle.data(), needle.data()+m)){
+                        ++errors;
+                    }
+                }
+            }
+        }
+        const T sets[][3]={{9, 8, 5}, {3, 9, 9}, {8, 8, 8}};
+        for(const auto& set: sets){
+            for(size_t m=0; m<=3; ++m){
+                if(mystl::find_first_of(first, last, set, set+m)!=std::find_first_of(first, last, set, set+m)){
+                    ++errors;
+                }
+            }
+        }
+    }
+    // 超过 16 个候选字节时走查找表
+    std::vector<T> text(100, static_cast<T>(1));
+    text[77]=static_cast<T>(40);
+    std::vector<T> set;
+    for(int i=20; i<=40; ++i){
+        set.push_back(static_cast<T>(i));
+    }
+    if(mystl::find_first_of(text.data(), text.data()+text.size(), set.data(), set.data()+set.size())!=text.data()+77){
+        ++errors;
+    }
+    return errors;
+}
+
+int check_search_all(){
+    return check_search<char>()+check_search<unsigned char>()+check_search<short>()+
+           check_search<uint16_t>()+check_search<int>()+check_search<uint32_t>()+
+           check_search<long long>()+check_search<uint64_t>();
+}
+
+// min_element/max_element/minmax_element 和求和的快速路径与 std 及逐个累加的结果一致
+    // 数据中有大量重复值，检查第一个最小值和最后一个最大值的位置
+template <class T>
+int check_reduction(){
+    int errors=0;
+    for(size_t n=1; n<=300; n+=(n<70? 1: 19)){
+        std::vector<T> a(n);
+        for(size_t i=0; i<n; ++i){
+            a[i]=static_cast<T>(static_cast<int>((i*7919+n)%97)-40);
+        }
+        const T* first=a.data();
+        const T* last=a.data()+n;
+        auto mm=mystl::minmax_element(first, last);
+        auto sm=std::minmax_element(first, last);
+        if(mystl::min_element(first, last)!=std::min_element(first, last) ||
+           mystl::max_element(first, last)!=std::max_element(first, last) ||
+           mm.first!=sm.first || mm.second!=sm.second){
+            ++errors;
+        }
+        T expect=0;
+        for(T x: a){
+            expect=static_cast<T>(expect+x);
+        }
+        if(mystl::accumulate(first, last, T(0))!=expect || mystl::reduce(first, last)!=expect){
+            ++errors;
+        }
+    }
+    // 全是最大值或最小值的长区间累加到 long long，检查内核中窄通道在溢出之前并入宽通道
+    if(std::is_integral<T>::value && sizeof(T)<=4){
+        for(T v: {std::numeric_limits<T>::max(), std::numeric_limits<T>::min()}){
+            std::vector<T> a(100003, v);
+            const long long expect=static_cast<long long>(v)*static_cast<long long>(a.size());
+            if(mystl::accumulate(a.data(), a.data()+a.size(), 0LL)!=expect){
+                ++errors;
+            }
+        }
+    }
+    return errors;
+}
+
+// 浮点数：第 0 个元素是 NaN 时它就是结果，+0.0 与 -0.0 相等时取第一个；含 NaN 的区间与逐个比较的结果一致
+template <class T>
+int check_float_reduction(){
+    int errors=0;
+    std::vector<T> a={T(0), T(-0.0), T(3), T(-2), T(-2), T(3), T(0)};
+    for(int i=0; i<40; ++i){
+        a.push_back(T(i%5));
+    }
+    if(mystl::min_element(a.data(), a.data()+a.size())!=a.data()+3 ||
+       mystl::max_element(a.data(), a.data()+a.size())!=std::max_element(a.data(), a.data()+a.size())){
+        ++errors;
+    }
+    a[0]=std::numeric_limits<T>::quiet_NaN();
+    if(mystl::min_element(a.data(), a.data()+a.size())!=a.data() ||
+       mystl::max_element(a.data(), a.data()+a.size())!=a.data()){
+        ++errors;
+    }
+    a.assign(40, T(1));
+    a[17]=T(-0.0);
+    a[19]=T(0);
+    if(mystl::min_element(a.data(), a.data()+a.size())!=a.data()+17){
+        ++errors;
+    }
+    // NaN、相等的值和 ±0 混在一起：连续区间的快速路径与逐个比较的迭代器版本下标完全相同
+        // minmax_element 的最大值按 !(x<hi) 更新，NaN 会被选中，随后又被下一个元素替换；
+        // libstdc++ 的 std::minmax_element 成对比较元素，有 NaN 时结果不同，这里用逐个比较的规则作参照，
+        // min_element/max_element 仍与 std 比较
+    const T nan=std::numeric_limits<T>::quiet_NaN();
+    const T inf=std::numeric_limits<T>::infinity();
+    const T pool[]={nan, T(-0.0), T(0), T(1), T(3), T(3), T(-2), inf, -inf};
+    auto same_as_sequential=[](const std::vector<T>& v){
+        const T* first=v.data();
+        const T* last=v.data()+v.size();
+        size_t lo=0, hi=0;
+        for(size_t i=1; i<v.size(); ++i){
+            if(v[i]<v[lo]) lo=i;
+            if(!(v[i]<v[hi])) hi=i;
+        }
+        auto mm=mystl::minmax_element(first, last);
+        auto it=mystl::minmax_element(v.begin(), v.end());
+        return mystl::min_element(first, last)==std::min_element(first, last) &&
+               mystl::max_element(first, last)==std::max_element(first, last) &&
+               mm.first==first+lo && mm.second==first+hi &&
+               it.first==v.begin()+lo && it.second==v.begin()+hi;
+    };
+    errors+=!same_as_sequential({T(1), T(3), nan}) || !same_as_sequential({nan, T(1), T(3), T(2)}) || !same_as_sequential({T(1), nan, T(0)});
+    {
+        const T x[]={T(1), T(3), nan}, y[]={nan, T(1), T(3), T(2)};
+        errors+=mystl::minmax_element(x, x+3).second!=x+2 || mystl::minmax_element(y, y+4).second!=y+2;
+    }
+    uint32_t seed=99;
+    for(size_t n=1; n<=200; n+=(n<70? 1: 13)){
+        for(int round=0; round<8; ++round){
+            std::vector<T> v(n);
+            for(size_t i=0; i<n; ++i){
+                seed=seed*1103515245u+12345u;
+                // 前几轮 NaN 较少，只出现在个别位置；后几轮大量出现
+                const uint32_t r=seed >> 8;
+                v[i]=round<4 && r%64!=0 ? T(static_cast<int>(r%7)-3) : pool[r%9];
+            }
+            // 第 0 个、最后一个和倒数第二个元素是 NaN 的情况
+            if(round==1) v[0]=nan;
+            if(round==2) v[n-1]=nan;
+            if(round==3 && n>1) v[n-2]=nan;
+            errors+=!same_as_sequential(v);
+        }
+    }
+    // 树形求和与 double 精度的结果相差在舍入误差以内
+    std::vector<T> v(100003);
+    double exact=0;
+    for(size_t i=0; i<v.size(); ++i){
+        v[i]=T(1)/T(i%1000+1);
+        exact+=double(v[i]);
+    }
+    const double got=double(mystl::reduce(mystl::execution::unseq, v.data(), v.data()+v.size(), T(0)));
+    if(std::abs(got-exact)>exact*1e-6){
+        ++errors;
+    }
+    return errors;
+}
+
+int check_reduction_all(){
+    return check_reduction<signed char>()+check_reduction<unsigned char>()+check_reduction<short>()+
+           check_reduction<uint16_t>()+check_reduction<int>()+check_reduction<uint32_t>()+
+           check_reduction<long long>()+check_reduction<uint64_t>()+check_reduction<float>()+
+           check_reduction<double>()+check_float_reduction<float>()+check_float_reduction<double>();
+}
+
+// 位数组内核：与逐字的结果比较，包括不足一个向量的尾部、不对齐的起点和 dst 与 a 相同的情况
+int check_bit_kernels(){
+    using mystl::simd::bit_op_kind;
+    int errors=0;
+    uint64_t x=0x9E3779B97F4A7C15ull;
+    auto next=[&x]{
+        x^=x<<13;
+        x^=x>>7;
+        x^=x<<17;
+        return x;
+    };
+    std::vector<uint64_t> a(700), b(700), dst(700);
+    for(size_t i=0; i<a.size(); ++i){
+        a[i]=next();
+        b[i]=i%5==0? 0: next()&next();
+    }
+    auto popcount=[](uint64_t w){
+        size_t c=0;
+        for(; w!=0; w&=w-1){
+            ++c;
+        }
+        return c;
+    };
+    for(size_t n: {0, 1, 3, 4, 7, 8, 15, 16, 31, 63, 64, 65, 127, 128, 255, 256, 257, 511, 600, 699}){
+        for(size_t off: {0, 1}){
+            const uint64_t* pa=a.data()+off;
+            const uint64_t* pb=b.data()+off;
+            size_t pc=0, apc=0;
+            for(size_t i=0; i<n; ++i){
+                pc+=popcount(pa[i]);
+                apc+=popcount(pa[i]&pb[i]);
+            }
+            errors+=mystl::simd::popcount_words(pa, n)!=pc;
+            errors+=mystl::simd::and_popcount_words(pa, pb, n)!=apc;
+            for(int op=0; op<mystl::simd::bit_op_count; ++op){
+                mystl::simd::bit_op(static_cast<bit_op_kind>(op), dst.data(), pa, pb, n);
+                for(size_t i=0; i<n; ++i){
+                    const uint64_t want=op==0? pa[i]&pb[i]: op==1? pa[i]|pb[i]: op==2? pa[i]^pb[i]: pa[i]&~pb[i];
+                    errors+=dst[i]!=want;
+                }
+            }
+            // 原地运算
+            std::vector<uint64_t> in_place(pa, pa+n);
+            mystl::simd::bit_op(bit_op_kind::xor_op, in_place.data(), in_place.data(), pb, n);
+            for(size_t i=0; i<n; ++i){
+                errors+=in_place[i]!=(pa[i]^pb[i]);
+            }
+        }
+        // 只有一个非零字，逐个移动它的位置
+        std::vector<uint64_t> z(n, 0);
+        errors+=mystl::simd::find_nonzero_words(z.data(), n)!=n;
+        for(size_t k=0; k<n; ++k){
+            z[k]=uint64_t(1)<<(k%64);
+            errors+=mystl::simd::find_nonzero_words(z.data(), n)!=k;
+            z[k]=0;
+        }
+    }
+    return errors;
+}
+
+// 批量哈希的内核与逐个调用 hash_mix64 的结果相同，包括原地计算
+int check_hash_kernels(){
+    int errors=0;
+    std::vector<uint64_t> keys(300), out(300);
+    for(size_t i=0; i<keys.size(); ++i){
+        keys[i]=i*0x9E3779B97F4A7C15ull+(i%3==0? 0: i);
+    }
+    for(size_t n: {0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 100, 299}){
+        for(uint64_t seed: {uint64_t(0), uint64_t(12345), ~uint64_t(0)}){
+            mystl::simd::hash_words(keys.data()+1, n, seed, out.data());
+            for(size_t i=0; i<n; ++i){
+                errors+=out[i]!=mystl::hash_mix64(keys[i+1]^seed);
+            }
+            std::vector<uint64_t> in_place(keys.begin(), keys.begin()+n);
+            mystl::simd::hash_words(in_place.data(), n, seed, in_place.data());
+            for(size_t i=0; i<n; ++i){
+                errors+=in_place[i]!=mystl::hash_mix64(keys[i]^seed);
+            }
+        }
+    }
+    return errors;
+}
+
+int check_lexicographical_all(){
+    return check_lexicographical<char>()+check_lexicographical<signed char>()+
+           check_lexicographical<unsigned char>()+check_lexicographical<short>()+
+           check_lexicographical<uint16_t>()+check_lexicographical<int>()+
+           check_lexicographical<uint32_t>()+check_lexicographical<long long>()+
+           check_lexicographical<uint64_t>();
+}
+
+// 与逐个元素的循环对比，覆盖空区间、不满一个向量/一个并行分块的长度和多个线程数
+int check_numeric(){
+    int errors=0;
+    std::vector<signed char> c(1000, -100);
+    int c_sum=0;
+    for(signed char x: c){
+        c_sum+=x;
+    }
+    // 窄元素累加到宽的结果类型中不会溢出
+    errors+=mystl::accumulate(c.data(), c.data()+c.size(), 0)!=c_sum || c_sum!=-100000;
+
+    uint32_t seed=7;
+    for(size_t n: {size_t(0), size_t(1), size_t(17), size_t(1000), (size_t(1) << 15)+3, size_t(1) << 18}){
+        std::vector<int> v(n);
+        long long sum=0;
+        int max_value=std::numeric_limits<int>::min();
+        for(size_t i=0; i<n; ++i){
+            seed=seed*1103515245u+12345u;
+            v[i]=static_cast<int>(seed >> 8)%2000001-1000000;
+            sum+=v[i];
+            max_value=v[i]>max_value ? v[i] : max_value;
+        }
+        const int* first=v.data();
+        const int* last=v.data()+n;
+        const long long seq=mystl::reduce(mystl::execution::seq, first, last, 0LL, mystl::plus<long long>());
+        errors+=mystl::accumulate(first, last, 0LL)!=sum || seq!=sum;
+        errors+=mystl::reduce(mystl::execution::unseq, first, last, 0LL)!=sum;
+        for(unsigned threads: {1u, 4u, 7u}){
+            const mystl::execution::parallel_policy par{threads};
+            errors+=mystl::reduce(par, first, last, 0LL)!=seq;
+            // 非加法的操作走通用的树形归约
+            errors+=mystl::reduce(par, first, last, std::numeric_limits<int>::min(),
+                                  [](int x, int y){ return x>y? x: y; })!=max_value;
+        }
+        // 最小值取第一个，最大值取最后一个，与 std::minmax_element 相同
+        auto mm=mystl::minmax_element(first, last);
+        auto expected=std::minmax_element(first, last);
+        errors+=mm.first!=expected.first || mm.second!=expected.second;
+    }
+
+    // 有重复的最值时检查位置
+    std::vector<int> d={3, 1, 4, 1, 5, 9, 2, 6, 9, 1};
+    auto mm=mystl::minmax_element(d.data(), d.data()+d.size());
+    errors+=mm.first-d.data()!=1 || mm.second-d.data()!=8;
+
+    // 非交换的操作保持元素顺序
+    std::vector<std::string> words={"a", "b", "c", "d", "e"};
+    errors+=mystl::reduce(mystl::execution::unseq, words.begin(), words.end(), std::string(">"))!=">abcde";
+    return errors;
+}
+
+void test_numeric(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const int errors=check_numeric();
+    g_failures+=errors;
+    std::cout<<"numeric: "<<errors<<" errors"<<std::endl;
+}
+
+// 第 fail_at 次构造时抛出异常，live 统计存活的对象个数
+struct throwing_counter
+{
+    static int live;
+    static int fail_at;
+    int value;
+
+    static void tick(){
+        if(fail_at>0 && --fail_at==0){
+            throw std::runtime_error("construct");
+        }
+        ++live;
+    }
+    throwing_counter(): value(0) { tick(); }
+    throwing_counter(int v): value(v) { tick(); }
+    throwing_counter(const throwing_counter& rhs): value(rhs.value) { tick(); }
+    throwing_counter(throwing_counter&& rhs): value(rhs.value) { tick(); }
+    // 赋值不改变存活对象的个数
+    throwing_counter& operator=(const throwing_counter&)=default;
+    throwing_counter& operator=(throwing_counter&&)=default;
+    ~throwing_counter() { --live; }
+};
+int throwing_counter::live=0;
+int throwing_counter::fail_at=0;
+
+// 构造到一半抛出异常时已构造的元素全部析构，异常继续传给调用者
+template <class Op>
+int check_rollback(Op op){
+    alignas(throwing_counter) unsigned char raw[8*sizeof(throwing_counter)];
+    throwing_counter* buf=reinterpret_cast<throwing_counter*>(raw);
+    const int before=throwing_counter::live;
+    throwing_counter::fail_at=5;
+    bool thrown=false;
+    try{
+        op(buf);
+    }
+    catch(const std::runtime_error&){
+        thrown=true;
+    }
+    throwing_counter::fail_at=0;
+    return thrown && throwing_counter::live==before? 0: 1;
+}
+
+// 有状态的分配器：tag 相同才相等
+template <class T>
+struct tagged_allocator: mystl::allocator<T>
+{
+    int tag;
+
+    tagged_allocator(int t): tag(t) {}
+    template <class U>
+    tagged_allocator(const tagged_allocator<U>& rhs): tag(rhs.tag) {}
+};
+
+template <class T, class U>
+bool operator==(const tagged_allocator<T>& a, const tagged_allocator<U>& b){
+    return a.tag==b.tag;
+}
+
+void test_uninitialized(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    int errors=0;
+    {
+        std::vector<throwing_counter> src(8);
+        for(int i=0; i<8; ++i){
+            src[i].value=i;
+        }
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_copy(src.begin(), src.end(), p); });
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_copy_n(src.data(), 8, p); });
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_fill(p, p+8, src[3]); });
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_fill_n(p, 8, src[3]); });
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_move(src.begin(), src.end(), p); });
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_move_n(src.begin(), 8, p); });
+        errors+=check_rollback([](throwing_counter* p){ mystl::uninitialized_default_construct(p, p+8); });
+        errors+=check_rollback([](throwing_counter* p){ mystl::uninitialized_value_construct(p, p+8); });
+        errors+=check_rollback([](throwing_counter* p){ mystl::uninitialized_default_construct_n(p, 8); });
+        errors+=check_rollback([](throwing_counter* p){ mystl::uninitialized_value_construct_n(p, 8); });
+        // relocate：throwing_counter 的移动构造可能抛出异常，所以复制；失败时原区间不变，成功时原区间被析构
+        errors+=check_rollback([&](throwing_counter* p){ mystl::uninitialized_relocate(src.begin(), src.end(), p); });
+        errors+=src.size()!=8 || src[7].value!=7 || throwing_counter::live!=8;
+        // 成功时构造出的元素交给调用者
+        alignas(throwing_counter) unsigned char raw[8*sizeof(throwing_counter)];
+        throwing_counter* p=reinterpret_cast<throwing_counter*>(raw);
+        throwing_counter* e=mystl::uninitialized_copy_n(src.data(), 8, p);
+        std::cout<<(e-p)<<" "<<p[7].value<<" "<<throwing_counter::live<<" ";
+        mystl::destroy(p, e);
+    }
+    std::cout<<throwing_counter::live<<std::endl;
+    // 平凡类型：值初始化清零；默认初始化后的值不确定，不读取
+    int ints[6]={1, 2, 3, 4, 5, 6};
+    mystl::uninitialized_value_construct(ints, ints+3);
+    mystl::uninitialized_default_construct(ints+3, ints+6);
+    for(int i=0; i<3; ++i){
+        std::cout<<ints[i]<<" ";
+    }
+    errors+=ints[0]!=0 || ints[1]!=0 || ints[2]!=0;
+    // 类类型：默认初始化调用默认构造函数
+    {
+        alignas(throwing_counter) unsigned char raw[3*sizeof(throwing_counter)];
+        mystl::fill(raw, raw+sizeof(raw), static_cast<unsigned char>(0xff));
+        throwing_counter* p=reinterpret_cast<throwing_counter*>(raw);
+        mystl::uninitialized_default_construct(p, p+3);
+        std::cout<<p[0].value<<" "<<p[2].value;
+        errors+=p[0].value!=0 || p[1].value!=0 || p[2].value!=0 || throwing_counter::live!=3;
+        mystl::destroy(p, p+3);
+    }
+    std::cout<<std::endl;
+    // default_init_allocator：resize 不清零，随后整体覆盖；rebind 后仍是 default_init_allocator
+    static_assert(std::is_same<mystl::rebind_alloc<mystl::default_init_allocator<int>, long>,
+                               mystl::default_init_allocator<long>>::value, "default_init rebind");
+    // 相等性转交给被包装的分配器
+    {
+        mystl::default_init_allocator<int, tagged_allocator<int>> a(tagged_allocator<int>(1));
+        mystl::default_init_allocator<long, tagged_allocator<long>> b(tagged_allocator<long>(1));
+        mystl::default_init_allocator<int, tagged_allocator<int>> c(tagged_allocator<int>(2));
+        errors+=!(a==b) || a!=b || a==c || !(a!=c);
+        errors+=mystl::default_init_allocator<int>()!=mystl::default_init_allocator<long>();
+    }
+    std::vector<int, mystl::default_init_allocator<int>> buf;
+    buf.resize(1000);
+    mystl::fill(buf.data(), buf.data()+buf.size(), 3);
+    mystl::list<std::string, mystl::default_init_allocator<std::string>> names;
+    names.push_back("x");
+    names.emplace_back(2, 'y');
+    std::cout<<mystl::accumulate(buf.data(), buf.data()+buf.size(), 0)<<" "<<names.back()<<" "
+             <<(mystl::uninitialized_value_construct_n(ints, 2)-ints)<<" "<<ints[1]<<std::endl;
+    if(errors!=0){
+        std::cout<<"uninitialized rollback: "<<errors<<" errors"<<std::endl;
+        g_failures+=errors;
+    }
+}
+
+void test_spsc_queue(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::spsc_queue<std::string> q(5);
+    std::cout<<q.capacity()<<" ";
+    // 批量放入时跨过环的末尾，分成两段
+    const std::string words[]={"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    std::string out[8];
+    std::cout<<q.push_n(words, 6)<<" "<<q.pop_n(out, 5)<<" "<<q.push_n(words+6, 4)<<" "
+             <<q.push_n(words, 4)<<" "<<q.size()<<" ";
+    std::string s;
+    q.try_pop(s);
+    std::cout<<s<<" "<<q.pop_n(out, 8)<<" "<<out[0]<<out[6]<<" "<<q.try_pop(s)<<std::endl;
+    q.try_emplace(3, 'x');
+    q.try_push("left in queue");   // 由析构函数释放
+
+    // 两个线程之间传递，检查顺序和总数
+    mystl::spsc_queue<int> ring(1024);
+    const int total=200000;
+    long long sum=0;
+    bool ordered=true;
+    std::thread consumer([&]{
+        int expect=0;
+        int buf[64];
+        while(expect<total){
+            size_t got=ring.pop_n(buf, 64);
+            if(got==0){
+                std::this_thread::yield();
+            }
+            for(size_t i=0; i<got; ++i){
+                ordered=ordered && buf[i]==expect++;
+                sum+=buf[i];
+            }
+        }
+    });
+    int batch[37];
+    for(int next=0; next<total;){
+        int n=0;
+        for(; n<37 && next+n<total; ++n){
+            batch[n]=next+n;
+        }
+        size_t pushed=ring.push_n(batch, static_cast<size_t>(n));
+        if(pushed==0){
+            std::this_thread::yield();
+        }
+        next+=static_cast<int>(pushed);
+    }
+    consumer.join();
+    std::cout<<ordered<<" "<<sum<<" "<<ring.empty()<<std::endl;
+    if(!ordered || sum!=static_cast<long long>(total)*(total-1)/2){
+        ++g_failures;
+    }
+}
+
+void test_mpmc_queue(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::mpmc_queue<std::string> q(3);
+    const std::string words[]={"a", "b", "c", "d", "e"};
+    std::string out[4];
+    std::string s;
+    std::cout<<q.capacity()<<" "<<q.push_n(words, 3)<<" "<<q.try_push("x")<<" "<<q.try_push("y")<<" ";
+    q.try_pop(s);
+    std::cout<<s<<" "<<q.pop_n(out, 4)<<" "<<out[0]<<out[2]<<" "<<q.try_pop(s)<<" ";
+    q.try_emplace(2, 'z');
+    q.push(std::string("w"));
+    q.pop(s);
+    std::cout<<s<<" "<<q.size()<<std::endl;   // 剩下的一个元素由析构函数释放
+
+    // 3 个生产者（单个、批量、阻塞）和 3 个消费者，检查总和与每个生产者内部的顺序
+    const int producers=3, consumers=3, per_producer=60000;
+    mystl::mpmc_queue<long long> ring(256);
+    std::atomic<long long> sum(0);
+    std::atomic<bool> ordered(true);
+    std::vector<std::thread> threads;
+    for(int p=0; p<producers; ++p){
+        threads.emplace_back([&, p]{
+            long long batch[16];
+            for(int i=0; i<per_producer;){
+                if(p==0){
+                    if(ring.try_push(static_cast<long long>(p)<<32 | i)){
+                        ++i;
+                    }
+                    else{
+                        std::this_thread::yield();
+                    }
+                }
+                else if(p==1){
+                    int n=0;
+                    for(; n<16 && i+n<per_producer; ++n){
+                        batch[n]=static_cast<long long>(p)<<32 | (i+n);
+                    }
+                    size_t pushed=ring.push_n(batch, static_cast<size_t>(n));
+                    if(pushed==0){
+                        std::this_thread::yield();
+                    }
+                    i+=static_cast<int>(pushed);
+                }
+                else{
+                    ring.push(static_cast<long long>(p)<<32 | i);
+                    ++i;
+                }
+            }
+        });
+    }
+    // 阻塞的消费者正好取 per_producer 个元素，另外两个先预订份额再取，保证阻塞的一方不会等不到元素
+    std::atomic<int> allowance(producers*per_producer-per_producer);
+    auto reserve=[&](int want){
+        int have=allowance.load();
+        while(have>0 && !allowance.compare_exchange_weak(have, have-(want<have? want: have))){}
+        return have<=0? 0: want<have? want: have;
+    };
+    for(int c=0; c<consumers; ++c){
+        threads.emplace_back([&, c]{
+            int last[producers]={-1, -1, -1};
+            long long buf[8];
+            for(int taken=0;;){
+                size_t got=0;
+                if(c==2){
+                    if(taken==per_producer){
+                        break;
+                    }
+                    ring.pop(buf[0]);
+                    got=1;
+                }
+                else{
+                    const int want=reserve(c==0? 8: 1);
+                    if(want==0){
+                        break;
+                    }
+                    got=c==0? ring.pop_n(buf, static_cast<size_t>(want)): ring.try_pop(buf[0])? 1: 0;
+                    allowance+=want-static_cast<int>(got);
+                    if(got==0){
+                        std::this_thread::yield();
+                    }
+                }
+                taken+=static_cast<int>(got);
+                for(size_t k=0; k<got; ++k){
+                    const int p=static_cast<int>(buf[k]>>32), i=static_cast<int>(buf[k]&0xffffffff);
+                    if(i<=last[p]){
+                        ordered=false;
+                    }
+                    last[p]=i;
+                    sum+=i;
+                }
+            }
+        });
+    }
+    for(std::thread& t: threads){
+        t.join();
+    }
+    const long long expect=static_cast<long long>(producers)*per_producer*(per_producer-1)/2;
+    std::cout<<ordered.load()<<" "<<(sum.load()==expect)<<" "<<ring.empty()<<std::endl;
+    if(!ordered.load() || sum.load()!=expect || !ring.empty()){
+        ++g_failures;
+    }
+}
+
+// 记录存活个数，析构时把值改成 -1，读者读到 -1 说明访问了已经释放的对象
+struct epoch_probe
+{
+    static std::atomic<int> live;
+    int value;
+
+    explicit epoch_probe(int v): value(v) { ++live; }
+    ~epoch_probe(){
+        value=-1;
+        --live;
+    }
+};
+std::atomic<int> epoch_probe::live(0);
+
+void test_epoch(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::epoch_domain& domain=mystl::epoch_domain::instance();
+    // 被钉住的线程让纪元最多再前进一步
+    {
+        mystl::epoch_guard outer;
+        mystl::epoch_guard inner;
+        const size_t e=domain.epoch();
+        domain.try_advance();
+        domain.try_advance();
+        std::cout<<domain.epoch()-e<<" ";
+    }
+    auto make=[](int v){
+        epoch_probe* p=mystl::allocator<epoch_probe>::allocate();
+        mystl::construct(p, v);
+        return p;
+    };
+    for(int i=0; i<200; ++i){
+        domain.retire(make(i));
+    }
+    for(int i=0; i<3; ++i){
+        domain.flush();
+    }
+    std::cout<<epoch_probe::live.load()<<" "<<domain.pending()<<std::endl;
+
+    // 一个写者不断替换共享对象并回收旧对象，两个读者在 epoch_guard 内读取，读到的值不能是已析构的 -1，且不会变小
+    const int updates=20000;
+    std::atomic<epoch_probe*> current(make(0));
+    std::atomic<bool> done(false);
+    std::atomic<bool> valid(true);
+    std::vector<std::thread> threads;
+    threads.emplace_back([&]{
+        for(int i=1; i<=updates; ++i){
+            epoch_probe* old=current.exchange(make(i), std::memory_order_acq_rel);
+            domain.retire(old);
+            if(i%256==0){
+                std::this_thread::yield();
+            }
+        }
+    });
+    for(int r=0; r<2; ++r){
+        threads.emplace_back([&]{
+            int last=0;
+            while(!done.load()){
+                for(int k=0; k<64; ++k){
+                    mystl::epoch_guard guard;
+                    const int v=current.load(std::memory_order_acquire)->value;
+                    if(v<last){
+                        valid=false;
+                    }
+                    last=v;
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    threads[0].join();
+    done=true;
+    threads[1].join();
+    threads[2].join();
+    // 写者退出时留下的袋子由之后调用 flush 的线程释放
+    domain.retire(current.load());
+    for(int i=0; i<3; ++i){
+        domain.flush();
+    }
+    std::cout<<valid.load()<<" "<<epoch_probe::live.load()<<" "<<domain.pending()<<std::endl;
+    if(!valid.load() || epoch_probe::live.load()!=0){
+        ++g_failures;
+    }
+}
+
+// 等间隔的整数键（std::hash 对整数是恒等映射）也要分散到各个桶和各个条带，并且元素增多时正常扩容
+int check_concurrent_hash_map_strided(){
+    typedef mystl::concurrent_hash_map<uint64_t, uint64_t> map_type;
+    int errors=0;
+    const size_t n=4096;
+    for(uint64_t stride: {uint64_t(1), uint64_t(64), uint64_t(4096), uint64_t(65536), uint64_t(1) << 32}){
+        map_type m;
+        for(uint64_t i=0; i<n; ++i){
+            m.insert(i*stride, i);
+        }
+        errors+=m.size()!=n || m.bucket_count()*2<n;
+        std::vector<size_t> per_bucket(m.bucket_count()), per_stripe(map_type::stripe_count);
+        const size_t buckets_per_stripe=m.bucket_count()/map_type::stripe_count;
+        for(uint64_t i=0; i<n; ++i){
+            const size_t b=m.bucket(i*stride);
+            ++per_bucket[b];
+            ++per_stripe[b/buckets_per_stripe];
+            uint64_t v=0;
+            errors+=!m.find(i*stride, v) || v!=i;
+        }
+        // 平均每个桶不到 2 个、每个条带 64 个
+        errors+=*std::max_element(per_bucket.begin(), per_bucket.end())>12;
+        errors+=*std::min_element(per_stripe.begin(), per_stripe.end())<16;
+        errors+=*std::max_element(per_stripe.begin(), per_stripe.end())>160;
+    }
+    return errors;
+}
+
+void test_concurrent_hash_map(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const int strided_errors=check_concurrent_hash_map_strided();
+    g_failures+=strided_errors;
+    std::cout<<"strided keys: "<<strided_errors<<" errors"<<std::endl;
+    mystl::concurrent_hash_map<int, std::string> m;
+    std::string s;
+    std::cout<<m.insert(1, "one")<<m.insert(1, "uno")<<m.emplace(2, 3, 't')<<" ";
+    m.find(1, s);
+    std::cout<<s<<" "<<m.insert_or_assign(1, "uno")<<m.insert_or_assign(3, "three")<<" ";
+    m.update(2, [](std::string& v){ v+="!"; });
+    m.visit(2, [](const std::string& v){ std::cout<<v<<" "; });
+    m.find(1, s);
+    std::cout<<s<<" "<<m.size()<<" "<<m.erase(2)<<m.erase(2)<<m.contains(2)<<m.contains(3)<<" ";
+    const size_t buckets=m.bucket_count();
+    for(int i=0; i<1000; ++i){
+        m.insert(i, std::to_string(i));
+    }
+    m.find(1, s);
+    std::cout<<s<<" "<<m.size()<<" "<<(m.bucket_count()>buckets)<<" ";
+    m.clear();
+    std::cout<<m.size()<<m.contains(3)<<std::endl;
+
+    // 两个写者在各自的键上反复插入、覆盖、删除，两个读者检查读到的值总是属于这个键
+    const int writers=2, readers=2, keys=512, rounds=40;
+    mystl::concurrent_hash_map<int, std::string> shared(16);
+    std::atomic<bool> done(false);
+    std::atomic<bool> consistent(true);
+    std::vector<std::thread> threads;
+    for(int w=0; w<writers; ++w){
+        threads.emplace_back([&, w]{
+            for(int r=0; r<rounds; ++r){
+                for(int k=w; k<keys; k+=writers){
+                    const std::string v=std::to_string(k)+":"+std::to_string(r);
+                    if(r%3==0){
+                        shared.insert(k, v);
+                    }
+                    else if(r%3==1){
+                        shared.insert_or_assign(k, v);
+                    }
+                    else if(!shared.erase(k)){
+                        consistent=false;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for(int r=0; r<readers; ++r){
+        threads.emplace_back([&]{
+            while(!done.load()){
+                for(int k=0; k<keys; ++k){
+                    const std::string prefix=std::to_string(k)+":";
+                    shared.visit(k, [&](const std::string& v){
+                        if(v.compare(0, prefix.size(), prefix)!=0){
+                            consistent=false;
+                        }
+                    });
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for(int w=0; w<writers; ++w){
+        threads[w].join();
+    }
+    done=true;
+    for(int r=0; r<readers; ++r){
+        threads[writers+r].join();
+    }
+    // rounds-1 轮是删除之后的插入，所有键都在，值是最后一轮写入的
+    bool last=true;
+    for(int k=0; k<keys; ++k){
+        last=last && shared.find(k, s) && s==std::to_string(k)+":"+std::to_string(rounds-1);
+    }
+    std::cout<<consistent.load()<<" "<<last<<" "<<shared.size()<<std::endl;
+    if(!consistent.load() || !last || shared.size()!=keys){
+        ++g_failures;
+    }
+}
+
+// 随机的操作序列同时作用于 mystl::string 和 std::string，每一步后比较内容和查找结果
+    // 长度在内联容量附近来回变化，覆盖短、长两种表示之间的转换和参数指向自身的情况
+int check_string_ops(){
+    int errors=0;
+    mystl::string a;
+    std::string b;
+    unsigned x=12345;
+    auto next=[&x](unsigned n){
+        x=x*1103515245u+12345u;
+        return (x>>8)%n;
+    };
+    const char* words[]={"", "a", "key", "abcdefghijklmnopqrstuvw", "needle", "0123456789012345678901234567890123456789"};
+    for(int step=0; step<20000; ++step){
+        const char* w=words[next(6)];
+        const size_t wn=std::strlen(w);
+        const size_t pos=a.empty()? 0: next(static_cast<unsigned>(a.size()));
+        const size_t n=next(8);
+        switch(next(11)){
+        case 0: a.append(w); b.append(w); break;
+        case 1: a.insert(pos, w); b.insert(pos, w); break;
+        case 2: a.erase(pos, n); b.erase(pos, n); break;
+        case 3: a.replace(pos, n, w); b.replace(pos, n, w); break;
+        case 4: a.push_back('z'); b.push_back('z'); break;
+        case 5: a.append(a.data()+pos, mystl::min(n, a.size()-pos)); b.append(b.data()+pos, std::min(n, b.size()-pos)); break;
+        case 6: a.insert(pos, a.data(), mystl::min(n, a.size())); b.insert(pos, b.data(), std::min(n, b.size())); break;
+        case 7: a.resize(n*5, 'r'); b.resize(n*5, 'r'); break;
+        case 8: a.shrink_to_fit(); break;
+        case 9: a=mystl::string(a.data()+pos, a.size()-pos); b=b.substr(pos); break;
+        default:
+            a.resize_and_overwrite(a.size()+wn, [&](char* p, size_t cap){
+                std::memcpy(p+cap-wn, w, wn);
+                return cap;
+            });
+            b.append(w);
+            break;
+        }
+        const std::string probe=std::string(w)+(n%2? "z": "");
+        if(a.size()!=b.size() || std::memcmp(a.c_str(), b.c_str(), b.size()+1)!=0 ||
+           a.find(probe.c_str())!=b.find(probe) || a.rfind(w)!=b.rfind(w) ||
+           a.find('z', pos)!=b.find('z', pos) || a.find_first_of("ze", pos)!=b.find_first_of("ze", pos) ||
+           a.find_last_not_of('r')!=b.find_last_not_of('r') ||
+           (a.compare(w)<0)!=(b.compare(w)<0) || (a.compare(w)==0)!=(b.compare(w)==0)){
+            ++errors;
+            break;
+        }
+    }
+    // 按无符号字符比较，与 std::string 一致
+    const mystl::string hi("\xff"), lo("a");
+    if(!(lo<hi) || hi.compare(lo)<=0){
+        ++errors;
+    }
+    return errors;
+}
+
+void test_basic_string(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::string s("hello");
+    std::cout<<sizeof(mystl::string)<<" "<<mystl::string::sso_capacity<<" "<<s.capacity()<<" ";
+    s+=", world";
+    s.insert(0, "[").append(1, ']');
+    std::cout<<s<<" "<<s.size()<<" "<<s.find("world")<<" "<<s.rfind('o')<<" "<<s.find_first_of(",!")<<" ";
+    mystl::string inline_max(mystl::string::sso_capacity, 'x');
+    std::cout<<inline_max.capacity()<<" ";
+    inline_max.push_back('y');
+    std::cout<<(inline_max.capacity()>mystl::string::sso_capacity)<<" "<<inline_max.back()<<" ";
+    mystl::string t=s.substr(1, 5)+"!";
+    std::cout<<t<<" "<<(t==mystl::string("hello!"))<<(t<s)<<t.starts_with("he")<<t.ends_with('!')<<" ";
+    t.replace(0, 5, "bye");
+    t.erase(t.begin());
+    std::cout<<t<<" ";
+    mystl::u16string w(3, u'w');
+    std::cout<<w.size()<<mystl::u16string::sso_capacity<<std::endl;
+
+    const int errors=check_string_ops();
+    g_failures+=errors;
+    std::cout<<"random ops: "<<errors<<" errors"<<std::endl;
+}
+
+// split 与逐个字符扫描得到的结果比较；tokenize 与去掉空段后的结果比较
+int check_split(){
+    int errors=0;
+    const char* texts[]={"", ",", "a", "a,b", ",a,,b,", "key=value;;x=1", "::a::b:::c::"};
+    for(const char* t: texts){
+        std::vector<std::string> expect(1);
+        for(const char* p=t; *p; ++p){
+            if(*p==','){
+                expect.emplace_back();
+            }
+            else{
+                expect.back().push_back(*p);
+            }
+        }
+        std::vector<std::string> got;
+        for(mystl::string_view part: mystl::split(mystl::string_view(t), ',')){
+            got.emplace_back(part.data(), part.size());
+        }
+        errors+=got!=expect;
+
+        std::vector<std::string> tokens;
+        for(const std::string& e: expect){
+            if(!e.empty()){
+                tokens.push_back(e);
+            }
+        }
+        got.clear();
+        for(mystl::string_view part: mystl::tokenize(mystl::string_view(t), ",")){
+            got.emplace_back(part.data(), part.size());
+        }
+        errors+=got!=tokens;
+    }
+    // 多字符分隔串，以及分隔串为空时整段作为一段
+    size_t pieces=0;
+    for(mystl::string_view part: mystl::split(mystl::string_view("::a::b:::c::"), "::")){
+        pieces+=part.empty()? 10: 1;
+    }
+    errors+=pieces!=10+1+1+1+10;    // "", "a", "b", ":c", ""
+    for(mystl::string_view part: mystl::split(mystl::string_view("abc"), "")){
+        errors+=part!="abc";
+    }
+    return errors;
+}
+
+void test_string_view(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const mystl::string owner("GET /index.html HTTP/1.1");
+    mystl::string_view line=owner;
+    std::cout<<sizeof(mystl::string_view)<<" "<<line.size()<<" "<<(line.data()==owner.data())<<" ";
+    const mystl::string_view method=line.substr(0, line.find(' '));
+    line.remove_prefix(method.size()+1);
+    std::cout<<method<<"|"<<line.substr(0, line.find(' '))<<"|"<<line.substr(line.rfind(' ')+1)<<" ";
+    std::cout<<(method=="GET")<<(owner==mystl::string_view(owner))<<(method<line)<<line.starts_with('/')
+             <<line.ends_with("1.1")<<line.contains(".html")<<" "<<line.find_first_of("./")<<" ";
+    mystl::string copy(method);
+    copy+=mystl::string_view("!?", 1);
+    std::cout<<copy<<" "<<copy.compare(method)<<std::endl;
+
+    for(mystl::string_view field: mystl::split(mystl::string_view("a=1;b=2;;c=3"), ';')){
+        std::cout<<"["<<field<<"]";
+    }
+    std::cout<<" ";
+    for(mystl::string_view word: mystl::tokenize(owner, " /.")){
+        std::cout<<"["<<word<<"]";
+    }
+    std::cout<<std::endl;
+
+    const int errors=check_split();
+    g_failures+=errors;
+    std::cout<<"split: "<<errors<<" errors"<<std::endl;
+}
+
+void test_span(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    int arr[8]={1, 2, 3, 4, 5, 6, 7, 8};
+    mystl::span<int, 8> fixed(arr);
+    mystl::span<int> dyn=fixed;
+    std::cout<<sizeof(fixed)<<" "<<sizeof(dyn)<<" "<<sizeof(mystl::span<int, 8>::iterator)<<" ";
+    const mystl::span<int, 3> head=fixed.first<3>();
+    const mystl::span<int, 4> mid=fixed.subspan<2, 4>();
+    const mystl::span<int> tail=dyn.last(2);
+    std::cout<<head.size()<<mid.front()<<mid.back()<<tail[0]<<" ";
+    // 迭代器是指针，fill/copy 走 algorithm_base.h 的连续快速路径
+    mystl::fill(mid.begin(), mid.end(), 0);
+    mystl::copy(head.begin(), head.end(), tail.begin()-1);
+    for(int x: dyn){
+        std::cout<<x;
+    }
+    std::vector<int> v(dyn.begin(), dyn.end());
+    mystl::span<const int> cv=v;
+    std::cout<<" "<<cv.size()<<mystl::equal(cv.begin(), cv.end(), dyn.begin())<<" "
+             <<mystl::as_bytes(fixed).size()<<" "<<mystl::span<int>(arr, 0).empty()<<std::endl;
+    g_failures+=sizeof(fixed)!=sizeof(int*) || sizeof(dyn)!=2*sizeof(int*);
+}
+
+// 每种叉数：建堆、逐个 push、pop 与 std 的结果比较，排序结果与 std::sort 比较
+template <size_t Arity>
+int check_heap_arity(){
+    int errors=0;
+    unsigned x=Arity*7919u;
+    for(int round=0; round<50; ++round){
+        std::vector<int> v;
+        const int n=round*13%97;
+        for(int i=0; i<n; ++i){
+            x=x*1103515245u+12345u;
+            v.push_back(static_cast<int>((x>>8)%50));
+        }
+        std::vector<int> h=v;
+        mystl::dary_make_heap<Arity>(h.begin(), h.end());
+        errors+=!mystl::dary_is_heap<Arity>(h.begin(), h.end());
+        std::vector<int> pushed;
+        for(int e: v){
+            pushed.push_back(e);
+            mystl::dary_push_heap<Arity>(pushed.begin(), pushed.end(), mystl::greater<int>());
+            errors+=!mystl::dary_is_heap<Arity>(pushed.begin(), pushed.end(), mystl::greater<int>());
+        }
+        std::vector<int> expect=v;
+        std::sort(expect.begin(), expect.end());
+        if(!h.empty()){
+            errors+=h.front()!=expect.back();
+        }
+        if(!pushed.empty()){
+            errors+=pushed.front()!=expect.front();
+        }
+        mystl::dary_sort_heap<Arity>(h.begin(), h.end());
+        errors+=h!=expect;
+    }
+    return errors;
+}
+
+// 随机的 push/pop/replace_top 序列同时作用于 mystl 和 std 的优先队列，比较每一步的堆顶
+template <size_t Arity>
+int check_priority_queue(){
+    int errors=0;
+    mystl::priority_queue<std::string, mystl::less<std::string>, Arity> a;
+    std::priority_queue<std::string> b;
+    unsigned x=12345;
+    for(int step=0; step<5000; ++step){
+        x=x*1103515245u+12345u;
+        const unsigned op=(x>>8)%5;
+        const std::string value=std::to_string((x>>12)%1000);
+        if(op<3 || b.empty()){
+            a.push(value);
+            b.push(value);
+        }
+        else if(op==3){
+            a.pop();
+            b.pop();
+        }
+        else{
+            a.replace_top(value);
+            b.pop();
+            b.push(value);
+        }
+        if(a.size()!=b.size() || (!b.empty() && a.top()!=b.top())){
+            ++errors;
+            break;
+        }
+    }
+    // push 的参数引用的是堆顶，扩容时也不能失效
+    mystl::priority_queue<std::string, mystl::less<std::string>, Arity> c;
+    c.push("seed");
+    for(int i=0; i<100; ++i){
+        c.push(c.top());
+    }
+    errors+=c.size()!=101 || c.top()!="seed";
+    return errors;
+}
+
+// 记录尚未归还的分配次数的分配器
+template <class T>
+struct counting_allocator: mystl::allocator<T>
+{
+    static int outstanding;
+
+    T* allocate(size_t n){
+        ++outstanding;
+        return mystl::allocator<T>::allocate(n);
+    }
+    void deallocate(T* ptr, size_t n){
+        if(ptr!=nullptr){
+            --outstanding;
+        }
+        mystl::allocator<T>::deallocate(ptr, n);
+    }
+};
+template <class T>
+int counting_allocator<T>::outstanding=0;
+
+struct counter_less
+{
+    bool operator()(const throwing_counter& a, const throwing_counter& b) const { return a.value<b.value; }
+};
+
+// 复制构造时元素复制抛出异常：已复制的元素析构，缓冲区归还
+int check_priority_queue_copy_rollback(){
+    typedef mystl::priority_queue<throwing_counter, counter_less, 4, counting_allocator<throwing_counter>> queue;
+    int errors=0;
+    {
+        queue q;
+        for(int i=0; i<16; ++i){
+            q.push(throwing_counter(i));
+        }
+        const int live=throwing_counter::live;
+        const int outstanding=counting_allocator<throwing_counter>::outstanding;
+        throwing_counter::fail_at=9;
+        bool thrown=false;
+        try{
+            queue copy(q);
+        }
+        catch(const std::runtime_error&){
+            thrown=true;
+        }
+        throwing_counter::fail_at=0;
+        errors+=!thrown || throwing_counter::live!=live ||
+                counting_allocator<throwing_counter>::outstanding!=outstanding;
+        queue copy(q);
+        errors+=copy.size()!=16 || copy.top().value!=15;
+    }
+    errors+=throwing_counter::live!=0 || counting_allocator<throwing_counter>::outstanding!=0;
+    return errors;
+}
+
+// 随机有向图上的 Dijkstra：indexed_priority_queue 的 decrease_key 与 Bellman-Ford 的结果比较
+int check_indexed_dijkstra(){
+    const size_t n=300;
+    struct edge { size_t to; unsigned w; };
+    std::vector<std::vector<edge>> graph(n);
+    unsigned x=777;
+    for(size_t u=0; u<n; ++u){
+        for(int k=0; k<4; ++k){
+            x=x*1103515245u+12345u;
+            graph[u].push_back(edge{(x>>8)%n, 1+(x>>20)%100});
+        }
+    }
+    const unsigned inf=~0u;
+    std::vector<unsigned> dist(n, inf);
+    mystl::indexed_priority_queue<unsigned> q(n);
+    dist[0]=0;
+    q.push(0, 0);
+    while(!q.empty()){
+        const size_t u=q.top();
+        q.pop();
+        for(const edge& e: graph[u]){
+            const unsigned d=dist[u]+e.w;
+            if(d<dist[e.to]){
+                if(q.contains(e.to)){
+                    q.decrease_key(e.to, d);
+                }
+                else{
+                    q.push(e.to, d);
+                }
+                dist[e.to]=d;
+            }
+        }
+    }
+    std::vector<unsigned> expect(n, inf);
+    expect[0]=0;
+    for(size_t round=0; round<n; ++round){
+        for(size_t u=0; u<n; ++u){
+            if(expect[u]==inf){
+                continue;
+            }
+            for(const edge& e: graph[u]){
+                expect[e.to]=std::min(expect[e.to], expect[u]+e.w);
+            }
+        }
+    }
+    int errors=dist!=expect;
+    // erase/update/increase_key 之后依次弹出的键仍然有序
+    mystl::indexed_priority_queue<int, mystl::greater<int>, 2> r(64);
+    for(size_t i=0; i<64; ++i){
+        r.push(i, static_cast<int>((i*37)%64));
+    }
+    for(size_t i=0; i<64; i+=3){
+        r.erase(i);
+    }
+    for(size_t i=1; i<64; i+=5){
+        if(r.contains(i)){
+            r.update(i, r.key(i)%2? -static_cast<int>(i): static_cast<int>(i)*2);
+        }
+    }
+    r.increase_key(2, 1000);
+    int prev=-1000;
+    while(!r.empty()){
+        errors+=r.top_key()<prev;
+        prev=r.top_key();
+        r.pop();
+    }
+    errors+=r.erase(2)!=0 || prev!=1000;
+    return errors;
+}
+
+void test_priority_queue(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    int heap[]={3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+    mystl::make_heap(heap, heap+10);
+    std::cout<<std::is_heap(heap, heap+10)<<" "<<heap[0]<<" ";
+    mystl::sort_heap(heap, heap+10);
+    for(int e: heap){
+        std::cout<<e;
+    }
+    mystl::priority_queue<int> q(heap, heap+10);
+    q.push(7);
+    q.replace_top(0);
+    std::cout<<" "<<q.size()<<" "<<q.top()<<" ";
+    mystl::indexed_priority_queue<double> jobs(4);
+    jobs.push(0, 5.0);
+    jobs.push(1, 3.0);
+    jobs.push(2, 4.0);
+    jobs.decrease_key(0, 1.0);
+    std::cout<<jobs.top()<<jobs.top_key()<<" ";
+    jobs.pop();
+    std::cout<<jobs.top()<<jobs.contains(0)<<std::endl;
+
+    const int errors=check_heap_arity<2>()+check_heap_arity<3>()+check_heap_arity<4>()+check_heap_arity<8>()+
+                     check_priority_queue<2>()+check_priority_queue<4>()+check_priority_queue<8>()+
+                     check_priority_queue_copy_rollback()+check_indexed_dijkstra();
+    g_failures+=errors;
+    std::cout<<"heap: "<<errors<<" errors"<<std::endl;
+}
+
+// 随机的 insert/erase 序列同时作用于 slot_map 和以句柄为键的 unordered_map，
+    // 每一步比较元素个数，定期检查所有存活句柄和已删除句柄
+int check_slot_map(){
+    int errors=0;
+    mystl::slot_map<std::string> sm;
+    std::unordered_map<uint64_t, std::string> model;
+    std::vector<mystl::slot_handle> live;
+    std::vector<mystl::slot_handle> dead;
+    auto key=[](mystl::slot_handle h){ return (uint64_t(h.index)<<32)|h.generation; };
+    unsigned x=2024;
+    for(int step=0; step<20000; ++step){
+        x=x*1103515245u+12345u;
+        const unsigned op=(x>>8)%8;
+        if(op<5 || live.empty()){
+            const std::string value="entity-"+std::to_string(step);
+            const mystl::slot_handle h=sm.insert(value);
+            errors+=model.count(key(h))!=0;
+            model[key(h)]=value;
+            live.push_back(h);
+        }
+        else{
+            const size_t k=(x>>12)%live.size();
+            const mystl::slot_handle h=live[k];
+            errors+=sm.erase(h)!=1 || sm.erase(h)!=0;
+            model.erase(key(h));
+            dead.push_back(h);
+            live[k]=live.back();
+            live.pop_back();
+        }
+        if(sm.size()!=model.size()){
+            ++errors;
+            break;
+        }
+        if(step%1000==999){
+            for(mystl::slot_handle h: live){
+                const std::string* p=sm.find(h);
+                errors+=p==nullptr || *p!=model[key(h)];
+            }
+            for(mystl::slot_handle h: dead){
+                errors+=sm.contains(h);
+            }
+            // 数组中的每个元素都能通过 handle_of 找回自己
+            for(auto it=sm.begin(); it!=sm.end(); ++it){
+                errors+=sm.find(sm.handle_of(it))!=it;
+            }
+        }
+    }
+    // 槽位被复用：元素个数不超过历史最大值
+    errors+=sm.capacity()>16384;
+
+    // 复制后句柄仍然有效；遍历中按位置删除
+    mystl::slot_map<std::string> copy(sm);
+    for(mystl::slot_handle h: live){
+        errors+=copy[h]!=sm[h];
+    }
+    for(auto it=copy.begin(); it!=copy.end(); ){
+        if(it->back()%2==0){
+            it=copy.erase(it);
+        }
+        else{
+            ++it;
+        }
+    }
+    for(mystl::slot_handle h: live){
+        errors+=copy.contains(h)!=(sm[h].back()%2!=0);
+    }
+    mystl::slot_map<std::string> moved(mystl::move(copy));
+    errors+=!copy.empty() || moved.empty();
+    sm.clear();
+    for(mystl::slot_handle h: live){
+        errors+=sm.contains(h);
+    }
+
+    // insert 的参数引用的是容器中的元素，扩容时也不能失效
+    mystl::slot_map<std::string> grow;
+    mystl::slot_handle first=grow.insert("seed");
+    for(int i=0; i<100; ++i){
+        grow.insert(grow[first]);
+    }
+    errors+=grow.size()!=101 || grow.at(first)!="seed";
+    bool thrown=false;
+    try{
+        grow.at(mystl::slot_handle());
+    }
+    catch(const std::out_of_range&){
+        thrown=true;
+    }
+    errors+=!thrown;
+    return errors;
+}
+
+void test_slot_map(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::slot_map<int> ids;
+    const mystl::slot_handle a=ids.insert(10);
+    const mystl::slot_handle b=ids.insert(20);
+    const mystl::slot_handle c=ids.emplace(30);
+    ids.erase(a);
+    // 删除 a 时最后一个元素 c 移到了下标 0，空出的槽位被 d 复用，代数加一
+    const mystl::slot_handle d=ids.insert(40);
+    std::cout<<ids.size()<<" "<<ids[c]<<ids[b]<<" "<<ids.contains(a)<<" "<<d.index<<d.generation<<" ";
+    for(int e: ids){
+        std::cout<<e;
+    }
+    std::cout<<std::endl;
+    const int errors=check_slot_map();
+    g_failures+=errors;
+    std::cout<<"slot_map: "<<errors<<" errors"<<std::endl;
+}
+
+// soa_vector：与 std::vector<std::tuple<...>> 比较，包括不平凡的列、扩容、按位置删除和扩容失败时的回滚
+int check_soa_vector(){
+    int errors=0;
+    mystl::soa_vector<int, std::string, double> v;
+    std::vector<std::tuple<int, std::string, double>> model;
+    for(int i=0; i<1000; ++i){
+        if(i%7==6){
+            v.erase(v.begin()+i%v.size());
+            model.erase(model.begin()+i%model.size());
+        }
+        else if(i%2==0){
+            v.emplace_back(i, std::to_string(i), i*0.5);
+            model.emplace_back(i, std::to_string(i), i*0.5);
+        }
+        else{
+            v.push_back(std::make_tuple(i, std::string(20, 'a'+i%26), -i*1.0));
+            model.emplace_back(i, std::string(20, 'a'+i%26), -i*1.0);
+        }
+    }
+    errors+=v.size()!=model.size();
+    for(size_t i=0; i<model.size() && i<v.size(); ++i){
+        errors+=std::tuple<int, std::string, double>(v[i])!=model[i];
+    }
+    // 每一列都按 64 字节对齐，列的 span 与迭代器看到的是同一个元素
+    errors+=reinterpret_cast<uintptr_t>(v.data<0>())%64!=0 || reinterpret_cast<uintptr_t>(v.data<1>())%64!=0 ||
+            reinterpret_cast<uintptr_t>(v.data<2>())%64!=0;
+    errors+=v.column<1>().size()!=v.size() || &v.column<2>()[5]!=&std::get<2>(v[5]) ||
+            &(v.begin()+5).get<1>()!=&v.column<1>()[5];
+    // 代理迭代器：iterator_traits 萃取为随机访问迭代器，可以交给 mystl 的算法
+    typedef mystl::soa_vector<int, std::string, double>::iterator iter;
+    static_assert(std::is_same<mystl::iterator_traits<iter>::iterator_category,
+                               mystl::random_access_iterator_tag>::value, "soa iterator category");
+    static_assert(mystl::is_random_access_iterator<iter>::value, "soa random access");
+    errors+=mystl::distance(v.begin(), v.end())!=static_cast<ptrdiff_t>(v.size());
+    auto found=mystl::find_if(v.cbegin(), v.cend(), [](std::tuple<const int&, const std::string&, const double&> r){
+        return std::get<0>(r)==500;
+    });
+    errors+=found==v.cend() || std::get<1>(*found)!="500";
+    // 整行赋值通过引用写回各列
+    *v.begin()=std::make_tuple(-1, std::string("first"), 0.25);
+    errors+=std::get<0>(v.front())!=-1 || std::get<1>(v[0])!="first";
+    // 交换两行：iter_swap 逐列交换，从两端向中间交换就是 reverse；swap_range 交换两段；与 std::vector 的结果比较
+    {
+        typedef mystl::soa_vector<int, std::string>::iterator row_iter;
+        static_assert(noexcept(mystl::iter_swap(std::declval<row_iter>(), std::declval<row_iter>())), "nothrow iter_swap");
+        mystl::soa_vector<int, std::string> r;
+        std::vector<std::tuple<int, std::string>> rm;
+        for(int i=0; i<37; ++i){
+            r.emplace_back(i, std::string(i, 'r'));
+            rm.emplace_back(i, std::string(i, 'r'));
+        }
+        mystl::iter_swap(r.begin(), r.begin()+5);
+        std::iter_swap(rm.begin(), rm.begin()+5);
+        for(row_iter first=r.begin(), last=r.end(); first!=last && first!=--last; ++first){
+            mystl::iter_swap(first, last);
+        }
+        std::reverse(rm.begin(), rm.end());
+        mystl::swap_range(r.begin(), r.begin()+10, r.begin()+20);
+        std::swap_ranges(rm.begin(), rm.begin()+10, rm.begin()+20);
+        mystl::swap(r[0], r[36]);
+        std::swap(rm[0], rm[36]);
+        for(size_t i=0; i<rm.size(); ++i){
+            errors+=std::tuple<int, std::string>(r[i])!=rm[i];
+        }
+    }
+    // emplace_back 的参数引用的是容器中的元素，扩容时也不能失效
+    mystl::soa_vector<std::string, int> grow;
+    grow.emplace_back(std::string("seed"), 1);
+    for(int i=0; i<100; ++i){
+        grow.emplace_back(std::get<0>(grow[0]), std::get<1>(grow.back())+1);
+    }
+    errors+=grow.size()!=101 || std::get<0>(grow.back())!="seed" || std::get<1>(grow.back())!=101;
+    // 复制、移动、resize
+    mystl::soa_vector<int, std::string, double> copy(v);
+    errors+=copy.size()!=v.size() || std::get<1>(copy[3])!=std::get<1>(v[3]);
+    mystl::soa_vector<int, std::string, double> moved(mystl::move(copy));
+    errors+=!copy.empty() || moved.size()!=v.size();
+    moved.resize(2000);
+    errors+=std::get<0>(moved[1999])!=0 || !std::get<1>(moved[1999]).empty();
+    moved.resize(10);
+    errors+=moved.size()!=10 || std::get<0>(moved[9])!=std::get<0>(v[9]);
+
+    // 第二列复制到一半抛出异常：已搬好的第一列被析构，原来的内容不变
+    {
+        mystl::soa_vector<std::string, throwing_counter> t;
+        for(int i=0; i<16; ++i){
+            t.emplace_back(std::to_string(i), i);
+        }
+        const int live=throwing_counter::live;
+        throwing_counter::fail_at=5;
+        bool thrown=false;
+        try{
+            t.emplace_back(std::string("x"), 16);
+        }
+        catch(const std::runtime_error&){
+            thrown=true;
+        }
+        throwing_counter::fail_at=0;
+        errors+=!thrown || t.size()!=16 || throwing_counter::live!=live || std::get<0>(t[15])!="15" ||
+                std::get<1>(t[15]).value!=15;
+    }
+    return errors;
+}
+
+void test_soa_vector(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::soa_vector<float, float, int> points;
+    for(int i=0; i<5; ++i){
+        points.emplace_back(i*1.0f, i*2.0f, i);
+    }
+    // 只读一列：span 交给 reduce
+    auto ys=points.column<1>();
+    std::cout<<points.size()<<" "<<mystl::reduce(ys.begin(), ys.end())<<" ";
+    for(auto [x, y, id]: points){
+        x+=y;
+        std::cout<<id;
+    }
+    std::cout<<" "<<std::get<0>(points[4])<<std::endl;
+    const int errors=check_soa_vector();
+    g_failures+=errors;
+    std::cout<<"soa_vector: "<<errors<<" errors"<<std::endl;
+}
+
+// bitset 和 dynamic_bitset：与 std::bitset 和 std::vector<bool> 比较随机操作后的结果
+template <size_t N>
+int check_bitset_size(){
+    int errors=0;
+    uint64_t x=N*2654435761u+1;
+    auto next=[&x]{
+        x=x*6364136223846793005ull+1442695040888963407ull;
+        return static_cast<size_t>(x>>33);
+    };
+    mystl::bitset<N> a, b;
+    std::bitset<N> ra, rb;
+    auto same=[&](const mystl::bitset<N>& m, const std::bitset<N>& r){
+        int e=m.count()!=r.count() || m.any()!=r.any() || m.none()!=r.none() || m.all()!=r.all();
+        for(size_t i=0; i<N; ++i){
+            e+=m[i]!=r[i];
+        }
+        // find_first/find_next 遍历到的位与 std::bitset 的 _Find_first/_Find_next 相同
+        size_t k=m.find_first(), rk=r._Find_first();
+        for(; k<N && rk<N; k=m.find_next(k), rk=r._Find_next(rk)){
+            e+=k!=rk;
+        }
+        e+=k!=N || rk!=N;
+        return e;
+    };
+    for(int round=0; round<40 && N>0; ++round){
+        for(size_t i=0; i<N/3+1; ++i){
+            const size_t p=next()%N;
+            a.set(p);
+            ra.set(p);
+            const size_t q=next()%N;
+            b[q]=true;
+            rb[q]=true;
+        }
+        switch(round%8){
+        case 0: a&=b; ra&=rb; break;
+        case 1: a|=b; ra|=rb; break;
+        case 2: a^=b; ra^=rb; break;
+        case 3: a.andnot(b); ra&=~rb; break;
+        case 4: a=~a; ra=~ra; break;
+        case 5: { const size_t s=next()%(N+2); a<<=s; ra<<=s; break; }
+        case 6: { const size_t s=next()%(N+2); a>>=s; ra>>=s; break; }
+        default: a.reset(); ra.reset(); break;
+        }
+        errors+=same(a, ra);
+        errors+=a.intersection_count(b)!=(ra&rb).count() || a.intersects(b)!=(ra&rb).any();
+        errors+=(a==b)!=(ra==rb) || (a^b).count()!=(ra^rb).count();
+    }
+    a.set();
+    ra.set();
+    errors+=same(a, ra);
+    errors+=same(mystl::bitset<N>(0x8000000000000001ull), std::bitset<N>(0x8000000000000001ull));
+    return errors;
+}
+
+int check_bitset(){
+    int errors=check_bitset_size<0>()+check_bitset_size<1>()+check_bitset_size<63>()+check_bitset_size<64>()+
+               check_bitset_size<65>()+check_bitset_size<200>()+check_bitset_size<512>()+
+               check_bitset_size<1000>()+check_bitset_size<4099>();
+    bool thrown=false;
+    try{
+        mystl::bitset<10>().test(10);
+    }
+    catch(const std::out_of_range&){
+        thrown=true;
+    }
+    errors+=!thrown;
+    thrown=false;
+    try{
+        (mystl::bitset<100>(1)<<70).to_ullong();
+    }
+    catch(const std::overflow_error&){
+        thrown=true;
+    }
+    errors+=!thrown || mystl::bitset<100>(12345).to_ullong()!=12345;
+    // 按字的存储按大小对齐
+    static_assert(alignof(mystl::bitset<1024>)==64 && alignof(mystl::bitset<64>)==8, "bitset alignment");
+
+    // dynamic_bitset：push_back、resize、按字运算和查找，与 std::vector<bool> 比较
+    uint64_t x=17;
+    auto next=[&x]{
+        x=x*6364136223846793005ull+1442695040888963407ull;
+        return static_cast<size_t>(x>>33);
+    };
+    auto same=[](const mystl::dynamic_bitset<>& m, const std::vector<bool>& r){
+        int e=m.size()!=r.size();
+        size_t c=0;
+        for(size_t i=0; i<r.size() && i<m.size(); ++i){
+            e+=m[i]!=r[i];
+            c+=r[i];
+        }
+        e+=m.count()!=c || m.any()!=(c>0) || m.all()!=(c==r.size());
+        size_t k=m.find_first();
+        for(size_t i=0; i<r.size(); ++i){
+            if(r[i]){
+                e+=k!=i;
+                k=m.find_next(k);
+            }
+        }
+        e+=k!=m.size();
+        return e;
+    };
+    mystl::dynamic_bitset<> d;
+    std::vector<bool> rd;
+    for(size_t i=0; i<3000; ++i){
+        const bool bit=next()%7==0;
+        d.push_back(bit);
+        rd.push_back(bit);
+    }
+    errors+=same(d, rd);
+    errors+=reinterpret_cast<uintptr_t>(d.data())%64!=0;
+    // 变小时截掉的位清零，再变大时新增的位按 value 填充
+    d.resize(1000);
+    rd.resize(1000);
+    d.resize(2500, true);
+    rd.resize(2500, true);
+    errors+=same(d, rd);
+    d.resize(1301);
+    rd.resize(1301);
+    d.resize(1400);
+    rd.resize(1400);
+    errors+=same(d, rd);
+    mystl::dynamic_bitset<> e(1400, false);
+    std::vector<bool> re(1400, false);
+    for(size_t i=0; i<300; ++i){
+        const size_t p=next()%1400;
+        e.set(p);
+        re[p]=true;
+    }
+    size_t inter=0;
+    for(size_t i=0; i<1400; ++i){
+        inter+=rd[i] && re[i];
+    }
+    errors+=d.intersection_count(e)!=inter || (d&e).count()!=inter || d.intersects(e)!=(inter>0);
+    mystl::dynamic_bitset<> f(d);
+    f.andnot(e);
+    f^=d;
+    errors+=f!=(d&e);
+    f|=e;
+    errors+=f!=e;
+    errors+=(~d).count()!=d.size()-d.count() || ((d<<100)>>100).count()+((d>>1300).count())!=d.count();
+    mystl::dynamic_bitset<> g(mystl::move(f));
+    errors+=!f.empty() || g!=e;
+    g.set();
+    errors+=!g.all() || g.count()!=1400;
+    g.clear();
+    errors+=!g.empty() || g.find_first()!=0 || g.any();
+    // 清空后再增长，新增的位都为 0
+    g.resize(700);
+    errors+=g.count()!=0;
+    return errors;
+}
+
+void test_bitset(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::bitset<200> visited;
+    visited.set(3).set(64).set(199);
+    mystl::bitset<200> frontier=visited<<1;
+    std::cout<<visited.count()<<" "<<frontier.find_first()<<" "<<frontier.find_next(65)<<" "
+             <<visited.intersection_count(frontier|mystl::bitset<200>(8))<<" ";
+    mystl::dynamic_bitset<> d(10);
+    d[2]=true;
+    d.push_back(true);
+    for(size_t i=d.find_first(); i<d.size(); i=d.find_next(i)){
+        std::cout<<i<<",";
+    }
+    std::cout<<" "<<d.size()<<std::endl;
+    const int errors=check_bitset();
+    g_failures+=errors;
+    std::cout<<"bitset: "<<errors<<" errors"<<std::endl;
+}
+
+// 不在集合中的 n 个键中 contains 为真的比例；插入的键是 [0, inserted)，查询 [base, base+n)
+template <class Filter>
+double measured_fpp(const Filter& f, uint64_t base, size_t n){
+    size_t hits=0;
+    for(uint64_t k=base; k<base+n; ++k){
+        hits+=f.contains(k);
+    }
+    return static_cast<double>(hits)/static_cast<double>(n);
+}
+
+// 测得的假阳性率与理论值的偏差在 50% 以内
+bool fpp_close(double measured, double theory){
+    return measured>0.5*theory && measured<1.5*theory;
+}
+
+// 复制、序列化后恢复的过滤器，对同一批键的查询结果相同
+template <class Filter>
+int check_filter_copies(const Filter& f, const std::vector<uint64_t>& keys){
+    int errors=0;
+    std::vector<unsigned char> buffer(f.serialized_size()+1);
+    f.serialize(buffer.data()+1);  // 不要求对齐
+    Filter restored=Filter::deserialize(buffer.data()+1, f.serialized_size());
+    Filter copied(f);
+    errors+=restored!=f || copied!=f || restored.size()!=f.size();
+    mystl::unique_ptr<bool[]> batch(new bool[keys.size()]);
+    restored.contains_batch(keys.data(), keys.size(), batch.get());
+    for(size_t i=0; i<keys.size(); ++i){
+        errors+=batch[i]!=f.contains(keys[i]) || copied.contains(keys[i])!=batch[i];
+    }
+    // 截断、种类不对的缓冲区
+    int thrown=0;
+    try{
+        Filter::deserialize(buffer.data()+1, f.serialized_size()-1);
+    }
+    catch(const std::runtime_error&){
+        ++thrown;
+    }
+    buffer[1]^=1;
+    try{
+        Filter::deserialize(buffer.data()+1, f.serialized_size());
+    }
+    catch(const std::runtime_error&){
+        ++thrown;
+    }
+    errors+=thrown!=2;
+    return errors;
+}
+
+int check_filters(){
+    int errors=0;
+    const size_t n=20000;
+    std::vector<uint64_t> keys;
+    for(uint64_t k=0; k<2*n; ++k){
+        keys.push_back(k*7);
+    }
+
+    // blocked_bloom_filter：没有假阴性，假阳性率接近理论值
+    mystl::blocked_bloom_filter<uint64_t> bloom(n, 0.01);
+    for(size_t i=0; i<n; ++i){
+        bloom.insert(keys[i]);
+    }
+    for(size_t i=0; i<n; ++i){
+        errors+=!bloom.contains(keys[i]);
+    }
+    const double bloom_fpp=measured_fpp(bloom, uint64_t(1) << 40, 200000);
+    errors+=bloom.size()!=n || bloom.expected_fpp()>0.01 || !fpp_close(bloom_fpp, bloom.expected_fpp());
+    errors+=bloom.set_bits()==0 || bloom.set_bits()>8*n;
+    errors+=check_filter_copies(bloom, keys);
+    // 合并：两半分别插入再合并，与全部插入同一个过滤器相同
+    mystl::blocked_bloom_filter<uint64_t> low(n, 0.01), high(n, 0.01);
+    low.insert(keys.begin(), keys.begin()+n/2);
+    high.insert(keys.begin()+n/2, keys.begin()+n);
+    low|=high;
+    errors+=low!=bloom || low.size()!=n;
+    bloom.clear();
+    errors+=!bloom.empty() || bloom.set_bits()!=0 || bloom.contains(keys[0]);
+    bool thrown=false;
+    try{
+        mystl::blocked_bloom_filter<uint64_t>(10, 1.5);
+    }
+    catch(const std::out_of_range&){
+        thrown=true;
+    }
+    errors+=!thrown;
+    // 更小的目标假阳性率需要更多的位
+    errors+=mystl::blocked_bloom_filter<int>::blocks_for(n, 0.001)<=mystl::blocked_bloom_filter<int>::blocks_for(n, 0.01);
+
+    // cuckoo_filter：没有假阴性，删除后不再包含，假阳性率接近理论值
+    mystl::cuckoo_filter<uint64_t> cuckoo(n);
+    for(size_t i=0; i<n; ++i){
+        errors+=!cuckoo.insert(keys[i]);
+    }
+    for(size_t i=0; i<n; ++i){
+        errors+=!cuckoo.contains(keys[i]);
+    }
+    const double cuckoo_fpp=measured_fpp(cuckoo, uint64_t(1) << 40, 1000000);
+    errors+=cuckoo.size()!=n || !fpp_close(cuckoo_fpp, cuckoo.expected_fpp());
+    errors+=check_filter_copies(cuckoo, keys);
+    size_t still=0;
+    for(size_t i=0; i<n; i+=2){
+        errors+=!cuckoo.erase(keys[i]);
+        still+=cuckoo.contains(keys[i]);
+    }
+    for(size_t i=1; i<n; i+=2){
+        errors+=!cuckoo.contains(keys[i]);
+    }
+    // 删除的键只有与留下的键指纹、候选桶都相同时才仍然被包含
+    errors+=cuckoo.size()!=n/2 || still>10;
+    errors+=cuckoo.erase(uint64_t(1) << 50);
+    // 同一个键插入两次需要删除两次
+    cuckoo.insert(keys[0]);
+    cuckoo.insert(keys[0]);
+    cuckoo.erase(keys[0]);
+    errors+=!cuckoo.contains(keys[0]);
+    cuckoo.erase(keys[0]);
+
+    // 插入到满：满之前的键都能找到，满之后 insert 失败；删除后可以继续插入
+    mystl::cuckoo_filter<uint64_t> small(1000);
+    size_t inserted=0;
+    while(small.insert(keys[inserted])){
+        ++inserted;
+    }
+    errors+=!small.full() || small.load_factor()<0.9 || small.size()!=inserted;
+    for(size_t i=0; i<inserted; ++i){
+        errors+=!small.contains(keys[i]);
+    }
+    errors+=check_filter_copies(small, keys);
+    errors+=!small.erase(keys[0]) || small.full() || !small.insert(keys[0]);
+    for(size_t i=0; i<inserted; ++i){
+        errors+=!small.contains(keys[i]);
+    }
+    small.clear();
+    errors+=!small.empty() || small.full() || small.contains(keys[1]);
+
+    // 字符串键
+    mystl::cuckoo_filter<std::string> names(16);
+    mystl::blocked_bloom_filter<std::string> seen(16);
+    for(const char* s: {"alpha", "beta", "gamma"}){
+        names.insert(s);
+        seen.insert(s);
+    }
+    errors+=!names.contains("beta") || !seen.contains("gamma") || !names.erase("beta");
+    return errors;
+}
+
+void test_filters(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    mystl::blocked_bloom_filter<int> bloom(1000, 0.01);
+    mystl::cuckoo_filter<int> cuckoo(1000);
+    for(int i=0; i<1000; ++i){
+        bloom.insert(i);
+        cuckoo.insert(i);
+    }
+    cuckoo.erase(7);
+    std::cout<<bloom.block_count()<<" "<<bloom.contains(7)<<" "<<cuckoo.bucket_count()<<" "
+             <<cuckoo.contains(7)<<" "<<cuckoo.contains(8)<<std::endl;
+    const int errors=check_filters();
+    g_failures+=errors;
+    std::cout<<"filters: "<<errors<<" errors"<<std::endl;
+}
+
+// 雪崩测试：随机输入的每一位翻转时，输出的每一位翻转的比例都接近 1/2，返回最大偏差
+template <class Hash>
+double avalanche_bias(size_t bytes, Hash h){
+    const size_t samples=4000;
+    std::vector<unsigned char> in(bytes);
+    std::vector<uint32_t> flips(bytes*8*64, 0);
+    uint64_t x=0x243F6A8885A308D3ull;
+    for(size_t s=0; s<samples; ++s){
+        for(unsigned char& c: in){
+            x=x*6364136223846793005ull+1442695040888963407ull;
+            c=static_cast<unsigned char>(x >> 56);
+        }
+        const uint64_t base=h(in.data(), bytes);
+        for(size_t bit=0; bit<bytes*8; ++bit){
+            in[bit/8]^=static_cast<unsigned char>(1u << (bit%8));
+            uint64_t diff=base^h(in.data(), bytes);
+            in[bit/8]^=static_cast<unsigned char>(1u << (bit%8));
+            for(; diff!=0; diff&=diff-1){
+                ++flips[bit*64+static_cast<size_t>(__builtin_ctzll(diff))];
+            }
+        }
+    }
+    double worst=0;
+    for(uint32_t f: flips){
+        worst=std::max(worst, std::fabs(static_cast<double>(f)/samples-0.5));
+    }
+    return worst;
+}
+
+// 碰撞测试：哈希值中不同值的个数
+size_t distinct(std::vector<uint64_t> v){
+    std::sort(v.begin(), v.end());
+    return static_cast<size_t>(std::unique(v.begin(), v.end())-v.begin());
+}
+
+enum class hash_color: short { red=-1, green=2 };
+
+int check_hash(){
+    int errors=0;
+    // 雪崩：4000 个样本时比例的标准差约 0.008，0.05 约为 6 个标准差；
+    // 1、2 字节的输入只有 256、65536 种，由下面的穷举碰撞测试覆盖
+    auto bytes_hash=[](const unsigned char* p, size_t n){ return mystl::hash_bytes(p, n); };
+    auto int_hash=[](const unsigned char* p, size_t){
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return mystl::hash_u64(v);
+    };
+    errors+=avalanche_bias(8, int_hash)>0.05;
+    for(size_t n: {3, 4, 8, 12, 16, 17, 33, 48, 49, 100}){
+        errors+=avalanche_bias(n, bytes_hash)>0.05;
+    }
+
+    // 碰撞：连续的整数、只差一个字符的短字符串、所有 0~2 字节的串（长度不同、内容全 0 也要区分）
+    const size_t n=1 << 20;
+    std::vector<uint64_t> ints(n), strings(n), small;
+    for(size_t i=0; i<n; ++i){
+        ints[i]=mystl::hash_u64(i);
+        const std::string key="key"+std::to_string(i);
+        strings[i]=mystl::hash_bytes(key.data(), key.size());
+    }
+    errors+=distinct(ints)!=n || distinct(strings)!=n;
+    unsigned char buf[2]={0, 0};
+    small.push_back(mystl::hash_bytes(buf, 0));
+    for(unsigned a=0; a<256; ++a){
+        buf[0]=static_cast<unsigned char>(a);
+        small.push_back(mystl::hash_bytes(buf, 1));
+        for(unsigned b=0; b<256; ++b){
+            buf[1]=static_cast<unsigned char>(b);
+            small.push_back(mystl::hash_bytes(buf, 2));
+        }
+    }
+    errors+=distinct(small)!=small.size();
+    // 低位的分布：把 2^20 个连续整数放入 2^20 个桶，非空桶的个数接近随机时的 (1-1/e)*2^20
+    std::vector<uint64_t> low(n);
+    for(size_t i=0; i<n; ++i){
+        low[i]=ints[i]&(n-1);
+    }
+    const double occupied=static_cast<double>(distinct(low))/n;
+    errors+=std::fabs(occupied-(1.0-std::exp(-1.0)))>0.005;
+
+    // 种子不同结果不同；读取不会越过末尾（用 ASan 检查），同样内容的不同位置结果相同
+    const char text[]="the quick brown fox jumps over the lazy dog, twice over: the quick brown fox";
+    errors+=mystl::hash_bytes(text, 40, 1)==mystl::hash_bytes(text, 40, 2);
+    std::vector<char> copy(text, text+sizeof(text));
+    for(size_t len=0; len<sizeof(text); ++len){
+        errors+=mystl::hash_bytes(text, len)!=mystl::hash_bytes(copy.data(), len);
+    }
+
+    // hash<T>：各类键，同样内容的字符串、字符串视图的哈希值相同
+    mystl::hash<std::string> hs;
+    errors+=hs("abc")!=mystl::hash<mystl::string_view>()("abc") || hs("abc")!=mystl::hash<mystl::string>()("abc")
+        || hs("abc")!=mystl::hash<std::string_view>()("abc") || hs("abc")==hs("abd");
+    errors+=mystl::hash<double>()(0.0)!=mystl::hash<double>()(-0.0) || mystl::hash<float>()(1.5f)!=mystl::hash<double>()(1.5);
+    errors+=mystl::hash<int>()(-1)!=mystl::hash_u64(~uint64_t(0)) || mystl::hash<hash_color>()(hash_color::green)!=mystl::hash_u64(2);
+    int slot=0;
+    errors+=mystl::hash<int*>()(&slot)!=mystl::hash_u64(reinterpret_cast<uintptr_t>(&slot));
+    errors+=mystl::hash<std::bitset<8>>()(std::bitset<8>(5))!=mystl::hash_u64(std::hash<std::bitset<8>>()(std::bitset<8>(5)));
+    // pair：两个成员都参与，交换顺序结果不同
+    typedef mystl::pair<int, std::string> key_pair;
+    mystl::hash<key_pair> hp;
+    errors+=hp(key_pair(1, "a"))!=mystl::hash_combine(mystl::hash_value(1), mystl::hash_value(std::string("a")));
+    errors+=hp(key_pair(1, "a"))==hp(key_pair(2, "a")) || hp(key_pair(1, "a"))==hp(key_pair(1, "b"));
+    mystl::hash<mystl::pair<int, int>> hi;
+    errors+=hi(mystl::make_pair(1, 2))==hi(mystl::make_pair(2, 1));
+    std::vector<uint64_t> pairs;
+    for(int a=0; a<300; ++a){
+        for(int b=0; b<300; ++b){
+            pairs.push_back(hi(mystl::make_pair(a, b)));
+        }
+    }
+    errors+=distinct(pairs)!=pairs.size();
+    errors+=mystl::hash<mystl::pair<mystl::pair<int, int>, double>>()(mystl::make_pair(mystl::make_pair(1, 2), 3.0))
+        !=mystl::hash_combine(hi(mystl::make_pair(1, 2)), mystl::hash_value(3.0));
+
+    // hash_batch 与逐个计算相同：64 位整数、更窄的整数、枚举和字符串
+    std::vector<int64_t> wide(333);
+    std::vector<short> narrow(333);
+    std::vector<hash_color> colors(333);
+    std::vector<std::string> words(333);
+    for(size_t i=0; i<wide.size(); ++i){
+        wide[i]=static_cast<int64_t>(i*i)-5000;
+        narrow[i]=static_cast<short>(i*97);
+        colors[i]=i%2? hash_color::red: hash_color::green;
+        words[i]=std::to_string(i);
+    }
+    std::vector<uint64_t> out(333);
+    mystl::hash_batch(wide.data(), wide.size(), out.data());
+    for(size_t i=0; i<wide.size(); ++i){
+        errors+=out[i]!=mystl::hash_value(wide[i]);
+    }
+    mystl::hash_batch(narrow.data(), narrow.size(), out.data());
+    for(size_t i=0; i<narrow.size(); ++i){
+        errors+=out[i]!=mystl::hash_value(narrow[i]);
+    }
+    mystl::hash_batch(colors.data(), colors.size(), out.data());
+    for(size_t i=0; i<colors.size(); ++i){
+        errors+=out[i]!=mystl::hash_value(colors[i]);
+    }
+    mystl::hash_batch(words.data(), words.size(), out.data());
+    for(size_t i=0; i<words.size(); ++i){
+        errors+=out[i]!=hs(words[i]);
+    }
+    std::vector<uint64_t> seeded(wide.begin(), wide.end());
+    mystl::hash_u64_batch(seeded.data(), seeded.size(), seeded.data(), 99);
+    for(size_t i=0; i<wide.size(); ++i){
+        errors+=seeded[i]!=mystl::hash_u64(static_cast<uint64_t>(wide[i]), 99);
+    }
+
+    // 作为容器的哈希函数
+    mystl::concurrent_hash_map<std::string, int, mystl::hash<std::string>> m;
+    m.insert("one", 1);
+    int v=0;
+    errors+=!m.find("one", v) || v!=1;
+    return errors;
+}
+
+void test_hash(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    std::cout<<std::hex<<mystl::hash_bytes("", 0)<<" "<<mystl::hash<std::string>()("mystl")<<" "
+             <<mystl::hash<mystl::pair<int, int>>()(mystl::make_pair(1, 2))<<std::dec<<std::endl;
+    const int errors=check_hash();
+    g_failures+=errors;
+    std::cout<<"hash: "<<errors<<" errors"<<std::endl;
+}
+
+void test_simd(){
+    std::cout<<__func__<<"-----------------"<<std::endl;
+    const mystl::simd::isa detected=mystl::simd::detected_isa();
+    const mystl::simd::isa active=mystl::simd::active_isa();
+    for(int i=0; i<=static_cast<int>(detected); ++i){
+        auto level=static_cast<mystl::simd::isa>(i);
+        if(!mystl::simd::force_isa(level)){
+            continue;  // 没有编译这个级别的内核
+        }
+        int errors=check_kernels()+check_lexicographical_all()+check_search_all()+
+                   check_reduction_all()+check_bit_kernels()+check_hash_kernels();
+        g_failures+=errors;
+        std::cout<<mystl::simd::isa_name(level)<<": "<<errors<<" errors"<<std::endl;
+    }
+    mystl::simd::force_isa(active);
+
+    // 算法通过当前级别的内核执行，结果与逐元素的语义一致
+    std::vector<int> v1={1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20};
+    std::vector<int> v2(v1);
+    v2[13]=-1;
+    auto mis=mystl::mismatch(v1.data(), v1.data()+v1.size(), v2.data());
+    std::cout<<(mis.first-v1.data())<<" "<<*mis.first<<" "<<*mis.second<<" "
+             <<mystl::equal(v1.data(), v1.data()+13, v2.data())<<std::endl;
+    std::vector<long> l(9);
+    mystl::fill(l.data(), l.data()+l.size(), 7);
+    for(long x: l){
+        std::cout<<x<<" ";
+    }
+    std::cout<<std::endl;
+}
+
 int main(){
 
     #ifdef max
@@ -90,6 +2758,29 @@ int main(){
     test_copy();
     test_pair();
     test_copy_backward();
-    
-    return 0;
+    test_compressed_pair();
+    test_move_if_noexcept();
+    test_unique_ptr();
+    test_shared_ptr();
+    test_local_shared_ptr();
+    test_list();
+    test_intrusive();
+    test_numeric();
+    test_uninitialized();
+    test_spsc_queue();
+    test_mpmc_queue();
+    test_epoch();
+    test_concurrent_hash_map();
+    test_basic_string();
+    test_string_view();
+    test_span();
+    test_priority_queue();
+    test_slot_map();
+    test_soa_vector();
+    test_bitset();
+    test_filters();
+    test_hash();
+    test_simd();
+
+    return g_failures==0? 0: 1;
 }
@@ -0,0 +1,288 @@
+#ifndef MYTINYSTL_NUMERIC_H_
+#define MYTINYSTL_NUMERIC_H_
+
+// 这个头文件包含数值算法 accumulate 和 reduce
+// accumulate 和默认的 reduce 按从左到右的顺序累加；连续的整数区间调用 simd.h 中的求和内核，
+// 整数加法满足结合律，结果与逐个相加相同
+// reduce 可以用 execution 中的策略选择求值方式：
+//   seq    与 accumulate 相同的顺序
+//   unseq  树形归约，允许任意结合顺序，浮点数区间调用向量化的树形求和内核，舍入结果与顺序累加不同
+//   par    把区间分成几段由多个线程分别做树形归约，再按顺序合并，要求 op 满足结合律
+
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "functional.h"
+#include "iterator.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl
+{
+
+namespace execution
+{
+
+struct sequenced_policy {};
+struct unsequenced_policy {};
+
+// threads 为 0 时使用 std::thread::hardware_concurrency() 个线程
+struct parallel_policy
+{
+    unsigned threads = 0;
+};
+
+constexpr sequenced_policy   seq{};
+constexpr unsequenced_policy unseq{};
+constexpr parallel_policy    par{};
+
+} // namespace execution
+
+// reduce 默认的二元操作：init + *first，两边的类型可以不同
+struct reduce_plus
+{
+    template <class T, class U>
+    constexpr auto operator()(T&& x, U&& y) const -> decltype(mystl::forward<T>(x) + mystl::forward<U>(y)){
+        return mystl::forward<T>(x) + mystl::forward<U>(y);
+    }
+};
+
+// 二元操作是否就是加法，是的话可以使用求和内核
+template <class Op, class T>
+struct is_plus_op
+    : std::integral_constant<bool, std::is_same<Op, reduce_plus>::value ||
+                                   std::is_same<Op, mystl::plus<T>>::value> {};
+
+// 可以由 sum_int 内核累加的元素类型和结果类型：都是不超过 64 位的整数（不含 bool）
+    // 整数的加法和类型转换都按 2^k 取模，先求出模 2^64 的和再转换为 T，与逐个相加后转换的结果相同
+template <class Tp, class T>
+struct is_int_sum
+    : std::integral_constant<bool,
+        std::is_integral<typename std::remove_const<Tp>::type>::value &&
+        !std::is_same<typename std::remove_const<Tp>::type, bool>::value &&
+        std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T)<=8> {};
+
+// 1.accumulate：以 init 为初值，从左到右用 binary_op（默认为 +）累加 [first, last)区间内的元素
+template <class InputIter, class T>
+constexpr T unchecked_accumulate(InputIter first, InputIter last, T init){
+    for(; first!=last; ++first){
+        init=init + *first;
+    }
+    return init;
+}
+
+template <class Tp, class T>
+constexpr typename std::enable_if<is_int_sum<Tp, T>::value, T>::type
+    unchecked_accumulate(Tp* first, Tp* last, T init) noexcept{
+    if(mystl::is_constant_evaluated()){
+        for(; first!=last; ++first){
+            init=static_cast<T>(init + *first);
+        }
+        return init;
+    }
+    const uint64_t sum=mystl::simd::sum_int(first, static_cast<size_t>(last-first));
+    return static_cast<T>(static_cast<uint64_t>(init)+sum);
+}
+
+template <class InputIter, class T>
+constexpr T accumulate(InputIter first, InputIter last, T init){
+    return unchecked_accumulate(first, last, init);
+}
+
+template <class InputIter, class T, class BinaryOp>
+constexpr T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op){
+    for(; first!=last; ++first){
+        init=binary_op(init, *first);
+    }
+    return init;
+}
+
+// 2.reduce：顺序版本，与 accumulate 的结果相同
+template <class InputIter, class T, class BinaryOp>
+constexpr T unchecked_reduce(InputIter first, InputIter last, T init, BinaryOp binary_op){
+    for(; first!=last; ++first){
+        init=binary_op(init, *first);
+    }
+    return init;
+}
+
+template <class Tp, class T, class BinaryOp>
+constexpr typename std::enable_if<is_int_sum<Tp, T>::value && is_plus_op<BinaryOp, T>::value, T>::type
+    unchecked_reduce(Tp* first, Tp* last, T init, BinaryOp) noexcept{
+    return unchecked_accumulate(first, last, init);
+}
+
+template <class InputIter, class T, class BinaryOp>
+constexpr T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op){
+    return unchecked_reduce(first, last, init, binary_op);
+}
+
+template <class InputIter, class T>
+constexpr T reduce(InputIter first, InputIter last, T init){
+    return unchecked_reduce(first, last, init, reduce_plus());
+}
+
+template <class InputIter>
+constexpr typename iterator_traits<InputIter>::value_type reduce(InputIter first, InputIter last){
+    return unchecked_reduce(first, last, typename iterator_traits<InputIter>::value_type(), reduce_plus());
+}
+
+template <class InputIter, class T, class BinaryOp>
+constexpr T reduce(execution::sequenced_policy, InputIter first, InputIter last, T init, BinaryOp binary_op){
+    return unchecked_reduce(first, last, init, binary_op);
+}
+
+// 3.树形归约：把区间对半拆分，两半分别归约后再合并，不超过 tree_reduce_block 个元素时顺序累加
+    // 只要求 binary_op 满足结合律；合并的深度是 log(n)，浮点数的舍入误差也按 log(n) 增长
+constexpr size_t tree_reduce_block=32;
+
+template <class RandomIter, class T, class BinaryOp>
+T tree_reduce(RandomIter first, size_t n, BinaryOp& binary_op){
+    // 要求 n>0
+    if(n<=tree_reduce_block){
+        T acc=*first;
+        for(size_t i=1; i<n; ++i){
+            acc=binary_op(acc, first[i]);
+        }
+        return acc;
+    }
+    const size_t half=n/2;
+    T left=tree_reduce<RandomIter, T>(first, half, binary_op);
+    return binary_op(left, tree_reduce<RandomIter, T>(first+half, n-half, binary_op));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T unchecked_reduce_unseq_cat(InputIter first, InputIter last, T init, BinaryOp binary_op, mystl::input_iterator_tag){
+    return unchecked_reduce(first, last, init, binary_op);
+}
+
+template <class RandomIter, class T, class BinaryOp>
+T unchecked_reduce_unseq_cat(RandomIter first, RandomIter last, T init, BinaryOp binary_op,
+    mystl::random_access_iterator_tag){
+    if(first==last){
+        return init;
+    }
+    return binary_op(init, tree_reduce<RandomIter, T>(first, static_cast<size_t>(last-first), binary_op));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T unchecked_reduce_unseq(InputIter first, InputIter last, T init, BinaryOp binary_op){
+    return unchecked_reduce_unseq_cat(first, last, init, binary_op, iterator_category(first));
+}
+
+// 整数求和：与顺序版本相同
+template <class Tp, class T, class BinaryOp>
+typename std::enable_if<is_int_sum<Tp, T>::value && is_plus_op<BinaryOp, T>::value, T>::type
+    unchecked_reduce_unseq(Tp* first, Tp* last, T init, BinaryOp) noexcept{
+    return unchecked_accumulate(first, last, init);
+}
+
+// 同类型的 float/double 求和：向量化的树形求和内核
+template <class Tp, class T, class BinaryOp>
+typename std::enable_if<
+    (std::is_same<T, float>::value || std::is_same<T, double>::value) &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value && is_plus_op<BinaryOp, T>::value, T>::type
+    unchecked_reduce_unseq(Tp* first, Tp* last, T init, BinaryOp) noexcept{
+    return init + mystl::simd::sum_tree(first, static_cast<size_t>(last-first));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T reduce(execution::unsequenced_policy, InputIter first, InputIter last, T init, BinaryOp binary_op){
+    return unchecked_reduce_unseq(first, last, init, binary_op);
+}
+
+// 4.并行归约：每个线程处理一段，段内用树形归约，最后按段的顺序合并
+    // 每个线程至少分到 parallel_reduce_grain 个元素，区间太短时不创建线程；
+    // binary_op 抛出的异常在所有线程结束后重新抛出，几段都抛出时只抛出最靠前一段的异常
+constexpr size_t parallel_reduce_grain=size_t(1)<<15;
+
+template <class InputIter, class T, class BinaryOp>
+T unchecked_reduce_par_cat(const execution::parallel_policy&, InputIter first, InputIter last, T init,
+    BinaryOp binary_op, mystl::input_iterator_tag){
+    return unchecked_reduce(first, last, init, binary_op);
+}
+
+template <class RandomIter, class T, class BinaryOp>
+T unchecked_reduce_par_cat(const execution::parallel_policy& policy, RandomIter first, RandomIter last, T init,
+    BinaryOp binary_op, mystl::random_access_iterator_tag){
+    const size_t n=static_cast<size_t>(last-first);
+    if(n<2*parallel_reduce_grain){
+        return unchecked_reduce_unseq(first, last, init, binary_op);
+    }
+    // hardware_concurrency 需要读取系统文件，只在区间足够长时调用
+    size_t threads=policy.threads!=0? policy.threads: std::thread::hardware_concurrency();
+    if(threads>n/parallel_reduce_grain){
+        threads=n/parallel_reduce_grain;
+    }
+    if(threads<=1){
+        return unchecked_reduce_unseq(first, last, init, binary_op);
+    }
+    // 每段的部分和以该段的第一个元素为初值，先在本线程中构造好，工作线程只给自己的元素赋值
+    std::vector<T> partials;
+    std::vector<std::exception_ptr> errors(threads);
+    partials.reserve(threads);
+    for(size_t i=0; i<threads; ++i){
+        partials.emplace_back(first[n*i/threads]);
+    }
+    auto work=[&](size_t i){
+        try{
+            const auto b=first+n*i/threads;
+            const auto e=first+n*(i+1)/threads;
+            partials[i]=unchecked_reduce_unseq(b+1, e, partials[i], binary_op);
+        }
+        catch(...){
+            errors[i]=std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads-1);
+    // 创建线程失败（std::system_error）时不再创建，没有分到线程的段由本线程依次计算，已启动的线程照常 join
+    size_t started=1;
+    try{
+        for(; started<threads; ++started){
+            workers.emplace_back(work, started);
+        }
+    }
+    catch(const std::system_error&){
+    }
+    work(0);
+    for(size_t i=started; i<threads; ++i){
+        work(i);
+    }
+    for(std::thread& t: workers){
+        t.join();
+    }
+    for(const std::exception_ptr& e: errors){
+        if(e){
+            std::rethrow_exception(e);
+        }
+    }
+    for(size_t i=0; i<threads; ++i){
+        init=binary_op(init, partials[i]);
+    }
+    return init;
+}
+
+template <class InputIter, class T, class BinaryOp>
+T reduce(const execution::parallel_policy& policy, InputIter first, InputIter last, T init, BinaryOp binary_op){
+    return unchecked_reduce_par_cat(policy, first, last, init, binary_op, iterator_category(first));
+}
+
+// 带策略但不带 op 或 init 的版本
+template <class Policy, class InputIter, class T>
+auto reduce(const Policy& policy, InputIter first, InputIter last, T init)
+    -> decltype(mystl::reduce(policy, first, last, init, reduce_plus())){
+    return mystl::reduce(policy, first, last, init, reduce_plus());
+}
+
+template <class Policy, class InputIter>
+auto reduce(const Policy& policy, InputIter first, InputIter last)
+    -> decltype(mystl::reduce(policy, first, last, typename iterator_traits<InputIter>::value_type(), reduce_plus())){
+    return mystl::reduce(policy, first, last, typename iterator_traits<InputIter>::value_type(), reduce_plus());
+}
+
+} // namespace mystl
+
+#endif
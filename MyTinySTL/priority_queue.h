@@ -0,0 +1,467 @@
+#ifndef MYTINYSTL_PRIORITY_QUEUE_H_
+#define MYTINYSTL_PRIORITY_QUEUE_H_
+
+// 这个头文件包含两个优先队列，都建立在 heap_algo.h 的 d 叉堆上，Arity 默认为 4
+// priority_queue：与 std::priority_queue 的语义相同，堆顶是 comp 意义下最大的元素
+    // 库中还没有 vector，元素放在自己管理的一段连续缓冲区中，容量不足时翻倍
+// indexed_priority_queue：可寻址的优先队列，元素由 [0, n) 中的编号标识，可以按编号修改键或删除，
+    // 用于 Dijkstra、A* 以及按截止时间调度等需要 decrease_key 的场合
+    // 堆中存放 {键, 编号}，另有一个数组记录每个编号在堆中的位置；两个数组在构造时按 n 一次分配
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// 模板参数 T 代表元素类型，Compare 代表比较方式，Arity 代表堆的叉数，Alloc 代表分配器类型
+template <class T, class Compare=mystl::less<T>, size_t Arity=4, class Alloc=mystl::allocator<T>>
+class priority_queue
+{
+public:
+    typedef Alloc       allocator_type;
+    typedef T           value_type;
+    typedef Compare     value_compare;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+
+    static constexpr size_t arity=Arity;
+
+    static_assert(Arity>=2, "priority_queue arity must be at least 2");
+
+private:
+    mystl::compressed_pair<allocator_type, T*> m_buffer;
+    size_type m_size;
+    size_type m_cap;
+    Compare m_comp;
+
+public:
+    // 构造、复制、移动、析构函数
+    priority_queue(): priority_queue(Compare()) {}
+
+    explicit priority_queue(const Compare& comp, const allocator_type& a=allocator_type())
+        : m_buffer(a, nullptr), m_size(0), m_cap(0), m_comp(comp) {}
+
+    // 先把 [first, last) 全部放入，再用 make_heap 一次建堆，O(n)
+    template <class Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type=0>
+    priority_queue(Iter first, Iter last, const Compare& comp=Compare(), const allocator_type& a=allocator_type())
+        : priority_queue(comp, a){
+        for(; first!=last; ++first){
+            emplace_back(*first);
+        }
+        dary_make_heap<Arity>(data(), data()+m_size, m_comp);
+    }
+
+    // 委托构造完成后析构函数才会生效，元素复制抛出异常时由它释放已分配的缓冲区
+    priority_queue(const priority_queue& rhs)
+        : priority_queue(rhs.m_comp, rhs.m_buffer.first()){
+        reserve(rhs.m_size);
+        mystl::uninitialized_copy(rhs.data(), rhs.data()+rhs.m_size, data());
+        m_size=rhs.m_size;
+    }
+
+    priority_queue(priority_queue&& rhs) noexcept
+        : m_buffer(mystl::move(rhs.m_buffer.first()), rhs.data()), m_size(rhs.m_size), m_cap(rhs.m_cap),
+          m_comp(mystl::move(rhs.m_comp)){
+        rhs.m_buffer.second()=nullptr;
+        rhs.m_size=rhs.m_cap=0;
+    }
+
+    priority_queue& operator=(const priority_queue& rhs){
+        if(this!=&rhs){
+            priority_queue tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    priority_queue& operator=(priority_queue&& rhs) noexcept{
+        if(this!=&rhs){
+            release();
+            m_buffer.first()=mystl::move(rhs.m_buffer.first());
+            m_buffer.second()=rhs.data();
+            m_size=rhs.m_size;
+            m_cap=rhs.m_cap;
+            m_comp=mystl::move(rhs.m_comp);
+            rhs.m_buffer.second()=nullptr;
+            rhs.m_size=rhs.m_cap=0;
+        }
+        return *this;
+    }
+
+    ~priority_queue() { release(); }
+
+public:
+    // 访问元素相关操作
+    const_reference top() const noexcept { MYSTL_DEBUG(!empty()); return data()[0]; }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return m_size==0; }
+    size_type size()     const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_cap; }
+
+    void reserve(size_type n){
+        if(n>m_cap){
+            reallocate(n);
+        }
+    }
+
+    allocator_type get_allocator() const { return m_buffer.first(); }
+    value_compare  value_comp()    const { return m_comp; }
+
+    // 修改容器相关操作
+    // emplace/push：在末尾构造后上浮
+    template <class... Args>
+    void emplace(Args&& ...args){
+        emplace_back(mystl::forward<Args>(args)...);
+        dary_push_heap<Arity>(data(), data()+m_size, m_comp);
+    }
+
+    void push(const value_type& value) { emplace(value); }
+    void push(value_type&& value) { emplace(mystl::move(value)); }
+
+    // pop：堆顶换到末尾后析构
+    void pop(){
+        MYSTL_DEBUG(!empty());
+        dary_pop_heap<Arity>(data(), data()+m_size, m_comp);
+        mystl::destroy(data()+ --m_size);
+    }
+
+    // replace_top：相当于 pop 之后 push，但只下沉一次；调度器取出任务、更新后放回时使用
+    void replace_top(value_type value){
+        MYSTL_DEBUG(!empty());
+        dary_adjust_heap<Arity>(data(), ptrdiff_t(0), static_cast<ptrdiff_t>(m_size), mystl::move(value), m_comp);
+    }
+
+    void clear() noexcept{
+        mystl::destroy(data(), data()+m_size);
+        m_size=0;
+    }
+
+    void swap(priority_queue& rhs) noexcept{
+        mystl::swap(m_buffer.first(), rhs.m_buffer.first());
+        mystl::swap(m_buffer.second(), rhs.m_buffer.second());
+        mystl::swap(m_size, rhs.m_size);
+        mystl::swap(m_cap, rhs.m_cap);
+        mystl::swap(m_comp, rhs.m_comp);
+    }
+
+private:
+    T* data() const noexcept { return m_buffer.second(); }
+
+    // 容量不足时先在新缓冲区的末尾构造新元素，参数引用的是队列中的元素时也不会失效
+    template <class... Args>
+    void emplace_back(Args&& ...args){
+        if(m_size<m_cap){
+            mystl::construct(data()+m_size, mystl::forward<Args>(args)...);
+            ++m_size;
+            return;
+        }
+        THROW_LENGTH_ERROR_IF(m_size>max_count()/2, "priority_queue<T>'s size too big");
+        const size_type cap=m_cap==0? 8: m_cap*2;
+        T* buf=m_buffer.first().allocate(cap);
+        try{
+            mystl::construct(buf+m_size, mystl::forward<Args>(args)...);
+        }
+        catch(...){
+            m_buffer.first().deallocate(buf, cap);
+            throw;
+        }
+        relocate_into(buf, cap, buf+m_size);
+        ++m_size;
+    }
+
+    void reallocate(size_type cap){
+        THROW_LENGTH_ERROR_IF(cap>max_count(), "priority_queue<T>'s size too big");
+        relocate_into(m_buffer.first().allocate(cap), cap, nullptr);
+    }
+
+    // 把已有元素搬到 buf，失败时原缓冲区不变（见 uninitialized_relocate）
+        // extra 是已经构造在 buf 中的新元素，搬移失败时一起析构
+    void relocate_into(T* buf, size_type cap, T* extra){
+        try{
+            mystl::uninitialized_relocate(data(), data()+m_size, buf);
+        }
+        catch(...){
+            if(extra!=nullptr){
+                mystl::destroy(extra);
+            }
+            m_buffer.first().deallocate(buf, cap);
+            throw;
+        }
+        m_buffer.first().deallocate(data(), m_cap);
+        m_buffer.second()=buf;
+        m_cap=cap;
+    }
+
+    void release() noexcept{
+        mystl::destroy(data(), data()+m_size);
+        m_buffer.first().deallocate(data(), m_cap);
+        m_buffer.second()=nullptr;
+    }
+
+    static constexpr size_type max_count() noexcept { return static_cast<size_type>(-1)/sizeof(T); }
+};
+
+// 重载 mystl 的 swap
+template <class T, class Compare, size_t Arity, class Alloc>
+void swap(priority_queue<T, Compare, Arity, Alloc>& lhs, priority_queue<T, Compare, Arity, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// indexed_priority_queue
+// 模板参数 Key 代表键的类型，Compare 默认为 greater，堆顶是键最小的编号（最短路径等场合的习惯）
+    // decrease_key 把编号移向堆顶：新键不能比原来的键离堆顶更远，即 comp(新键, 原键) 不能为真
+    // increase_key 相反；不确定方向时用 update
+/*****************************************************************************************/
+template <class Key, class Compare=mystl::greater<Key>, size_t Arity=4, class Alloc=mystl::allocator<Key>>
+class indexed_priority_queue
+{
+public:
+    typedef Alloc       allocator_type;
+    typedef Key         key_type;
+    typedef Compare     key_compare;
+    typedef size_t      size_type;
+
+    static constexpr size_t arity=Arity;
+    static constexpr size_type npos=static_cast<size_type>(-1);
+
+    static_assert(Arity>=2, "indexed_priority_queue arity must be at least 2");
+
+private:
+    // 键和编号放在一起，比较时不必再按编号间接访问
+    struct entry
+    {
+        Key key;
+        size_type id;
+    };
+
+    // 按键比较两个 entry，供 heap_algo.h 中选孩子的函数使用
+    struct entry_compare
+    {
+        Compare& comp;
+        bool operator()(const entry& a, const entry& b) const { return comp(a.key, b.key); }
+    };
+
+    typedef mystl::rebind_alloc<Alloc, entry>      entry_allocator;
+    typedef mystl::rebind_alloc<Alloc, size_type>  pos_allocator;
+
+    mystl::compressed_pair<entry_allocator, entry*> m_heap;
+    size_type* m_pos;           // 编号在堆中的下标，不在队列中时为 npos
+    size_type m_size;
+    size_type m_ids;
+    Compare m_comp;
+
+public:
+    // 编号的范围为 [0, id_count)
+    explicit indexed_priority_queue(size_type id_count, const Compare& comp=Compare(),
+        const allocator_type& a=allocator_type())
+        : m_heap(entry_allocator(a), nullptr), m_pos(nullptr), m_size(0), m_ids(id_count), m_comp(comp){
+        pos_allocator pa(m_heap.first());
+        m_pos=pa.allocate(id_count);
+        mystl::uninitialized_fill_n(m_pos, id_count, npos);
+        try{
+            m_heap.second()=m_heap.first().allocate(id_count);
+        }
+        catch(...){
+            pa.deallocate(m_pos, id_count);
+            throw;
+        }
+    }
+
+    indexed_priority_queue(const indexed_priority_queue&)=delete;
+    indexed_priority_queue& operator=(const indexed_priority_queue&)=delete;
+
+    indexed_priority_queue(indexed_priority_queue&& rhs) noexcept
+        : m_heap(mystl::move(rhs.m_heap.first()), rhs.m_heap.second()), m_pos(rhs.m_pos),
+          m_size(rhs.m_size), m_ids(rhs.m_ids), m_comp(mystl::move(rhs.m_comp)){
+        rhs.m_heap.second()=nullptr;
+        rhs.m_pos=nullptr;
+        rhs.m_size=rhs.m_ids=0;
+    }
+
+    indexed_priority_queue& operator=(indexed_priority_queue&& rhs) noexcept{
+        if(this!=&rhs){
+            indexed_priority_queue tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~indexed_priority_queue(){
+        mystl::destroy(heap(), heap()+m_size);
+        m_heap.first().deallocate(heap(), m_ids);
+        pos_allocator(m_heap.first()).deallocate(m_pos, m_ids);
+    }
+
+public:
+    // 容量相关操作
+    bool      empty()    const noexcept { return m_size==0; }
+    size_type size()     const noexcept { return m_size; }
+    size_type id_count() const noexcept { return m_ids; }
+
+    // 访问元素相关操作
+    size_type       top()     const noexcept { MYSTL_DEBUG(!empty()); return heap()[0].id; }
+    const key_type& top_key() const noexcept { MYSTL_DEBUG(!empty()); return heap()[0].key; }
+
+    bool contains(size_type id) const noexcept { MYSTL_DEBUG(id<m_ids); return m_pos[id]!=npos; }
+
+    const key_type& key(size_type id) const noexcept{
+        MYSTL_DEBUG(contains(id));
+        return heap()[m_pos[id]].key;
+    }
+
+    // 修改容器相关操作
+    // push：编号 id 必须不在队列中
+    void push(size_type id, key_type k){
+        MYSTL_DEBUG(id<m_ids && !contains(id));
+        mystl::construct(heap()+m_size, entry{mystl::move(k), id});
+        m_pos[id]=m_size;
+        sift_up(m_size++);
+    }
+
+    void pop(){
+        MYSTL_DEBUG(!empty());
+        remove_at(0);
+    }
+
+    // decrease_key：键变为 k，编号只会向堆顶移动
+    void decrease_key(size_type id, key_type k){
+        MYSTL_DEBUG(contains(id) && !m_comp(k, heap()[m_pos[id]].key));
+        const size_type i=m_pos[id];
+        heap()[i].key=mystl::move(k);
+        sift_up(i);
+    }
+
+    // increase_key：键变为 k，编号只会远离堆顶
+    void increase_key(size_type id, key_type k){
+        MYSTL_DEBUG(contains(id) && !m_comp(heap()[m_pos[id]].key, k));
+        const size_type i=m_pos[id];
+        heap()[i].key=mystl::move(k);
+        sift_down(i);
+    }
+
+    // update：不在队列中时插入，否则按新键的方向上浮或下沉
+    void update(size_type id, key_type k){
+        if(!contains(id)){
+            push(id, mystl::move(k));
+            return;
+        }
+        const size_type i=m_pos[id];
+        const bool up=m_comp(heap()[i].key, k);
+        heap()[i].key=mystl::move(k);
+        if(up){
+            sift_up(i);
+        }
+        else{
+            sift_down(i);
+        }
+    }
+
+    // erase：编号不在队列中时什么也不做，返回删除的个数
+    size_type erase(size_type id){
+        MYSTL_DEBUG(id<m_ids);
+        if(m_pos[id]==npos){
+            return 0;
+        }
+        remove_at(m_pos[id]);
+        return 1;
+    }
+
+    void clear() noexcept{
+        for(size_type i=0; i<m_size; ++i){
+            m_pos[heap()[i].id]=npos;
+        }
+        mystl::destroy(heap(), heap()+m_size);
+        m_size=0;
+    }
+
+    void swap(indexed_priority_queue& rhs) noexcept{
+        mystl::swap(m_heap.first(), rhs.m_heap.first());
+        mystl::swap(m_heap.second(), rhs.m_heap.second());
+        mystl::swap(m_pos, rhs.m_pos);
+        mystl::swap(m_size, rhs.m_size);
+        mystl::swap(m_ids, rhs.m_ids);
+        mystl::swap(m_comp, rhs.m_comp);
+    }
+
+private:
+    entry* heap() const noexcept { return m_heap.second(); }
+
+    // 与 heap_algo.h 相同的“空洞”做法，每次移动元素时同时更新它的位置
+    void place(size_type i, entry&& e) noexcept{
+        m_pos[e.id]=i;
+        heap()[i]=mystl::move(e);
+    }
+
+    void sift_up(size_type hole){
+        entry e=mystl::move(heap()[hole]);
+        while(hole>0){
+            const size_type parent=(hole-1)/Arity;
+            if(!m_comp(heap()[parent].key, e.key)){
+                break;
+            }
+            place(hole, mystl::move(heap()[parent]));
+            hole=parent;
+        }
+        place(hole, mystl::move(e));
+    }
+
+    void sift_down(size_type hole){
+        entry e=mystl::move(heap()[hole]);
+        for(;;){
+            const size_type child=Arity*hole+1;
+            if(child>=m_size){
+                break;
+            }
+            entry_compare comp{m_comp};
+            const size_type best=static_cast<size_type>(dary_best_child<Arity>(
+                heap(), static_cast<ptrdiff_t>(child), static_cast<ptrdiff_t>(m_size), comp));
+            if(!m_comp(e.key, heap()[best].key)){
+                break;
+            }
+            place(hole, mystl::move(heap()[best]));
+            hole=best;
+        }
+        place(hole, mystl::move(e));
+    }
+
+    // 用最后一个元素填补下标 i，再按它与原元素的大小关系上浮或下沉
+    void remove_at(size_type i){
+        m_pos[heap()[i].id]=npos;
+        const size_type last=--m_size;
+        if(i!=last){
+            const bool up=m_comp(heap()[i].key, heap()[last].key);
+            heap()[i]=mystl::move(heap()[last]);
+            m_pos[heap()[i].id]=i;
+            mystl::destroy(heap()+last);
+            if(up){
+                sift_up(i);
+            }
+            else{
+                sift_down(i);
+            }
+        }
+        else{
+            mystl::destroy(heap()+last);
+        }
+    }
+};
+
+template <class Key, class Compare, size_t Arity, class Alloc>
+void swap(indexed_priority_queue<Key, Compare, Arity, Alloc>& lhs,
+    indexed_priority_queue<Key, Compare, Arity, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef MYTINYSTL_RB_TREE_H_
+#define MYTINYSTL_RB_TREE_H_
+
+// 这个头文件包含红黑树的节点基类和平衡算法
+// 算法只操作 rb_tree_node_base 的指针和颜色，不涉及元素和内存分配
+// 有序容器和 intrusive.h 中的 intrusive_set 共用这些算法
+
+#include "util.h"
+
+namespace mystl
+{
+
+typedef bool rb_tree_color_type;
+
+static constexpr rb_tree_color_type rb_tree_red   = false;
+static constexpr rb_tree_color_type rb_tree_black = true;
+
+// rb_tree_node_base：红黑树节点基类
+    // 树使用一个头节点 header：header->parent 指向根，header->left 指向最小节点，header->right 指向最大节点
+    // header 为红色，以便在 decrement 中与根节点区分
+struct rb_tree_node_base
+{
+    rb_tree_node_base* parent;
+    rb_tree_node_base* left;
+    rb_tree_node_base* right;
+    rb_tree_color_type color;
+
+    rb_tree_node_base() noexcept: parent(nullptr), left(nullptr), right(nullptr), color(rb_tree_red) {}
+
+    // 拷贝节点不拷贝链接关系
+    rb_tree_node_base(const rb_tree_node_base&) noexcept
+        : parent(nullptr), left(nullptr), right(nullptr), color(rb_tree_red) {}
+    rb_tree_node_base& operator=(const rb_tree_node_base&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return parent!=nullptr; }
+};
+
+// 把 header 置为空树状态
+inline void rb_tree_reset_header(rb_tree_node_base* header) noexcept{
+    header->parent=nullptr;
+    header->left=header;
+    header->right=header;
+    header->color=rb_tree_red;
+}
+
+inline rb_tree_node_base* rb_tree_min(rb_tree_node_base* x) noexcept{
+    while(x->left!=nullptr){
+        x=x->left;
+    }
+    return x;
+}
+
+inline rb_tree_node_base* rb_tree_max(rb_tree_node_base* x) noexcept{
+    while(x->right!=nullptr){
+        x=x->right;
+    }
+    return x;
+}
+
+// 中序遍历的后继节点，最大节点的后继是 header
+inline rb_tree_node_base* rb_tree_increment(rb_tree_node_base* x) noexcept{
+    if(x->right!=nullptr){
+        return rb_tree_min(x->right);
+    }
+    rb_tree_node_base* y=x->parent;
+    while(x==y->right){
+        x=y;
+        y=y->parent;
+    }
+    // 只有根节点且没有右子树时，x 会走到 header，此时 x->right==y（根），结果应为 header
+    if(x->right!=y){
+        x=y;
+    }
+    return x;
+}
+
+// 中序遍历的前驱节点，header 的前驱是最大节点
+inline rb_tree_node_base* rb_tree_decrement(rb_tree_node_base* x) noexcept{
+    if(x->color==rb_tree_red && x->parent!=nullptr && x->parent->parent==x){
+        return x->right;  // x 是 header
+    }
+    if(x->left!=nullptr){
+        return rb_tree_max(x->left);
+    }
+    rb_tree_node_base* y=x->parent;
+    while(x==y->left){
+        x=y;
+        y=y->parent;
+    }
+    return y;
+}
+
+inline const rb_tree_node_base* rb_tree_increment(const rb_tree_node_base* x) noexcept{
+    return rb_tree_increment(const_cast<rb_tree_node_base*>(x));
+}
+
+inline const rb_tree_node_base* rb_tree_decrement(const rb_tree_node_base* x) noexcept{
+    return rb_tree_decrement(const_cast<rb_tree_node_base*>(x));
+}
+
+// 左旋，x 为旋转点
+inline void rb_tree_rotate_left(rb_tree_node_base* x, rb_tree_node_base*& root) noexcept{
+    rb_tree_node_base* y=x->right;
+    x->right=y->left;
+    if(y->left!=nullptr){
+        y->left->parent=x;
+    }
+    y->parent=x->parent;
+    if(x==root){
+        root=y;
+    }
+    else if(x==x->parent->left){
+        x->parent->left=y;
+    }
+    else{
+        x->parent->right=y;
+    }
+    y->left=x;
+    x->parent=y;
+}
+
+// 右旋，x 为旋转点
+inline void rb_tree_rotate_right(rb_tree_node_base* x, rb_tree_node_base*& root) noexcept{
+    rb_tree_node_base* y=x->left;
+    x->left=y->right;
+    if(y->right!=nullptr){
+        y->right->parent=x;
+    }
+    y->parent=x->parent;
+    if(x==root){
+        root=y;
+    }
+    else if(x==x->parent->right){
+        x->parent->right=y;
+    }
+    else{
+        x->parent->left=y;
+    }
+    y->right=x;
+    x->parent=y;
+}
+
+// 把 x 链接为 p 的左（insert_left 为 true）或右子节点，然后重新平衡
+    // 调用者负责找到插入位置 p；p==header 表示插入空树
+inline void rb_tree_insert_and_rebalance(bool insert_left, rb_tree_node_base* x,
+    rb_tree_node_base* p, rb_tree_node_base* header) noexcept{
+    rb_tree_node_base*& root=header->parent;
+
+    x->parent=p;
+    x->left=nullptr;
+    x->right=nullptr;
+    x->color=rb_tree_red;
+
+    if(insert_left){
+        p->left=x;  // p==header 时同时设置了最小节点
+        if(p==header){
+            header->parent=x;
+            header->right=x;
+        }
+        else if(p==header->left){
+            header->left=x;
+        }
+    }
+    else{
+        p->right=x;
+        if(p==header->right){
+            header->right=x;
+        }
+    }
+
+    // 父节点为红色时需要调整
+    while(x!=root && x->parent->color==rb_tree_red){
+        rb_tree_node_base* xpp=x->parent->parent;
+        if(x->parent==xpp->left){
+            rb_tree_node_base* uncle=xpp->right;
+            if(uncle!=nullptr && uncle->color==rb_tree_red){
+                // 叔叔为红：父、叔变黑，祖父变红，继续向上
+                x->parent->color=rb_tree_black;
+                uncle->color=rb_tree_black;
+                xpp->color=rb_tree_red;
+                x=xpp;
+            }
+            else{
+                // 叔叔为黑：旋转
+                if(x==x->parent->right){
+                    x=x->parent;
+                    rb_tree_rotate_left(x, root);
+                }
+                x->parent->color=rb_tree_black;
+                xpp->color=rb_tree_red;
+                rb_tree_rotate_right(xpp, root);
+            }
+        }
+        else{
+            rb_tree_node_base* uncle=xpp->left;
+            if(uncle!=nullptr && uncle->color==rb_tree_red){
+                x->parent->color=rb_tree_black;
+                uncle->color=rb_tree_black;
+                xpp->color=rb_tree_red;
+                x=xpp;
+            }
+            else{
+                if(x==x->parent->left){
+                    x=x->parent;
+                    rb_tree_rotate_right(x, root);
+                }
+                x->parent->color=rb_tree_black;
+                xpp->color=rb_tree_red;
+                rb_tree_rotate_left(xpp, root);
+            }
+        }
+    }
+    root->color=rb_tree_black;
+}
+
+// 从树中摘除 z 并重新平衡，返回 z，之后由调用者释放 z
+inline rb_tree_node_base* rb_tree_erase_and_rebalance(rb_tree_node_base* z,
+    rb_tree_node_base* header) noexcept{
+    rb_tree_node_base*& root=header->parent;
+    rb_tree_node_base*& leftmost=header->left;
+    rb_tree_node_base*& rightmost=header->right;
+
+    rb_tree_node_base* y=z;          // 实际从原位置摘下的节点
+    rb_tree_node_base* x=nullptr;    // 顶替 y 的节点
+    rb_tree_node_base* x_parent=nullptr;
+
+    if(y->left==nullptr){
+        x=y->right;
+    }
+    else if(y->right==nullptr){
+        x=y->left;
+    }
+    else{
+        // 有两个子节点：用后继 y 顶替 z
+        y=rb_tree_min(y->right);
+        x=y->right;
+    }
+
+    if(y!=z){
+        z->left->parent=y;
+        y->left=z->left;
+        if(y!=z->right){
+            x_parent=y->parent;
+            if(x!=nullptr){
+                x->parent=y->parent;
+            }
+            y->parent->left=x;
+            y->right=z->right;
+            z->right->parent=y;
+        }
+        else{
+            x_parent=y;
+        }
+        if(root==z){
+            root=y;
+        }
+        else if(z->parent->left==z){
+            z->parent->left=y;
+        }
+        else{
+            z->parent->right=y;
+        }
+        y->parent=z->parent;
+        mystl::swap(y->color, z->color);
+        y=z;  // y 现在指向被摘除的节点
+    }
+    else{
+        x_parent=y->parent;
+        if(x!=nullptr){
+            x->parent=y->parent;
+        }
+        if(root==z){
+            root=x;
+        }
+        else if(z->parent->left==z){
+            z->parent->left=x;
+        }
+        else{
+            z->parent->right=x;
+        }
+        if(leftmost==z){
+            leftmost= z->right==nullptr? z->parent: rb_tree_min(x);
+        }
+        if(rightmost==z){
+            rightmost= z->left==nullptr? z->parent: rb_tree_max(x);
+        }
+    }
+
+    // 摘除的是黑节点时，x 所在路径少了一个黑节点，需要调整
+    if(y->color!=rb_tree_red){
+        while(x!=root && (x==nullptr || x->color==rb_tree_black)){
+            if(x==x_parent->left){
+                rb_tree_node_base* w=x_parent->right;
+                if(w->color==rb_tree_red){
+                    w->color=rb_tree_black;
+                    x_parent->color=rb_tree_red;
+                    rb_tree_rotate_left(x_parent, root);
+                    w=x_parent->right;
+                }
+                if((w->left==nullptr || w->left->color==rb_tree_black) &&
+                   (w->right==nullptr || w->right->color==rb_tree_black)){
+                    w->color=rb_tree_red;
+                    x=x_parent;
+                    x_parent=x_parent->parent;
+                }
+                else{
+                    if(w->right==nullptr || w->right->color==rb_tree_black){
+                        w->left->color=rb_tree_black;
+                        w->color=rb_tree_red;
+                        rb_tree_rotate_right(w, root);
+                        w=x_parent->right;
+                    }
+                    w->color=x_parent->color;
+                    x_parent->color=rb_tree_black;
+                    if(w->right!=nullptr){
+                        w->right->color=rb_tree_black;
+                    }
+                    rb_tree_rotate_left(x_parent, root);
+                    break;
+                }
+            }
+            else{
+                rb_tree_node_base* w=x_parent->left;
+                if(w->color==rb_tree_red){
+                    w->color=rb_tree_black;
+                    x_parent->color=rb_tree_red;
+                    rb_tree_rotate_right(x_parent, root);
+                    w=x_parent->left;
+                }
+                if((w->right==nullptr || w->right->color==rb_tree_black) &&
+                   (w->left==nullptr || w->left->color==rb_tree_black)){
+                    w->color=rb_tree_red;
+                    x=x_parent;
+                    x_parent=x_parent->parent;
+                }
+                else{
+                    if(w->left==nullptr || w->left->color==rb_tree_black){
+                        w->right->color=rb_tree_black;
+                        w->color=rb_tree_red;
+                        rb_tree_rotate_left(w, root);
+                        w=x_parent->left;
+                    }
+                    w->color=x_parent->color;
+                    x_parent->color=rb_tree_black;
+                    if(w->left!=nullptr){
+                        w->left->color=rb_tree_black;
+                    }
+                    rb_tree_rotate_right(x_parent, root);
+                    break;
+                }
+            }
+        }
+        if(x!=nullptr){
+            x->color=rb_tree_black;
+        }
+    }
+    return y;
+}
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,467 @@
+#ifndef MYTINYSTL_SIMD_H_
+#define MYTINYSTL_SIMD_H_
+
+// 这个头文件包含向量化内核的运行时分派接口
+// 内核按指令集分别编译在 kernels/ 下的不同翻译单元中（SSE2、AVX2、AVX-512），
+// 第一次调用时根据 cpuid 选出当前 CPU 支持的最高级别，之后通过函数指针表调用
+// 环境变量 MYSTL_ISA=scalar|sse2|avx2|avx512 或 force_isa 可以指定级别，用于测试和基准对比
+//
+// 定义 MYSTL_HEADER_ONLY 时不使用编译好的内核库，所有接口退回到 memmove/memset 和逐字比较
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "functional.h"
+
+#ifndef MYSTL_HEADER_ONLY
+#include <atomic>
+#endif
+
+namespace mystl
+{
+namespace simd
+{
+
+// 指令集级别，数值越大越高
+enum class isa : int
+{
+    scalar = 0,
+    sse2   = 1,
+    avx2   = 2,
+    avx512 = 3,
+};
+
+// 归约内核按元素类型分别实现，函数表中以 arith_kind 为下标
+enum class arith_kind : int
+{
+    i8, u8, i16, u16, i32, u32, i64, u64, f32, f64,
+};
+constexpr int arith_kind_count=10;
+constexpr int int_kind_count=8;  // 前 8 种是整数
+
+// 位数组按字的运算，函数表中以 bit_op_kind 为下标；andnot 是 a&~b
+enum class bit_op_kind : int
+{
+    and_op, or_op, xor_op, andnot_op,
+};
+constexpr int bit_op_count=4;
+
+// 有归约内核的算术类型：除 bool 以外的整数，以及 float 和 double
+template <class T>
+struct is_reducible
+    : std::integral_constant<bool, (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+                                   std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+template <class T>
+struct arith_kind_of
+    : std::integral_constant<int, std::is_floating_point<T>::value
+        ? (sizeof(T)==4? static_cast<int>(arith_kind::f32): static_cast<int>(arith_kind::f64))
+        : (sizeof(T)==1? 0: sizeof(T)==2? 2: sizeof(T)==4? 4: 6) + (std::is_unsigned<T>::value? 1: 0)> {};
+
+// 内核函数表，每个指令集一张
+    // copy 到 search8 的内核只按位比较和搬运，元素类型的语义（如有符号比较）由 algorithm_base.h 处理；
+    // 归约内核按 arith_kind 区分元素类型
+struct kernel_table
+{
+    isa level;
+    // memmove 语义：区间可以重叠
+    void   (*copy_bytes)(void* dst, const void* src, size_t n) noexcept;
+    // 以 value 填充 count 个 1/2/4/8 字节的元素
+    void   (*fill8)(void* dst, uint8_t value, size_t count) noexcept;
+    void   (*fill16)(void* dst, uint16_t value, size_t count) noexcept;
+    void   (*fill32)(void* dst, uint32_t value, size_t count) noexcept;
+    void   (*fill64)(void* dst, uint64_t value, size_t count) noexcept;
+    // 返回第一个不同字节的下标，完全相同时返回 n
+    size_t (*mismatch_bytes)(const void* a, const void* b, size_t n) noexcept;
+    // 在 count 个 1/2/4/8 字节的元素中查找 value，返回第一个相等元素的下标，没有时返回 count
+    size_t (*find8)(const void* p, uint8_t value, size_t count) noexcept;
+    size_t (*find16)(const void* p, uint16_t value, size_t count) noexcept;
+    size_t (*find32)(const void* p, uint32_t value, size_t count) noexcept;
+    size_t (*find64)(const void* p, uint64_t value, size_t count) noexcept;
+    // 统计 count 个元素中等于 value 的个数
+    size_t (*count8)(const void* p, uint8_t value, size_t count) noexcept;
+    size_t (*count16)(const void* p, uint16_t value, size_t count) noexcept;
+    size_t (*count32)(const void* p, uint32_t value, size_t count) noexcept;
+    size_t (*count64)(const void* p, uint64_t value, size_t count) noexcept;
+    // 返回 [p, p+n) 中第一个属于字节集合 [set, set+m) 的字节的下标，没有时返回 n
+    size_t (*find_first_of8)(const void* p, size_t n, const void* set, size_t m) noexcept;
+    // 返回字节串 [needle, needle+m) 在 [p, p+n) 中第一次出现的下标，没有时返回 n，m 为 0 时返回 0
+    size_t (*search8)(const void* p, size_t n, const void* needle, size_t m) noexcept;
+    // 以下 n 都必须大于 0
+    // 第一个最小（最大）元素的下标，比较语义与逐个用 < 比较相同
+    size_t (*min_element[arith_kind_count])(const void* p, size_t n) noexcept;
+    size_t (*max_element[arith_kind_count])(const void* p, size_t n) noexcept;
+    // 第一个最小元素和最后一个最大元素的下标
+    void   (*minmax_element[arith_kind_count])(const void* p, size_t n, size_t* min_index, size_t* max_index) noexcept;
+    // 整数元素扩展到 64 位后的和，模 2^64
+    uint64_t (*sum_int[int_kind_count])(const void* p, size_t n) noexcept;
+    // 浮点数的树形求和，结果与逐个累加的舍入不同
+    float  (*sum_f32)(const void* p, size_t n) noexcept;
+    double (*sum_f64)(const void* p, size_t n) noexcept;
+    // 以下是位数组的内核，按 64 位字处理，n 可以为 0
+    // dst[i]=a[i] op b[i]，dst 可以与 a 或 b 是同一个数组
+    void   (*bit_op[bit_op_count])(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept;
+    // 所有字中 1 的个数
+    size_t (*popcount64)(const uint64_t* p, size_t n) noexcept;
+    // a[i]&b[i] 中 1 的个数，不写出按位与的结果
+    size_t (*and_popcount64)(const uint64_t* a, const uint64_t* b, size_t n) noexcept;
+    // 第一个非零字的下标，全为零时返回 n
+    size_t (*find_nonzero64)(const uint64_t* p, size_t n) noexcept;
+    // out[i]=hash_mix64(keys[i]^seed)，out 可以与 keys 是同一个数组
+    void   (*hash64)(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept;
+};
+
+// 当前 CPU（及操作系统）支持的最高级别
+isa detected_isa() noexcept;
+// 当前使用的级别
+isa active_isa() noexcept;
+// 指定使用的级别，高于 detected_isa() 或未编译进来时返回 false 且不做修改
+bool force_isa(isa level) noexcept;
+const char* isa_name(isa level) noexcept;
+// 按名字解析级别，如 "avx2"，失败时返回 false
+bool parse_isa(const char* name, isa& level) noexcept;
+
+#ifndef MYSTL_HEADER_ONLY
+
+namespace detail
+{
+// 初始指向一张解析表：第一次调用时检测 CPU，把指针换成选中的表后再转发
+extern std::atomic<const kernel_table*> active_kernels;
+} // namespace detail
+
+inline const kernel_table& kernels() noexcept{
+    return *detail::active_kernels.load(std::memory_order_relaxed);
+}
+
+inline void copy_bytes(void* dst, const void* src, size_t n) noexcept{
+    kernels().copy_bytes(dst, src, n);
+}
+
+inline void fill(uint8_t* dst, uint8_t value, size_t count) noexcept{
+    kernels().fill8(dst, value, count);
+}
+
+inline void fill(uint16_t* dst, uint16_t value, size_t count) noexcept{
+    kernels().fill16(dst, value, count);
+}
+
+inline void fill(uint32_t* dst, uint32_t value, size_t count) noexcept{
+    kernels().fill32(dst, value, count);
+}
+
+inline void fill(uint64_t* dst, uint64_t value, size_t count) noexcept{
+    kernels().fill64(dst, value, count);
+}
+
+inline size_t mismatch_bytes(const void* a, const void* b, size_t n) noexcept{
+    return kernels().mismatch_bytes(a, b, n);
+}
+
+inline size_t find(const uint8_t* p, uint8_t value, size_t count) noexcept{
+    return kernels().find8(p, value, count);
+}
+
+inline size_t find(const uint16_t* p, uint16_t value, size_t count) noexcept{
+    return kernels().find16(p, value, count);
+}
+
+inline size_t find(const uint32_t* p, uint32_t value, size_t count) noexcept{
+    return kernels().find32(p, value, count);
+}
+
+inline size_t find(const uint64_t* p, uint64_t value, size_t count) noexcept{
+    return kernels().find64(p, value, count);
+}
+
+inline size_t count(const uint8_t* p, uint8_t value, size_t count) noexcept{
+    return kernels().count8(p, value, count);
+}
+
+inline size_t count(const uint16_t* p, uint16_t value, size_t count) noexcept{
+    return kernels().count16(p, value, count);
+}
+
+inline size_t count(const uint32_t* p, uint32_t value, size_t count) noexcept{
+    return kernels().count32(p, value, count);
+}
+
+inline size_t count(const uint64_t* p, uint64_t value, size_t count) noexcept{
+    return kernels().count64(p, value, count);
+}
+
+inline size_t find_first_of_bytes(const void* p, size_t n, const void* set, size_t m) noexcept{
+    return kernels().find_first_of8(p, n, set, m);
+}
+
+inline size_t search_bytes(const void* p, size_t n, const void* needle, size_t m) noexcept{
+    return kernels().search8(p, n, needle, m);
+}
+
+template <class T>
+inline size_t min_element_n(const T* p, size_t n) noexcept{
+    return kernels().min_element[arith_kind_of<T>::value](p, n);
+}
+
+template <class T>
+inline size_t max_element_n(const T* p, size_t n) noexcept{
+    return kernels().max_element[arith_kind_of<T>::value](p, n);
+}
+
+template <class T>
+inline void minmax_element_n(const T* p, size_t n, size_t& min_index, size_t& max_index) noexcept{
+    kernels().minmax_element[arith_kind_of<T>::value](p, n, &min_index, &max_index);
+}
+
+template <class T>
+inline uint64_t sum_int(const T* p, size_t n) noexcept{
+    return kernels().sum_int[arith_kind_of<T>::value](p, n);
+}
+
+inline float sum_tree(const float* p, size_t n) noexcept{
+    return kernels().sum_f32(p, n);
+}
+
+inline double sum_tree(const double* p, size_t n) noexcept{
+    return kernels().sum_f64(p, n);
+}
+
+inline void bit_op(bit_op_kind op, uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    kernels().bit_op[static_cast<int>(op)](dst, a, b, n);
+}
+
+inline size_t popcount_words(const uint64_t* p, size_t n) noexcept{
+    return kernels().popcount64(p, n);
+}
+
+inline size_t and_popcount_words(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    return kernels().and_popcount64(a, b, n);
+}
+
+inline size_t find_nonzero_words(const uint64_t* p, size_t n) noexcept{
+    return kernels().find_nonzero64(p, n);
+}
+
+inline void hash_words(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept{
+    kernels().hash64(keys, n, seed, out);
+}
+
+#else // MYSTL_HEADER_ONLY
+
+inline void copy_bytes(void* dst, const void* src, size_t n) noexcept{
+    std::memmove(dst, src, n);
+}
+
+inline void fill(uint8_t* dst, uint8_t value, size_t count) noexcept{
+    std::memset(dst, value, count);
+}
+
+template <class T>
+inline void fill(T* dst, T value, size_t count) noexcept{
+    for(size_t i=0; i<count; ++i){
+        dst[i]=value;
+    }
+}
+
+inline size_t mismatch_bytes(const void* a, const void* b, size_t n) noexcept{
+    const unsigned char* p=static_cast<const unsigned char*>(a);
+    const unsigned char* q=static_cast<const unsigned char*>(b);
+    size_t i=0;
+    while(i<n && p[i]==q[i]){
+        ++i;
+    }
+    return i;
+}
+
+inline size_t find(const uint8_t* p, uint8_t value, size_t count) noexcept{
+    if(count==0){
+        return 0;
+    }
+    const void* q=std::memchr(p, value, count);
+    return q!=nullptr? static_cast<size_t>(static_cast<const uint8_t*>(q)-p): count;
+}
+
+template <class T>
+inline size_t find(const T* p, T value, size_t count) noexcept{
+    size_t i=0;
+    while(i<count && p[i]!=value){
+        ++i;
+    }
+    return i;
+}
+
+template <class T>
+inline size_t count(const T* p, T value, size_t count) noexcept{
+    size_t n=0;
+    for(size_t i=0; i<count; ++i){
+        n+=p[i]==value;
+    }
+    return n;
+}
+
+inline size_t find_first_of_bytes(const void* p, size_t n, const void* set, size_t m) noexcept{
+    const unsigned char* q=static_cast<const unsigned char*>(p);
+    for(size_t i=0; m>0 && i<n; ++i){
+        if(std::memchr(set, q[i], m)!=nullptr){
+            return i;
+        }
+    }
+    return n;
+}
+
+inline size_t search_bytes(const void* p, size_t n, const void* needle, size_t m) noexcept{
+    const unsigned char* q=static_cast<const unsigned char*>(p);
+    for(size_t i=0; i+m<=n; ++i){
+        if(std::memcmp(q+i, needle, m)==0){
+            return i;
+        }
+    }
+    return n;
+}
+
+template <class T>
+inline size_t min_element_n(const T* p, size_t n) noexcept{
+    size_t k=0;
+    for(size_t i=1; i<n; ++i){
+        if(p[i]<p[k]) k=i;
+    }
+    return k;
+}
+
+template <class T>
+inline size_t max_element_n(const T* p, size_t n) noexcept{
+    size_t k=0;
+    for(size_t i=1; i<n; ++i){
+        if(p[k]<p[i]) k=i;
+    }
+    return k;
+}
+
+template <class T>
+inline void minmax_element_n(const T* p, size_t n, size_t& min_index, size_t& max_index) noexcept{
+    min_index=max_index=0;
+    for(size_t i=1; i<n; ++i){
+        if(p[i]<p[min_index]) min_index=i;
+        if(!(p[i]<p[max_index])) max_index=i;
+    }
+}
+
+template <class T>
+inline uint64_t sum_int(const T* p, size_t n) noexcept{
+    uint64_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=static_cast<uint64_t>(p[i]);
+    }
+    return total;
+}
+
+template <class T>
+inline T sum_tree(const T* p, size_t n) noexcept{
+    if(n<=256){
+        T total=0;
+        for(size_t i=0; i<n; ++i){
+            total+=p[i];
+        }
+        return total;
+    }
+    return sum_tree(p, n/2)+sum_tree(p+n/2, n-n/2);
+}
+
+inline void bit_op(bit_op_kind op, uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    for(size_t i=0; i<n; ++i){
+        switch(op){
+        case bit_op_kind::and_op:    dst[i]=a[i]&b[i]; break;
+        case bit_op_kind::or_op:     dst[i]=a[i]|b[i]; break;
+        case bit_op_kind::xor_op:    dst[i]=a[i]^b[i]; break;
+        case bit_op_kind::andnot_op: dst[i]=a[i]&~b[i]; break;
+        }
+    }
+}
+
+// 一个字中 1 的个数：先求每 2、4、8 位中 1 的个数，再用乘法把 8 个字节加到最高字节
+inline size_t popcount_word(uint64_t x) noexcept{
+    x-=(x>>1)&0x5555555555555555ull;
+    x=(x&0x3333333333333333ull)+((x>>2)&0x3333333333333333ull);
+    x=(x+(x>>4))&0x0F0F0F0F0F0F0F0Full;
+    return static_cast<size_t>((x*0x0101010101010101ull)>>56);
+}
+
+inline size_t popcount_words(const uint64_t* p, size_t n) noexcept{
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=popcount_word(p[i]);
+    }
+    return total;
+}
+
+inline size_t and_popcount_words(const uint64_t* a, const uint64_t* b, size_t n) noexcept{
+    size_t total=0;
+    for(size_t i=0; i<n; ++i){
+        total+=popcount_word(a[i]&b[i]);
+    }
+    return total;
+}
+
+inline size_t find_nonzero_words(const uint64_t* p, size_t n) noexcept{
+    size_t i=0;
+    while(i<n && p[i]==0){
+        ++i;
+    }
+    return i;
+}
+
+inline void hash_words(const uint64_t* keys, size_t n, uint64_t seed, uint64_t* out) noexcept{
+    for(size_t i=0; i<n; ++i){
+        out[i]=hash_mix64(keys[i]^seed);
+    }
+}
+
+#endif // MYSTL_HEADER_ONLY
+
+// 可以按字节比较相等的类型：整数、指针和枚举（浮点数的 +0.0/-0.0 和 NaN 不满足）
+template <class T>
+struct is_bitwise_comparable
+    : std::integral_constant<bool, std::is_integral<T>::value || std::is_pointer<T>::value ||
+                                   std::is_enum<T>::value> {};
+
+// 与 T 同样大小的无符号整数，用来按位模式调用对应宽度的内核
+template <class T>
+struct bits_of
+{
+    using type = typename std::conditional<sizeof(T)==1, uint8_t,
+                 typename std::conditional<sizeof(T)==2, uint16_t,
+                 typename std::conditional<sizeof(T)==4, uint32_t, uint64_t>::type>::type>::type;
+    static_assert(sizeof(T)==sizeof(type), "only 1, 2, 4 or 8 byte elements are supported");
+
+    static type pattern(const T& value) noexcept{
+        type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+};
+
+// 按元素大小选择 fill 的内核；value 按位复制，所以任意可平凡复制的 1/2/4/8 字节类型都可以用
+template <class T>
+inline void fill_n(T* dst, const T& value, size_t count) noexcept{
+    using bits = typename bits_of<T>::type;
+    simd::fill(reinterpret_cast<bits*>(dst), bits_of<T>::pattern(value), count);
+}
+
+// 按元素大小选择 find/count 的内核；按位模式比较，只适用于 is_bitwise_comparable 的类型
+template <class T>
+inline size_t find_n(const T* p, const T& value, size_t count) noexcept{
+    using bits = typename bits_of<T>::type;
+    return simd::find(reinterpret_cast<const bits*>(p), bits_of<T>::pattern(value), count);
+}
+
+template <class T>
+inline size_t count_n(const T* p, const T& value, size_t count) noexcept{
+    using bits = typename bits_of<T>::type;
+    return simd::count(reinterpret_cast<const bits*>(p), bits_of<T>::pattern(value), count);
+}
+
+} // namespace simd
+} // namespace mystl
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef MYTINYSTL_SLOT_MAP_H_
+#define MYTINYSTL_SLOT_MAP_H_
+
+// 这个头文件包含模板类 slot_map：元素紧密地存放在一段连续缓冲区中，通过带代数（generation）的句柄访问
+    // insert 返回句柄 {槽位, 代数}，槽位数组把句柄映射到元素的下标，查找是两次数组访问，没有指针追逐
+    // erase 把最后一个元素移到空位（swap-and-pop），元素始终连续，遍历就是扫描数组
+    // 删除后槽位的代数加一并放入空闲链表，再次插入时 O(1) 复用；旧句柄的代数与槽位不再相等，查找时返回空，
+    // 不会访问到复用这个槽位的新元素
+    // 元素的地址在插入、删除后会改变，需要长期保存的是句柄而不是指针或迭代器
+// 元素、元素所属的槽位、槽位三个数组容量相同，一起按两倍扩容，元素用 uninitialized_relocate 搬移
+
+#include <cstdint>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// slot_map 的句柄：槽位的下标和代数，默认构造的句柄不指向任何元素
+struct slot_handle
+{
+    uint32_t index;
+    uint32_t generation;
+
+    constexpr slot_handle() noexcept: index(static_cast<uint32_t>(-1)), generation(0) {}
+    constexpr slot_handle(uint32_t i, uint32_t g) noexcept: index(i), generation(g) {}
+};
+
+constexpr bool operator==(const slot_handle& lhs, const slot_handle& rhs) noexcept{
+    return lhs.index==rhs.index && lhs.generation==rhs.generation;
+}
+
+constexpr bool operator!=(const slot_handle& lhs, const slot_handle& rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+// 模板参数 T 代表元素类型，Alloc 代表分配器类型
+template <class T, class Alloc=mystl::allocator<T>>
+class slot_map
+{
+public:
+    typedef Alloc                                    allocator_type;
+    typedef T                                        value_type;
+    typedef slot_handle                              handle_type;
+    typedef T*                                       pointer;
+    typedef const T*                                 const_pointer;
+    typedef T&                                       reference;
+    typedef const T&                                 const_reference;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+
+    typedef T*                                       iterator;
+    typedef const T*                                 const_iterator;
+    typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+private:
+    // 槽位：元素存活时 index 是元素在数组中的下标，空闲时是空闲链表中的下一个槽位
+    struct slot
+    {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    typedef mystl::rebind_alloc<Alloc, uint32_t>  owner_allocator;
+    typedef mystl::rebind_alloc<Alloc, slot>      slot_allocator;
+
+    // 一次分配的三个数组
+    struct buffers
+    {
+        T*        data;
+        uint32_t* owner;
+        slot*     slots;
+    };
+
+    static constexpr uint32_t npos=static_cast<uint32_t>(-1);
+
+    mystl::compressed_pair<allocator_type, T*> m_data;
+    uint32_t* m_owner;          // m_owner[i] 是第 i 个元素所属的槽位，删除时由它找到要修改的槽位
+    slot*     m_slots;
+    uint32_t  m_size;
+    uint32_t  m_cap;
+    uint32_t  m_slot_count;     // 用过的槽位个数，等于元素个数加上空闲槽位个数，不超过 m_cap
+    uint32_t  m_free;           // 空闲链表的头，没有空闲槽位时为 npos
+
+public:
+    // 构造、复制、移动、析构函数
+    slot_map() noexcept(noexcept(allocator_type())): slot_map(allocator_type()) {}
+
+    explicit slot_map(const allocator_type& a) noexcept
+        : m_data(a, nullptr), m_owner(nullptr), m_slots(nullptr),
+          m_size(0), m_cap(0), m_slot_count(0), m_free(npos) {}
+
+    // 复制后槽位和代数都相同，原来的句柄在副本中指向对应的元素
+    slot_map(const slot_map& rhs): slot_map(rhs.m_data.first()){
+        if(rhs.m_slot_count==0){
+            return;
+        }
+        const buffers b=allocate_buffers(rhs.m_slot_count);
+        try{
+            mystl::uninitialized_copy(rhs.data(), rhs.data()+rhs.m_size, b.data);
+        }
+        catch(...){
+            deallocate_buffers(b, rhs.m_slot_count);
+            throw;
+        }
+        mystl::uninitialized_copy(rhs.m_owner, rhs.m_owner+rhs.m_size, b.owner);
+        mystl::uninitialized_copy(rhs.m_slots, rhs.m_slots+rhs.m_slot_count, b.slots);
+        adopt(b, rhs.m_slot_count);
+        m_size=rhs.m_size;
+        m_slot_count=rhs.m_slot_count;
+        m_free=rhs.m_free;
+    }
+
+    slot_map(slot_map&& rhs) noexcept: slot_map(rhs.m_data.first()){
+        swap(rhs);
+    }
+
+    slot_map& operator=(const slot_map& rhs){
+        if(this!=&rhs){
+            slot_map tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    slot_map& operator=(slot_map&& rhs) noexcept{
+        if(this!=&rhs){
+            slot_map tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~slot_map(){
+        mystl::destroy(data(), data()+m_size);
+        deallocate_buffers(current(), m_cap);
+    }
+
+public:
+    // 迭代器相关操作：按元素在数组中的顺序，与插入顺序无关
+    iterator       begin()        noexcept { return data(); }
+    const_iterator begin()  const noexcept { return data(); }
+    iterator       end()          noexcept { return data()+m_size; }
+    const_iterator end()    const noexcept { return data()+m_size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    reverse_iterator       rbegin()       noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()         noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return m_size==0; }
+    size_type size()     const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_cap; }
+
+    // 下标和代数都是 32 位，npos 留作空闲链表的结尾
+    static constexpr size_type max_size() noexcept{
+        return static_cast<size_type>(-1)/sizeof(T)<npos-1? static_cast<size_type>(-1)/sizeof(T): npos-1;
+    }
+
+    void reserve(size_type n){
+        if(n>m_cap){
+            THROW_LENGTH_ERROR_IF(n>max_size(), "slot_map<T>'s size too big");
+            reallocate(static_cast<uint32_t>(n), nullptr);
+        }
+    }
+
+    allocator_type get_allocator() const { return m_data.first(); }
+
+    // 访问元素相关操作
+    pointer       data()       noexcept { return m_data.second(); }
+    const_pointer data() const noexcept { return m_data.second(); }
+
+    // find：句柄失效（元素已删除、槽位被复用）时返回 nullptr
+    pointer find(handle_type h) noexcept{
+        return const_cast<pointer>(static_cast<const slot_map*>(this)->find(h));
+    }
+
+    const_pointer find(handle_type h) const noexcept{
+        if(h.index>=m_slot_count || m_slots[h.index].generation!=h.generation){
+            return nullptr;
+        }
+        return data()+m_slots[h.index].index;
+    }
+
+    bool contains(handle_type h) const noexcept { return find(h)!=nullptr; }
+
+    // operator[] 要求句柄有效，at 在句柄失效时抛出 out_of_range
+    reference operator[](handle_type h) noexcept{
+        MYSTL_DEBUG(contains(h));
+        return data()[m_slots[h.index].index];
+    }
+
+    const_reference operator[](handle_type h) const noexcept{
+        MYSTL_DEBUG(contains(h));
+        return data()[m_slots[h.index].index];
+    }
+
+    reference at(handle_type h){
+        pointer p=find(h);
+        THROW_OUT_OF_RANGE_IF(p==nullptr, "slot_map<T>::at() handle is stale");
+        return *p;
+    }
+
+    const_reference at(handle_type h) const{
+        const_pointer p=find(h);
+        THROW_OUT_OF_RANGE_IF(p==nullptr, "slot_map<T>::at() handle is stale");
+        return *p;
+    }
+
+    // handle_of：遍历时取得元素的句柄
+    handle_type handle_of(const_iterator pos) const noexcept{
+        MYSTL_DEBUG(pos>=begin() && pos<end());
+        const uint32_t s=m_owner[pos-begin()];
+        return handle_type(s, m_slots[s].generation);
+    }
+
+    // 修改容器相关操作
+    // emplace/insert：在末尾构造，优先复用空闲槽位，返回新元素的句柄
+    template <class... Args>
+    handle_type emplace(Args&& ...args){
+        emplace_back(mystl::forward<Args>(args)...);
+        uint32_t s;
+        if(m_free!=npos){
+            s=m_free;
+            m_free=m_slots[s].index;
+        }
+        else{
+            s=m_slot_count++;
+            m_slots[s].generation=0;
+        }
+        m_slots[s].index=m_size;
+        m_owner[m_size]=s;
+        ++m_size;
+        return handle_type(s, m_slots[s].generation);
+    }
+
+    handle_type insert(const value_type& value) { return emplace(value); }
+    handle_type insert(value_type&& value) { return emplace(mystl::move(value)); }
+
+    // erase：句柄失效时什么也不做，返回删除的个数
+    size_type erase(handle_type h){
+        if(!contains(h)){
+            return 0;
+        }
+        remove_at(m_slots[h.index].index);
+        return 1;
+    }
+
+    // 按位置删除，最后一个元素移到 pos，返回 pos；遍历中删除时不要递增迭代器
+    iterator erase(const_iterator pos){
+        MYSTL_DEBUG(pos>=begin() && pos<end());
+        const uint32_t i=static_cast<uint32_t>(pos-begin());
+        remove_at(i);
+        return data()+i;
+    }
+
+    // clear：所有句柄失效，槽位全部进入空闲链表，容量不变
+    void clear() noexcept{
+        for(uint32_t i=0; i<m_size; ++i){
+            release_slot(m_owner[i]);
+        }
+        mystl::destroy(data(), data()+m_size);
+        m_size=0;
+    }
+
+    void swap(slot_map& rhs) noexcept{
+        mystl::swap(m_data.first(), rhs.m_data.first());
+        mystl::swap(m_data.second(), rhs.m_data.second());
+        mystl::swap(m_owner, rhs.m_owner);
+        mystl::swap(m_slots, rhs.m_slots);
+        mystl::swap(m_size, rhs.m_size);
+        mystl::swap(m_cap, rhs.m_cap);
+        mystl::swap(m_slot_count, rhs.m_slot_count);
+        mystl::swap(m_free, rhs.m_free);
+    }
+
+private:
+    buffers current() const noexcept { return buffers{m_data.second(), m_owner, m_slots}; }
+
+    // 代数加一使旧句柄失效，再放到空闲链表的头部
+    void release_slot(uint32_t s) noexcept{
+        ++m_slots[s].generation;
+        m_slots[s].index=m_free;
+        m_free=s;
+    }
+
+    // 最后一个元素移到下标 i，并让它的槽位指向新位置
+    void remove_at(uint32_t i){
+        const uint32_t s=m_owner[i];
+        const uint32_t last=m_size-1;
+        if(i!=last){
+            data()[i]=mystl::move(data()[last]);
+            m_owner[i]=m_owner[last];
+            m_slots[m_owner[i]].index=i;
+        }
+        mystl::destroy(data()+last);
+        --m_size;
+        release_slot(s);
+    }
+
+    // 容量不足时先在新缓冲区的末尾构造新元素，参数引用的是容器中的元素时也不会失效
+    template <class... Args>
+    void emplace_back(Args&& ...args){
+        if(m_size<m_cap){
+            mystl::construct(data()+m_size, mystl::forward<Args>(args)...);
+            return;
+        }
+        THROW_LENGTH_ERROR_IF(m_cap>max_size()/2, "slot_map<T>'s size too big");
+        const uint32_t cap=m_cap==0? 8: m_cap*2;
+        const buffers b=allocate_buffers(cap);
+        try{
+            mystl::construct(b.data+m_size, mystl::forward<Args>(args)...);
+        }
+        catch(...){
+            deallocate_buffers(b, cap);
+            throw;
+        }
+        relocate_into(b, cap, b.data+m_size);
+    }
+
+    void reallocate(uint32_t cap, T* extra){
+        relocate_into(allocate_buffers(cap), cap, extra);
+    }
+
+    // 把已有的元素和槽位搬到 b，失败时原缓冲区不变（见 uninitialized_relocate）
+        // extra 是已经构造在 b 中的新元素，搬移失败时一起析构
+    void relocate_into(const buffers& b, uint32_t cap, T* extra){
+        try{
+            mystl::uninitialized_relocate(data(), data()+m_size, b.data);
+        }
+        catch(...){
+            if(extra!=nullptr){
+                mystl::destroy(extra);
+            }
+            deallocate_buffers(b, cap);
+            throw;
+        }
+        mystl::uninitialized_copy(m_owner, m_owner+m_size, b.owner);
+        mystl::uninitialized_copy(m_slots, m_slots+m_slot_count, b.slots);
+        deallocate_buffers(current(), m_cap);
+        adopt(b, cap);
+    }
+
+    void adopt(const buffers& b, uint32_t cap) noexcept{
+        m_data.second()=b.data;
+        m_owner=b.owner;
+        m_slots=b.slots;
+        m_cap=cap;
+    }
+
+    buffers allocate_buffers(uint32_t cap){
+        buffers b{nullptr, nullptr, nullptr};
+        try{
+            b.data=m_data.first().allocate(cap);
+            b.owner=owner_allocator(m_data.first()).allocate(cap);
+            b.slots=slot_allocator(m_data.first()).allocate(cap);
+        }
+        catch(...){
+            deallocate_buffers(b, cap);
+            throw;
+        }
+        return b;
+    }
+
+    void deallocate_buffers(const buffers& b, uint32_t cap) noexcept{
+        if(b.data!=nullptr){
+            m_data.first().deallocate(b.data, cap);
+        }
+        if(b.owner!=nullptr){
+            owner_allocator(m_data.first()).deallocate(b.owner, cap);
+        }
+        if(b.slots!=nullptr){
+            slot_allocator(m_data.first()).deallocate(b.slots, cap);
+        }
+    }
+};
+
+// 重载 mystl 的 swap
+template <class T, class Alloc>
+void swap(slot_map<T, Alloc>& lhs, slot_map<T, Alloc>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,473 @@
+#ifndef MYTINYSTL_SOA_VECTOR_H_
+#define MYTINYSTL_SOA_VECTOR_H_
+
+// 这个头文件包含模板类 soa_vector：结构体数组（AoS）的“按列存放”版本（SoA）
+    // soa_vector<float, float, uint32_t> 中第 i 行是 (x[i], y[i], id[i])，每个成员各占一段连续的数组（列），
+    // 只读一个成员的循环只访问这一列，不会把同一条缓存行里其余的成员也读进来，
+    // 列是 T* 上的连续数组，column<I>() 得到的 span 可以直接交给向量化的算法（reduce、find、copy 等）
+// 所有列放在一次分配的内存中，每列的起点按 64 字节（缓存行、AVX-512 向量）对齐
+// 扩容时逐列搬移元素（移动不抛异常时移动，否则复制），某一列失败时已搬好的列被析构，原来的内容不变
+// 行的值类型是 std::tuple<Ts...>，引用是 std::tuple<Ts&...>，迭代器是同时指向各列的代理迭代器，
+    // 可以用 for(auto [x, y, id]: v) 遍历，也可以交给 mystl 中按迭代器类型分派的算法；
+    // mystl::swap、iter_swap、swap_range 逐列交换两行，std 的算法不认 mystl 的迭代器类型，不能直接使用
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "span.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// soa_iterator：按行移动的随机访问迭代器，解引用得到各列元素的引用组成的 tuple
+    // 模板参数 Ps 是各列的元素类型，const 迭代器的 Ps 带 const
+template <class... Ps>
+class soa_iterator
+{
+public:
+    typedef random_access_iterator_tag                              iterator_category;
+    typedef std::tuple<typename std::remove_const<Ps>::type...>     value_type;
+    typedef std::tuple<Ps&...>                                      reference;
+    typedef void                                                    pointer;
+    typedef ptrdiff_t                                               difference_type;
+
+    typedef std::tuple<Ps*...>                                      columns_type;
+
+private:
+    columns_type    m_cols;
+    difference_type m_index;
+
+public:
+    soa_iterator() noexcept: m_cols(), m_index(0) {}
+    soa_iterator(const columns_type& cols, difference_type i) noexcept: m_cols(cols), m_index(i) {}
+
+    // iterator 到 const_iterator 的转换
+    template <class... Qs, typename std::enable_if<
+        !std::is_same<std::tuple<Qs...>, std::tuple<Ps...>>::value &&
+        std::is_same<std::tuple<const Qs...>, std::tuple<Ps...>>::value, int>::type=0>
+    soa_iterator(const soa_iterator<Qs...>& rhs) noexcept: m_cols(rhs.columns()), m_index(rhs.index()) {}
+
+    reference operator*() const noexcept { return deref(m_index, std::index_sequence_for<Ps...>()); }
+    reference operator[](difference_type n) const noexcept { return deref(m_index+n, std::index_sequence_for<Ps...>()); }
+
+    // 当前行在第 I 列中的元素
+    template <size_t I>
+    typename std::tuple_element<I, reference>::type get() const noexcept { return std::get<I>(m_cols)[m_index]; }
+
+    const columns_type& columns() const noexcept { return m_cols; }
+    difference_type     index()   const noexcept { return m_index; }
+
+    soa_iterator& operator++() noexcept { ++m_index; return *this; }
+    soa_iterator& operator--() noexcept { --m_index; return *this; }
+    soa_iterator  operator++(int) noexcept { soa_iterator tmp(*this); ++m_index; return tmp; }
+    soa_iterator  operator--(int) noexcept { soa_iterator tmp(*this); --m_index; return tmp; }
+
+    soa_iterator& operator+=(difference_type n) noexcept { m_index+=n; return *this; }
+    soa_iterator& operator-=(difference_type n) noexcept { m_index-=n; return *this; }
+    soa_iterator  operator+(difference_type n) const noexcept { return soa_iterator(m_cols, m_index+n); }
+    soa_iterator  operator-(difference_type n) const noexcept { return soa_iterator(m_cols, m_index-n); }
+    friend soa_iterator operator+(difference_type n, const soa_iterator& it) noexcept { return it+n; }
+
+    // 比较只看行号，两个迭代器必须来自同一个容器
+    difference_type operator-(const soa_iterator& rhs) const noexcept { return m_index-rhs.m_index; }
+    bool operator==(const soa_iterator& rhs) const noexcept { return m_index==rhs.m_index; }
+    bool operator!=(const soa_iterator& rhs) const noexcept { return m_index!=rhs.m_index; }
+    bool operator<(const soa_iterator& rhs)  const noexcept { return m_index<rhs.m_index; }
+    bool operator>(const soa_iterator& rhs)  const noexcept { return m_index>rhs.m_index; }
+    bool operator<=(const soa_iterator& rhs) const noexcept { return m_index<=rhs.m_index; }
+    bool operator>=(const soa_iterator& rhs) const noexcept { return m_index>=rhs.m_index; }
+
+private:
+    template <size_t... I>
+    reference deref(difference_type i, std::index_sequence<I...>) const noexcept{
+        return reference(std::get<I>(m_cols)[i]...);
+    }
+};
+
+// 交换两行的各列元素：解引用得到的是 tuple 右值，mystl::swap 对它逐列交换（见 util.h）
+template <class... Ps>
+constexpr void iter_swap(soa_iterator<Ps...> lhs, soa_iterator<Ps...> rhs)
+    noexcept(noexcept(mystl::swap(*lhs, *rhs))){
+    mystl::swap(*lhs, *rhs);
+}
+
+// 分配的单位：64 字节对齐的块，rebind 后由分配器按对齐要求分配
+struct alignas(64) soa_block
+{
+    unsigned char bytes[64];
+};
+
+// 模板参数 Alloc 代表分配器类型（会被 rebind 到 soa_block），Ts 代表各列的元素类型
+template <class Alloc, class... Ts>
+class basic_soa_vector
+{
+    static_assert(sizeof...(Ts)>0 && sizeof...(Ts)<=64, "soa_vector needs 1 to 64 columns");
+
+public:
+    typedef Alloc                                    allocator_type;
+    typedef std::tuple<Ts...>                        value_type;
+    typedef std::tuple<Ts&...>                       reference;
+    typedef std::tuple<const Ts&...>                 const_reference;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+
+    typedef soa_iterator<Ts...>                      iterator;
+    typedef soa_iterator<const Ts...>                const_iterator;
+
+    static constexpr size_t column_count=sizeof...(Ts);
+    static constexpr size_t column_alignment=alignof(soa_block);
+
+    // 第 I 列的元素类型
+    template <size_t I>
+    using column_type=typename std::tuple_element<I, value_type>::type;
+
+private:
+    typedef mystl::rebind_alloc<Alloc, soa_block>   block_allocator;
+    typedef std::tuple<Ts*...>                      pointers;
+    typedef std::index_sequence_for<Ts...>          columns;
+
+    mystl::compressed_pair<block_allocator, soa_block*> m_raw;
+    pointers  m_cols;
+    size_type m_size;
+    size_type m_cap;
+
+public:
+    // 构造、复制、移动、析构函数
+    basic_soa_vector() noexcept(noexcept(allocator_type())): basic_soa_vector(allocator_type()) {}
+
+    explicit basic_soa_vector(const allocator_type& a) noexcept
+        : m_raw(block_allocator(a), nullptr), m_cols(), m_size(0), m_cap(0) {}
+
+    // n 行，每列值初始化
+    explicit basic_soa_vector(size_type n, const allocator_type& a=allocator_type()): basic_soa_vector(a){
+        resize(n);
+    }
+
+    basic_soa_vector(const basic_soa_vector& rhs): basic_soa_vector(allocator_type(rhs.m_raw.first())){
+        reserve(rhs.m_size);
+        copy_columns(rhs, columns());
+        m_size=rhs.m_size;
+    }
+
+    basic_soa_vector(basic_soa_vector&& rhs) noexcept: basic_soa_vector(allocator_type(rhs.m_raw.first())){
+        swap(rhs);
+    }
+
+    basic_soa_vector& operator=(const basic_soa_vector& rhs){
+        if(this!=&rhs){
+            basic_soa_vector tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    basic_soa_vector& operator=(basic_soa_vector&& rhs) noexcept{
+        if(this!=&rhs){
+            basic_soa_vector tmp(mystl::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~basic_soa_vector(){
+        destroy_rows(m_cols, 0, m_size, columns());
+        m_raw.first().deallocate(m_raw.second(), block_count(m_cap));
+    }
+
+public:
+    // 迭代器相关操作
+    iterator       begin()        noexcept { return iterator(m_cols, 0); }
+    const_iterator begin()  const noexcept { return const_iterator(const_columns(), 0); }
+    iterator       end()          noexcept { return iterator(m_cols, static_cast<difference_type>(m_size)); }
+    const_iterator end()    const noexcept { return const_iterator(const_columns(), static_cast<difference_type>(m_size)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return m_size==0; }
+    size_type size()     const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_cap; }
+
+    // 一行占用的字节数（不计对齐的填充）
+    static constexpr size_type row_bytes() noexcept { return sum_sizes(); }
+    static constexpr size_type max_size() noexcept { return static_cast<size_type>(-1)/2/row_bytes(); }
+
+    void reserve(size_type n){
+        if(n>m_cap){
+            THROW_LENGTH_ERROR_IF(n>max_size(), "soa_vector's size too big");
+            const buffer b=allocate_buffer(n);
+            relocate_into(b, n, false);
+        }
+    }
+
+    // resize：新增的行每列值初始化，多余的行析构
+    void resize(size_type n){
+        if(n<m_size){
+            destroy_rows(m_cols, n, m_size, columns());
+            m_size=n;
+            return;
+        }
+        reserve(n);
+        value_construct_rows(m_size, n, columns());
+        m_size=n;
+    }
+
+    allocator_type get_allocator() const { return allocator_type(m_raw.first()); }
+
+    // 访问元素相关操作
+    reference       operator[](size_type i)       noexcept { MYSTL_DEBUG(i<m_size); return begin()[i]; }
+    const_reference operator[](size_type i) const noexcept { MYSTL_DEBUG(i<m_size); return begin()[i]; }
+
+    reference at(size_type i){
+        THROW_OUT_OF_RANGE_IF(i>=m_size, "soa_vector<Ts...>::at() subscript out of range");
+        return begin()[i];
+    }
+
+    const_reference at(size_type i) const{
+        THROW_OUT_OF_RANGE_IF(i>=m_size, "soa_vector<Ts...>::at() subscript out of range");
+        return begin()[i];
+    }
+
+    reference       front()       noexcept { MYSTL_DEBUG(!empty()); return begin()[0]; }
+    const_reference front() const noexcept { MYSTL_DEBUG(!empty()); return begin()[0]; }
+    reference       back()        noexcept { MYSTL_DEBUG(!empty()); return begin()[m_size-1]; }
+    const_reference back()  const noexcept { MYSTL_DEBUG(!empty()); return begin()[m_size-1]; }
+
+    // 第 I 列：起点按 column_alignment 对齐
+    template <size_t I>
+    column_type<I>* data() noexcept { return std::get<I>(m_cols); }
+
+    template <size_t I>
+    const column_type<I>* data() const noexcept { return std::get<I>(m_cols); }
+
+    template <size_t I>
+    span<column_type<I>> column() noexcept { return span<column_type<I>>(data<I>(), m_size); }
+
+    template <size_t I>
+    span<const column_type<I>> column() const noexcept { return span<const column_type<I>>(data<I>(), m_size); }
+
+    // 修改容器相关操作
+    // emplace_back：每列一个参数，第 I 个参数用来构造第 I 列的元素
+    template <class... Us,
+        typename std::enable_if<sizeof...(Us)==sizeof...(Ts), int>::type=0>
+    void emplace_back(Us&& ...args){
+        if(m_size<m_cap){
+            construct_row(m_cols, m_size, columns(), mystl::forward<Us>(args)...);
+        }
+        else{
+            // 先在新缓冲区中构造新的一行，参数引用的是容器中的元素时也不会失效
+            THROW_LENGTH_ERROR_IF(m_cap>max_size()/2, "soa_vector's size too big");
+            const size_type cap=m_cap==0? 16: m_cap*2;
+            const buffer b=allocate_buffer(cap);
+            try{
+                construct_row(b.cols, m_size, columns(), mystl::forward<Us>(args)...);
+            }
+            catch(...){
+                m_raw.first().deallocate(b.raw, block_count(cap));
+                throw;
+            }
+            relocate_into(b, cap, true);
+        }
+        ++m_size;
+    }
+
+    void push_back(const value_type& row) { push_tuple(row, columns()); }
+    void push_back(value_type&& row) { push_tuple(mystl::move(row), columns()); }
+
+    void pop_back() noexcept{
+        MYSTL_DEBUG(!empty());
+        --m_size;
+        destroy_rows(m_cols, m_size, m_size+1, columns());
+    }
+
+    // erase：后面的行逐列前移一位，保持顺序，返回指向被删除行的下一行的迭代器
+    iterator erase(const_iterator pos){
+        MYSTL_DEBUG(pos>=begin() && pos<end());
+        const size_type i=static_cast<size_type>(pos.index());
+        shift_left(i, columns());
+        pop_back();
+        return begin()+static_cast<difference_type>(i);
+    }
+
+    void clear() noexcept{
+        destroy_rows(m_cols, 0, m_size, columns());
+        m_size=0;
+    }
+
+    void swap(basic_soa_vector& rhs) noexcept{
+        mystl::swap(m_raw.first(), rhs.m_raw.first());
+        mystl::swap(m_raw.second(), rhs.m_raw.second());
+        mystl::swap(m_cols, rhs.m_cols);
+        mystl::swap(m_size, rhs.m_size);
+        mystl::swap(m_cap, rhs.m_cap);
+    }
+
+private:
+    // 一次分配的内存和在其中划分出的各列
+    struct buffer
+    {
+        soa_block* raw;
+        pointers   cols;
+    };
+
+    static constexpr size_type sum_sizes() noexcept{
+        size_type n=0;
+        for(size_type s: {sizeof(Ts)...}){
+            n+=s;
+        }
+        return n;
+    }
+
+    static size_type align_up(size_type bytes) noexcept{
+        return (bytes+column_alignment-1)/column_alignment*column_alignment;
+    }
+
+    // cap 行需要的块数：每列占用的字节数向上对齐后相加
+    static size_type block_count(size_type cap) noexcept{
+        size_type bytes=0;
+        for(size_type s: {sizeof(Ts)...}){
+            bytes+=align_up(s*cap);
+        }
+        return bytes/column_alignment;
+    }
+
+    template <class T>
+    static T* carve(unsigned char* raw, size_type& offset, size_type cap) noexcept{
+        static_assert(alignof(T)<=alignof(soa_block), "soa_vector column is over-aligned");
+        T* col=reinterpret_cast<T*>(raw+offset);
+        offset+=align_up(sizeof(T)*cap);
+        return col;
+    }
+
+    buffer allocate_buffer(size_type cap){
+        soa_block* raw=m_raw.first().allocate(block_count(cap));
+        size_type offset=0;
+        // 花括号中的初始化按从左到右的顺序求值，各列依次排在 offset 之后
+        return buffer{raw, pointers{carve<Ts>(reinterpret_cast<unsigned char*>(raw), offset, cap)...}};
+    }
+
+    std::tuple<const Ts*...> const_columns() const noexcept { return std::tuple<const Ts*...>(m_cols); }
+
+    // 把已有的行逐列搬到 b，全部成功后才析构原来的元素并释放原缓冲区
+        // 移动构造不抛异常的列搬移后原列已被“掏空”，无法回退，所以先搬可能失败（复制）的列，这些列的原列不变；
+        // 某列失败时析构已经搬好的列（和已构造的新行），原缓冲区不变
+    void relocate_into(const buffer& b, size_type cap, bool extra_row){
+        uint64_t done=0;
+        try{
+            relocate_columns(b.cols, false, done, columns());
+            relocate_columns(b.cols, true, done, columns());
+        }
+        catch(...){
+            destroy_columns(b.cols, done, columns());
+            if(extra_row){
+                destroy_rows(b.cols, m_size, m_size+1, columns());
+            }
+            m_raw.first().deallocate(b.raw, block_count(cap));
+            throw;
+        }
+        destroy_rows(m_cols, 0, m_size, columns());
+        m_raw.first().deallocate(m_raw.second(), block_count(m_cap));
+        m_raw.second()=b.raw;
+        m_cols=b.cols;
+        m_cap=cap;
+    }
+
+    // 搬移移动构造是否不抛异常与 nothrow_pass 相同的列：unchecked_uninit_relocate 是 uninitialized_move
+        // 或 uninitialized_copy，只构造不析构；done 的第 I 位表示第 I 列已经搬好
+    template <size_t... I>
+    void relocate_columns(const pointers& to, bool nothrow_pass, uint64_t& done, std::index_sequence<I...>){
+        (void)std::initializer_list<int>{(
+            std::is_nothrow_move_constructible<Ts>::value==nothrow_pass?
+                (mystl::unchecked_uninit_relocate(std::get<I>(m_cols), std::get<I>(m_cols)+m_size, std::get<I>(to),
+                    is_relocate_by_move<Ts>{}), done|=uint64_t(1)<<I, 0): 0)...};
+    }
+
+    template <size_t... I>
+    void destroy_columns(const pointers& cols, uint64_t done, std::index_sequence<I...>) noexcept{
+        (void)std::initializer_list<int>{(
+            (done>>I&1)!=0? mystl::destroy(std::get<I>(cols), std::get<I>(cols)+m_size): void(), 0)...};
+    }
+
+    template <size_t... I>
+    void copy_columns(const basic_soa_vector& rhs, std::index_sequence<I...>){
+        size_type done=0;
+        try{
+            (void)std::initializer_list<int>{(
+                mystl::uninitialized_copy(std::get<I>(rhs.m_cols), std::get<I>(rhs.m_cols)+rhs.m_size,
+                    std::get<I>(m_cols)),
+                ++done, 0)...};
+        }
+        catch(...){
+            (void)std::initializer_list<int>{(
+                I<done? mystl::destroy(std::get<I>(m_cols), std::get<I>(m_cols)+rhs.m_size): void(), 0)...};
+            throw;
+        }
+    }
+
+    // 在第 i 行逐列构造，某列抛出异常时析构这一行已构造的列
+    template <size_t... I, class... Us>
+    static void construct_row(const pointers& cols, size_type i, std::index_sequence<I...>, Us&& ...args){
+        size_type done=0;
+        try{
+            (void)std::initializer_list<int>{(
+                mystl::construct(std::get<I>(cols)+i, mystl::forward<Us>(args)), ++done, 0)...};
+        }
+        catch(...){
+            (void)std::initializer_list<int>{(I<done? mystl::destroy(std::get<I>(cols)+i): void(), 0)...};
+            throw;
+        }
+    }
+
+    template <class Tuple, size_t... I>
+    void push_tuple(Tuple&& row, std::index_sequence<I...>){
+        emplace_back(std::get<I>(mystl::forward<Tuple>(row))...);
+    }
+
+    // 新增的行 [first, last) 逐列值初始化，某列失败时析构已初始化的列
+    template <size_t... I>
+    void value_construct_rows(size_type first, size_type last, std::index_sequence<I...>){
+        size_type done=0;
+        try{
+            (void)std::initializer_list<int>{(
+                mystl::uninitialized_value_construct(std::get<I>(m_cols)+first, std::get<I>(m_cols)+last),
+                ++done, 0)...};
+        }
+        catch(...){
+            (void)std::initializer_list<int>{(
+                I<done? mystl::destroy(std::get<I>(m_cols)+first, std::get<I>(m_cols)+last): void(), 0)...};
+            throw;
+        }
+    }
+
+    template <class Cols, size_t... I>
+    static void destroy_rows(const Cols& cols, size_type first, size_type last, std::index_sequence<I...>) noexcept{
+        (void)std::initializer_list<int>{(mystl::destroy(std::get<I>(cols)+first, std::get<I>(cols)+last), 0)...};
+    }
+
+    // 第 i 行之后的行逐列前移一位
+    template <size_t... I>
+    void shift_left(size_type i, std::index_sequence<I...>){
+        (void)std::initializer_list<int>{(
+            mystl::move(std::get<I>(m_cols)+i+1, std::get<I>(m_cols)+m_size, std::get<I>(m_cols)+i), 0)...};
+    }
+};
+
+// soa_vector：使用 mystl::allocator 的 SoA 容器
+template <class... Ts>
+using soa_vector=basic_soa_vector<mystl::allocator<soa_block>, Ts...>;
+
+// 重载 mystl 的 swap
+template <class Alloc, class... Ts>
+void swap(basic_soa_vector<Alloc, Ts...>& lhs, basic_soa_vector<Alloc, Ts...>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif
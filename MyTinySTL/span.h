@@ -0,0 +1,228 @@
+#ifndef MYTINYSTL_SPAN_H_
+#define MYTINYSTL_SPAN_H_
+
+// 这个头文件包含模板类 span：指向一段连续元素的视图，不拥有元素，复制只复制指针和长度
+// Extent 为编译期已知的长度时只保存指针，sizeof(span<T, N>)==sizeof(T*)；dynamic_extent 时再保存长度
+// 迭代器就是 T*，传给 copy、fill、equal 等算法时直接进入 algorithm_base.h 中针对指针的快速路径
+
+#include <cstddef>
+#include <utility>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+namespace mystl
+{
+
+constexpr size_t dynamic_extent=static_cast<size_t>(-1);
+
+template <class T, size_t Extent=dynamic_extent>
+class span;
+
+// span_storage：静态长度只存指针，长度是编译期常量
+template <class T, size_t Extent>
+struct span_storage
+{
+    T* data;
+
+    constexpr span_storage(T* p, size_t) noexcept: data(p) {}
+    static constexpr size_t size() noexcept { return Extent; }
+};
+
+template <class T>
+struct span_storage<T, dynamic_extent>
+{
+    T* data;
+    size_t count;
+
+    constexpr span_storage(T* p, size_t n) noexcept: data(p), count(n) {}
+    constexpr size_t size() const noexcept { return count; }
+};
+
+// 由 U* 到 T* 只增加 const/volatile 时才能转换，排除派生类到基类这种会改变元素大小的转换
+template <class U, class T>
+struct is_span_compatible: public m_bool_constant<std::is_convertible<U(*)[], T(*)[]>::value> {};
+
+// 提供 data() 和 size() 且元素类型兼容的容器
+template <class Container, class T, class=void>
+struct is_span_container: public m_false_type {};
+
+template <class Container, class T>
+struct is_span_container<Container, T, decltype(
+    (void)std::declval<Container&>().data(), (void)std::declval<Container&>().size())>
+    : public m_bool_constant<
+        !std::is_array<Container>::value &&
+        is_span_compatible<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type, T>::value> {};
+
+// 模板参数 T 代表元素类型，可以带 const；Extent 代表编译期长度
+template <class T, size_t Extent>
+class span
+{
+public:
+    typedef T                                        element_type;
+    typedef typename std::remove_cv<T>::type         value_type;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+    typedef T*                                       pointer;
+    typedef const T*                                 const_pointer;
+    typedef T&                                       reference;
+    typedef const T&                                 const_reference;
+
+    typedef T*                                       iterator;
+    typedef mystl::reverse_iterator<iterator>        reverse_iterator;
+
+    static constexpr size_type extent=Extent;
+
+private:
+    span_storage<T, Extent> m_storage;
+
+    // 子视图的编译期长度
+    template <size_t Offset, size_t Count>
+    struct subspan_extent: public m_integral_constant<size_t,
+        Count!=dynamic_extent? Count: Extent!=dynamic_extent? Extent-Offset: dynamic_extent> {};
+
+public:
+    // 构造函数：静态长度时，从指针和长度构造是 explicit 的，长度必须等于 Extent
+    template <size_t E=Extent,
+        typename std::enable_if<E==0 || E==dynamic_extent, int>::type=0>
+    constexpr span() noexcept: m_storage(nullptr, 0) {}
+
+    template <size_t E=Extent,
+        typename std::enable_if<E==dynamic_extent, int>::type=0>
+    constexpr span(pointer p, size_type n) noexcept: m_storage(p, n) {}
+
+    template <size_t E=Extent,
+        typename std::enable_if<E!=dynamic_extent, int>::type=0>
+    constexpr explicit span(pointer p, size_type n) noexcept: m_storage(p, n){
+        MYSTL_DEBUG(n==Extent);
+    }
+
+    // 首尾两个指针；写成模板，span(p, 0) 时不会与上面的构造函数产生歧义
+    template <class It, size_t E=Extent,
+        typename std::enable_if<std::is_same<It, pointer>::value && E==dynamic_extent, int>::type=0>
+    constexpr span(It first, It last) noexcept: m_storage(first, static_cast<size_type>(last-first)) {}
+
+    template <size_t N,
+        typename std::enable_if<Extent==dynamic_extent || Extent==N, int>::type=0>
+    constexpr span(element_type (&arr)[N]) noexcept: m_storage(arr, N) {}
+
+    // 从 vector、basic_string 等连续容器构造，只用于动态长度
+    template <class Container, size_t E=Extent,
+        typename std::enable_if<E==dynamic_extent && !std::is_same<typename std::remove_cv<Container>::type, span>::value &&
+            is_span_container<Container, T>::value, int>::type=0>
+    constexpr span(Container& c) noexcept: m_storage(c.data(), static_cast<size_type>(c.size())) {}
+
+    template <class Container, size_t E=Extent,
+        typename std::enable_if<E==dynamic_extent && std::is_const<T>::value &&
+            is_span_container<const Container, T>::value, int>::type=0>
+    constexpr span(const Container& c) noexcept: m_storage(c.data(), static_cast<size_type>(c.size())) {}
+
+    // span<U, N> 到 span<const U, N>、静态长度到动态长度可以隐式转换
+    template <class U, size_t N,
+        typename std::enable_if<(Extent==dynamic_extent || Extent==N) && is_span_compatible<U, T>::value, int>::type=0>
+    constexpr span(const span<U, N>& s) noexcept: m_storage(s.data(), s.size()) {}
+
+    // 动态长度到静态长度需要显式转换
+    template <class U, size_t E=Extent,
+        typename std::enable_if<E!=dynamic_extent && is_span_compatible<U, T>::value, int>::type=0>
+    constexpr explicit span(const span<U, dynamic_extent>& s) noexcept: m_storage(s.data(), s.size()){
+        MYSTL_DEBUG(s.size()==Extent);
+    }
+
+    constexpr span(const span&) noexcept=default;
+    span& operator=(const span&) noexcept=default;
+
+public:
+    // 迭代器相关操作
+    constexpr iterator begin() const noexcept { return data(); }
+    constexpr iterator end()   const noexcept { return data()+size(); }
+
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   const noexcept { return reverse_iterator(begin()); }
+
+    // 容量相关操作
+    constexpr size_type size()       const noexcept { return m_storage.size(); }
+    constexpr size_type size_bytes() const noexcept { return size()*sizeof(element_type); }
+    constexpr bool      empty()      const noexcept { return size()==0; }
+
+    // 访问元素相关操作
+    constexpr reference operator[](size_type n) const noexcept{
+        MYSTL_DEBUG(n<size());
+        return data()[n];
+    }
+
+    constexpr reference front() const noexcept { MYSTL_DEBUG(!empty()); return data()[0]; }
+    constexpr reference back()  const noexcept { MYSTL_DEBUG(!empty()); return data()[size()-1]; }
+    constexpr pointer   data()  const noexcept { return m_storage.data; }
+
+    // 子视图：长度写在模板参数中时得到静态长度的 span
+    template <size_t Count>
+    constexpr span<element_type, Count> first() const noexcept{
+        static_assert(Extent==dynamic_extent || Count<=Extent, "span::first<Count> out of range");
+        MYSTL_DEBUG(Count<=size());
+        return span<element_type, Count>(data(), Count);
+    }
+
+    template <size_t Count>
+    constexpr span<element_type, Count> last() const noexcept{
+        static_assert(Extent==dynamic_extent || Count<=Extent, "span::last<Count> out of range");
+        MYSTL_DEBUG(Count<=size());
+        return span<element_type, Count>(data()+size()-Count, Count);
+    }
+
+    template <size_t Offset, size_t Count=dynamic_extent>
+    constexpr span<element_type, subspan_extent<Offset, Count>::value> subspan() const noexcept{
+        static_assert(Extent==dynamic_extent || (Offset<=Extent && (Count==dynamic_extent || Count<=Extent-Offset)),
+            "span::subspan<Offset, Count> out of range");
+        MYSTL_DEBUG(Offset<=size() && (Count==dynamic_extent || Count<=size()-Offset));
+        return span<element_type, subspan_extent<Offset, Count>::value>(
+            data()+Offset, Count==dynamic_extent? size()-Offset: Count);
+    }
+
+    constexpr span<element_type> first(size_type n) const noexcept{
+        MYSTL_DEBUG(n<=size());
+        return span<element_type>(data(), n);
+    }
+
+    constexpr span<element_type> last(size_type n) const noexcept{
+        MYSTL_DEBUG(n<=size());
+        return span<element_type>(data()+size()-n, n);
+    }
+
+    constexpr span<element_type> subspan(size_type offset, size_type n=dynamic_extent) const noexcept{
+        MYSTL_DEBUG(offset<=size() && (n==dynamic_extent || n<=size()-offset));
+        return span<element_type>(data()+offset, n==dynamic_extent? size()-offset: n);
+    }
+};
+
+// 推导指引
+template <class T, size_t N>
+span(T (&)[N]) -> span<T, N>;
+
+template <class Container>
+span(Container&) -> span<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type>;
+
+template <class Container>
+span(const Container&) -> span<typename std::remove_pointer<decltype(std::declval<const Container&>().data())>::type>;
+
+template <class T>
+span(T*, size_t) -> span<T>;
+
+// 以字节查看同一段内存
+template <class T, size_t N>
+span<const std::byte, N==dynamic_extent? dynamic_extent: N*sizeof(T)> as_bytes(span<T, N> s) noexcept{
+    return span<const std::byte, N==dynamic_extent? dynamic_extent: N*sizeof(T)>(
+        reinterpret_cast<const std::byte*>(s.data()), s.size_bytes());
+}
+
+template <class T, size_t N,
+    typename std::enable_if<!std::is_const<T>::value, int>::type=0>
+span<std::byte, N==dynamic_extent? dynamic_extent: N*sizeof(T)> as_writable_bytes(span<T, N> s) noexcept{
+    return span<std::byte, N==dynamic_extent? dynamic_extent: N*sizeof(T)>(
+        reinterpret_cast<std::byte*>(s.data()), s.size_bytes());
+}
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef MYTINYSTL_SPSC_QUEUE_H_
+#define MYTINYSTL_SPSC_QUEUE_H_
+
+// 这个头文件包含一个模板类 spsc_queue：单生产者、单消费者的无锁有界队列（环形缓冲区）
+// 只允许一个线程调用 push 系列函数、另一个线程调用 pop 系列函数，两者都不会阻塞，队列满或空时返回 false/0
+// head 是消费者读的位置，tail 是生产者写的位置，两者只增不减，用容量减一做掩码得到槽位，容量总是 2 的幂
+// head 和 tail 各占一个缓存行；生产者缓存一份 head，只有看起来满的时候才重新读取，消费者对 tail 同理，
+// 所以稳定状态下每批元素只在两个线程之间传递一次缓存行
+
+#include <atomic>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl
+{
+
+template <class T, class Alloc=mystl::allocator<T>>
+class spsc_queue
+{
+public:
+    typedef Alloc       allocator_type;
+    typedef T           value_type;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+
+    static_assert(std::is_nothrow_destructible<T>::value, "spsc_queue requires nothrow destructible elements");
+
+private:
+    // 生产者写的数据
+    alignas(cache_line_size) std::atomic<size_type> m_tail;
+    size_type m_head_cache;     // 生产者看到的 head，可能落后于真实值
+    // 消费者写的数据
+    alignas(cache_line_size) std::atomic<size_type> m_head;
+    size_type m_tail_cache;     // 消费者看到的 tail
+    // 构造后只读的数据，分配器和缓冲区放在一起，无状态分配器不占空间
+    alignas(cache_line_size) mystl::compressed_pair<allocator_type, T*> m_storage;
+    size_type m_mask;
+
+public:
+    // 容量向上取整到 2 的幂，至少为 1
+    explicit spsc_queue(size_type capacity, const allocator_type& a=allocator_type())
+        : m_tail(0), m_head_cache(0), m_head(0), m_tail_cache(0),
+          m_storage(a, nullptr), m_mask(round_capacity(capacity)-1){
+        m_storage.second()=m_storage.first().allocate(m_mask+1);
+    }
+
+    spsc_queue(const spsc_queue&)=delete;
+    spsc_queue& operator=(const spsc_queue&)=delete;
+
+    ~spsc_queue(){
+        const size_type head=m_head.load(std::memory_order_relaxed);
+        const size_type tail=m_tail.load(std::memory_order_relaxed);
+        destroy_range(head, tail-head);
+        m_storage.first().deallocate(m_storage.second(), m_mask+1);
+    }
+
+public:
+    size_type capacity() const noexcept { return m_mask+1; }
+
+    // 两个线程都在运行时只是一个近似值
+    size_type size() const noexcept{
+        const size_type head=m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire)-head;
+    }
+
+    bool empty() const noexcept { return size()==0; }
+
+    allocator_type get_allocator() const { return m_storage.first(); }
+
+    // 生产者：在队尾构造一个元素，队列满时返回 false
+    template <class... Args>
+    bool try_emplace(Args&& ...args){
+        const size_type tail=m_tail.load(std::memory_order_relaxed);
+        if(tail-m_head_cache>m_mask){
+            m_head_cache=m_head.load(std::memory_order_acquire);
+            if(tail-m_head_cache>m_mask){
+                return false;
+            }
+        }
+        mystl::construct(buffer()+(tail&m_mask), mystl::forward<Args>(args)...);
+        m_tail.store(tail+1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value) { return try_emplace(mystl::move(value)); }
+
+    // 消费者：把队首元素移动到 value 中，队列空时返回 false
+    bool try_pop(value_type& value){
+        const size_type head=m_head.load(std::memory_order_relaxed);
+        if(head==m_tail_cache){
+            m_tail_cache=m_tail.load(std::memory_order_acquire);
+            if(head==m_tail_cache){
+                return false;
+            }
+        }
+        T* slot=buffer()+(head&m_mask);
+        value=mystl::move(*slot);
+        mystl::destroy(slot);
+        m_head.store(head+1, std::memory_order_release);
+        return true;
+    }
+
+    // 生产者：从 first 开始最多放入 n 个元素，返回放入的个数
+        // 空闲的槽位在环上最多分成两段，每段用 uninitialized_copy_n 构造，平凡类型就是一次 copy；
+        // 第二段构造时抛出异常，第一段由 uninit_guard 析构，队列不变
+    template <class ForwardIter>
+    size_type push_n(ForwardIter first, size_type n){
+        const size_type tail=m_tail.load(std::memory_order_relaxed);
+        if(capacity()-(tail-m_head_cache)<n){
+            m_head_cache=m_head.load(std::memory_order_acquire);
+        }
+        const size_type free=capacity()-(tail-m_head_cache);
+        const size_type count=n<free? n: free;
+        if(count==0){
+            return 0;
+        }
+        const size_type pos=tail&m_mask;
+        const size_type first_part=count<capacity()-pos? count: capacity()-pos;
+        T* cur=mystl::uninitialized_copy_n(first, first_part, buffer()+pos);
+        if(first_part<count){
+            uninit_guard<T*> guard(buffer()+pos, cur);
+            mystl::advance(first, first_part);
+            mystl::uninitialized_copy_n(first, count-first_part, buffer());
+            guard.release();
+        }
+        m_tail.store(tail+count, std::memory_order_release);
+        return count;
+    }
+
+    // 消费者：最多取出 n 个元素，依次移动赋值到 result 开始的位置，返回取出的个数
+        // 每段用 mystl::move 移出（平凡类型就是 memmove）后整段析构；赋值抛出异常时队列不变
+    template <class OutputIter>
+    size_type pop_n(OutputIter result, size_type n){
+        const size_type head=m_head.load(std::memory_order_relaxed);
+        if(m_tail_cache-head<n){
+            m_tail_cache=m_tail.load(std::memory_order_acquire);
+        }
+        const size_type ready=m_tail_cache-head;
+        const size_type count=n<ready? n: ready;
+        if(count==0){
+            return 0;
+        }
+        const size_type pos=head&m_mask;
+        const size_type first_part=count<capacity()-pos? count: capacity()-pos;
+        result=mystl::move(buffer()+pos, buffer()+pos+first_part, result);
+        mystl::move(buffer(), buffer()+(count-first_part), result);
+        destroy_range(head, count);
+        m_head.store(head+count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    T* buffer() const noexcept { return m_storage.second(); }
+
+    static size_type round_capacity(size_type n){
+        THROW_LENGTH_ERROR_IF(n>(size_type(-1)>>1)/sizeof(T), "spsc_queue<T>'s capacity too big");
+        size_type cap=1;
+        while(cap<n){
+            cap<<=1;
+        }
+        return cap;
+    }
+
+    // 析构从位置 from 开始的 n 个元素，最多分成两段
+    void destroy_range(size_type from, size_type n) noexcept{
+        const size_type pos=from&m_mask;
+        const size_type first_part=n<capacity()-pos? n: capacity()-pos;
+        mystl::destroy(buffer()+pos, buffer()+pos+first_part);
+        mystl::destroy(buffer(), buffer()+(n-first_part));
+    }
+};
+
+} // namespace mystl
+
+#endif
@@ -0,0 +1,620 @@
+#ifndef MYTINYSTL_STRING_VIEW_H_
+#define MYTINYSTL_STRING_VIEW_H_
+
+// 这个头文件包含 basic_string_view：指向一段连续字符的只读视图，不拥有也不复制字符
+// 迭代器就是 const CharT*，algorithm_base.h 中针对指针的内核快速路径（比较、查找）直接适用
+// basic_string 的查找和比较也委托给这里
+// 同时包含按分隔符切分的 split 和 tokenize，逐段返回视图，不分配内存
+
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+
+#include "algorithm_base.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl
+{
+
+// string_length：以空字符结尾的字符串的长度，char 调用 strlen
+template <class CharT>
+inline size_t string_length(const CharT* s) noexcept{
+    const CharT* p=s;
+    while(*p!=CharT()){
+        ++p;
+    }
+    return static_cast<size_t>(p-s);
+}
+
+inline size_t string_length(const char* s) noexcept { return std::strlen(s); }
+
+// 只用于在函数参数中阻止模板实参推导，使 basic_string 等能隐式转换为视图
+template <class T>
+struct type_identity
+{
+    typedef T type;
+};
+
+// 模板参数 CharT 代表字符类型
+template <class CharT>
+class basic_string_view
+{
+public:
+    typedef CharT                                    value_type;
+    typedef const CharT*                             pointer;
+    typedef const CharT*                             const_pointer;
+    typedef const CharT&                             reference;
+    typedef const CharT&                             const_reference;
+    typedef size_t                                   size_type;
+    typedef ptrdiff_t                                difference_type;
+
+    typedef const CharT*                             iterator;
+    typedef const CharT*                             const_iterator;
+    typedef mystl::reverse_iterator<const_iterator>  reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+    static constexpr size_type npos=static_cast<size_type>(-1);
+
+    static_assert(std::is_trivial<CharT>::value && std::is_standard_layout<CharT>::value,
+        "basic_string_view requires a trivial standard-layout character type");
+
+private:
+    const CharT* m_data;
+    size_type m_size;
+
+public:
+    // 构造函数，复制只复制指针和长度
+    constexpr basic_string_view() noexcept: m_data(nullptr), m_size(0) {}
+
+    constexpr basic_string_view(const CharT* s, size_type n) noexcept: m_data(s), m_size(n) {}
+
+    basic_string_view(const CharT* s) noexcept: m_data(s), m_size(string_length(s)) {}
+
+    constexpr basic_string_view(const basic_string_view&) noexcept=default;
+    basic_string_view& operator=(const basic_string_view&) noexcept=default;
+
+public:
+    // 迭代器相关操作
+    constexpr const_iterator begin()  const noexcept { return m_data; }
+    constexpr const_iterator end()    const noexcept { return m_data+m_size; }
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend()   const noexcept { return end(); }
+
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 容量相关操作
+    constexpr bool      empty()    const noexcept { return m_size==0; }
+    constexpr size_type size()     const noexcept { return m_size; }
+    constexpr size_type length()   const noexcept { return m_size; }
+    constexpr size_type max_size() const noexcept { return static_cast<size_type>(-1)/sizeof(CharT); }
+
+    // 访问元素相关操作
+    constexpr const_reference operator[](size_type n) const noexcept{
+        MYSTL_DEBUG(n<m_size);
+        return m_data[n];
+    }
+
+    const_reference at(size_type n) const{
+        THROW_OUT_OF_RANGE_IF(n>=m_size, "basic_string_view<CharT>::at() subscript out of range");
+        return m_data[n];
+    }
+
+    constexpr const_reference front() const noexcept { MYSTL_DEBUG(!empty()); return m_data[0]; }
+    constexpr const_reference back()  const noexcept { MYSTL_DEBUG(!empty()); return m_data[m_size-1]; }
+    constexpr const_pointer   data()  const noexcept { return m_data; }
+
+    // 修改视图本身，不修改字符
+    constexpr void remove_prefix(size_type n) noexcept{
+        MYSTL_DEBUG(n<=m_size);
+        m_data+=n;
+        m_size-=n;
+    }
+
+    constexpr void remove_suffix(size_type n) noexcept{
+        MYSTL_DEBUG(n<=m_size);
+        m_size-=n;
+    }
+
+    void swap(basic_string_view& rhs) noexcept{
+        mystl::swap(m_data, rhs.m_data);
+        mystl::swap(m_size, rhs.m_size);
+    }
+
+    // 子串和复制：substr 只调整指针和长度
+    size_type copy(CharT* dest, size_type n, size_type pos=0) const{
+        THROW_OUT_OF_RANGE_IF(pos>m_size, "basic_string_view<CharT>'s position out of range");
+        n=mystl::min(n, m_size-pos);
+        mystl::copy(m_data+pos, m_data+pos+n, dest);
+        return n;
+    }
+
+    basic_string_view substr(size_type pos=0, size_type n=npos) const{
+        THROW_OUT_OF_RANGE_IF(pos>m_size, "basic_string_view<CharT>'s position out of range");
+        return basic_string_view(m_data+pos, mystl::min(n, m_size-pos));
+    }
+
+    // compare：返回负数、0 或正数
+    int compare(basic_string_view v) const noexcept{
+        return compare_chars(m_data, m_size, v.m_data, v.m_size);
+    }
+
+    int compare(size_type pos, size_type n, basic_string_view v) const{
+        return substr(pos, n).compare(v);
+    }
+
+    int compare(const CharT* s) const noexcept { return compare(basic_string_view(s)); }
+
+    bool starts_with(basic_string_view v) const noexcept{
+        return v.m_size<=m_size && equal_chars(m_data, v.m_data, v.m_size);
+    }
+    bool starts_with(CharT ch) const noexcept { return !empty() && front()==ch; }
+    bool starts_with(const CharT* s) const noexcept { return starts_with(basic_string_view(s)); }
+
+    bool ends_with(basic_string_view v) const noexcept{
+        return v.m_size<=m_size && equal_chars(m_data+m_size-v.m_size, v.m_data, v.m_size);
+    }
+    bool ends_with(CharT ch) const noexcept { return !empty() && back()==ch; }
+    bool ends_with(const CharT* s) const noexcept { return ends_with(basic_string_view(s)); }
+
+    // 查找：找不到时返回 npos
+    // find：单个字符用 find 内核，子串用 search 内核
+    size_type find(CharT ch, size_type pos=0) const noexcept{
+        if(pos>=m_size){
+            return npos;
+        }
+        const CharT* r=mystl::find(m_data+pos, m_data+m_size, ch);
+        return r==m_data+m_size? npos: static_cast<size_type>(r-m_data);
+    }
+
+    size_type find(const CharT* s, size_type pos, size_type n) const noexcept{
+        if(pos>m_size || n>m_size-pos){
+            return npos;
+        }
+        if(n==0){
+            return pos;
+        }
+        const CharT* r=mystl::search(m_data+pos, m_data+m_size, s, s+n);
+        return r==m_data+m_size? npos: static_cast<size_type>(r-m_data);
+    }
+
+    size_type find(basic_string_view v, size_type pos=0) const noexcept { return find(v.m_data, pos, v.m_size); }
+    size_type find(const CharT* s, size_type pos=0) const noexcept { return find(s, pos, string_length(s)); }
+
+    bool contains(basic_string_view v) const noexcept { return find(v)!=npos; }
+    bool contains(CharT ch) const noexcept { return find(ch)!=npos; }
+    bool contains(const CharT* s) const noexcept { return find(s)!=npos; }
+
+    // rfind：从 pos（含）开始向前找最后一次出现的位置
+    size_type rfind(CharT ch, size_type pos=npos) const noexcept{
+        if(m_size==0){
+            return npos;
+        }
+        for(size_type i=mystl::min(pos, m_size-1)+1; i>0; --i){
+            if(m_data[i-1]==ch){
+                return i-1;
+            }
+        }
+        return npos;
+    }
+
+    size_type rfind(const CharT* s, size_type pos, size_type n) const noexcept{
+        if(n>m_size){
+            return npos;
+        }
+        for(size_type i=mystl::min(pos, m_size-n)+1; i>0; --i){
+            if(equal_chars(m_data+i-1, s, n)){
+                return i-1;
+            }
+        }
+        return npos;
+    }
+
+    size_type rfind(basic_string_view v, size_type pos=npos) const noexcept { return rfind(v.m_data, pos, v.m_size); }
+    size_type rfind(const CharT* s, size_type pos=npos) const noexcept { return rfind(s, pos, string_length(s)); }
+
+    // find_first_of：单字节字符用 find_first_of 内核
+    size_type find_first_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        if(pos>=m_size){
+            return npos;
+        }
+        const CharT* r=mystl::find_first_of(m_data+pos, m_data+m_size, s, s+n);
+        return r==m_data+m_size? npos: static_cast<size_type>(r-m_data);
+    }
+
+    size_type find_first_of(basic_string_view v, size_type pos=0) const noexcept{
+        return find_first_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_first_of(const CharT* s, size_type pos=0) const noexcept{
+        return find_first_of(s, pos, string_length(s));
+    }
+    size_type find_first_of(CharT ch, size_type pos=0) const noexcept { return find(ch, pos); }
+
+    size_type find_first_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        for(size_type i=pos; i<m_size; ++i){
+            if(mystl::find(s, s+n, m_data[i])==s+n){
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_first_not_of(basic_string_view v, size_type pos=0) const noexcept{
+        return find_first_not_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_first_not_of(const CharT* s, size_type pos=0) const noexcept{
+        return find_first_not_of(s, pos, string_length(s));
+    }
+    size_type find_first_not_of(CharT ch, size_type pos=0) const noexcept{
+        return find_first_not_of(&ch, pos, 1);
+    }
+
+    size_type find_last_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        if(m_size==0){
+            return npos;
+        }
+        for(size_type i=mystl::min(pos, m_size-1)+1; i>0; --i){
+            if(mystl::find(s, s+n, m_data[i-1])!=s+n){
+                return i-1;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_last_of(basic_string_view v, size_type pos=npos) const noexcept{
+        return find_last_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_last_of(const CharT* s, size_type pos=npos) const noexcept{
+        return find_last_of(s, pos, string_length(s));
+    }
+    size_type find_last_of(CharT ch, size_type pos=npos) const noexcept { return rfind(ch, pos); }
+
+    size_type find_last_not_of(const CharT* s, size_type pos, size_type n) const noexcept{
+        if(m_size==0){
+            return npos;
+        }
+        for(size_type i=mystl::min(pos, m_size-1)+1; i>0; --i){
+            if(mystl::find(s, s+n, m_data[i-1])==s+n){
+                return i-1;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_last_not_of(basic_string_view v, size_type pos=npos) const noexcept{
+        return find_last_not_of(v.m_data, pos, v.m_size);
+    }
+    size_type find_last_not_of(const CharT* s, size_type pos=npos) const noexcept{
+        return find_last_not_of(s, pos, string_length(s));
+    }
+    size_type find_last_not_of(CharT ch, size_type pos=npos) const noexcept{
+        return find_last_not_of(&ch, pos, 1);
+    }
+
+    // 按无符号字符比较：先用 mismatch 内核找到第一个不同的字符，再比较这一对字符
+    // 不超过 short_bytes 个字节的单字节字符串按 8 字节的字逐段比较，省去一次内核的间接调用
+    static int compare_chars(const CharT* a, size_type na, const CharT* b, size_type nb) noexcept{
+        typedef typename std::make_unsigned<CharT>::type uchar;
+        const size_type n=mystl::min(na, nb);
+        if(sizeof(CharT)==1 && n<=short_bytes){
+            const int r=short_compare(reinterpret_cast<const unsigned char*>(a),
+                                      reinterpret_cast<const unsigned char*>(b), n);
+            return r!=0? r: na<nb? -1: na>nb? 1: 0;
+        }
+        const auto mis=mystl::mismatch(a, a+n, b);
+        if(mis.first!=a+n){
+            return static_cast<uchar>(*mis.first)<static_cast<uchar>(*mis.second)? -1: 1;
+        }
+        return na<nb? -1: na>nb? 1: 0;
+    }
+
+    // 两段长度为 n 的字符是否相同，短字符串的处理同 compare_chars
+    static bool equal_chars(const CharT* a, const CharT* b, size_type n) noexcept{
+        if(n*sizeof(CharT)<=short_bytes){
+            return short_equal(reinterpret_cast<const unsigned char*>(a),
+                               reinterpret_cast<const unsigned char*>(b), n*sizeof(CharT));
+        }
+        return mystl::equal(a, a+n, b);
+    }
+
+private:
+    static constexpr size_type short_bytes=32;
+
+    static uint64_t load64(const unsigned char* p) noexcept { uint64_t v; std::memcpy(&v, p, 8); return v; }
+    static uint32_t load32(const unsigned char* p) noexcept { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+    // 首尾两组可以重叠的载入覆盖整段，没有分支依赖于内容
+    static bool short_equal(const unsigned char* a, const unsigned char* b, size_type n) noexcept{
+        if(n>=16){
+            return ((load64(a)^load64(b)) | (load64(a+8)^load64(b+8)) |
+                    (load64(a+n-16)^load64(b+n-16)) | (load64(a+n-8)^load64(b+n-8)))==0;
+        }
+        if(n>=8){
+            return ((load64(a)^load64(b)) | (load64(a+n-8)^load64(b+n-8)))==0;
+        }
+        if(n>=4){
+            return ((load32(a)^load32(b)) | (load32(a+n-4)^load32(b+n-4)))==0;
+        }
+        return n==0 || (a[0]==b[0] && a[n/2]==b[n/2] && a[n-1]==b[n-1]);
+    }
+
+    // 按大端序载入 8 个字节，整数的大小关系就是这 8 个无符号字节的字典序；编译器会把它识别为一次载入加字节反转
+    static uint64_t load64_be(const unsigned char* p) noexcept{
+        return uint64_t(p[0])<<56 | uint64_t(p[1])<<48 | uint64_t(p[2])<<40 | uint64_t(p[3])<<32 |
+               uint64_t(p[4])<<24 | uint64_t(p[5])<<16 | uint64_t(p[6])<<8 | uint64_t(p[7]);
+    }
+
+    // 每次比较 8 个字节，最后不足 8 个字节时退回到与前一段重叠的末尾 8 个字节
+    static int short_compare(const unsigned char* a, const unsigned char* b, size_type n) noexcept{
+        if(n<8){
+            for(size_type i=0; i<n; ++i){
+                if(a[i]!=b[i]){
+                    return a[i]<b[i]? -1: 1;
+                }
+            }
+            return 0;
+        }
+        for(size_type i=0; ; i+=8){
+            if(i+8>n){
+                i=n-8;
+            }
+            const uint64_t x=load64_be(a+i), y=load64_be(b+i);
+            if(x!=y){
+                return x<y? -1: 1;
+            }
+            if(i+8==n){
+                return 0;
+            }
+        }
+    }
+};
+
+// 重载比较操作符：另一侧的参数不参与推导，basic_string 和字符串字面量可以直接与视图比较
+template <class CharT>
+bool operator==(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept{
+    return lhs.size()==rhs.size() && basic_string_view<CharT>::equal_chars(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class CharT>
+bool operator==(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return lhs.size()==rhs.size() && basic_string_view<CharT>::equal_chars(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class CharT>
+bool operator==(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return lhs.size()==rhs.size() && basic_string_view<CharT>::equal_chars(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class CharT>
+bool operator!=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept { return !(lhs==rhs); }
+
+template <class CharT>
+bool operator!=(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+template <class CharT>
+bool operator!=(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return !(lhs==rhs);
+}
+
+template <class CharT>
+bool operator<(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept { return lhs.compare(rhs)<0; }
+
+template <class CharT>
+bool operator<(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return lhs.compare(rhs)<0;
+}
+
+template <class CharT>
+bool operator<(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return lhs.compare(rhs)<0;
+}
+
+template <class CharT>
+bool operator>(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept { return rhs<lhs; }
+
+template <class CharT>
+bool operator>(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return rhs<lhs;
+}
+
+template <class CharT>
+bool operator>(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return rhs<lhs;
+}
+
+template <class CharT>
+bool operator<=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept { return !(rhs<lhs); }
+
+template <class CharT>
+bool operator<=(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return !(rhs<lhs);
+}
+
+template <class CharT>
+bool operator<=(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return !(rhs<lhs);
+}
+
+template <class CharT>
+bool operator>=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept { return !(lhs<rhs); }
+
+template <class CharT>
+bool operator>=(basic_string_view<CharT> lhs, typename type_identity<basic_string_view<CharT>>::type rhs) noexcept{
+    return !(lhs<rhs);
+}
+
+template <class CharT>
+bool operator>=(typename type_identity<basic_string_view<CharT>>::type lhs, basic_string_view<CharT> rhs) noexcept{
+    return !(lhs<rhs);
+}
+
+// 重载 mystl 的 swap
+template <class CharT>
+void swap(basic_string_view<CharT>& lhs, basic_string_view<CharT>& rhs) noexcept{
+    lhs.swap(rhs);
+}
+
+// 输出到标准流，使用时需要包含 <ostream>
+template <class CharT, class Traits>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, basic_string_view<CharT> v){
+    return os.write(v.data(), static_cast<std::streamsize>(v.size()));
+}
+
+typedef basic_string_view<char>      string_view;
+typedef basic_string_view<wchar_t>   wstring_view;
+typedef basic_string_view<char16_t>  u16string_view;
+typedef basic_string_view<char32_t>  u32string_view;
+
+// split_range：切分一段字符得到的区间，迭代时才查找下一个分隔符，每一段都是指向原字符的视图
+    // split 按分隔串或单个分隔字符切分，相邻分隔符之间得到空视图，n 个分隔符得到 n+1 段；分隔串为空时整段作为一段
+    // tokenize 按分隔字符集合切分，跳过所有空段
+    // 区间和它产生的视图都不拥有字符，原字符串必须比它们活得久
+template <class CharT>
+class split_range
+{
+public:
+    typedef basic_string_view<CharT>  view_type;
+    typedef size_t                    size_type;
+
+    enum class mode { by_string, by_char, by_any_of };
+
+    class iterator
+    {
+    public:
+        typedef mystl::forward_iterator_tag  iterator_category;
+        typedef view_type                    value_type;
+        typedef ptrdiff_t                    difference_type;
+        typedef const view_type*             pointer;
+        typedef const view_type&             reference;
+
+    private:
+        const split_range* m_range=nullptr;
+        view_type m_piece;
+        bool m_done=true;
+
+    public:
+        iterator()=default;
+
+        iterator(const split_range* r): m_range(r), m_done(false){
+            next_from(0);
+        }
+
+        reference operator*()  const noexcept { return m_piece; }
+        pointer   operator->() const noexcept { return &m_piece; }
+
+        iterator& operator++(){
+            const view_type& text=m_range->m_text;
+            const size_type end=static_cast<size_type>(m_piece.data()+m_piece.size()-text.data());
+            if(end==text.size()){
+                m_done=true;
+            }
+            else{
+                next_from(end+m_range->delim_size());
+            }
+            return *this;
+        }
+
+        iterator operator++(int){
+            iterator tmp=*this;
+            ++*this;
+            return tmp;
+        }
+
+        // 结束迭代器只比较 m_done；同一区间中的两段由起始位置区分
+        bool operator==(const iterator& rhs) const noexcept{
+            return m_done==rhs.m_done && (m_done || m_piece.data()==rhs.m_piece.data());
+        }
+        bool operator!=(const iterator& rhs) const noexcept { return !(*this==rhs); }
+
+    private:
+        // 从 pos 开始取出下一段
+        void next_from(size_type pos){
+            const view_type& text=m_range->m_text;
+            size_type first=pos, last=view_type::npos;
+            switch(m_range->m_mode){
+            case mode::by_string:
+                if(!m_range->m_delim.empty()){
+                    last=text.find(m_range->m_delim, pos);
+                }
+                break;
+            case mode::by_char:
+                last=text.find(m_range->m_ch, pos);
+                break;
+            default:
+                first=text.find_first_not_of(m_range->m_delim, pos);
+                if(first==view_type::npos){
+                    m_done=true;
+                    return;
+                }
+                last=text.find_first_of(m_range->m_delim, first);
+                break;
+            }
+            m_piece=view_type(text.data()+first, mystl::min(last, text.size())-first);
+        }
+    };
+
+    typedef iterator const_iterator;
+
+private:
+    view_type m_text;
+    view_type m_delim;
+    mode m_mode;
+    CharT m_ch=CharT();
+
+public:
+    split_range(view_type text, view_type delim, mode m) noexcept
+        : m_text(text), m_delim(delim), m_mode(m) {}
+
+    split_range(view_type text, CharT ch) noexcept
+        : m_text(text), m_mode(mode::by_char), m_ch(ch) {}
+
+    iterator begin() const { return iterator(this); }
+    iterator end()   const { return iterator(); }
+
+private:
+    // 一段之后要跳过的分隔符长度；tokenize 在 next_from 中跳过所有分隔字符
+    size_type delim_size() const noexcept{
+        return m_mode==mode::by_string? m_delim.size(): m_mode==mode::by_char? 1: 0;
+    }
+};
+
+// split：按分隔串或单个分隔字符切分，text 可以是任何能转换为视图的字符串
+    // 单个分隔字符的版本限定为整数类型，传入视图作为分隔串时不会把视图推导为字符类型
+template <class CharT,
+    typename std::enable_if<std::is_integral<CharT>::value, int>::type=0>
+split_range<CharT> split(typename type_identity<basic_string_view<CharT>>::type text, CharT delim) noexcept{
+    return split_range<CharT>(text, delim);
+}
+
+template <class CharT>
+split_range<CharT> split(typename type_identity<basic_string_view<CharT>>::type text, const CharT* delim) noexcept{
+    return split_range<CharT>(text, delim, split_range<CharT>::mode::by_string);
+}
+
+template <class CharT>
+split_range<CharT> split(typename type_identity<basic_string_view<CharT>>::type text,
+    basic_string_view<CharT> delim) noexcept{
+    return split_range<CharT>(text, delim, split_range<CharT>::mode::by_string);
+}
+
+// tokenize：delims 中任一字符都是分隔符，只返回非空的段
+template <class CharT>
+split_range<CharT> tokenize(typename type_identity<basic_string_view<CharT>>::type text, const CharT* delims) noexcept{
+    return split_range<CharT>(text, delims, split_range<CharT>::mode::by_any_of);
+}
+
+template <class CharT>
+split_range<CharT> tokenize(typename type_identity<basic_string_view<CharT>>::type text,
+    basic_string_view<CharT> delims) noexcept{
+    return split_range<CharT>(text, delims, split_range<CharT>::mode::by_any_of);
+}
+
+} // namespace mystl
+
+#endif
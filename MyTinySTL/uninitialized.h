@@ -2,6 +2,9 @@
 #define MYTINYSTL_UNINITIALIZED_H_
 
 // 这个文件用于对为初始化空间构造元素
+// 平凡类型直接调用 copy/fill/move（连续内存上是 memmove/memset 或向量化内核）；
+// 非平凡类型逐个构造，由 uninit_guard 记录已构造的部分，构造抛出异常时整段析构后继续抛出，
+// 构造循环中不需要 try 块，也不需要额外的分支
 
 #include "algorithm_base.h"
 #include "construct.h"
@@ -12,34 +15,67 @@
 namespace mystl
 {
 
+// 0.uninit_guard：记录已构造的前缀 [first, cur)，析构时如果没有 release，用 mystl::destroy 整段析构
+    // cur 以引用保存，构造循环推进自己的迭代器即可；平凡析构的类型 destroy 是空操作，整个对象被优化掉
+template <class ForwardIter>
+class uninit_guard
+{
+public:
+    uninit_guard(ForwardIter first, ForwardIter& cur) noexcept
+        : m_first(first), m_cur(cur), m_released(false) {}
+
+    ~uninit_guard(){
+        if(!m_released){
+            mystl::destroy(m_first, m_cur);
+        }
+    }
+
+    uninit_guard(const uninit_guard&)=delete;
+    uninit_guard& operator=(const uninit_guard&)=delete;
+
+    // 全部构造成功后调用，已构造的元素交给调用者
+    void release() noexcept { m_released=true; }
+
+private:
+    ForwardIter  m_first;
+    ForwardIter& m_cur;
+    bool         m_released;
+};
+
+// 在未初始化的内存上用赋值代替构造的条件：构造和赋值都是平凡的
+template <class T>
+struct is_trivially_uninit_copy
+    : std::integral_constant<bool, std::is_trivially_copy_constructible<T>::value &&
+                                   std::is_trivially_copy_assignable<T>::value> {};
+
+template <class T>
+struct is_trivially_uninit_move
+    : std::integral_constant<bool, std::is_trivially_move_constructible<T>::value &&
+                                   std::is_trivially_move_assignable<T>::value> {};
+
 // 1.uninitialized_copy把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
-// 迭代器为可平凡拷贝赋值时，调用copy函数
+// 元素可以平凡拷贝时，调用copy函数
 template <class InputIter, class ForwardIter>
 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::true_type){
     return mystl::copy(first,last,result);
 }
 
-// 迭代器不能平凡拷贝赋值时，挨个进行深拷贝
+// 不能平凡拷贝时，挨个进行深拷贝
 template <class InputIter, class ForwardIter>
 ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::false_type){
     auto cur=result;
-    try{
-        for(;first!=last; ++first, ++cur){
-            mystl::construct(&*cur, *first);
-        }
-    }
-    catch(...){ //发生异常时的回滚过程，遍历从已构造位置 cur 到初始位置 result，对已构造的对象执行析构操作
-        for(;result!=cur; --cur){
-            mystl::destroy(&*cur);
-        }
+    uninit_guard<ForwardIter> guard(result, cur);
+    for(;first!=last; ++first, ++cur){
+        mystl::construct(&*cur, *first);
     }
+    guard.release();
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter unintialized_copy(InputIter first, InputIter last, ForwardIter result){
+ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result){
     return mystl::unchecked_uninit_copy(first,last,result,
-        std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
+        is_trivially_uninit_copy<typename iterator_traits<ForwardIter>::value_type>{});
     // {}创建一个类型为 bool 的临时对象，传递给unchecked_uninit_copy模板函数
 }
 
@@ -53,22 +89,18 @@ ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result,
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result, std::false_type){
     auto cur=result;
-    try{
-        for(; n>0; --n,++cur,++first){
-            mystl::construct(&*cur, *first);
-        }
-    }
-    catch(...){
-        for(; result!=cur; --cur){
-            mystl::destroy(&*cur);
-        }
+    uninit_guard<ForwardIter> guard(result, cur);
+    for(; n>0; --n,++cur,++first){
+        mystl::construct(&*cur, *first);
     }
+    guard.release();
+    return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result){
-    return mystl::unchecked_uninit_copy_n(first, n, result, 
-        std::is_trivially_copy_assignable<typename iterator_traits<InputIter>::value_type{});
+    return mystl::unchecked_uninit_copy_n(first, n, result,
+        is_trivially_uninit_copy<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 // 3.uninitialized_fill：在 [first, last) 区间内填充元素值
@@ -80,22 +112,17 @@ void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value,
 template <class ForwardIter, class T>
 void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value, std::false_type){
     auto cur=first;
-    try(
-        for(; cur!=last; ++cur){
-            mystl::construct(&*cur,value);
-        }
-    )
-    catch(...){
-        for(; first!=cur;++first){
-            mystl::destroy(&*fisrt);
-        }
+    uninit_guard<ForwardIter> guard(first, cur);
+    for(; cur!=last; ++cur){
+        mystl::construct(&*cur,value);
     }
+    guard.release();
 }
 
 template <class ForwardIter, class T>
 void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value){
     mystl::unchecked_uninit_fill(first,last,value,
-        std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type{});
+        is_trivially_uninit_copy<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 // 4.uninitialized_fill_n：从 first 位置开始，填充 n 个元素值，返回填充结束的位置
@@ -107,22 +134,18 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, s
 template <class ForwardIter, class Size, class T>
 ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::false_type){
     auto cur = first;
-    try{
-        for (; n > 0; --n, ++cur){
+    uninit_guard<ForwardIter> guard(first, cur);
+    for (; n > 0; --n, ++cur){
         mystl::construct(&*cur, value);
-        }
-    }
-    catch (...){
-        for (; first != cur; ++first)
-        mystl::destroy(&*first);
     }
+    guard.release();
     return cur;
 }
 
 template <class ForwardIter, class Size, class T>
 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value){
-    return mystl::unchecked_uninit_fill_n(first, n, value, 
-        std::is_trivially_copy_assignable<typename iterator_traits<ForwardIter>::value_type>{});
+    return mystl::unchecked_uninit_fill_n(first, n, value,
+        is_trivially_uninit_copy<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 // 5.uninitialized_move：把[first, last)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
@@ -131,55 +154,186 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last, ForwardIter r
     return mystl::move(first, last, result);
 }
 
-template <class InputIter, class ForwardIter> 
+template <class InputIter, class ForwardIter>
 ForwardIter unchecked_uninit_move(InputIter first, InputIter last, ForwardIter result, std::false_type){
     ForwardIter cur = result;
-    try{
-        for (; first != last; ++first, ++cur){
+    uninit_guard<ForwardIter> guard(result, cur);
+    for (; first != last; ++first, ++cur){
         mystl::construct(&*cur, mystl::move(*first));
-        }
-    }
-    catch (...){
-        mystl::destroy(result, cur);
     }
+    guard.release();
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result){
     return mystl::unchecked_uninit_move(first, last, result,
-        std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value_type>{});
+        is_trivially_uninit_move<typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 
 // 6.uninitialized_move_n：把[first, first + n)上的内容移动到以 result 为起始处的空间，返回移动结束的位置
+    // 平凡类型：随机访问迭代器转为 move（连续内存上是 memmove），其余迭代器逐个赋值
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter unchecked_uninit_move_n_cat(InputIter first, Size n, ForwardIter result, mystl::input_iterator_tag){
+    for (; n > 0; --n, ++first, ++result){
+        *result = mystl::move(*first);
+    }
+    return result;
+}
+
+template <class RandomIter, class Size, class ForwardIter>
+ForwardIter unchecked_uninit_move_n_cat(RandomIter first, Size n, ForwardIter result, mystl::random_access_iterator_tag){
+    return n > 0 ? mystl::move(first, first + n, result) : result;
+}
+
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::true_type){
-    return mystl::move(first, first + n, result);
+    return mystl::unchecked_uninit_move_n_cat(first, n, result, iterator_category(first));
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result, std::false_type){
     auto cur = result;
-    try{
-        for (; n > 0; --n, ++first, ++cur){
+    uninit_guard<ForwardIter> guard(result, cur);
+    for (; n > 0; --n, ++first, ++cur){
         mystl::construct(&*cur, mystl::move(*first));
-        }
-    }
-    catch (...){
-        for (; result != cur; ++result)
-        mystl::destroy(&*result);
-        throw;
     }
+    guard.release();
     return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result){
     return mystl::unchecked_uninit_move_n(first, n, result,
-        std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value_type>{});
+        is_trivially_uninit_move<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+// 7.uninitialized_default_construct：在 [first, last) 上默认初始化元素（new T，不带括号）
+    // 平凡默认构造的类型什么也不做，不写内存
+template <class ForwardIter>
+void unchecked_uninit_default_construct(ForwardIter, ForwardIter, std::true_type){}
+
+template <class ForwardIter>
+void unchecked_uninit_default_construct(ForwardIter first, ForwardIter last, std::false_type){
+    auto cur = first;
+    uninit_guard<ForwardIter> guard(first, cur);
+    for (; cur != last; ++cur){
+        mystl::construct_default(&*cur);
+    }
+    guard.release();
+}
+
+template <class ForwardIter>
+void uninitialized_default_construct(ForwardIter first, ForwardIter last){
+    mystl::unchecked_uninit_default_construct(first, last,
+        std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+// 8.uninitialized_value_construct：在 [first, last) 上值初始化元素（new T()）
+    // 平凡类型的值初始化就是清零，转为 fill（连续内存上是 memset）
+template <class ForwardIter>
+void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::true_type){
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    mystl::fill(first, last, value_type());
+}
+
+template <class ForwardIter>
+void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::false_type){
+    auto cur = first;
+    uninit_guard<ForwardIter> guard(first, cur);
+    for (; cur != last; ++cur){
+        mystl::construct(&*cur);
+    }
+    guard.release();
+}
+
+template <class ForwardIter>
+void uninitialized_value_construct(ForwardIter first, ForwardIter last){
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    mystl::unchecked_uninit_value_construct(first, last,
+        std::integral_constant<bool, std::is_trivially_default_constructible<value_type>::value &&
+                                     is_trivially_uninit_copy<value_type>::value>{});
+}
+
+// 9.uninitialized_default_construct_n：从 first 开始默认初始化 n 个元素，返回构造结束的位置
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::true_type){
+    if (n > 0){
+        mystl::advance(first, n);
+    }
+    return first;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::false_type){
+    auto cur = first;
+    uninit_guard<ForwardIter> guard(first, cur);
+    for (; n > 0; --n, ++cur){
+        mystl::construct_default(&*cur);
+    }
+    guard.release();
+    return cur;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n){
+    return mystl::unchecked_uninit_default_construct_n(first, n,
+        std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+// 10.uninitialized_value_construct_n：从 first 开始值初始化 n 个元素，返回构造结束的位置
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::true_type){
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::fill_n(first, n, value_type());
+}
+
+template <class ForwardIter, class Size>
+ForwardIter unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::false_type){
+    auto cur = first;
+    uninit_guard<ForwardIter> guard(first, cur);
+    for (; n > 0; --n, ++cur){
+        mystl::construct(&*cur);
+    }
+    guard.release();
+    return cur;
+}
+
+template <class ForwardIter, class Size>
+ForwardIter uninitialized_value_construct_n(ForwardIter first, Size n){
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::unchecked_uninit_value_construct_n(first, n,
+        std::integral_constant<bool, std::is_trivially_default_constructible<value_type>::value &&
+                                     is_trivially_uninit_copy<value_type>::value>{});
+}
+
+// 11.uninitialized_relocate：把 [first, last) 上的元素搬到以 result 为起始处的未初始化空间，并析构原来的元素，返回搬移结束的位置
+    // 容器扩容时使用：移动构造不抛异常（或者元素不能复制）时移动，否则复制，
+    // 构造失败时已构造的部分被析构，原区间保持不变（强异常保证），全部成功后才析构原区间
+template <class T>
+struct is_relocate_by_move
+    : std::integral_constant<bool, std::is_nothrow_move_constructible<T>::value ||
+                                   !std::is_copy_constructible<T>::value> {};
+
+template <class InputIter, class ForwardIter>
+ForwardIter unchecked_uninit_relocate(InputIter first, InputIter last, ForwardIter result, std::true_type){
+    return mystl::uninitialized_move(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter unchecked_uninit_relocate(InputIter first, InputIter last, ForwardIter result, std::false_type){
+    return mystl::uninitialized_copy(first, last, result);
+}
+
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_relocate(InputIter first, InputIter last, ForwardIter result){
+    ForwardIter end=mystl::unchecked_uninit_relocate(first, last, result,
+        is_relocate_by_move<typename iterator_traits<InputIter>::value_type>{});
+    mystl::destroy(first, last);
+    return end;
 }
 
 } // namespace mystl
 
-#endif
\ No newline at end of file
+#endif
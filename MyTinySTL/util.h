@@ -3,14 +3,67 @@
 
 // 引入标准库中的cstddef，用于内存操作、指针运算和数组处理等
 #include <cstddef>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
 #include "type_traits.h"
 
+// MYSTL_HAS_IS_CONSTANT_EVALUATED：编译器是否提供 __builtin_is_constant_evaluated
+    // 算法中 memmove/memset/memcmp 的快速路径不能在编译期求值，需要借助它在编译期退回到逐元素的循环
+#if defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define MYSTL_HAS_IS_CONSTANT_EVALUATED 1
+#  endif
+#endif
+#if !defined(MYSTL_HAS_IS_CONSTANT_EVALUATED) && \
+    ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#  define MYSTL_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
+// MYSTL_NOINLINE：不内联的函数，用于把很少执行的路径（如释放对象）移出热路径
+#if defined(__GNUC__) || defined(__clang__)
+#  define MYSTL_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#  define MYSTL_NOINLINE __declspec(noinline)
+#else
+#  define MYSTL_NOINLINE
+#endif
+
 namespace mystl{
 
+// is_constant_evaluated：当前是否处于常量求值（编译期）中
+    // 编译器不支持时总是返回 false，此时对可平凡复制的指针区间调用 copy/fill 等不能在编译期求值
+constexpr bool is_constant_evaluated() noexcept{
+#ifdef MYSTL_HAS_IS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// cache_line_size：缓存行的大小，并发容器中由不同线程写的成员按它对齐，避免伪共享
+constexpr size_t cache_line_size=64;
+
+// cpu_relax：自旋等待的循环体，x86 上是 pause 指令，减少自旋时对内存顺序流水线和超线程兄弟的干扰
+inline void cpu_relax() noexcept{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+}
+
+// prefetch：提示 CPU 把 p 所在的缓存行预先取到缓存中，只是提示，不会出错，p 可以指向任何地方
+inline void prefetch(const void* p) noexcept{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 // move：将左值转化为右值，即move(左值)是右值，进而支持移动语义（不分配新的内存，只是移动源对象，“窃取”，原来的指针不再使用）
     // 移动语义允许资源的所有权从一个对象转移到另一个对象，而无需进行深拷贝，提高性能和效率（将即将被销毁的右值保存下来，传递函数的返回值使用的就是移动语义）
 template <class T>
-typename std::remove_reference<T>::type&& move(T&& arg) noexcept{ 
+constexpr typename std::remove_reference<T>::type&& move(T&& arg) noexcept{
     // typename是指定获取模板类的类型成员
     // remove_reference<T>::type 解除引用的模板元函数，得到原始类型
     // && 在返回类型中使用&&表示右值引用的返回类型
@@ -26,30 +79,59 @@ typename std::remove_reference<T>::type&& move(T&& arg) noexcept{
     // 根据引用折叠原理，将forward使用在右值引用函数参数上，转发保持被转发实参的所有性质（是否是const，是左值还是右值）
         // 右值引用函数参数接受实参（右值）后可能改变其性质（变成左值），因为函数参数的传递是左值表达式，左值和右值之间可能无法传递，需要用forward加上&&保持性质
 template <class T>
-T&& forward(typename std::remove_reference<T>::type& arg) noexcept{
+constexpr T&& forward(typename std::remove_reference<T>::type& arg) noexcept{
     return static_cast<T&&>(arg);
 }
 
 template <class T>
-T&& forward(typename std::remove_reference<T>::type&& arg) noexcept{
+constexpr T&& forward(typename std::remove_reference<T>::type&& arg) noexcept{
     static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
     // 这个静态断言检查参数的值类别是否为左值引用。如果 T 是左值引用，就会触发断言
     return static_cast<T&&>(arg);
 }
 
 
+// move_if_noexcept：移动构造不抛异常（或者不可拷贝）时返回右值，否则返回 const 左值
+    // 容器在重新分配内存时用它来保证强异常安全：能安全移动就移动，否则退回拷贝
+template <class T>
+constexpr typename std::conditional<
+    !std::is_nothrow_move_constructible<T>::value && std::is_copy_constructible<T>::value,
+    const T&, T&&>::type
+    move_if_noexcept(T& arg) noexcept{
+    return mystl::move(arg);
+}
+
 // swap：使用了move函数来实现移动语义，从而在交换对象时避免进行不必要的深拷贝
     // 只是所有权名字发生改变，不用实际交付资产
+    // 移动构造和移动赋值都不抛异常时，swap 也不抛异常
 template <class T>
-void swap(T& p1, T& p2){
+constexpr void swap(T& p1, T& p2) noexcept(
+    std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value){
     auto tmp(mystl::move(p1));
     p1=mystl::move(p2);
     p2=mystl::move(tmp);
 }
 
+// 代理引用的 swap：soa_vector 等按列存放的容器解引用得到 std::tuple<Ts&...> 右值，
+    // 交换两个代理就是逐个交换它们引用的对象；iter_swap、swap_range 由此可以用在这些容器的迭代器上
+template <class... Ts, size_t... I>
+constexpr void swap_referents(const std::tuple<Ts&...>& lhs, const std::tuple<Ts&...>& rhs, std::index_sequence<I...>)
+    noexcept(std::conjunction<std::is_nothrow_move_constructible<Ts>..., std::is_nothrow_move_assignable<Ts>...>::value){
+    (void)std::initializer_list<int>{(mystl::swap(std::get<I>(lhs), std::get<I>(rhs)), 0)...};
+}
+
+template <class... Ts>
+constexpr void swap(std::tuple<Ts&...>&& lhs, std::tuple<Ts&...>&& rhs)
+    noexcept(std::conjunction<std::is_nothrow_move_constructible<Ts>..., std::is_nothrow_move_assignable<Ts>...>::value){
+    mystl::swap_referents(lhs, rhs, std::index_sequence_for<Ts...>());
+}
+
 // 交换某一范围内的数组元素
 template <class ForwardIter1, class ForwardIter2>
-ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2){
+constexpr ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
+    noexcept(noexcept(mystl::swap(*first1, *first2)) && noexcept(first1!=last1) &&
+             noexcept(++first1) && noexcept(++first2)){
     for(; first1!=last1; ++first1, (void) ++first2){
         mystl::swap(*first1,*first2);
     }
@@ -57,7 +139,7 @@ ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 fi
 }
 
 template <class Tp, size_t N>
-void swap(Tp(&a)[N], Tp(&b)[N]){
+constexpr void swap(Tp(&a)[N], Tp(&b)[N]) noexcept(noexcept(mystl::swap(*a, *b))){
     mystl::swap_range(a,a+N,b);
 }
 
@@ -77,7 +159,9 @@ struct pair
             std::is_default_constructible<Other1>::value &&
             std::is_default_constructible<Other2>::value, void>::type>
     // 运用标准库的type_traits进行特性抽取，判断两种类型是否都是默认可构造的
-    constexpr pair(): first(), second(){}
+    constexpr pair() noexcept(
+        std::is_nothrow_default_constructible<Other1>::value &&
+        std::is_nothrow_default_constructible<Other2>::value): first(), second(){}
     // 使用 constexpr 的目的是将构造函数声明为在编译时可以确定其结果的函数，这是为了支持在编译期间进行条件检查。
 
     // 2.只接受 Ty1 和 Ty2 类型的参数，并进行值的拷贝构造
@@ -89,22 +173,27 @@ struct pair
             std::is_convertible<const U1&, Ty1>::value &&
             std::is_convertible<const U2&, Ty2>::value, int>::type=0>
     // is_convertible检查是否可以将第一个类型转换为第二个类型
-    constexpr pair(const Ty1& a, const Ty2& b):first(a),second(b){}
+    constexpr pair(const Ty1& a, const Ty2& b) noexcept(
+        std::is_nothrow_copy_constructible<U1>::value &&
+        std::is_nothrow_copy_constructible<U2>::value):first(a),second(b){}
     // 参数类型为
 
     // 显式构造（不能发生类型隐式转换）
     template <class U1=Ty1, class U2=Ty2,
         typename std::enable_if<
             std::is_copy_constructible<U1>::value &&
-            std::is_copy_constructible<U2>::vlaue &&
+            std::is_copy_constructible<U2>::value &&
             (!std::is_convertible<const U1&, Ty1>::value ||
             !std::is_convertible<const U2&, Ty2>::value),int>::type=0>
-    explicit constexpr pair(const Ty1& a, const Ty2& b):first(a),second(b){}
+    explicit constexpr pair(const Ty1& a, const Ty2& b) noexcept(
+        std::is_nothrow_copy_constructible<U1>::value &&
+        std::is_nothrow_copy_constructible<U2>::value):first(a),second(b){}
     // explicit的作用是表明该构造函数是显式的, 而非隐式的,防止类构造函数的隐式自动转换
 
-    // 提供拷贝构造
+    // 提供拷贝构造和移动构造
+        // 默认生成的版本会根据成员自动推导 constexpr 和 noexcept，移动构造不抛异常时容器扩容就能选择移动
     pair(const pair& rhs)=default;
-    pair(pair& rhs)=default;
+    pair(pair&& rhs)=default;
     
     // 3.支持从不同类型的参数构造对象，使用完美转发来保留参数的值类别
     // 隐式构造
@@ -115,7 +204,10 @@ struct pair
             std::is_convertible<Other1&&, Ty1>::value &&
             std::is_convertible<Other2&&, Ty2>::value, int>::type=0>
     // is_constructible检验是否可以通过将类型Other1作为参数传递给Ty1的构造函数来构造Ty1类型的对象
-    constexpr pair(Other1&& a, Other2&& b):first(mystl::forward<Other1>(a)),second(mystl::forward<Other2>(b)){}
+    constexpr pair(Other1&& a, Other2&& b) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value &&
+        std::is_nothrow_constructible<Ty2, Other2>::value)
+        :first(mystl::forward<Other1>(a)),second(mystl::forward<Other2>(b)){}
 
     // 显式构造
     template <class Other1, class Other2,
@@ -124,7 +216,10 @@ struct pair
             std::is_constructible<Ty2, Other2>::value &&
             (!std::is_convertible<Other1, Ty1>::value ||
             !std::is_convertible<Other2, Ty2>::value), int>::type=0>
-    explicit constexpr pair(Other1&& a, Other2&& b):first(mystl::forward<Other1>(a)),second(mystl::forward<Other2>(b)){}
+    explicit constexpr pair(Other1&& a, Other2&& b) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value &&
+        std::is_nothrow_constructible<Ty2, Other2>::value)
+        :first(mystl::forward<Other1>(a)),second(mystl::forward<Other2>(b)){}
 
     // 4.使用拷贝构造，支持从不同类型的 pair 对象构造当前的 pair 对象
     // 隐式构造
@@ -134,7 +229,10 @@ struct pair
             std::is_constructible<Ty2, const Other2&>::value &&
             std::is_convertible<const Other1&, Ty1>::value &&
             std::is_convertible<const Other2&, Ty2>::value, int>::type=0>
-    constexpr pair(const pair<Other1,Other2>& other): first(other.first),second(other.second){}
+    constexpr pair(const pair<Other1,Other2>& other) noexcept(
+        std::is_nothrow_constructible<Ty1, const Other1&>::value &&
+        std::is_nothrow_constructible<Ty2, const Other2&>::value)
+        : first(other.first),second(other.second){}
 
     // 显式构造
     template <class Other1, class Other2,
@@ -143,7 +241,10 @@ struct pair
             std::is_constructible<Ty2, const Other2&>::value &&
             (!std::is_convertible<const Other1&, Ty1>::value ||
             !std::is_convertible<const Other2&, Ty2>::value), int>::type=0>
-    explicit constexpr pair(const pair<Other1,Other2>& other):first(other.first),second(other.second){}
+    explicit constexpr pair(const pair<Other1,Other2>& other) noexcept(
+        std::is_nothrow_constructible<Ty1, const Other1&>::value &&
+        std::is_nothrow_constructible<Ty2, const Other2&>::value)
+        :first(other.first),second(other.second){}
 
     // 5.使用完美转发
     // 隐式构造
@@ -153,7 +254,10 @@ struct pair
             std::is_constructible<Ty2, Other2>::value &&
             std::is_convertible<Other1, Ty1>::value &&
             std::is_convertible<Other2, Ty2>::value, int>::type=0>
-    constexpr pair(pair<Other1, Other2>&& other):first(mystl::forward<Other1>(other.first)),second(mystl::forward<Other2>(other.second)){}
+    constexpr pair(pair<Other1, Other2>&& other) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value &&
+        std::is_nothrow_constructible<Ty2, Other2>::value)
+        :first(mystl::forward<Other1>(other.first)),second(mystl::forward<Other2>(other.second)){}
 
     // 显式构造
     template <class Other1, class Other2,
@@ -162,11 +266,16 @@ struct pair
             std::is_constructible<Ty2, Other2>::value &&
             (!std::is_convertible<Other1, Ty1>::value ||
             !std::is_convertible<Other2, Ty2>::value), int>::type=0>
-    explicit constexpr pair(pair<Other1,Other2>&& other):first(mystl::forward<Other1>(other.first)),second(mystl::forward<Other2>(other.second)){}
+    explicit constexpr pair(pair<Other1,Other2>&& other) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value &&
+        std::is_nothrow_constructible<Ty2, Other2>::value)
+        :first(mystl::forward<Other1>(other.first)),second(mystl::forward<Other2>(other.second)){}
 
     // 同类型赋值
     // 拷贝赋值（深拷贝）
-    pair& operator=(const pair& rhs){
+    constexpr pair& operator=(const pair& rhs) noexcept(
+        std::is_nothrow_copy_assignable<Ty1>::value &&
+        std::is_nothrow_copy_assignable<Ty2>::value){
         if(this!=&rhs){
             first=rhs.first;
             second=rhs.second;
@@ -175,7 +284,9 @@ struct pair
     }
 
     // 移动赋值（浅拷贝）（将其他类型的对象转换成右值从而替代）
-    pair& operator=(pair&& rhs){
+    constexpr pair& operator=(pair&& rhs) noexcept(
+        std::is_nothrow_move_assignable<Ty1>::value &&
+        std::is_nothrow_move_assignable<Ty2>::value){
         if(this!=&rhs){
             first=mystl::move(rhs.first);
             second=mystl::move(rhs.second);
@@ -186,7 +297,9 @@ struct pair
     // 不同类型赋值
     // 拷贝赋值（深拷贝）
     template <class Other1, class Other2>
-    pair& operator=(const pair<Other1,Other2>& other){
+    constexpr pair& operator=(const pair<Other1,Other2>& other) noexcept(
+        std::is_nothrow_assignable<Ty1&, const Other1&>::value &&
+        std::is_nothrow_assignable<Ty2&, const Other2&>::value){
         first=other.first;
         second=other.second;
         return *this;
@@ -194,7 +307,9 @@ struct pair
 
     // 移动赋值（浅拷贝）（保留其他类型的对象）
     template <class Other1, class Other2>
-    pair& operator=(pair<Other1,Other2>&& other){
+    constexpr pair& operator=(pair<Other1,Other2>&& other) noexcept(
+        std::is_nothrow_assignable<Ty1&, Other1>::value &&
+        std::is_nothrow_assignable<Ty2&, Other2>::value){
         first=mystl::forward<Other1>(other.first);
         second=mystl::forward<Other2>(other.second);
         return *this;
@@ -203,7 +318,9 @@ struct pair
     ~pair()=default;
 
     // 提供swap函数
-    void swap(pair& other){
+    constexpr void swap(pair& other) noexcept(
+        noexcept(mystl::swap(other.first, other.first)) &&
+        noexcept(mystl::swap(other.second, other.second))){
         if(this!=&other){
             mystl::swap(first, other.first);
             mystl::swap(second,other.second);
@@ -214,48 +331,267 @@ struct pair
 
 // 重载比较操作符: 比较元素大小
 template <class Ty1, class Ty2>
-bool operator==(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator==(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return lhs.first==rhs.first && lhs.second==rhs.second;
 }
 
 template <class Ty1, class Ty2>
-bool operator<(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator<(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return lhs.first<rhs.first || (lhs.first==rhs.first && lhs.second<rhs.second);
 }
 
 // 借助上面的函数取反
 template <class Ty1, class Ty2>
-bool operator!=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator!=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return !(lhs==rhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return rhs<lhs;
 }
 
 template <class Ty1, class Ty2>
-bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return !(rhs<lhs);
 }
 
 template <class Ty1, class Ty2>
-bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
+constexpr bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs){
     return !(lhs<rhs);
 }
 
 // 重载swap
 template <class Ty1, class Ty2>
-void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs){
+constexpr void swap(pair<Ty1, Ty2>& lhs, pair<Ty1, Ty2>& rhs) noexcept(noexcept(lhs.swap(rhs))){
     lhs.swap(rhs);
 }
 
 // make_pair
 template <class Ty1, class Ty2>
-pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second){
+constexpr pair<Ty1, Ty2> make_pair(Ty1&& first, Ty2&& second){
     return pair<Ty1,Ty2>(mystl::forward<Ty1>(first), mystl::forward<Ty2>(second));
 }
 
+// compressed_pair：利用空基类优化（EBO）压缩存储的 pair
+    // 空类（如无状态的比较器、哈希函数、分配器）作为成员时仍至少占用 1 字节，再加上对齐往往会多占一个指针大小
+    // 若改为继承空类，编译器可以把空基类放在偏移 0 处而不占空间，于是 compressed_pair<allocator, T*> 与 T* 一样大
+    // 容器中“分配器+指针”、“比较器+根节点”这类布局都可以用它来存储
+// compressed_pair_elem：compressed_pair 的一个元素，Index 用来区分两个元素，使 Ty1 与 Ty2 相同时也是不同的基类
+template <class T, size_t Index,
+    bool=std::is_empty<T>::value && !std::is_final<T>::value>
+struct compressed_pair_elem
+{
+    typedef T value_type;
+
+    // 值初始化，与 pair 的 first()、second() 行为一致
+    constexpr compressed_pair_elem(): value(){}
+
+    template <class U,
+        typename std::enable_if<
+            !std::is_same<compressed_pair_elem, typename std::decay<U>::type>::value, int>::type=0>
+    constexpr explicit compressed_pair_elem(U&& u): value(mystl::forward<U>(u)){}
+
+    constexpr T& get() noexcept { return value; }
+    constexpr const T& get() const noexcept { return value; }
+
+private:
+    T value;
+};
+
+// 空类且非 final：以私有继承的方式存储，不占空间
+template <class T, size_t Index>
+struct compressed_pair_elem<T, Index, true>: private T
+{
+    typedef T value_type;
+
+    constexpr compressed_pair_elem(): T(){}
+
+    template <class U,
+        typename std::enable_if<
+            !std::is_same<compressed_pair_elem, typename std::decay<U>::type>::value, int>::type=0>
+    constexpr explicit compressed_pair_elem(U&& u): T(mystl::forward<U>(u)){}
+
+    constexpr T& get() noexcept { return *this; }
+    constexpr const T& get() const noexcept { return *this; }
+};
+
+template <class Ty1, class Ty2>
+class compressed_pair: private compressed_pair_elem<Ty1, 0>, private compressed_pair_elem<Ty2, 1>
+{
+    typedef compressed_pair_elem<Ty1, 0> base1;
+    typedef compressed_pair_elem<Ty2, 1> base2;
+
+    template <class, class> friend class compressed_pair;
+
+public:
+    typedef Ty1 first_type;
+    typedef Ty2 second_type;
+
+    // 构造函数与 pair 一一对应，同样按是否可隐式转换来决定是否 explicit
+    // 构造函数的 noexcept 由两个成员的相应构造是否不抛异常决定
+    // 1.默认构造
+    template <class Other1=Ty1, class Other2=Ty2,
+        typename=typename std::enable_if<
+            std::is_default_constructible<Other1>::value &&
+            std::is_default_constructible<Other2>::value, void>::type>
+    constexpr compressed_pair() noexcept(
+        std::is_nothrow_default_constructible<Ty1>::value && std::is_nothrow_default_constructible<Ty2>::value)
+        : base1(), base2(){}
+
+    // 2.拷贝构造两个值
+    // 隐式构造
+    template <class U1=Ty1, class U2=Ty2,
+        typename std::enable_if<
+            std::is_copy_constructible<U1>::value &&
+            std::is_copy_constructible<U2>::value &&
+            std::is_convertible<const U1&, Ty1>::value &&
+            std::is_convertible<const U2&, Ty2>::value, int>::type=0>
+    constexpr compressed_pair(const Ty1& a, const Ty2& b) noexcept(
+        std::is_nothrow_copy_constructible<Ty1>::value && std::is_nothrow_copy_constructible<Ty2>::value)
+        : base1(a), base2(b){}
+
+    // 显式构造
+    template <class U1=Ty1, class U2=Ty2,
+        typename std::enable_if<
+            std::is_copy_constructible<U1>::value &&
+            std::is_copy_constructible<U2>::value &&
+            (!std::is_convertible<const U1&, Ty1>::value ||
+            !std::is_convertible<const U2&, Ty2>::value), int>::type=0>
+    explicit constexpr compressed_pair(const Ty1& a, const Ty2& b) noexcept(
+        std::is_nothrow_copy_constructible<Ty1>::value && std::is_nothrow_copy_constructible<Ty2>::value)
+        : base1(a), base2(b){}
+
+    compressed_pair(const compressed_pair& rhs)=default;
+    compressed_pair(compressed_pair&& rhs)=default;
+
+    // 3.从不同类型的参数构造，完美转发
+    // 隐式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, Other1>::value &&
+            std::is_constructible<Ty2, Other2>::value &&
+            std::is_convertible<Other1&&, Ty1>::value &&
+            std::is_convertible<Other2&&, Ty2>::value, int>::type=0>
+    constexpr compressed_pair(Other1&& a, Other2&& b) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value && std::is_nothrow_constructible<Ty2, Other2>::value)
+        : base1(mystl::forward<Other1>(a)), base2(mystl::forward<Other2>(b)){}
+
+    // 显式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, Other1>::value &&
+            std::is_constructible<Ty2, Other2>::value &&
+            (!std::is_convertible<Other1, Ty1>::value ||
+            !std::is_convertible<Other2, Ty2>::value), int>::type=0>
+    explicit constexpr compressed_pair(Other1&& a, Other2&& b) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value && std::is_nothrow_constructible<Ty2, Other2>::value)
+        : base1(mystl::forward<Other1>(a)), base2(mystl::forward<Other2>(b)){}
+
+    // 4.从不同类型的 compressed_pair 拷贝构造
+    // 隐式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, const Other1&>::value &&
+            std::is_constructible<Ty2, const Other2&>::value &&
+            std::is_convertible<const Other1&, Ty1>::value &&
+            std::is_convertible<const Other2&, Ty2>::value, int>::type=0>
+    constexpr compressed_pair(const compressed_pair<Other1, Other2>& other) noexcept(
+        std::is_nothrow_constructible<Ty1, const Other1&>::value &&
+        std::is_nothrow_constructible<Ty2, const Other2&>::value)
+        : base1(other.first()), base2(other.second()){}
+
+    // 显式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, const Other1&>::value &&
+            std::is_constructible<Ty2, const Other2&>::value &&
+            (!std::is_convertible<const Other1&, Ty1>::value ||
+            !std::is_convertible<const Other2&, Ty2>::value), int>::type=0>
+    explicit constexpr compressed_pair(const compressed_pair<Other1, Other2>& other) noexcept(
+        std::is_nothrow_constructible<Ty1, const Other1&>::value &&
+        std::is_nothrow_constructible<Ty2, const Other2&>::value)
+        : base1(other.first()), base2(other.second()){}
+
+    // 5.从不同类型的 compressed_pair 移动构造
+    // 隐式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, Other1>::value &&
+            std::is_constructible<Ty2, Other2>::value &&
+            std::is_convertible<Other1, Ty1>::value &&
+            std::is_convertible<Other2, Ty2>::value, int>::type=0>
+    constexpr compressed_pair(compressed_pair<Other1, Other2>&& other) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value && std::is_nothrow_constructible<Ty2, Other2>::value)
+        : base1(mystl::forward<Other1>(other.first())), base2(mystl::forward<Other2>(other.second())){}
+
+    // 显式构造
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, Other1>::value &&
+            std::is_constructible<Ty2, Other2>::value &&
+            (!std::is_convertible<Other1, Ty1>::value ||
+            !std::is_convertible<Other2, Ty2>::value), int>::type=0>
+    explicit constexpr compressed_pair(compressed_pair<Other1, Other2>&& other) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value && std::is_nothrow_constructible<Ty2, Other2>::value)
+        : base1(mystl::forward<Other1>(other.first())), base2(mystl::forward<Other2>(other.second())){}
+
+    // 6.从 pair 构造，方便与已有代码互通
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, const Other1&>::value &&
+            std::is_constructible<Ty2, const Other2&>::value, int>::type=0>
+    explicit constexpr compressed_pair(const pair<Other1, Other2>& other) noexcept(
+        std::is_nothrow_constructible<Ty1, const Other1&>::value &&
+        std::is_nothrow_constructible<Ty2, const Other2&>::value)
+        : base1(other.first), base2(other.second){}
+
+    template <class Other1, class Other2,
+        typename std::enable_if<
+            std::is_constructible<Ty1, Other1>::value &&
+            std::is_constructible<Ty2, Other2>::value, int>::type=0>
+    explicit constexpr compressed_pair(pair<Other1, Other2>&& other) noexcept(
+        std::is_nothrow_constructible<Ty1, Other1>::value && std::is_nothrow_constructible<Ty2, Other2>::value)
+        : base1(mystl::forward<Other1>(other.first)), base2(mystl::forward<Other2>(other.second)){}
+
+    compressed_pair& operator=(const compressed_pair& rhs)=default;
+    compressed_pair& operator=(compressed_pair&& rhs)=default;
+
+    ~compressed_pair()=default;
+
+    // 成员通过函数访问：空基类没有可命名的数据成员
+    constexpr Ty1& first() noexcept { return static_cast<base1&>(*this).get(); }
+    constexpr const Ty1& first() const noexcept { return static_cast<const base1&>(*this).get(); }
+
+    constexpr Ty2& second() noexcept { return static_cast<base2&>(*this).get(); }
+    constexpr const Ty2& second() const noexcept { return static_cast<const base2&>(*this).get(); }
+
+    constexpr void swap(compressed_pair& other) noexcept(
+        noexcept(mystl::swap(other.first(), other.first())) &&
+        noexcept(mystl::swap(other.second(), other.second()))){
+        if(this!=&other){
+            mystl::swap(first(), other.first());
+            mystl::swap(second(), other.second());
+        }
+    }
+};
+
+template <class Ty1, class Ty2>
+constexpr bool operator==(const compressed_pair<Ty1, Ty2>& lhs, const compressed_pair<Ty1, Ty2>& rhs){
+    return lhs.first()==rhs.first() && lhs.second()==rhs.second();
+}
+
+template <class Ty1, class Ty2>
+constexpr bool operator!=(const compressed_pair<Ty1, Ty2>& lhs, const compressed_pair<Ty1, Ty2>& rhs){
+    return !(lhs==rhs);
+}
+
+// 重载swap
+template <class Ty1, class Ty2>
+constexpr void swap(compressed_pair<Ty1, Ty2>& lhs, compressed_pair<Ty1, Ty2>& rhs) noexcept(noexcept(lhs.swap(rhs))){
+    lhs.swap(rhs);
+}
+
 } // namespace mystl
 
 #endif